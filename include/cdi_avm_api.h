@@ -150,6 +150,25 @@ typedef struct {
     CdiAvmExtraData avm_extra_data;
 } CdiAvmTxPayloadConfig;
 
+/// @brief A payload to transmit with CdiAvmEndpointTxPayloadMultiple(). The members are the parameters of
+/// CdiAvmEndpointTxPayload().
+typedef struct {
+    /// @brief Handle of the endpoint to send the payload to, returned by CdiAvmTxStreamEndpointCreate().
+    CdiEndpointHandle endpoint_handle;
+
+    /// @brief Pointer to payload configuration data. See CdiAvmEndpointTxPayload().
+    const CdiAvmTxPayloadConfig* payload_config_ptr;
+
+    /// @brief Pointer to AVM configuration data or NULL. See CdiAvmEndpointTxPayload().
+    const CdiAvmConfig* avm_config_ptr;
+
+    /// @brief Scatter-gather list containing the data to be transmitted. See CdiAvmEndpointTxPayload().
+    const CdiSgList* sgl_ptr;
+
+    /// @brief Maximum latency in microseconds. See CdiAvmEndpointTxPayload().
+    int max_latency_microsecs;
+} CdiAvmTxPayloadDescriptor;
+
 /**
  * @brief A structure of this type is passed as the parameter to CdiAvmRxCallback(). It contains a single payload sent
  * from a transmitter.
@@ -206,6 +225,20 @@ typedef struct {
  */
 typedef void (*CdiAvmTxCallback)(const CdiAvmTxCbData* data_ptr);
 
+/**
+ * @brief Priority of the payloads sent on a Tx stream endpoint relative to the payloads of the connection's other
+ * endpoints. Set using #CdiTxConfigDataStream.priority.
+ */
+typedef enum {
+    /// @brief Default priority, such as for video streams.
+    kCdiTxPriorityNormal,
+
+    /// @brief Packets of these payloads are queued before those of any normal priority payload, including one that has
+    /// been partially queued. Use for small payloads that must not wait behind a large video frame, such as audio and
+    /// ancillary data.
+    kCdiTxPriorityHigh,
+} CdiTxPriority;
+
 /**
  * @brief Stream configuration data used by the CdiAvmTxStreamEndpointCreate() API function.
  */
@@ -222,6 +255,11 @@ typedef struct {
     /// to this stream. If NULL, a name is internally generated. Length of name must not exceed
     /// CDI_MAX_STREAM_NAME_STRING_LENGTH.
     const char* stream_name_str;
+
+    /// @brief Priority of this stream's payloads. Payloads of higher priority streams are packetized first. Payloads of
+    /// streams with the same priority are packetized in order of their deadline (the time they were sent plus their
+    /// max_latency_microsecs). Defaults to kCdiTxPriorityNormal when zeroed.
+    CdiTxPriority priority;
 } CdiTxConfigDataStream;
 
 //*********************************************************************************************************************
@@ -401,4 +439,46 @@ CDI_INTERFACE CdiReturnStatus CdiAvmEndpointTxPayload(CdiEndpointHandle endpoint
                                                       const CdiAvmConfig* avm_config_ptr, const CdiSgList* sgl_ptr,
                                                       int max_latency_microsecs);
 
+/**
+ * Transmit a payload of data to a remote endpoint, replacing the payloads of the same stream (see
+ * CdiAvmExtraData.stream_identifier) that were sent to the endpoint and are still waiting to be sent. This is the same
+ * as CdiAvmEndpointTxPayload(), except that the replaced payloads are not sent and their CdiAvmTxCallback() is invoked
+ * with a status of kCdiStatusTxPayloadCancelled. A payload whose packets have started to be sent is not replaced. This
+ * allows an application to keep a single payload of a stream queued without waiting for callbacks.
+ *
+ * @param endpoint_handle Connection handle returned by a previous call to CdiAvmTxStreamEndpointCreate().
+ * @param payload_config_ptr Pointer to payload configuration data. See CdiAvmEndpointTxPayload().
+ * @param avm_config_ptr Pointer to configuration data that describes the contents of this payload. See
+ *                       CdiAvmEndpointTxPayload(). If a replaced payload carried a configuration, it must be specified
+ *                       again here.
+ * @param sgl_ptr Scatter-gather list containing the data to be transmitted. See CdiAvmEndpointTxPayload().
+ * @param max_latency_microsecs Maximum latency in microseconds. See CdiAvmEndpointTxPayload().
+ *
+ * @return A value from the CdiReturnStatus enumeration.
+ */
+CDI_INTERFACE CdiReturnStatus CdiAvmEndpointTxPayloadReplace(CdiEndpointHandle endpoint_handle,
+                                                             const CdiAvmTxPayloadConfig* payload_config_ptr,
+                                                             const CdiAvmConfig* avm_config_ptr,
+                                                             const CdiSgList* sgl_ptr, int max_latency_microsecs);
+
+/**
+ * Transmit multiple payloads, each to its own endpoint. This is the same as calling CdiAvmEndpointTxPayload() for each
+ * payload in order, except that consecutive payloads sent to endpoints of the same connection are queued together,
+ * with a single wake-up of the connection's transmit thread. This lowers the per-payload cost of applications that
+ * send many small payloads, such as audio and ancillary data for several streams, at the same time. Payloads that
+ * specify AVM configuration data are queued individually.
+ *
+ * The status of each payload is written to ret_status_array. A payload that is not sent, for example because the
+ * connection's payload queue is full, does not prevent the payloads that follow it from being sent, so the application
+ * must check the status of each payload to know which CdiAvmTxCallback() calls to expect.
+ *
+ * @param descriptor_array Array of payloads to transmit. See CdiAvmTxPayloadDescriptor.
+ * @param descriptor_count Number of payloads in descriptor_array.
+ * @param ret_status_array Address of an array of descriptor_count values where the status of each payload is written.
+ *
+ * @return kCdiStatusOk if all payloads were sent, otherwise the status of the first payload that was not sent.
+ */
+CDI_INTERFACE CdiReturnStatus CdiAvmEndpointTxPayloadMultiple(const CdiAvmTxPayloadDescriptor* descriptor_array,
+                                                              int descriptor_count, CdiReturnStatus* ret_status_array);
+
 #endif // CDI_AVM_API_H__
@@ -125,6 +125,10 @@
 /// Sized to allow receive of 4K RGB 4:4:4 12 bit.
 #define CDI_MAX_RX_PACKET_OUT_OF_ORDER_WINDOW           (5000)
 
+/// @brief Maximum number of threads that can copy received packets into the linear receive buffers of a connection.
+/// See CdiRxConfigData.copy_thread_count.
+#define CDI_MAX_RX_COPY_THREADS                         (16)
+
 /// @brief Maximum connection name string length.
 #define CDI_MAX_CONNECTION_NAME_STRING_LENGTH           (128)
 
@@ -322,6 +326,13 @@ typedef enum {
 
     /// Resource not available. Retry the operation.
     kCdiStatusRetry                 = 42,
+
+    /// Tx payload was not sent because it was stale. See CdiTxStalePayloadConfig.
+    kCdiStatusTxPayloadStale        = 43,
+
+    /// Tx payload was not sent because it was cancelled or replaced. See CdiCoreTxPayloadCancel() and
+    /// CdiAvmEndpointTxPayloadReplace().
+    kCdiStatusTxPayloadCancelled    = 44,
 } CdiReturnStatus;
 
 /// @brief A structure for holding a PTP timestamp defined in seconds and nanoseconds. This PTP time as defined by
@@ -441,6 +452,46 @@ typedef struct {
     CdiUserCbParameter user_cb_param;
 } CdiCoreCbData;
 
+/**
+ * @brief A structure of this type is passed as the parameter to CdiCoreRxSliceCallback(). It describes a slice of a
+ * payload that is still being received: a range of bytes that follows the ones reported by the previous slice of the
+ * payload, such that all of the bytes from the start of the payload to the end of the range have been received.
+ */
+typedef struct {
+    /// @brief The handle of the instance which was created using a previous call to one of the Cdi...RxCreate() API
+    /// functions.
+    CdiConnectionHandle connection_handle;
+
+    /// @brief Extra data that was sent along with the payload. Identifies the payload, as in the CdiCoreCbData that is
+    /// passed to the Rx callback once the payload is complete.
+    CdiCoreExtraData core_extra_data;
+
+    /// @brief Address of the linear receive buffer the payload is being received into. The buffer is handed to the
+    /// application with the complete payload, so it must not be freed until then.
+    const uint8_t* payload_buffer_ptr;
+
+    /// @brief Offset in bytes of the start of the slice within the payload.
+    int slice_offset;
+
+    /// @brief Size of the slice in bytes.
+    int slice_size;
+
+    /// @brief User defined callback parameter. This value is set as part of the CdiRxConfigData data provided to one of
+    /// the Cdi...RxCreate() API functions (see CdiRxConfigData.slice_user_cb_param).
+    CdiUserCbParameter slice_user_cb_param;
+} CdiCoreRxSliceCbData;
+
+/**
+ * @brief Prototype of Rx slice callback function. The user code must implement a function with this prototype and
+ *        provide it in the CdiRxConfigData structure when using one of the Cdi...RxCreate() API functions.
+ *
+ * This callback function is invoked whenever more of the start of a payload has been received, before the payload is
+ * complete. It is invoked by the thread that receives the connection's packets, so it must return quickly.
+ *
+ * @param data_ptr A pointer to a CdiCoreRxSliceCbData structure.
+ */
+typedef void (*CdiCoreRxSliceCallback)(const CdiCoreRxSliceCbData* data_ptr);
+
 /**
  * @brief This selector determines the type of network adapter in the API function.
  * NOTE: Any changes made here MUST also be made to "adapter_type_key_array" in cdi_avm_api.c.
@@ -543,6 +594,15 @@ typedef struct {
 
     /// @brief The 99th percentile time to transfer a payload over the time interval.
     uint32_t transfer_time_P99;
+
+    /// @brief Transmitter only. Maximum time a payload waited before its packetization started over the time interval.
+    /// Since a Tx stream's priority is set per endpoint (see #CdiTxConfigDataStream.priority), this is the queueing
+    /// delay of the endpoint's priority class.
+    uint32_t tx_queue_time_max;
+
+    /// @brief Transmitter only. Accumulating sum of the time payloads waited before their packetization started over
+    /// the time interval. Divide by transfer_count for the average.
+    uint64_t tx_queue_time_sum;
 } CdiPayloadTimeIntervalStats;
 
 /**
@@ -564,8 +624,54 @@ typedef struct {
     int poll_thread_load;
 
     bool connected; ///< true if connected, false if not connected.
+
+    /// Transmitter only. Number of payload data packets sent since the connection was created.
+    uint64_t tx_packet_count;
+
+    /// Transmitter only. Number of times the packet pacer (see #CdiTxConfigData.pacing) delayed sending a packet
+    /// because a burst had been used up, which ends the burst.
+    uint64_t tx_pacing_delay_count;
 } CdiAdapterEndpointStats;
 
+/**
+ * @brief Memory pool and queue usage statistics of a connection. Each value is aggregated across the pools and queues
+ * used internally by the connection and its adapter. The counters are always maintained and don't reset. Used in the
+ * CdiTransferStats structure as a parameter of the user-registered CdiCoreStatsCallback() API function.
+ */
+typedef struct {
+    uint32_t pool_item_count;            ///< Total number of items in all of the connection's pools.
+    uint32_t pool_free_item_count;       ///< Number of pool items currently free.
+
+    /// @brief Sum of the largest number of items that each pool has had in use at the same time.
+    uint32_t pool_high_water_item_count;
+
+    /// @brief Largest high-water mark of any single pool, as a percentage of that pool's size. A value that reaches 100
+    /// means a pool has been empty at least once and is likely to have stalled the connection.
+    uint32_t pool_peak_usage_percent;
+
+    uint32_t pool_grow_count;            ///< Number of times a pool had to be increased in size.
+    uint32_t pool_get_fail_count;        ///< Number of pool gets that failed because a pool was exhausted.
+
+    uint32_t queue_item_count;           ///< Total number of items that all of the connection's queues can hold.
+    uint32_t queue_free_item_count;      ///< Number of queue items currently free.
+
+    /// @brief Sum of the largest number of items that have been enqueued on each queue.
+    uint32_t queue_high_water_item_count;
+
+    /// @brief Largest high-water mark of any single queue, as a percentage of that queue's size.
+    uint32_t queue_peak_usage_percent;
+
+    uint32_t queue_grow_count;           ///< Number of times a queue had to be increased in size.
+    uint32_t queue_push_fail_count;      ///< Number of queue pushes that failed because a queue was full.
+
+    uint64_t pool_byte_size;             ///< Memory used by all of the connection's pools.
+    uint64_t queue_byte_size;            ///< Memory used by all of the connection's queues.
+
+    /// @brief Memory used by the adapter's receive packet buffers. Always 0 for Tx connections, since their packet
+    /// headers are held in pools and included in pool_byte_size.
+    uint64_t rx_packet_buffer_byte_size;
+} CdiResourceStats;
+
 /**
  * @brief Transfer statistics data. Used as a parameter of the user-registered CdiCoreStatsCallback() API function.
  */
@@ -580,6 +686,7 @@ typedef struct {
     CdiPayloadCounterStats payload_counter_stats; ///< Statistics data specific to payloads that don't reset.
     CdiPayloadTimeIntervalStats payload_time_interval_stats; ///< Statistics data specific to payloads that reset.
     CdiAdapterEndpointStats endpoint_stats; ///< Statistics data specific to adapter endpoints.
+    CdiResourceStats resource_stats; ///< Pool and queue usage of the connection. Same for each of its endpoints.
 } CdiTransferStats;
 
 /**
@@ -618,6 +725,69 @@ typedef struct {
     bool disable_cloudwatch_stats;
 } CdiStatsConfigData;
 
+/**
+ * @brief Describes the stream a connection is expected to carry, so the SDK can size the connection's internal pools
+ * and queues for it instead of for the worst case of 4K video. Used by #CdiTxConfigData.resource_profile and
+ * #CdiRxConfigData.resource_profile. If max_payload_byte_size is 0 the profile is not used, which is the default. The
+ * derived sizes never exceed the worst case sizes. CdiCoreConnectionGetResourceStats() returns the resulting
+ * footprint. NOTE: The pools sized by max_simultaneous_tx_payloads and max_simultaneous_tx_payload_sgl_entries are not
+ * affected, since they depend on how the application builds its payloads.
+ */
+typedef struct {
+    /// @brief Size in bytes of the largest payload that will be sent on the connection. A value of 0 disables the
+    /// profile.
+    uint64_t max_payload_byte_size;
+
+    /// @brief Number of payloads sent each second, such as the frame rate of a video stream. Used by receivers to size
+    /// the buffers held by the receive buffer delay (see #CdiRxConfigData.buffer_delay_ms). If 0, the buffers are sized
+    /// as if the profile was not used.
+    uint32_t payloads_per_second;
+
+    /// @brief Number of payloads that can be in flight at the same time. If 0, max_simultaneous_tx_payloads or
+    /// max_simultaneous_rx_payloads_per_connection is used.
+    int max_in_flight_payloads;
+} CdiResourceProfile;
+
+/**
+ * @brief Configuration of a Tx connection's packet pacer, used by #CdiTxConfigData.pacing. Without pacing, the
+ * packets of a payload are sent as fast as the adapter accepts them, so a video frame leaves as a single line-rate
+ * burst. The pacer spreads the packets sent to each of the connection's endpoints using a token bucket, which allows
+ * bursts of up to burst_bytes to be sent back to back. Pacing is disabled if both rate_bits_per_second and
+ * latency_percent are 0, which is the default. CdiAdapterEndpointStats reports the pacer's activity.
+ */
+typedef struct {
+    /// @brief Fixed rate in bits per second at which packets are sent to each endpoint. If 0, no fixed rate is used.
+    uint64_t rate_bits_per_second;
+
+    /// @brief Percentage (1 to 100) of each payload's max_latency_microsecs over which its packets are spread. For
+    /// example, with 80 a video frame sent with a max latency of one frame interval is spread over the first 80% of the
+    /// interval. Payloads sent with a max latency of 0 are not paced by this setting. If both this and
+    /// rate_bits_per_second are set, the faster of the two rates is used. If 0, this setting is not used.
+    int latency_percent;
+
+    /// @brief Maximum number of bytes that can be sent back to back. If 0, a default of 32KB is used.
+    uint32_t burst_bytes;
+} CdiTxPacingConfig;
+
+/**
+ * @brief Configuration of how a Tx connection handles stale payloads, used by #CdiTxConfigData.stale_payloads. By
+ * default every payload is sent, so when the network or the receiver falls behind, late payloads are still sent and
+ * delay the payloads that follow them. Each payload is checked just before its first packet is built. A skipped payload
+ * is not sent, its Tx callback is made with a status of kCdiStatusTxPayloadStale and it is counted in
+ * CdiPayloadCounterStats.num_payloads_dropped.
+ */
+typedef struct {
+    /// @brief If true, a payload is skipped if it cannot be sent within its max_latency_microsecs of the time it was
+    /// sent, because the time has already passed or because its packets are paced (see CdiTxPacingConfig) at a rate
+    /// that cannot send them, after the packets queued ahead of them, in the time left. Payloads sent with a max latency
+    /// of 0 are never skipped by this setting.
+    bool skip_late;
+
+    /// @brief If true, a payload is skipped if a newer payload of the same stream has been sent to the same endpoint
+    /// and is waiting to be sent, so only the newest payload of a stream that has fallen behind is sent.
+    bool skip_superseded;
+} CdiTxStalePayloadConfig;
+
 /**
  * @brief Configuration data used by one of the Cdi...TxCreate() API functions.
  */
@@ -697,6 +867,17 @@ typedef struct {
     /// @brief Configuration data for gathering statistics. The data can be changed at runtime using the
     /// CdiCoreStatsReconfigure() API function.
     CdiStatsConfigData stats_config;
+
+    /// @brief Expected stream characteristics used to size the connection's resources. Leave zeroed to use the worst
+    /// case sizes.
+    CdiResourceProfile resource_profile;
+
+    /// @brief Configuration of the connection's packet pacer. Leave zeroed to send packets as fast as the adapter
+    /// accepts them.
+    CdiTxPacingConfig pacing;
+
+    /// @brief Configuration of how stale payloads are handled. Leave zeroed to send every payload.
+    CdiTxStalePayloadConfig stale_payloads;
 } CdiTxConfigData;
 
 /**
@@ -800,6 +981,42 @@ typedef struct {
     /// value is only used if rx_buffer_type = kCdiLinearBuffer.
     uint64_t linear_buffer_size;
 
+    /// @brief Number of threads that copy received packets into the linear receive buffer. If 0, the poll thread copies
+    /// the packets, which limits the connection's receive rate to the memory bandwidth of one core. Otherwise, the poll
+    /// thread only decodes the packet headers and hands the copies to these threads, and frees the packet buffers once
+    /// they are copied. The value must not exceed CDI_MAX_RX_COPY_THREADS. NOTE: This value is only used if
+    /// rx_buffer_type = kCdiLinearBuffer.
+    int copy_thread_count;
+
+    /// @brief The core to pin the first copy thread to (see copy_thread_count). Each following copy thread is pinned to
+    /// the following core. A value of -1 disables pinning the copy threads, otherwise the value must be between 0
+    /// (inclusive) and the number of CPU cores (exclusive) in the host.
+    int copy_thread_core_num;
+
+    /// @brief If true, packets of a payload that arrive out of order are held in slots indexed by their sequence number
+    /// until the packets before them arrive, with a bitmap of the slots in use. Each packet is then placed in constant
+    /// time instead of by walking the runs of packets received so far, which is faster when packets are heavily
+    /// reordered, such as when they are sprayed over multiple network paths. The slots are allocated in pages as
+    /// needed. NOTE: This value is only used if rx_buffer_type = kCdiSgl.
+    bool bitmap_packet_reorder;
+
+    /// @brief Address of the user function to call whenever more of the start of a payload has been received into the
+    /// linear receive buffer, so the application can start processing the top of a frame while the rest of it is still
+    /// in flight. The Rx callback is still invoked once the payload is complete, after the last slice of the payload.
+    /// Slices are not delayed by buffer_delay_ms. If NULL, slices are not reported. Slices are reported on a best-effort
+    /// basis: if a packet arrives more than 128 packets ahead of the first packet still missing from a payload, no
+    /// more slices are reported for that payload, and the whole payload is only delivered by the Rx callback. NOTE:
+    /// This value is only used if rx_buffer_type = kCdiLinearBuffer.
+    CdiCoreRxSliceCallback slice_cb_ptr;
+
+    /// @brief Minimum size in bytes of the slices passed to slice_cb_ptr. If 0, a slice is reported whenever the data
+    /// received at the start of a payload grows.
+    int slice_size;
+
+    /// @brief User defined callback parameter passed to the user registered slice callback function (see
+    /// slice_cb_ptr).
+    CdiUserCbParameter slice_user_cb_param;
+
     /// @brief The max number of allowable payloads that can be simultaneously received on a single connection in the
     /// SDK. This number should be larger than the respective transmit limit since more payloads can potentially be in
     /// flight in the receive logic. This is because Tx packets can get acknowledged to the transmitter before being
@@ -840,6 +1057,10 @@ typedef struct {
     /// @brief Configuration data for gathering statistics. The data can be changed at runtime using the
     /// CdiCoreStatsReconfigure() API function.
     CdiStatsConfigData stats_config;
+
+    /// @brief Expected stream characteristics used to size the connection's resources. Leave zeroed to use the worst
+    /// case sizes.
+    CdiResourceProfile resource_profile;
 } CdiRxConfigData;
 
 /**
@@ -988,6 +1209,34 @@ CDI_INTERFACE int CdiCoreGather(const CdiSgList* sgl_ptr, int offset, void* dest
  */
 CDI_INTERFACE CdiReturnStatus CdiCoreStatsReconfigure(CdiConnectionHandle handle, const CdiStatsConfigData* config_ptr);
 
+/**
+ * Get the current pool and queue usage of a connection, including the memory used by them. This is the same data that
+ * is provided in CdiTransferStats.resource_stats, but can be read at any time, such as right after the connection has
+ * been created to check its footprint.
+ *
+ * @param handle Connection handle returned by a Cdi...TxCreate() or Cdi...RxCreate() API function.
+ * @param ret_stats_ptr Address where to write the statistics.
+ *
+ * @return A value from the CdiReturnStatus enumeration.
+ */
+CDI_INTERFACE CdiReturnStatus CdiCoreConnectionGetResourceStats(CdiConnectionHandle handle,
+                                                                CdiResourceStats* ret_stats_ptr);
+
+/**
+ * Cancel the payloads of a Tx connection that were sent with the specified user callback parameter (see
+ * CdiCoreTxPayloadConfig.user_cb_param) and are still waiting to be sent. This function is asynchronous and will
+ * immediately return. Each cancelled payload is not sent and its Tx callback is invoked with a status of
+ * kCdiStatusTxPayloadCancelled, after which its buffers can be reused. Payloads whose packets have started to be sent
+ * are not affected and complete as usual. The request applies to the payloads sent before this function is called.
+ *
+ * @param handle Connection handle returned by a Cdi...TxCreate() or CdiAvmTxStreamConnectionCreate() API function.
+ * @param user_cb_param User callback parameter of the payloads to cancel.
+ *
+ * @return A value from the CdiReturnStatus enumeration. kCdiStatusQueueFull is returned if too many cancel requests
+ *         are waiting to be processed.
+ */
+CDI_INTERFACE CdiReturnStatus CdiCoreTxPayloadCancel(CdiConnectionHandle handle, CdiUserCbParameter user_cb_param);
+
 /**
  * Destroy a specific TX or RX connection and free resources that were created for it.
  *
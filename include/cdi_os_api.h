@@ -114,6 +114,7 @@ struct iovec;
     #define CdiOsAtomicDec32(x) InterlockedDecrement(x)
     #define CdiOsAtomicRead32(x) InterlockedAdd((x), 0)
     #define CdiOsAtomicAdd32(x, b) InterlockedAdd((x), (b))
+    #define CdiOsAtomicSub32(x, b) InterlockedAdd((x), -(LONG)(b))
 
     // NOTE: These macros operate on 64-bit values.
     #define CdiOsAtomicInc64(x) InterlockedIncrement64(x)
@@ -121,6 +122,12 @@ struct iovec;
     #define CdiOsAtomicRead64(x) InterlockedAdd64((x), 0)
     #define CdiOsAtomicAdd64(x, b) InterlockedAdd64((x), (b))
 
+    // NOTE: These macros return true if the value at x was equal to expected and was replaced with desired.
+    #define CdiOsAtomicCompareExchange32(x, expected, desired) \
+        (InterlockedCompareExchange((x), (desired), (expected)) == (expected))
+    #define CdiOsAtomicCompareExchange64(x, expected, desired) \
+        (InterlockedCompareExchange64((x), (desired), (expected)) == (expected))
+
     // MSVC uses volatile to add necessary compiler/memory fence barriers as needed depending on CPU architecture. For
     // x86 platforms, recommend to use "/volatile:iso" for "C/C++"", "Command Line", "Additional Options" in MSVC
     // project configuration properties.
@@ -213,6 +220,8 @@ struct iovec;
     #define CdiOsAtomicRead32(x) __sync_add_and_fetch((x), 0)
     /// Atomic add a 32-bit value by a 32-bit value sent (matches windows variant, which uses functions).
     #define CdiOsAtomicAdd32(x, b) __sync_add_and_fetch((x), (b))
+    /// Atomic subtract a 32-bit value by a 32-bit value sent (matches windows variant, which uses functions).
+    #define CdiOsAtomicSub32(x, b) __sync_sub_and_fetch((x), (b))
 
     /// Atomic increment a 64-bit value by 1 (matches windows variant, which uses functions).
     #define CdiOsAtomicInc64(x) __sync_add_and_fetch((x), 1)
@@ -223,6 +232,12 @@ struct iovec;
     /// Atomic add a 64-bit value by a 64-bit value sent (matches windows variant, which uses functions).
     #define CdiOsAtomicAdd64(x, b) __sync_add_and_fetch((x), (b))
 
+    /// @brief Atomic compare and exchange of a 32-bit value. If the value at x is equal to expected, it is replaced with
+    /// desired and true is returned, otherwise false is returned (matches windows variant, which uses functions).
+    #define CdiOsAtomicCompareExchange32(x, expected, desired) __sync_bool_compare_and_swap((x), (expected), (desired))
+    /// @brief 64-bit version of CdiOsAtomicCompareExchange32 (matches windows variant, which uses functions).
+    #define CdiOsAtomicCompareExchange64(x, expected, desired) __sync_bool_compare_and_swap((x), (expected), (desired))
+
     /// @brief Atomic load value. Valid memory models are:
     /*! @code
         __ATOMIC_RELAXED : No barriers or synchronization.
@@ -298,9 +313,17 @@ struct iovec;
 /// The maximum size of iovec array that can be passed in to CdiOsSocketWrite().
 #define CDI_OS_SOCKET_MAX_IOVCNT (10)
 
+/// @brief Value used in place of a NUMA node number to indicate that memory may be placed on any node, and returned by
+/// the NUMA node query functions when the node is unknown (for example, on hosts that are not NUMA aware).
+#define CDI_NUMA_NODE_ANY       (-1)
+
 /// @brief Type used for signal handler.
 typedef void (*CdiSignalHandlerFunction)(int sig, siginfo_t* siginfo, void* context);
 
+/// @brief Type of function called with a thread's value of a thread-local storage slot when the thread exits. See
+/// CdiOsThreadAllocDataWithDestructor().
+typedef void (*CdiThreadDataDestructor)(void* content_ptr);
+
 /// @brief Structure used to hold signal handler data.
 typedef struct {
     int signal_num;  ///< Signal number of the signal related to the handler.
@@ -387,6 +410,20 @@ static inline bool CdiOsThreadCreate(CdiThreadFuncName thread_func, CdiThreadID*
  */
 CDI_INTERFACE bool CdiOsThreadAllocData(CdiThreadData* handle_out_ptr);
 
+/**
+ * Allocates a slot of thread-local storage like CdiOsThreadAllocData(). When a thread that stored a non-NULL value in
+ * the slot exits, destructor_fn is called with that value. On Windows, CdiOsThreadFreeData() also calls it for the
+ * non-NULL values of threads that are still running, so destructor_fn must not depend on running on the thread whose
+ * value it is called with.
+ *
+ * @param destructor_fn Function called with the slot's value when a thread exits.
+ * @param handle_out_ptr Returned handle for a thread data slot.
+ *
+ * @return true if successful, otherwise false.
+ */
+CDI_INTERFACE bool CdiOsThreadAllocDataWithDestructor(CdiThreadDataDestructor destructor_fn,
+                                                      CdiThreadData* handle_out_ptr);
+
 /**
  * Frees a slot of thread-local storage.  Should be called before program exit but after all threads are done using the
  * slot.
@@ -660,6 +697,56 @@ CDI_INTERFACE void* CdiOsMemAllocHugePage(int64_t mem_size);
  */
 CDI_INTERFACE void CdiOsMemFreeHugePage(void* mem_ptr, int64_t mem_size);
 
+/**
+ * Allocates a page aligned block of zeroed memory whose pages are placed on the specified NUMA node. The pages are
+ * touched before returning, so they are backed by memory on that node no matter which CPU core later accesses them.
+ * Must be freed using CdiOsMemFreeOnNumaNode().
+ *
+ * @param mem_size Number of bytes to allocate.
+ * @param numa_node NUMA node to place the memory on, or CDI_NUMA_NODE_ANY to let the OS decide.
+ *
+ * @return Pointer to the allocated memory block. If unable to allocate the memory block, NULL is returned.
+ */
+CDI_INTERFACE void* CdiOsMemAllocOnNumaNode(int64_t mem_size, int numa_node);
+
+/**
+ * Releases a block of memory that was allocated using CdiOsMemAllocOnNumaNode().
+ *
+ * @param mem_ptr Pointer to start address of memory block.
+ * @param mem_size Number of bytes that were allocated.
+ */
+CDI_INTERFACE void CdiOsMemFreeOnNumaNode(void* mem_ptr, int64_t mem_size);
+
+/**
+ * Sets the NUMA node that the pages of a page aligned block of memory (such as memory returned by
+ * CdiOsMemAllocHugePage()) are to be placed on. Only affects pages that have not been touched yet.
+ *
+ * @param mem_ptr Pointer to start address of memory block. Must be page aligned.
+ * @param mem_size Number of bytes in the memory block.
+ * @param numa_node NUMA node to place the memory on. If CDI_NUMA_NODE_ANY, nothing is done.
+ *
+ * @return true if successful or if the OS does not support NUMA placement, otherwise false.
+ */
+CDI_INTERFACE bool CdiOsMemBindToNumaNode(void* mem_ptr, int64_t mem_size, int numa_node);
+
+/**
+ * Get the NUMA node that backs the page containing the specified address. The page must have been touched.
+ *
+ * @param mem_ptr Address to query.
+ *
+ * @return NUMA node number, or CDI_NUMA_NODE_ANY if it cannot be determined.
+ */
+CDI_INTERFACE int CdiOsMemGetNumaNode(const void* mem_ptr);
+
+/**
+ * Get the NUMA node that a CPU core belongs to.
+ *
+ * @param cpu_core_num CPU core number, as used by CdiOsThreadCreatePinned(). A negative value means no core.
+ *
+ * @return NUMA node number, or CDI_NUMA_NODE_ANY if cpu_core_num is negative or the node cannot be determined.
+ */
+CDI_INTERFACE int CdiOsGetCpuNumaNode(int cpu_core_num);
+
 // -- File --
 
 /**
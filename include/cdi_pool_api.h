@@ -109,6 +109,41 @@ typedef struct CdiPoolState* CdiPoolHandle;
  */
 typedef bool (*CdiPoolItemOperatorFunction)(const void* context_ptr, void* item_ptr);
 
+/**
+ * @brief Option flags used when creating a pool with CdiPoolCreateWithFlags(). Values may be OR'ed together.
+ */
+typedef enum {
+    kPoolFlagNone = 0x00, ///< No locks are used. Single threaded access to all APIs is required.
+
+    /// @brief Locks are used to protect resources from multi-threaded access. This is the same as setting thread_safe
+    /// to true when using CdiPoolCreate().
+    kPoolFlagThreadSafe = 0x01,
+
+    /// @brief Each thread that uses the pool keeps a small cache (a magazine) of free items. Magazines are exchanged
+    /// through a lock-free depot, so the common CdiPoolGet() and CdiPoolPut() path does not acquire a lock. The pool's
+    /// lock is only used when the depot is empty (to refill a magazine from the pool's free list or grow the pool).
+    /// Implies kPoolFlagThreadSafe.
+    ///
+    /// NOTE: If the pool is empty and can't grow, a get takes the free items held in the magazines of threads that
+    /// aren't using the pool at that moment before failing. Items in a thread's magazines are returned to the pool when
+    /// the thread exits. CdiPoolPeekInUse() is not supported and CdiPoolPutAll() must only be used when no other thread
+    /// is accessing the pool.
+    kPoolFlagThreadCache = 0x02,
+
+    /// @brief Back the pool's item arrays (including those added when the pool grows) with huge pages, which reduces
+    /// TLB misses when the items of a large pool are accessed in no particular order. Arrays smaller than
+    /// POOL_HUGE_PAGES_MIN_BYTE_SIZE and arrays for which no huge pages are available use regular pages.
+    kPoolFlagHugePages = 0x04,
+
+    /// @brief Items don't have a header. The pool does not keep a list of items in use and links free items together
+    /// through their first bytes, so each item only uses item_byte_size bytes (at least the size of a pointer) and
+    /// CdiPoolGet() and CdiPoolPut() write fewer pointers. Intended for large pools of small items such as CdiSglEntry.
+    ///
+    /// NOTE: The contents of an item are not preserved while it is free, so an initialization function cannot be used.
+    /// CdiPoolPeekInUse() is not supported and CdiPoolPutAll() rebuilds the free list from the pool's buffers instead.
+    kPoolFlagSlimItems = 0x08,
+} CdiPoolFlags;
+
 /**
  * @brief Contains the state of a single pool get or put operation.
  */
@@ -127,6 +162,20 @@ typedef struct {
  */
 typedef void (*CdiPoolCallback)(const CdiPoolCbData* data_ptr);
 
+/**
+ * @brief Usage statistics of a pool. The counters are always maintained and never reset. See CdiPoolGetStats().
+ */
+typedef struct {
+    int total_item_count;      ///< Number of items in the pool, including items added each time it was increased.
+    int free_item_count;       ///< Number of items currently free.
+    /// @brief Largest number of items that have been in use at the same time. For pools created with
+    /// kPoolFlagThreadCache, items held in thread magazines are counted as in use.
+    int high_water_item_count;
+    int grow_count;            ///< Number of times the pool has been increased.
+    int get_fail_count;        ///< Number of gets that failed because the pool was empty and could not be increased.
+    uint64_t byte_size;        ///< Memory used by the items of the pool, including per-item overhead.
+} CdiPoolStats;
+
 //*********************************************************************************************************************
 //******************************************* START OF PUBLIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
@@ -184,6 +233,55 @@ CDI_INTERFACE bool CdiPoolCreateAndInitItems(const char* name_str, uint32_t item
                                              CdiPoolHandle* ret_handle_ptr, CdiPoolItemOperatorFunction init_fn,
                                              void* init_context_ptr);
 
+/**
+ * Create a new memory pool using the specified option flags and initialize each item in it using the provided callback
+ * function. Memory is allocated by this function.
+ *
+ * @param name_str Pointer to name of pool to copy to the new pool instance.
+ * @param item_count Number of items in the pool.
+ * @param grow_count Number of items that a pool will be increased by if the initial size requested is inadequate.
+ * @param max_grow_count Maximum number of times a pool may be increased before an error occurs.
+ * @param item_byte_size Size of each item in bytes.
+ * @param flags Option flags OR'ed together from the CdiPoolFlags enumeration.
+ * @param ret_handle_ptr Pointer to returned handle of the new pool.
+ * @param init_fn The address of a function that will be called for each item in the pool at creation time; a value of
+ *                NULL indicates that no initialization beyond zeroing the memory is to be done. If false is returned by
+ *                the function, the pool creation will fail and all the resources allocated in the process of creating
+ *                it will be freed.
+ * @param init_context_ptr A value to provide as init_context to init_fn().
+ *
+ * @return true if successful, otherwise false (not enough memory).
+ */
+CDI_INTERFACE bool CdiPoolCreateWithFlags(const char* name_str, uint32_t item_count, uint32_t grow_count,
+                                          uint32_t max_grow_count, uint32_t item_byte_size, CdiPoolFlags flags,
+                                          CdiPoolHandle* ret_handle_ptr, CdiPoolItemOperatorFunction init_fn,
+                                          void* init_context_ptr);
+
+/**
+ * Same as CdiPoolCreateWithFlags(), except that the pool's memory (including any memory added when the pool grows) is
+ * allocated on the specified NUMA node and touched when it is allocated, so it is local to threads that run on CPU
+ * cores of that node. Use CdiOsGetCpuNumaNode() to get the node of the core a pool's main user is pinned to.
+ *
+ * @param name_str Name of memory pool.
+ * @param item_count Number of items in the pool.
+ * @param grow_count Number of items that a pool may be increased by if the initial size requested is inadequate.
+ * @param max_grow_count Maximum number of times a pool may be increased before an error occurs.
+ * @param item_byte_size Size of each item in bytes.
+ * @param flags Option flags OR'ed together from the CdiPoolFlags enumeration.
+ * @param numa_node NUMA node to allocate the pool's memory on. If CDI_NUMA_NODE_ANY, this function is the same as
+ *                  CdiPoolCreateWithFlags().
+ * @param ret_handle_ptr Pointer to returned handle of the new pool.
+ * @param init_fn The address of a function that will be called for each item in the pool at creation time; a value of
+ *                NULL indicates that no initialization beyond zeroing the memory is to be done.
+ * @param init_context_ptr A value to provide as init_context to init_fn().
+ *
+ * @return true if successful, otherwise false (not enough memory).
+ */
+CDI_INTERFACE bool CdiPoolCreateOnNumaNode(const char* name_str, uint32_t item_count, uint32_t grow_count,
+                                           uint32_t max_grow_count, uint32_t item_byte_size, CdiPoolFlags flags,
+                                           int numa_node, CdiPoolHandle* ret_handle_ptr,
+                                           CdiPoolItemOperatorFunction init_fn, void* init_context_ptr);
+
 /**
  * Create a new memory pool from a user-provided buffer and initialize each item in it using the provided callback
  * function. Some additional memory is required for each item in the pool to hold data used internally by this pool API.
@@ -254,7 +352,8 @@ CDI_INTERFACE bool CdiPoolCreateUsingExistingBufferAndInitItems(const char* name
  * and false returned.
  *
  * NOTE: Since the returned pointer still resides in the pool, the caller must ensure that other threads cannot use it.
- * This means other threads won't be using CdiPoolPut() for the pool item.
+ * This means other threads won't be using CdiPoolPut() for the pool item. Pools created with kPoolFlagThreadCache or
+ * kPoolFlagSlimItems do not track items that are in use, so false is always returned for them.
  *
  * @param handle Memory pool handle.
  * @param ret_item_ptr Pointer to returned pointer to buffer.
@@ -274,6 +373,19 @@ CDI_INTERFACE bool CdiPoolPeekInUse(CdiPoolHandle handle, void** ret_item_ptr);
  */
 CDI_INTERFACE bool CdiPoolGet(CdiPoolHandle handle, void** ret_item_ptr);
 
+/**
+ * Get pointers to multiple available buffers in the pool using a single lock acquisition. Either all of the requested
+ * buffers are returned or none are.
+ *
+ * @param handle Memory pool handle.
+ * @param item_count Number of buffers to get.
+ * @param ret_item_array Pointer to array of at least item_count entries where the returned buffer pointers are
+ *                       written.
+ *
+ * @return true if successful, otherwise false (not enough free buffers).
+ */
+CDI_INTERFACE bool CdiPoolGetMultiple(CdiPoolHandle handle, int item_count, void** ret_item_array);
+
 #ifdef USE_MEMORY_POOL_APPENDED_LISTS
 /**
  * Get a pointer to an available buffer in the pool and append the new item to an existing item in the pool. This
@@ -298,7 +410,34 @@ CDI_INTERFACE bool CdiPoolGetAndAppend(CdiPoolHandle handle, void* existing_item
 CDI_INTERFACE void CdiPoolPut(CdiPoolHandle handle, const void* item_ptr);
 
 /**
- * Put all the used buffers back into the pool.
+ * Put a list of buffers back into the pool. The buffers are linked together by a pointer stored within each buffer
+ * (for example, the next_ptr member of CdiSglEntry), which must point to the start of the next buffer in the list or
+ * be NULL for the last buffer. The list is walked without holding the pool's lock and then spliced onto the pool's
+ * free list using a single lock acquisition.
+ *
+ * @param handle Memory pool handle.
+ * @param item_list_ptr Pointer to the first buffer in the list to put back. Can be NULL.
+ * @param next_ptr_offset Byte offset within each buffer of the pointer to the next buffer in the list.
+ *
+ * @return false if the list is malformed (a buffer points to itself), otherwise true.
+ */
+CDI_INTERFACE bool CdiPoolPutList(CdiPoolHandle handle, const void* item_list_ptr, uint32_t next_ptr_offset);
+
+/**
+ * Put multiple buffers back into the pool using a single lock acquisition. This is the counterpart of
+ * CdiPoolGetMultiple() for buffers that are not linked together (see CdiPoolPutList()).
+ *
+ * @param handle Memory pool handle.
+ * @param item_count Number of buffers in item_array. Can be zero.
+ * @param item_array Array of pointers to the buffers to put back.
+ */
+CDI_INTERFACE void CdiPoolPutMultiple(CdiPoolHandle handle, int item_count, void* const* item_array);
+
+/**
+ * Put all the used buffers back into the pool. For pools created with kPoolFlagThreadCache, this also empties the
+ * magazines of all threads, so no other thread may be accessing the pool while this function executes. Pools that
+ * don't track items in use (created with kPoolFlagThreadCache or kPoolFlagSlimItems) rebuild their free list from the
+ * pool's buffers.
  *
  * @param handle Memory pool handle.
  */
@@ -313,6 +452,24 @@ CDI_INTERFACE void CdiPoolPutAll(CdiPoolHandle handle);
  */
 CDI_INTERFACE const char* CdiPoolGetName(CdiPoolHandle handle);
 
+/**
+ * Get the NUMA node that backs the pool's initial buffer of items.
+ *
+ * @param handle Pool handle.
+ *
+ * @return NUMA node number, or CDI_NUMA_NODE_ANY if it cannot be determined.
+ */
+CDI_INTERFACE int CdiPoolGetNumaNode(CdiPoolHandle handle);
+
+/**
+ * Get whether the pool's initial array of items is backed by huge pages. See kPoolFlagHugePages.
+ *
+ * @param handle Pool handle.
+ *
+ * @return true if huge pages are used, otherwise false.
+ */
+CDI_INTERFACE bool CdiPoolUsesHugePages(CdiPoolHandle handle);
+
 /**
  * Get byte size of buffer for a single pool item.
  *
@@ -323,7 +480,8 @@ CDI_INTERFACE const char* CdiPoolGetName(CdiPoolHandle handle);
 CDI_INTERFACE uint32_t CdiPoolGetItemSize(CdiPoolHandle handle);
 
 /**
- * Get the number of free items currently available in the pool.
+ * Get the number of free items currently available in the pool. For pools created with kPoolFlagThreadCache, the value
+ * includes items held in thread magazines and is only approximate while other threads are using the pool.
  *
  * @param handle Pool handle.
  *
@@ -340,6 +498,15 @@ CDI_INTERFACE int CdiPoolGetFreeItemCount(CdiPoolHandle handle);
  */
 CDI_INTERFACE int CdiPoolGetTotalItemCount(CdiPoolHandle handle);
 
+/**
+ * Get the usage statistics of the pool. May be called from any thread while the pool is in use. For pools that are not
+ * thread-safe, the values are only approximate while another thread is using the pool.
+ *
+ * @param handle Pool handle.
+ * @param ret_stats_ptr Address where to write the statistics.
+ */
+CDI_INTERFACE void CdiPoolGetStats(CdiPoolHandle handle, CdiPoolStats* ret_stats_ptr);
+
 /**
  * Call a function for each item in the pool. If any items are allocated from the pool when this function is called, no
  * operations will be performed and false will be returned.
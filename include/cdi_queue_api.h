@@ -53,9 +53,6 @@ typedef enum {
     kQueueMultipleWritersFlag = 0x08,  ///< Optional flag to add locking for thread safe pushing into the queue.
 } CdiQueueSignalMode;
 
-/// Forward declaration of CdiSinglyLinkedListEntry defined in singly_linked_list_api.h
-typedef struct CdiSinglyLinkedListEntry CdiSinglyLinkedListEntry;
-
 //*********************************************************************************************************************
 //******************************************* START OF PUBLIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
@@ -126,6 +123,55 @@ CDI_INTERFACE bool CdiQueuePopWaitMultiple(CdiQueueHandle handle, int timeout_ms
                                            CdiSignalType* abort_wait_signal_array, int num_signals,
                                            uint32_t* ret_signal_index_ptr, void* item_dest_ptr);
 
+/**
+ * Pop up to max_item_count items from the queue buffer and copy them to item_dest_array. The push wait signal, if
+ * enabled, is set at most once and not at all if it is already set. Does not wait if the queue is empty.
+ *
+ * @param handle Queue handle.
+ * @param item_dest_array Pointer to array of items where to copy the items to. Must be large enough to hold
+ *                        max_item_count items of the size set when the queue was created (see item_byte_size). This is
+ *                        an optional parameter. Pass NULL to discard the items.
+ * @param max_item_count Maximum number of items to pop.
+ *
+ * @return Number of items popped. Zero if the queue is empty.
+ */
+CDI_INTERFACE int CdiQueuePopMultiple(CdiQueueHandle handle, void* item_dest_array, int max_item_count);
+
+/**
+ * Get a pointer to the next item in the queue without copying or removing it, so the item can be used in place. The
+ * item remains in the queue until CdiQueuePopRelease() is called, which must be done before the next item can be
+ * peeked. Calling this function again before CdiQueuePopRelease() returns the same item. Must not be mixed with the
+ * other Pop functions while an item is being peeked. If the queue is empty, false is returned.
+ *
+ * @param handle Queue handle.
+ * @param ret_item_ptr Address where to write the pointer to the item's data in the queue.
+ *
+ * @return true if successful, otherwise false (queue is empty).
+ */
+CDI_INTERFACE bool CdiQueuePopPeek(CdiQueueHandle handle, void** ret_item_ptr);
+
+/**
+ * Same as CdiQueuePopPeek(), except if the queue is empty, wait until the specified timeout expires or the signal gets
+ * set.
+ *
+ * @param handle Queue handle.
+ * @param timeout_ms Timeout in mSec can be CDI_INFINITE to wait indefinitely.
+ * @param abort_wait_signal Signal used to abort waiting.
+ * @param ret_item_ptr Address where to write the pointer to the item's data in the queue.
+ *
+ * @return true if successful, otherwise false (queue is empty and timeout expired or signal got set).
+ */
+CDI_INTERFACE bool CdiQueuePopPeekWait(CdiQueueHandle handle, int timeout_ms, CdiSignalType abort_wait_signal,
+                                       void** ret_item_ptr);
+
+/**
+ * Remove the item returned by CdiQueuePopPeek() or CdiQueuePopPeekWait() from the queue. The item's pointer must not be
+ * used after this function is called.
+ *
+ * @param handle Queue handle.
+ */
+CDI_INTERFACE void CdiQueuePopRelease(CdiQueueHandle handle);
+
 /**
  * Push an item on the queue. If the queue is full, false is returned.
  *
@@ -136,6 +182,49 @@ CDI_INTERFACE bool CdiQueuePopWaitMultiple(CdiQueueHandle handle, int timeout_ms
  */
 CDI_INTERFACE bool CdiQueuePush(CdiQueueHandle handle, const void* item_ptr);
 
+/**
+ * Push multiple items on the queue. Items are made visible to the consumer as a group and the pop wait signal, if
+ * enabled, is set at most once and not at all if it is already set (the consumer has not yet popped since it was last
+ * set, so it is either running or about to wake up). If the queue is full and cannot grow, the items that fit are
+ * pushed.
+ *
+ * @param handle Queue handle.
+ * @param item_array Pointer to array of items to copy from. Each item is the size set when the queue was created (see
+ *                   item_byte_size).
+ * @param item_count Number of items in item_array.
+ *
+ * @return Number of items pushed, starting with the first item in item_array. Less than item_count if the queue is
+ *         full.
+ */
+CDI_INTERFACE int CdiQueuePushMultiple(CdiQueueHandle handle, const void* item_array, int item_count);
+
+/**
+ * Reserve the next free item in the queue, so the item can be written in place instead of being copied by
+ * CdiQueuePush(). The item is not visible to the consumer until CdiQueuePushCommit() is called. More than one item may
+ * be reserved before calling CdiQueuePushCommit(), which makes all of them visible and sets the pop wait signal at most
+ * once. If the queue was created with kQueueMultipleWritersFlag, the queue's lock is held from the first successful
+ * reserve until the commit. The other Push functions must not be used while items are reserved.
+ *
+ * NOTE: Items reserved before a commit must fit in the part of the queue currently being written to, so if items are
+ * already reserved and that part is full, false is returned even if the queue could grow. Call CdiQueuePushCommit() and
+ * reserve again. If nothing is reserved, false is only returned if the queue is full and cannot grow. Items reserved by
+ * earlier calls must still be committed.
+ *
+ * @param handle Queue handle.
+ * @param ret_item_ptr Address where to write the pointer to the item's data in the queue.
+ *
+ * @return true if successful, otherwise false (queue is full, or items are reserved and must be committed first).
+ */
+CDI_INTERFACE bool CdiQueuePushReserve(CdiQueueHandle handle, void** ret_item_ptr);
+
+/**
+ * Make the items reserved using CdiQueuePushReserve() visible to the consumer. Must only be called after at least one
+ * successful CdiQueuePushReserve() call.
+ *
+ * @param handle Queue handle.
+ */
+CDI_INTERFACE void CdiQueuePushCommit(CdiQueueHandle handle);
+
 /**
  * Push an item on the queue. If the queue is full, wait until the specified timeout expires or the optional signal gets
  * set.
@@ -211,14 +300,38 @@ CDI_INTERFACE CdiSignalType CdiQueueGetPushWaitSignal(CdiQueueHandle handle);
  */
 CDI_INTERFACE const char* CdiQueueGetName(CdiQueueHandle handle);
 
+/**
+ * @brief Usage statistics of a queue. The counters are always maintained and never reset. See CdiQueueGetStats().
+ */
+typedef struct {
+    int item_count;            ///< Number of items the queue can hold, including items added when it was increased.
+    int occupancy;             ///< Number of items currently enqueued.
+    /// @brief Largest number of items the consumer has seen enqueued. Sampled each time the consumer refreshes its
+    /// view of the producer's position, so it does not add any work to pushing an item. Only items in the part of the
+    /// queue being read are counted, so it can be lower than the true peak while the queue is growing.
+    int high_water_item_count;
+    int grow_count;            ///< Number of times the queue has been increased.
+    int push_fail_count;       ///< Number of pushes that failed because the queue was full and could not be increased.
+    uint64_t byte_size;        ///< Memory allocated for the queue's segments.
+} CdiQueueStats;
+
+/**
+ * Get the usage statistics of the queue. May be called from any thread while the queue is in use, in which case the
+ * values are only approximate.
+ *
+ * @param handle Queue handle.
+ * @param ret_stats_ptr Address where to write the statistics.
+ */
+CDI_INTERFACE void CdiQueueGetStats(CdiQueueHandle handle, CdiQueueStats* ret_stats_ptr);
+
 /**
  * @brief A structure of this type is passed as the parameter to CdiQueueCallback(). It contains the state of a
  * single queue read or write operation.
  */
 typedef struct {
     bool is_pop;        ///< True if read triggered the callback, otherwise a write triggered it.
-    CdiSinglyLinkedListEntry* read_ptr;  ///< Current read pointer in the queue.
-    CdiSinglyLinkedListEntry* write_ptr; ///< Current write pointer in the queue.
+    void* read_ptr;     ///< Item slot at the current read position in the queue.
+    void* write_ptr;    ///< Item slot at the current write position in the queue.
     void* item_data_ptr; ///< Pointer to item data.
     int occupancy; ///< The number of entries currently enqueued.
 } CdiQueueCbData;
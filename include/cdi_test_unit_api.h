@@ -36,6 +36,15 @@ typedef enum {
     kTestUnitRxPayloadReorder, ///< Test unit Rx payload reorderer.
     kTestUnitList, ///< Unit test for doubly linked list implementation.
     kTestUnitLogger, ///< Test logger functions.
+    kTestUnitPool, ///< Test pool functions, including thread cached pools.
+    kTestUnitQueue, ///< Test queue functions.
+    kTestUnitSignal, ///< Test OS signal functions.
+    kTestUnitTxEndpoints, ///< Test Tx stream connections with multiple endpoints.
+    kTestUnitTxPacing, ///< Test the Tx packet pacer.
+    kTestUnitPacketizer, ///< Test the Tx packetizer and benchmark its packet rate.
+    kTestUnitTxStalePayloads, ///< Test skipping stale Tx payloads.
+    kTestUnitRxCopyEngine, ///< Test the Rx copy engine and benchmark its copy rate.
+    kTestUnitRxSlices, ///< Test reporting slices of Rx payloads.
     kTestUnitLast, ///< End of list (for range checking, do no remove).
 } CdiTestUnitName;
 
@@ -84,6 +84,61 @@ static Packet* GetNextPacket(AdapterEndpointState* endpoint_ptr, int num_signals
     return packet_ptr;
 }
 
+/**
+ * Check whether the Tx packet pacer of an endpoint allows a packet to be sent now. Bytes are added to the endpoint's
+ * token bucket at the packet's pacing rate for the time since they were last added, up to burst_bytes. The packet can
+ * be sent if the bucket is not empty, in which case the packet's size is taken from the bucket.
+ *
+ * @param endpoint_ptr Pointer to the endpoint's state.
+ * @param packet_ptr Pointer to the packet to send.
+ * @param burst_bytes Maximum number of bytes that can be sent back to back.
+ * @param ret_ready_time_ptr Pointer to returned time in microseconds at which the bucket will no longer be empty. Only
+ *                           written if false is returned.
+ *
+ * @return true if the packet can be sent now, false if it must wait.
+ */
+static bool TxPacerAllow(AdapterEndpointState* endpoint_ptr, const Packet* packet_ptr, int64_t burst_bytes,
+                         uint64_t* ret_ready_time_ptr)
+{
+    uint64_t rate = packet_ptr->tx_state.pacing_bytes_per_second;
+    uint64_t now = CdiOsGetMicroseconds();
+    uint64_t elapsed_time = now - endpoint_ptr->tx_pacing_time;
+
+    if (0 == rate || elapsed_time >= 1000000) {
+        // Packet isn't paced or the endpoint has been idle long enough to refill the bucket at any rate.
+        endpoint_ptr->tx_pacing_tokens = burst_bytes;
+        endpoint_ptr->tx_pacing_time = now;
+        if (0 == rate) {
+            return true;
+        }
+    } else {
+        // Only advance the time if bytes were added, so low rates still accumulate bytes when polled rapidly.
+        int64_t added_bytes = (int64_t)(elapsed_time * rate / 1000000);
+        if (added_bytes) {
+            endpoint_ptr->tx_pacing_tokens += added_bytes;
+            if (endpoint_ptr->tx_pacing_tokens > burst_bytes) {
+                endpoint_ptr->tx_pacing_tokens = burst_bytes;
+            }
+            endpoint_ptr->tx_pacing_time = now;
+        }
+    }
+
+    CdiAdapterEndpointStats* stats_ptr = endpoint_ptr->endpoint_stats_ptr;
+    if (endpoint_ptr->tx_pacing_tokens <= 0) {
+        if (!endpoint_ptr->tx_pacing_delayed && stats_ptr) {
+            stats_ptr->tx_pacing_delay_count++;
+        }
+        endpoint_ptr->tx_pacing_delayed = true;
+        // Time at which at least one byte will have been added since tx_pacing_time, rounded up.
+        uint64_t missing_bytes = (uint64_t)(1 - endpoint_ptr->tx_pacing_tokens);
+        *ret_ready_time_ptr = endpoint_ptr->tx_pacing_time + (missing_bytes * 1000000 + rate - 1) / rate;
+        return false;
+    }
+    endpoint_ptr->tx_pacing_delayed = false;
+    endpoint_ptr->tx_pacing_tokens -= packet_ptr->sg_list.total_data_size;
+    return true;
+}
+
 /**
  * Update thread utilization statistics.
  *
@@ -231,10 +286,14 @@ static void ControlInterfacePoll(AdapterConnectionState* adapter_con_state_ptr,
  * Used directly by PollThread() to process polling for a data endpoint.
  *
  * @param adapter_con_state_ptr Pointer to adapter connection state data.
+ * @param pacer_wake_time_ptr Pointer to the earliest time in microseconds at which the packet pacer of an endpoint
+ *                            allows a waiting packet to be sent. Lowered if an endpoint has a packet waiting for the
+ *                            pacer and is otherwise left unchanged. 0 means no packet is waiting.
  *
- * @return true if all endpoints for the specified connection are idle (no work to do).
+ * @return true if all endpoints for the specified connection are idle (no work to do, other than packets waiting for
+ *         the packet pacer).
  */
-static bool DataPoll(AdapterConnectionState* adapter_con_state_ptr)
+static bool DataPoll(AdapterConnectionState* adapter_con_state_ptr, uint64_t* pacer_wake_time_ptr)
 {
     bool all_idle = true;
 
@@ -273,6 +332,13 @@ static bool DataPoll(AdapterConnectionState* adapter_con_state_ptr)
                                          &adapter_con_state_ptr->load_state);
         }
 
+        // Pacing configuration only applies to Tx connections.
+        int64_t burst_bytes = 0;
+        if (adapter_con_state_ptr->can_transmit) {
+            CdiConnectionState* con_state_ptr = adapter_con_state_ptr->data_state.cdi_connection_handle;
+            burst_bytes = con_state_ptr->tx_state.config_data.pacing.burst_bytes;
+        }
+
         Packet* packet_ptr = NULL;
         while (cdi_endpoint_handle) {
             adapter_con_state_ptr->load_state.top_time = CdiOsGetMicroseconds();
@@ -282,15 +348,31 @@ static bool DataPoll(AdapterConnectionState* adapter_con_state_ptr)
             if (EndpointManagerPoll(&cdi_endpoint_handle) && adapter_endpoint_ptr) {
                 if (adapter_con_state_ptr->can_transmit) {
                     bool last_packet = false;
+                    bool retry = NULL != packet_ptr;
                     EndpointTransmitQueueLevel queue_level = CdiAdapterGetTransmitQueueLevel(adapter_endpoint_ptr);
                     bool got_packet = packet_ptr || ((kEndpointTransmitQueueFull != queue_level) &&
                         (NULL != (packet_ptr = GetNextPacket(adapter_endpoint_ptr, 0, NULL, &last_packet))));
+                    uint64_t ready_time = 0;
+                    if (got_packet && !retry &&
+                        !TxPacerAllow(adapter_endpoint_ptr, packet_ptr, burst_bytes, &ready_time)) {
+                        // Put the packet back until the pacer allows it to be sent. PollThread() can sleep until then.
+                        CdiSinglyLinkedListPushHead(&adapter_endpoint_ptr->tx_packet_waiting_list,
+                                                    &packet_ptr->list_entry);
+                        packet_ptr = NULL;
+                        got_packet = false;
+                        if (0 == *pacer_wake_time_ptr || ready_time < *pacer_wake_time_ptr) {
+                            *pacer_wake_time_ptr = ready_time;
+                        }
+                    }
                     if (got_packet) {
                         idle = false;
                         // Use the adapter to send the packet.
                         if (kCdiStatusRetry != adapter_con_state_ptr->adapter_state_ptr->functions_ptr->Send(
                                 adapter_endpoint_ptr, packet_ptr, last_packet)) {
                             packet_ptr = NULL; // For retry, don't clear the packet pointer. We will resend it again.
+                            if (adapter_endpoint_ptr->endpoint_stats_ptr) {
+                                adapter_endpoint_ptr->endpoint_stats_ptr->tx_packet_count++;
+                            }
                         }
                         // NOTE: No need to generate any error or warnings here since, the Send() will normally fail if
                         // the receiver is not connected (ie. during probe).
@@ -358,6 +440,7 @@ static CDI_THREAD PollThread(void* ptr)
     int num_signals = kSignalIndexArray;
 
     bool all_idle = true;
+    uint64_t pacer_wake_time = 0; // Earliest time a packet waiting for a packet pacer can be sent. 0 if none.
     while (true) {
         if (CdiOsSignalReadState(poll_thread_state_ptr->connection_list_changed_signal) && (0 == connection_index)) {
             // Make local copy of the connection list for this poll thread. This allows the connection list to be
@@ -368,6 +451,7 @@ static CDI_THREAD PollThread(void* ptr)
             CdiListIteratorInit(&poll_thread_state_ptr->connection_list, &list_iterator);
             num_of_connections = 0;
             all_idle = true;
+            pacer_wake_time = 0;
             num_signals = kSignalIndexArray;
             AdapterConnectionState* entry_ptr = NULL;
             poll_thread_state_ptr->only_transmit = true; // Default to only transmit. State is updated below.
@@ -434,7 +518,7 @@ static CDI_THREAD PollThread(void* ptr)
                 }
             } else {
                 // Data interface (user data payloads/packets and probe EFA packets).
-                if (!DataPoll(adapter_con_state_ptr)) {
+                if (!DataPoll(adapter_con_state_ptr, &pacer_wake_time)) {
                     all_idle = false;
                 }
                 // For transmitter, If tx_poll_do_work_signal is set and all endpoints are idle then clear the signal,
@@ -465,10 +549,19 @@ static CDI_THREAD PollThread(void* ptr)
         connection_index++;
         if (connection_index >= num_of_connections) {
             connection_index = 0;
-            // If the poll thread is data type, only contains transmitters, uses a polling adapter and all endpoints for
-            // all connections are currently idle then sleep until there is a notification.
+            // If the poll thread is data type, only contains transmitters and all endpoints for all connections are
+            // idle except for packets waiting for a packet pacer, then sleep until the first of them can be sent. The
+            // Tx poll do work signal stays set while payloads are in flight, so it can't be used to wait here.
             if (kEndpointTypeData == poll_thread_state_ptr->data_type && poll_thread_state_ptr->only_transmit &&
-                poll_thread_state_ptr->is_poll && all_idle) {
+                all_idle && pacer_wake_time) {
+                uint64_t now = CdiOsGetMicroseconds();
+                if (pacer_wake_time > now) {
+                    CdiOsSleepMicroseconds((uint32_t)CDI_MIN(pacer_wake_time - now, TX_PACING_MAX_SLEEP_MICROSECONDS));
+                }
+            } else if (kEndpointTypeData == poll_thread_state_ptr->data_type && poll_thread_state_ptr->only_transmit &&
+                       poll_thread_state_ptr->is_poll && all_idle) {
+                // Uses a polling adapter and all endpoints for all connections are currently idle, so sleep until there
+                // is a notification.
 #ifdef DEBUG_POLL_THREAD_SLEEP_TIME
                 uint64_t start_time = CdiOsGetMicroseconds();
 #endif
@@ -479,6 +572,7 @@ static CDI_THREAD PollThread(void* ptr)
 #endif
             }
             all_idle = true;
+            pacer_wake_time = 0;
         }
     }
 
@@ -627,6 +721,7 @@ CdiReturnStatus CdiAdapterCreateConnection(CdiAdapterConnectionConfigData* confi
 
         // Remember what kind of endpoint this is.
         adapter_con_state_ptr->direction = config_data_ptr->direction;
+        adapter_con_state_ptr->numa_node = CdiOsGetCpuNumaNode(config_data_ptr->thread_core_num);
         adapter_con_state_ptr->can_transmit = (kEndpointDirectionSend == adapter_con_state_ptr->direction ||
                                                 kEndpointDirectionBidirectional == adapter_con_state_ptr->direction);
         adapter_con_state_ptr->can_receive = (kEndpointDirectionReceive == adapter_con_state_ptr->direction ||
@@ -641,7 +736,7 @@ CdiReturnStatus CdiAdapterCreateConnection(CdiAdapterConnectionConfigData* confi
 
     if (kCdiStatusOk == rs && kEndpointDirectionSend == adapter_con_state_ptr->direction) {
         // Determine memory required for Tx packet headers.
-        uint32_t tx_header_entries = MAX_TX_PACKET_WORK_REQUESTS_PER_CONNECTION;
+        uint32_t tx_header_entries = config_data_ptr->tx_state.reserve_packet_headers;
         uint32_t tx_header_size = sizeof(TxPacketHeader);
         uint32_t tx_header_buffer_size_needed =  CdiPoolGetSizeNeeded(tx_header_entries, tx_header_size);
 
@@ -661,6 +756,11 @@ CdiReturnStatus CdiAdapterCreateConnection(CdiAdapterConnectionConfigData* confi
                 mem_ptr = CdiOsMemAllocHugePage(allocated_size);
                 // Set flag so we know how to later free Tx buffer.
                 adapter_con_state_ptr->tx_header_buffer_is_hugepages = NULL != mem_ptr;
+                if (mem_ptr) {
+                    // Headers are written by the payload thread but read by the poll thread, so place them on the
+                    // poll thread's NUMA node. Must be done before the pool touches the pages.
+                    CdiOsMemBindToNumaNode(mem_ptr, allocated_size, adapter_con_state_ptr->numa_node);
+                }
                 if (NULL == mem_ptr) {
                     // Fallback using heap memory.
                     mem_ptr = CdiOsMemAlloc(allocated_size);
@@ -797,6 +897,9 @@ CdiReturnStatus CdiAdapterCreateConnection(CdiAdapterConnectionConfigData* confi
     }
 
     if (kCdiStatusOk == rs) {
+        if (adapter_con_state_ptr->can_transmit) {
+            adapter_con_state_ptr->tx_state = config_data_ptr->tx_state;
+        }
         if (adapter_con_state_ptr->can_receive) {
             adapter_con_state_ptr->rx_state = config_data_ptr->rx_state;
         }
@@ -910,6 +1013,7 @@ CdiReturnStatus CdiAdapterOpenEndpoint(CdiAdapterEndpointConfigData* config_data
         endpoint_state_ptr->cdi_endpoint_handle = config_data_ptr->cdi_endpoint_handle;
         endpoint_state_ptr->msg_from_endpoint_func_ptr = config_data_ptr->msg_from_endpoint_func_ptr;
         endpoint_state_ptr->msg_from_endpoint_param_ptr = config_data_ptr->msg_from_endpoint_param_ptr;
+        endpoint_state_ptr->tx_packets_complete_func_ptr = config_data_ptr->tx_packets_complete_func_ptr;
 
         if (kEndpointDirectionSend == adapter_con_state_ptr->direction ||
             kEndpointDirectionBidirectional == adapter_con_state_ptr->direction) {
@@ -1124,3 +1228,33 @@ void CdiAdapterTxPacketComplete(AdapterEndpointHandle handle, const Packet* pack
         CdiOsAtomicDec32(&handle->tx_in_flight_ref_count);
     }
 }
+
+void CdiAdapterTxPacketsComplete(AdapterEndpointHandle handle, Packet* const* packet_array, int packet_count)
+{
+    // Same as CdiAdapterTxPacketComplete() for each packet.
+    uint32_t decrement_count = packet_count;
+    for (int i = 0; i < packet_count; i++) {
+        if (packet_array[i]->payload_last_packet) {
+            decrement_count++;
+        }
+    }
+    if (decrement_count) {
+        assert(CdiOsAtomicLoad32(&handle->tx_in_flight_ref_count) >= decrement_count);
+        CdiOsAtomicSub32(&handle->tx_in_flight_ref_count, decrement_count);
+    }
+}
+
+void CdiAdapterTxPacketsSent(AdapterEndpointHandle handle, Packet** packet_array, int packet_count)
+{
+    // NOTE: The probe replaces msg_from_endpoint_func_ptr and clears tx_packets_complete_func_ptr while it owns the
+    // endpoint, so its completions are always passed one at a time.
+    TxPacketsCompleteFromEndpoint tx_packets_complete_func_ptr = handle->tx_packets_complete_func_ptr;
+    if (tx_packets_complete_func_ptr) {
+        (tx_packets_complete_func_ptr)(handle->msg_from_endpoint_param_ptr, packet_array, packet_count);
+    } else {
+        for (int i = 0; i < packet_count; i++) {
+            (handle->msg_from_endpoint_func_ptr)(handle->msg_from_endpoint_param_ptr, packet_array[i],
+                                                 kEndpointMessageTypePacketSent);
+        }
+    }
+}
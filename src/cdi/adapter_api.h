@@ -46,6 +46,9 @@ typedef struct {
     union {
         struct TxState {
             AdapterPacketAckStatus ack_status; ///< Status of the packet.
+            /// Rate in bytes per second at which the poll thread sends the packets of this packet's payload. 0 if the
+            /// packet is not paced. See CdiTxPacingConfig.
+            uint64_t pacing_bytes_per_second;
         } tx_state;
     };
 
@@ -104,6 +107,16 @@ typedef enum {
  */
 typedef void (*MessageFromEndpoint)(void* param_ptr, Packet* packet_ptr, EndpointMessageType message_type);
 
+/**
+ * @brief Prototype of function used to process the completions of an array of Tx packets from the endpoint. It is the
+ * batched form of MessageFromEndpoint with kEndpointMessageTypePacketSent and uses the same parameter.
+ *
+ * @param param_ptr A pointer to data used by the function.
+ * @param packet_array Array of pointers to the packets that have completed.
+ * @param packet_count Number of packets in packet_array.
+ */
+typedef void (*TxPacketsCompleteFromEndpoint)(void* param_ptr, Packet** packet_array, int packet_count);
+
 /**
  * @brief Structure used to hold adapter endpoint state.
  */
@@ -117,6 +130,9 @@ struct AdapterEndpointState {
     /// @brief Address of function used to queue packet messages from the endpoint.
     MessageFromEndpoint msg_from_endpoint_func_ptr;
     void* msg_from_endpoint_param_ptr;    ///< Parameter passed to queue message function.
+    /// @brief Address of function used to process arrays of Tx packet completions from the endpoint. If NULL, each
+    /// completion is passed to msg_from_endpoint_func_ptr. See CdiAdapterTxPacketsSent().
+    TxPacketsCompleteFromEndpoint tx_packets_complete_func_ptr;
 
     /// @brief Current state of this endpoint. NOTE: Made volatile, since it is written to and read by different
     /// threads. The reader uses the value within a loop, so we don't want the value to be cached and held in a
@@ -129,6 +145,12 @@ struct AdapterEndpointState {
     /// @brief Number of Tx packets that are in process (sent but haven't received ACK/error response).
     volatile uint32_t tx_packets_in_process;
 
+    /// @brief Number of bytes the Tx packet pacer can send before it must wait. Negative if the last packet sent was
+    /// larger than the bytes that were available. Only used by the poll thread.
+    int64_t tx_pacing_tokens;
+    uint64_t tx_pacing_time; ///< Time in microseconds tokens were last added to tx_pacing_tokens.
+    bool tx_pacing_delayed;  ///< True if the pacer is delaying the packet at the head of tx_packet_waiting_list.
+
     CdiAdapterEndpointStats* endpoint_stats_ptr; ///< Address where to store adapter endpoint statistics.
 
     /// @brief Signal used to start adapter endpoint threads. A separate signal is used for the connection (see
@@ -165,6 +187,14 @@ struct AdapterEndpointState {
 /// Forward declaration to create pointer to adapter endpoint state when used.
 typedef struct AdapterEndpointState* AdapterEndpointHandle;
 
+/**
+ * @brief This defines a structure that contains the state information for a tx adapter connection.
+ */
+typedef struct {
+    /// @brief Number of packet headers to reserve for outgoing payloads.
+    int reserve_packet_headers;
+} TxAdapterConnectionState;
+
 /**
  * @brief This defines a structure that contains the state information for an rx adapter connection.
  */
@@ -264,6 +294,7 @@ struct AdapterConnectionState {
     CdiLogHandle log_handle;
 
     EndpointDirection direction;          ///< The direction that this endpoint supports.
+    TxAdapterConnectionState tx_state;    ///< Valid if direction supports transmit.
     RxAdapterConnectionState rx_state;    ///< Valid if direction supports receive.
 
     union {
@@ -293,6 +324,9 @@ struct AdapterConnectionState {
 
     PollThreadState* poll_thread_state_ptr; ///< Pointer to poll thread state data associated with this connection.
 
+    /// @brief NUMA node of the CPU core that the poll thread is pinned to, or CDI_NUMA_NODE_ANY if it is not pinned.
+    int numa_node;
+
     CdiSignalType shutdown_signal; ///< Signal used to shutdown adapter connection threads.
 
     /// @brief If true, tx_header_buffer_allocated_ptr is using hugepages, otherwise it is using heap memory.
@@ -311,6 +345,10 @@ struct AdapterConnectionState {
     /// Valid if direction supports transmit. Memory pool of Tx extra headers for packets (TxExtraPacketHeader).
     CdiPoolHandle tx_extra_header_pool_handle;
 
+    /// @brief Valid if direction supports receive. Size in bytes of the packet buffers allocated by the adapter's
+    /// endpoint for incoming packets. Used for reporting only.
+    uint64_t rx_packet_buffer_byte_size;
+
     ControlInterfaceHandle control_interface_handle; ///< Handle of control interface for the connection.
 
     CdiCsID endpoint_lock; ///< Lock used to protect access to endpoint resources.
@@ -469,6 +507,9 @@ typedef struct {
     /// to disable pinning the thread to a specific core.
     int thread_core_num;
 
+    /// @brief Valid if direction = kEndpointDirectionSend or kEndpointDirectionBidirectional.
+    TxAdapterConnectionState tx_state;
+
     /// @brief Valid if direction = kEndpointDirectionReceive or kEndpointDirectionBidirectional.
     RxAdapterConnectionState rx_state;
 
@@ -486,6 +527,8 @@ typedef struct {
     /// @brief Address of function used to queue messages from this endpoint.
     MessageFromEndpoint msg_from_endpoint_func_ptr;
     void* msg_from_endpoint_param_ptr; ///< Pointer to parameter passed to queue message function.
+    /// @brief Address of function used to process arrays of Tx packet completions from this endpoint. Optional.
+    TxPacketsCompleteFromEndpoint tx_packets_complete_func_ptr;
 
     /// @brief Address where to write adapter endpoint statistics.
     CdiAdapterEndpointStats* endpoint_stats_ptr;
@@ -709,4 +752,25 @@ void CdiAdapterPollThreadFlushResources(AdapterEndpointHandle handle);
  */
 void CdiAdapterTxPacketComplete(AdapterEndpointHandle handle, const Packet* packet_ptr);
 
+/**
+ * Multiple Tx packets have ACKed. Same as calling CdiAdapterTxPacketComplete() for each packet, using a single atomic
+ * operation.
+ *
+ * @param handle The handle of the endpoint that the Tx packets are related to.
+ * @param packet_array Array of pointers to the packets.
+ * @param packet_count Number of packets in packet_array.
+ */
+void CdiAdapterTxPacketsComplete(AdapterEndpointHandle handle, Packet* const* packet_array, int packet_count);
+
+/**
+ * Report the completions of an array of Tx packets to the upper layer of an endpoint. Adapters use this function
+ * instead of calling the endpoint's message function for each completed packet, so the upper layer can retire them as a
+ * batch.
+ *
+ * @param handle The handle of the endpoint that sent the packets.
+ * @param packet_array Array of pointers to the packets. The tx_state.ack_status of each packet must be set.
+ * @param packet_count Number of packets in packet_array.
+ */
+void CdiAdapterTxPacketsSent(AdapterEndpointHandle handle, Packet** packet_array, int packet_count);
+
 #endif // ADAPTER_API_H__
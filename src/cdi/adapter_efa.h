@@ -92,8 +92,12 @@ typedef struct {
  * single EFA endpoint.
  */
 typedef struct {
-    /// @brief Memory pool for Rx packet SGL entries (CdiSglEntry). Not thread-safe.
-    CdiPoolHandle packet_sgl_entries_pool_handle;
+    /// @brief SGL entry of each receive packet buffer, indexed by the position of the buffer in packet_buffers_ptr. An
+    /// entry is in use while its buffer holds a received packet, so no pool is needed.
+    CdiSglEntry* packet_sgl_entry_array;
+    int packet_buffer_count;                ///< Number of receive packet buffers.
+    uint8_t* packet_buffers_ptr;            ///< Aligned address of the first receive packet buffer.
+    int64_t aligned_packet_size;            ///< Distance in bytes between the starts of adjacent packet buffers.
     void* allocated_buffer_ptr;             ///< Address of receive packets memory buffer; needed for freeing.
     int allocated_buffer_size;              ///< Total size of allocated packets buffer; needed for freeing.
     bool allocated_buffer_was_from_heap;    ///< True if no huge pages were available; needed for freeing.
@@ -125,6 +125,7 @@ CdiReturnStatus ProbeEndpointCreate(AdapterEndpointHandle app_adapter_endpoint_h
 
         probe_ptr->app_msg_from_endpoint_func_ptr = app_adapter_endpoint_handle->msg_from_endpoint_func_ptr;
         probe_ptr->app_msg_from_endpoint_param_ptr = app_adapter_endpoint_handle->msg_from_endpoint_param_ptr;
+        probe_ptr->app_tx_packets_complete_func_ptr = app_adapter_endpoint_handle->tx_packets_complete_func_ptr;
 
         probe_ptr->log_handle = log_handle;
     }
@@ -121,6 +121,8 @@ typedef struct ProbeEndpointState ProbeEndpointState;
 struct ProbeEndpointState {
     MessageFromEndpoint app_msg_from_endpoint_func_ptr; ///< Saved copy of original function pointer
     void* app_msg_from_endpoint_param_ptr; ///< Saved copy of original parameter
+    /// Saved copy of original Tx packets complete function pointer.
+    TxPacketsCompleteFromEndpoint app_tx_packets_complete_func_ptr;
 
     AdapterEndpointHandle app_adapter_endpoint_handle; ///< Handle to the application's endpoint.
     union {
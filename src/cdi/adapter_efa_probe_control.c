@@ -169,6 +169,7 @@ bool ProbeControlEfaConnectionStart(ProbeEndpointState* probe_ptr)
         probe_ptr->rx_probe_state.packets_received_count = 0;
     }
     endpoint_ptr->msg_from_endpoint_param_ptr = probe_ptr;
+    endpoint_ptr->tx_packets_complete_func_ptr = NULL; // Probe variants handle one completion at a time.
 
     // Start the application's EFA connection.
     EfaEndpointState* efa_endpoint_state_ptr = (EfaEndpointState*)endpoint_ptr->type_specific_ptr;
@@ -215,6 +216,7 @@ void ProbeControlEfaConnectionEnableApplication(ProbeEndpointState* probe_ptr)
     // Setup message functions and related parameters to point to the application variants.
     endpoint_ptr->msg_from_endpoint_func_ptr = probe_ptr->app_msg_from_endpoint_func_ptr;
     endpoint_ptr->msg_from_endpoint_param_ptr = probe_ptr->app_msg_from_endpoint_param_ptr;
+    endpoint_ptr->tx_packets_complete_func_ptr = probe_ptr->app_tx_packets_complete_func_ptr;
 
     ProbeControlQueueStateChange(probe_ptr, kProbeStateEfaConnected);
 }
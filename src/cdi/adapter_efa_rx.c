@@ -105,11 +105,11 @@ static bool Poll(EfaEndpointState* efa_endpoint_ptr)
     if (fi_ret > 0) {
         for (int i = 0; i < fi_ret; i++) {
             const size_t message_length = comp_array[i].len;
-            CdiSglEntry* sgl_entry_ptr = NULL;
-            // NOTE: This pool is not thread-safe, so must ensure that only one thread is accessing it at a time.
-            if (!CdiPoolGet(efa_endpoint_ptr->rx_state.packet_sgl_entries_pool_handle, (void**)&sgl_entry_ptr)) {
-                assert(false);
-            }
+            // Use the SGL entry of the packet buffer the message was received into.
+            const int64_t buffer_index = ((uint8_t*)comp_array[i].buf - efa_endpoint_ptr->rx_state.packet_buffers_ptr) /
+                                         efa_endpoint_ptr->rx_state.aligned_packet_size;
+            assert(buffer_index >= 0 && buffer_index < efa_endpoint_ptr->rx_state.packet_buffer_count);
+            CdiSglEntry* sgl_entry_ptr = &efa_endpoint_ptr->rx_state.packet_sgl_entry_array[buffer_index];
 
             Packet packet = {
                 .sg_list = {
@@ -123,12 +123,10 @@ static bool Poll(EfaEndpointState* efa_endpoint_ptr)
                 }
             };
 
-            if (sgl_entry_ptr) {
-                sgl_entry_ptr->address_ptr = (char*)comp_array[i].buf + msg_prefix_size;
-                sgl_entry_ptr->size_in_bytes = message_length - msg_prefix_size;
-                sgl_entry_ptr->internal_data_ptr = NULL;
-                sgl_entry_ptr->next_ptr = NULL;
-            }
+            sgl_entry_ptr->address_ptr = (char*)comp_array[i].buf + msg_prefix_size;
+            sgl_entry_ptr->size_in_bytes = message_length - msg_prefix_size;
+            sgl_entry_ptr->internal_data_ptr = NULL;
+            sgl_entry_ptr->next_ptr = NULL;
 
 #ifdef DEBUG_PACKET_SEQUENCES
             CdiProtocolHandle protocol_handle = efa_endpoint_ptr->adapter_endpoint_ptr->protocol_handle;
@@ -189,20 +187,32 @@ static bool CreatePacketPool(EfaEndpointState* endpoint_state_ptr, int packet_si
     // Round up to next even-multiple of hugepages byte size.
     allocated_size = ((allocated_size + CDI_HUGE_PAGES_BYTE_SIZE-1) / CDI_HUGE_PAGES_BYTE_SIZE) * CDI_HUGE_PAGES_BYTE_SIZE;
 
-    uint8_t* allocated_ptr = CdiOsMemAllocHugePage(allocated_size);
-    if (NULL == allocated_ptr) {
-        // Fallback using heap memory.
-        allocated_ptr = CdiOsMemAlloc(allocated_size);
-        endpoint_state_ptr->rx_state.allocated_buffer_was_from_heap = true;
-    } else {
-        // Buffer was allocated using huge pages. Set flag to know how to later free it.
-        endpoint_state_ptr->rx_state.allocated_buffer_was_from_heap = false;
+    // Allocate the SGL entries of the packet buffers on the poll thread's NUMA node, since only it uses them.
+    const int numa_node = endpoint_state_ptr->adapter_endpoint_ptr->adapter_con_state_ptr->numa_node;
+    const int64_t sgl_entry_array_size = packet_count * sizeof(CdiSglEntry);
+    CdiSglEntry* sgl_entry_array = CdiOsMemAllocOnNumaNode(sgl_entry_array_size, numa_node);
+
+    uint8_t* allocated_ptr = NULL;
+    if (NULL != sgl_entry_array) {
+        allocated_ptr = CdiOsMemAllocHugePage(allocated_size);
+        if (NULL == allocated_ptr) {
+            // Fallback using heap memory.
+            allocated_ptr = CdiOsMemAlloc(allocated_size);
+            endpoint_state_ptr->rx_state.allocated_buffer_was_from_heap = true;
+        } else {
+            // Buffer was allocated using huge pages. Set flag to know how to later free it.
+            endpoint_state_ptr->rx_state.allocated_buffer_was_from_heap = false;
+            // Place the packet buffers on the poll thread's NUMA node before libfabric touches them.
+            CdiOsMemBindToNumaNode(allocated_ptr, allocated_size, numa_node);
+        }
     }
 
     if (NULL != allocated_ptr) {
         // Move the address pointer up to the next aligned position.
         uint8_t* mem_ptr = (uint8_t*)(((uint64_t)(allocated_ptr + packet_buffer_alignment - 1))
                                       & ~(packet_buffer_alignment - 1));
+        endpoint_state_ptr->rx_state.packet_buffers_ptr = mem_ptr;
+        endpoint_state_ptr->rx_state.aligned_packet_size = aligned_packet_size;
 
         // Register the newly allocated and aligned region with libfabric.
         int fi_ret = endpoint_state_ptr->libfabric_api_ptr->fi_mr_reg(endpoint_state_ptr->domain_ptr, mem_ptr,
@@ -230,8 +240,11 @@ static bool CreatePacketPool(EfaEndpointState* endpoint_state_ptr, int packet_si
     }
 
     if (ret) {
+        endpoint_state_ptr->rx_state.packet_sgl_entry_array = sgl_entry_array;
+        endpoint_state_ptr->rx_state.packet_buffer_count = packet_count;
         endpoint_state_ptr->rx_state.allocated_buffer_ptr = allocated_ptr;
         endpoint_state_ptr->rx_state.allocated_buffer_size = allocated_size;
+        endpoint_state_ptr->adapter_endpoint_ptr->adapter_con_state_ptr->rx_packet_buffer_byte_size = allocated_size;
     } else {
         if (NULL != allocated_ptr) {
             if (endpoint_state_ptr->rx_state.allocated_buffer_was_from_heap) {
@@ -240,6 +253,9 @@ static bool CreatePacketPool(EfaEndpointState* endpoint_state_ptr, int packet_si
                 CdiOsMemFreeHugePage(allocated_ptr, allocated_size);
             }
         }
+        if (NULL != sgl_entry_array) {
+            CdiOsMemFreeOnNumaNode(sgl_entry_array, sgl_entry_array_size);
+        }
     }
 
     return ret;
@@ -268,6 +284,13 @@ static void FreePacketPool(EfaEndpointState* endpoint_state_ptr)
         }
         endpoint_state_ptr->rx_state.allocated_buffer_ptr = NULL;
         endpoint_state_ptr->rx_state.allocated_buffer_size = 0;
+
+        CdiOsMemFreeOnNumaNode(endpoint_state_ptr->rx_state.packet_sgl_entry_array,
+                               endpoint_state_ptr->rx_state.packet_buffer_count * sizeof(CdiSglEntry));
+        endpoint_state_ptr->rx_state.packet_sgl_entry_array = NULL;
+        endpoint_state_ptr->rx_state.packet_buffer_count = 0;
+        endpoint_state_ptr->rx_state.packet_buffers_ptr = NULL;
+        endpoint_state_ptr->adapter_endpoint_ptr->adapter_con_state_ptr->rx_packet_buffer_byte_size = 0;
     }
 }
 
@@ -279,18 +302,8 @@ CdiReturnStatus EfaRxEndpointOpen(EfaEndpointState* endpoint_state_ptr)
 {
     // NOTE: Since the caller is the application's thread, use SDK_LOG_GLOBAL() for any logging in this function.
     CdiReturnStatus rs = kCdiStatusOk;
-    int reserve_packets = endpoint_state_ptr->adapter_endpoint_ptr->adapter_con_state_ptr->rx_state.reserve_packet_buffers;
-
-    if (kCdiStatusOk == rs) {
-        // NOTE: This pool is not thread-safe, so must ensure that only one thread is accessing it at a time.
-        if (!CdiPoolCreate("EfaRxEndpoint CdiSglEntry Pool", reserve_packets,
-                           MAX_RX_PACKETS_PER_CONNECTION_GROW, MAX_POOL_GROW_COUNT, sizeof(CdiSglEntry),
-                           false, // false= Not thread-safe (don't use OS resource locks)
-                           &endpoint_state_ptr->rx_state.packet_sgl_entries_pool_handle)) {
-            rs = kCdiStatusNotEnoughMemory;
-        }
-    }
 
+    // NOTE: The SGL entries of the receive packets are allocated along with the packet buffers. See CreatePacketPool().
     if (kCdiStatusOk == rs) {
         rs = EfaAdapterProbeEndpointCreate(endpoint_state_ptr, &endpoint_state_ptr->probe_endpoint_handle);
     }
@@ -311,9 +324,7 @@ CdiReturnStatus EfaRxEndpointReset(EfaEndpointState* endpoint_state_ptr)
 {
     // Clean up resources used by PollThread().
 
-    // This pool only contains pool buffers (so nothing else needs to be freed).
-    // NOTE: This pool is not thread-safe, so must ensure that only one thread is accessing it at a time.
-    CdiPoolPutAll(endpoint_state_ptr->rx_state.packet_sgl_entries_pool_handle);
+    // NOTE: The SGL entries of the receive packets belong to their packet buffers, so nothing needs to be freed here.
     ProbeEndpointReset(endpoint_state_ptr->probe_endpoint_handle);
 
     // NOTE: No need to flush Tx control packet FIFO. Any pending packets in the FIFO will be processed and related work
@@ -333,10 +344,6 @@ CdiReturnStatus EfaRxEndpointClose(EfaEndpointState* endpoint_state_ptr)
     ProbeEndpointDestroy(endpoint_state_ptr->probe_endpoint_handle);
     endpoint_state_ptr->probe_endpoint_handle = NULL;
 
-    // NOTE: This pool is not thread-safe, so  must ensure that only one thread is accessing it at a time.
-    CdiPoolDestroy(endpoint_state_ptr->rx_state.packet_sgl_entries_pool_handle);
-    endpoint_state_ptr->rx_state.packet_sgl_entries_pool_handle = NULL;
-
     return kCdiStatusOk;
 }
 
@@ -351,24 +358,22 @@ CdiReturnStatus EfaRxEndpointRxBuffersFree(const AdapterEndpointHandle handle, c
         .iov_len = adapter_endpoint_ptr->maximum_payload_bytes + msg_prefix_size
     };
 
-    // Free SGL data buffers and SGL entries.
+    // Give the packet buffers of the SGL entries back to libfabric.
     CdiSglEntry *sgl_entry_ptr = sgl_ptr->sgl_head_ptr;
     while (sgl_entry_ptr) {
         msg_iov.iov_base = (char*)sgl_entry_ptr->address_ptr - msg_prefix_size;
+        // Save next entry, since the SGL entry belongs to the packet buffer and is reused once the buffer is posted.
+        CdiSglEntry* next_ptr = sgl_entry_ptr->next_ptr;
 
         // NOTE: This function is called from PollThread(), so no need to use libfabric's FI_THREAD_SAFE option.
         // Access to libfabric functions such as fi_recvmsg() and fi_cq_read() use PollThread().
-        if (!PostRxBuffer(endpoint_state_ptr, &msg_iov, NULL != sgl_entry_ptr->next_ptr)) {
+        if (!PostRxBuffer(endpoint_state_ptr, &msg_iov, NULL != next_ptr)) {
             // Something went terribly wrong in libfabric. Notify the probe component so it can start the connection
             // reset process.
             ProbeEndpointError(endpoint_state_ptr->probe_endpoint_handle);
             rs = kCdiStatusNotConnected;
         }
 
-        // Free SGL entry buffer.
-        CdiSglEntry *next_ptr = sgl_entry_ptr->next_ptr; // Save next entry, since Put() will free its memory.
-        // NOTE: This pool is not thread-safe, so must ensure that only one thread is accessing it at a time.
-        CdiPoolPut(endpoint_state_ptr->rx_state.packet_sgl_entries_pool_handle, sgl_entry_ptr);
         sgl_entry_ptr = next_ptr; // Point to next SGL entry
     }
 
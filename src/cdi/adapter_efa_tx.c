@@ -197,14 +197,12 @@ static bool Poll(EfaEndpointState* efa_endpoint_ptr)
     efa_endpoint_ptr->tx_state.tx_packets_in_process -= packet_ack_count;
 
     // Process any completions that were received.
+    Packet* packet_array[MAX_TX_BULK_COMPLETION_QUEUE_MESSAGES];
     for (int i = 0; i < packet_ack_count; i++) {
         Packet* packet_ptr = comp_array[i].op_context;
         assert(packet_ptr);
         packet_ptr->tx_state.ack_status = status ? kAdapterPacketStatusOk : kAdapterPacketStatusFailed;
-
-        // Send the completion message for the packet.
-        (adapter_endpoint_ptr->msg_from_endpoint_func_ptr)(adapter_endpoint_ptr->msg_from_endpoint_param_ptr,
-                                                           packet_ptr, kEndpointMessageTypePacketSent);
+        packet_array[i] = packet_ptr;
 
 #ifdef DEBUG_PACKET_SEQUENCES
         CdiProtocolHandle protocol_handle = adapter_endpoint_ptr->protocol_handle;
@@ -218,6 +216,11 @@ static bool Poll(EfaEndpointState* efa_endpoint_ptr)
 #endif
     }
 
+    // Send the completion messages for all the packets at once.
+    if (packet_ack_count) {
+        CdiAdapterTxPacketsSent(adapter_endpoint_ptr, packet_array, packet_ack_count);
+    }
+
     if (!status && kCdiConnectionStatusConnected == adapter_endpoint_ptr->connection_status_code) {
         // Must assume the connection to the receiver has gone down and must reset it. Notify the probe component so
         // it can start the connection reset process.
@@ -12,6 +12,7 @@
 
 #include "adapter_api.h"
 
+#include <stddef.h>
 #include <sys/uio.h>
 
 #include "cdi_os_api.h"
@@ -68,6 +69,9 @@ typedef struct {
     uint8_t buffer[kSocketMtu];  ///< Memory where received packet is placed and sent up to the connection layer.
 } ReceiveBufferRecord;
 
+// SocketEndpointRxBuffersFree() relies on each SGL entry's next_ptr also pointing to the start of the next record.
+CDI_STATIC_ASSERT(0 == offsetof(ReceiveBufferRecord, sgl_entry), "sgl_entry must be first member.");
+
 /**
  * @brief State definition for socket endpoint.
  */
@@ -260,12 +264,14 @@ static CdiReturnStatus SocketEndpointOpen(AdapterEndpointHandle endpoint_handle,
                 if (!signal_created) {
                     CDI_LOG_THREAD(kLogError, "Failed to create socket receive thread shutdown signal.");
                 } else {
-                    // Create a pool of ReceiveBufferRecord structures.
-                    pool_created = CdiPoolCreateAndInitItems("socket receiver", RX_SOCKET_BUFFER_SIZE,
-                                                             RX_SOCKET_BUFFER_SIZE_GROW, MAX_POOL_GROW_COUNT,
-                                                             sizeof(ReceiveBufferRecord), true,
-                                                             &private_state_ptr->receive_buffer_pool,
-                                                             SocketEndpointPoolItemInit, NULL);
+                    // Create a pool of ReceiveBufferRecord structures. Buffers are taken by the receive thread and
+                    // returned by the connection's thread, so use thread caches to avoid contending for the lock.
+                    pool_created = CdiPoolCreateOnNumaNode("socket receiver", RX_SOCKET_BUFFER_SIZE,
+                                                           RX_SOCKET_BUFFER_SIZE_GROW, MAX_POOL_GROW_COUNT,
+                                                           sizeof(ReceiveBufferRecord), kPoolFlagThreadCache,
+                                                           endpoint_handle->adapter_con_state_ptr->numa_node,
+                                                           &private_state_ptr->receive_buffer_pool,
+                                                           SocketEndpointPoolItemInit, NULL);
                     if (!pool_created) {
                         CDI_LOG_THREAD(kLogError, "Failed to allocate socket receive buffer pool.");
                     }
@@ -432,11 +438,12 @@ static CdiReturnStatus SocketEndpointSend(const AdapterEndpointHandle handle, co
 
     // A copy of the data has been made so the application's buffer is available now. Send the message to the upper
     // layers.
+    // The packet is sent synchronously, so it is reported as a single completion.
     Packet rx_packet = *packet_ptr; // Make a copy of the packet, so we can modify ack_status.
     rx_packet.tx_state.ack_status = (kCdiStatusOk == ret) ? kAdapterPacketStatusOk : kAdapterPacketStatusNotConnected;
 
-    (handle->msg_from_endpoint_func_ptr)(handle->msg_from_endpoint_param_ptr, &rx_packet,
-                                         kEndpointMessageTypePacketSent);
+    Packet* rx_packet_ptr = &rx_packet;
+    CdiAdapterTxPacketsSent(handle, &rx_packet_ptr, 1);
 
     return ret;
 }
@@ -454,14 +461,9 @@ static CdiReturnStatus SocketEndpointRxBuffersFree(const AdapterEndpointHandle h
     AdapterEndpointState* endpoint_state_ptr = (AdapterEndpointState*)handle;
     SocketEndpointState* private_state_ptr = (SocketEndpointState*)endpoint_state_ptr->type_specific_ptr;
 
-    // Iterate through the SGL returning each ReceiveBufferRecord in it.
-    CdiSglEntry* entry_ptr = sgl_ptr->sgl_head_ptr;
-    while (entry_ptr) {
-        ReceiveBufferRecord* receive_buffer_ptr = CONTAINER_OF(entry_ptr, ReceiveBufferRecord, sgl_entry);
-        CdiSglEntry* next_ptr = entry_ptr->next_ptr; // Save next entry, since Put() will free its memory.
-        CdiPoolPut(private_state_ptr->receive_buffer_pool, receive_buffer_ptr);
-        entry_ptr = next_ptr;
-    }
+    // Return every ReceiveBufferRecord in the SGL using a single pool operation. The SGL entry is the first member of
+    // ReceiveBufferRecord, so each entry's next_ptr also points to the start of the next record.
+    CdiPoolPutList(private_state_ptr->receive_buffer_pool, sgl_ptr->sgl_head_ptr, offsetof(CdiSglEntry, next_ptr));
 
     return kCdiStatusOk;
 }
@@ -29,6 +29,18 @@
 //***************************************** START OF DEFINITIONS AND TYPES ********************************************
 //*********************************************************************************************************************
 
+CDI_STATIC_ASSERT(sizeof(CDIPacketAvmNoConfig) == sizeof(CdiAvmExtraData),
+                  "AVM extra data must be the whole CDI packet #0 header of a payload without AVM configuration.");
+
+/**
+ * @brief Payloads of CdiAvmEndpointTxPayloadMultiple() that are queued together.
+ */
+typedef struct {
+    TxPayloadRequest request_array[MAX_TX_PAYLOAD_BATCH_ITEM_COUNT];  ///< Payloads to queue.
+    int descriptor_index_array[MAX_TX_PAYLOAD_BATCH_ITEM_COUNT];      ///< Index of each payload's descriptor.
+    int count;                                                        ///< Number of payloads in request_array.
+} AvmTxPayloadBatch;
+
 //*********************************************************************************************************************
 //*********************************************** START OF VARIABLES **************************************************
 //*********************************************************************************************************************
@@ -37,6 +49,62 @@
 //******************************************* START OF STATIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
 
+/**
+ * Transmit a payload of data to a remote endpoint. See CdiAvmEndpointTxPayload() and CdiAvmEndpointTxPayloadReplace().
+ *
+ * @param endpoint_handle Handle of the endpoint to send the payload to.
+ * @param payload_config_ptr Pointer to payload configuration data.
+ * @param avm_config_ptr Pointer to AVM configuration data or NULL.
+ * @param sgl_ptr Scatter-gather list containing the data to be transmitted.
+ * @param max_latency_microsecs Maximum latency in microseconds.
+ * @param replace True if the payload replaces the payloads of its stream that are waiting to be sent.
+ *
+ * @return A value from the CdiReturnStatus enumeration.
+ */
+static CdiReturnStatus AvmEndpointTxPayload(CdiEndpointHandle endpoint_handle,
+                                            const CdiAvmTxPayloadConfig* payload_config_ptr,
+                                            const CdiAvmConfig* avm_config_ptr, const CdiSgList* sgl_ptr,
+                                            int max_latency_microsecs, bool replace)
+{
+    if (!IsValidEndpointHandle(endpoint_handle)) {
+        return kCdiStatusInvalidHandle;
+    }
+
+    CDIPacketAvmUnion packet_avm_data;
+    memset((void*)&packet_avm_data, 0, sizeof(packet_avm_data));
+
+    packet_avm_data.common_header.avm_extra_data = payload_config_ptr->avm_extra_data;
+
+    if (NULL != avm_config_ptr) {
+        packet_avm_data.with_config.config = *avm_config_ptr;
+    }
+
+    int avm_data_size =
+        (NULL == avm_config_ptr) ? sizeof(packet_avm_data.no_config) : sizeof(packet_avm_data.with_config);
+
+    return TxPayloadInternal(endpoint_handle, &payload_config_ptr->core_config_data, sgl_ptr, max_latency_microsecs,
+                             avm_data_size, (uint8_t*)&packet_avm_data, replace);
+}
+
+/**
+ * Queue the payloads of a batch and write their status to the CdiAvmEndpointTxPayloadMultiple() status array. The
+ * batch is empty when this function returns.
+ *
+ * @param batch_ptr Pointer to the batch of payloads.
+ * @param ret_status_array Status array of CdiAvmEndpointTxPayloadMultiple().
+ */
+static void AvmTxPayloadBatchFlush(AvmTxPayloadBatch* batch_ptr, CdiReturnStatus* ret_status_array)
+{
+    if (batch_ptr->count) {
+        CdiReturnStatus status_array[MAX_TX_PAYLOAD_BATCH_ITEM_COUNT];
+        TxPayloadMultipleInternal(batch_ptr->request_array, batch_ptr->count, status_array);
+        for (int i = 0; i < batch_ptr->count; i++) {
+            ret_status_array[batch_ptr->descriptor_index_array[i]] = status_array[i];
+        }
+        batch_ptr->count = 0;
+    }
+}
+
 //*********************************************************************************************************************
 //******************************************* START OF PUBLIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
@@ -103,22 +171,62 @@ CdiReturnStatus CdiAvmEndpointTxPayload(CdiEndpointHandle endpoint_handle,
                                         const CdiAvmConfig* avm_config_ptr, const CdiSgList* sgl_ptr,
                                         int max_latency_microsecs)
 {
-    if (!IsValidEndpointHandle(endpoint_handle)) {
-        return kCdiStatusInvalidHandle;
-    }
-
-    CDIPacketAvmUnion packet_avm_data;
-    memset((void*)&packet_avm_data, 0, sizeof(packet_avm_data));
+    return AvmEndpointTxPayload(endpoint_handle, payload_config_ptr, avm_config_ptr, sgl_ptr, max_latency_microsecs,
+                                false);
+}
 
-    packet_avm_data.common_header.avm_extra_data = payload_config_ptr->avm_extra_data;
+CdiReturnStatus CdiAvmEndpointTxPayloadReplace(CdiEndpointHandle endpoint_handle,
+                                               const CdiAvmTxPayloadConfig* payload_config_ptr,
+                                               const CdiAvmConfig* avm_config_ptr, const CdiSgList* sgl_ptr,
+                                               int max_latency_microsecs)
+{
+    return AvmEndpointTxPayload(endpoint_handle, payload_config_ptr, avm_config_ptr, sgl_ptr, max_latency_microsecs,
+                                true);
+}
 
-    if (NULL != avm_config_ptr) {
-        packet_avm_data.with_config.config = *avm_config_ptr;
+CdiReturnStatus CdiAvmEndpointTxPayloadMultiple(const CdiAvmTxPayloadDescriptor* descriptor_array,
+                                                int descriptor_count, CdiReturnStatus* ret_status_array)
+{
+    AvmTxPayloadBatch batch;
+    batch.count = 0;
+
+    for (int i = 0; i < descriptor_count; i++) {
+        const CdiAvmTxPayloadDescriptor* descriptor_ptr = &descriptor_array[i];
+        if (!IsValidEndpointHandle(descriptor_ptr->endpoint_handle)) {
+            ret_status_array[i] = kCdiStatusInvalidHandle;
+        } else if (NULL != descriptor_ptr->avm_config_ptr) {
+            // The CDI packet #0 header with a configuration is too large to keep one for each payload of a batch, so
+            // send the payload on its own. Queue the payloads before it first, so the order is kept.
+            AvmTxPayloadBatchFlush(&batch, ret_status_array);
+            ret_status_array[i] = AvmEndpointTxPayload(descriptor_ptr->endpoint_handle,
+                                                       descriptor_ptr->payload_config_ptr,
+                                                       descriptor_ptr->avm_config_ptr, descriptor_ptr->sgl_ptr,
+                                                       descriptor_ptr->max_latency_microsecs, false);
+        } else {
+            // Without a configuration, the CDI packet #0 header is the AVM extra data, so it is sent from the
+            // descriptor's payload configuration as is.
+            const CdiAvmTxPayloadConfig* payload_config_ptr = descriptor_ptr->payload_config_ptr;
+            batch.request_array[batch.count] = (TxPayloadRequest) {
+                .endpoint_ptr = descriptor_ptr->endpoint_handle,
+                .core_payload_config_ptr = &payload_config_ptr->core_config_data,
+                .sgl_ptr = descriptor_ptr->sgl_ptr,
+                .max_latency_microsecs = descriptor_ptr->max_latency_microsecs,
+                .extra_data_size = sizeof(CDIPacketAvmNoConfig),
+                .extra_data_ptr = (const uint8_t*)&payload_config_ptr->avm_extra_data,
+                .replace = false
+            };
+            batch.descriptor_index_array[batch.count++] = i;
+            if (MAX_TX_PAYLOAD_BATCH_ITEM_COUNT == batch.count) {
+                AvmTxPayloadBatchFlush(&batch, ret_status_array);
+            }
+        }
     }
+    AvmTxPayloadBatchFlush(&batch, ret_status_array);
 
-    int avm_data_size =
-        (NULL == avm_config_ptr) ? sizeof(packet_avm_data.no_config) : sizeof(packet_avm_data.with_config);
-
-    return TxPayloadInternal(endpoint_handle, &payload_config_ptr->core_config_data, sgl_ptr, max_latency_microsecs,
-                             avm_data_size, (uint8_t*)&packet_avm_data);
+    for (int i = 0; i < descriptor_count; i++) {
+        if (kCdiStatusOk != ret_status_array[i]) {
+            return ret_status_array[i];
+        }
+    }
+    return kCdiStatusOk;
 }
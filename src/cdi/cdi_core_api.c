@@ -17,6 +17,8 @@
 
 #include "internal.h"
 #include "internal_rx.h"
+#include "internal_tx.h"
+#include "statistics.h"
 
 //*********************************************************************************************************************
 //***************************************** START OF DEFINITIONS AND TYPES ********************************************
@@ -115,7 +117,8 @@ int CdiCoreGather(const CdiSgList* sgl_ptr, int offset, void* dest_data, int byt
         return -1;
     }
 
-    return CdiGatherInternal(sgl_ptr, offset, dest_data, byte_count);
+    // A destination this large is not going to fit in the caches alongside the data being gathered.
+    return CdiGatherInternal(sgl_ptr, offset, dest_data, byte_count, byte_count >= GATHER_NON_TEMPORAL_MIN_BYTES);
 }
 
 CdiReturnStatus CdiCoreStatsReconfigure(CdiConnectionHandle handle, const CdiStatsConfigData* config_ptr)
@@ -128,6 +131,28 @@ CdiReturnStatus CdiCoreStatsReconfigure(CdiConnectionHandle handle, const CdiSta
     return CoreStatsConfigureInternal(handle, config_ptr, false);
 }
 
+CdiReturnStatus CdiCoreConnectionGetResourceStats(CdiConnectionHandle handle, CdiResourceStats* ret_stats_ptr)
+{
+    if (!IsValidConnectionHandle(handle)) {
+        return kCdiStatusInvalidHandle;
+    }
+    if (NULL == ret_stats_ptr) {
+        return kCdiStatusInvalidParameter;
+    }
+
+    StatsGetResourceStats(handle->stats_state_ptr, ret_stats_ptr);
+    return kCdiStatusOk;
+}
+
+CdiReturnStatus CdiCoreTxPayloadCancel(CdiConnectionHandle handle, CdiUserCbParameter user_cb_param)
+{
+    if (!IsValidTxHandle(handle)) {
+        return kCdiStatusInvalidHandle;
+    }
+
+    return TxPayloadCancelInternal(handle, user_cb_param);
+}
+
 CdiReturnStatus CdiCoreConnectionDestroy(CdiConnectionHandle handle)
 {
     if (!IsValidConnectionHandle(handle)) {
@@ -225,6 +250,8 @@ const char* CdiCoreStatusToString(CdiReturnStatus status)
         { kCdiStatusLibraryLoadFailed,     "Library load failed"            },
         { kCdiStatusLibrarySymbolNotFound, "Library symbol not found"       },
         { kCdiStatusLibraryWrongVersion,   "Wrong library version"          },
+        { kCdiStatusTxPayloadStale,        "Stale Tx payload skipped"       },
+        { kCdiStatusTxPayloadCancelled,    "Tx payload cancelled"           },
         { CDI_INVALID_ENUM_VALUE,          "<invalid>"                      },
     };
 
@@ -76,7 +76,7 @@ CdiReturnStatus CdiRawTxPayload(CdiConnectionHandle con_handle,
         return kCdiStatusInvalidHandle;
     }
 
-    // Raw doesn't use extra data (so last two parameters are 0 and NULL).
+    // Raw doesn't use extra data (so extra data parameters are 0 and NULL).
     return TxPayloadInternal(con_handle->default_tx_endpoint_ptr, payload_config_ptr, sgl_ptr, max_latency_microsecs,
-                             0, NULL);
+                             0, NULL, false);
 }
@@ -40,6 +40,24 @@ extern CdiReturnStatus TestUnitRxReorderPayloads(void);
 extern CdiReturnStatus TestUnitList(void);
 /// External declarations.
 extern CdiReturnStatus TestUnitLogger(void);
+/// External declarations.
+extern CdiReturnStatus TestUnitPool(void);
+/// External declarations.
+extern CdiReturnStatus TestUnitQueue(void);
+/// External declarations.
+extern CdiReturnStatus TestUnitSignal(void);
+/// External declarations.
+extern CdiReturnStatus TestUnitTxEndpoints(void);
+/// External declarations.
+extern CdiReturnStatus TestUnitTxPacing(void);
+/// External declarations.
+extern CdiReturnStatus TestUnitPacketizer(void);
+/// External declarations.
+extern CdiReturnStatus TestUnitTxStalePayloads(void);
+/// External declarations.
+extern CdiReturnStatus TestUnitRxCopyEngine(void);
+/// External declarations.
+extern CdiReturnStatus TestUnitRxSlices(void);
 
 /// Type used as a pointer to function that runs a unit test.
 typedef CdiReturnStatus (*RunTestAPI)(void);
@@ -66,6 +84,15 @@ static const RunTestParams tests[] = {
     { kTestUnitRxPayloadReorder,    "RxPayloadReorder", TestUnitRxReorderPayloads },
     { kTestUnitList,                "List",             TestUnitList },
     { kTestUnitLogger,              "Logger",           TestUnitLogger },
+    { kTestUnitPool,                "Pool",             TestUnitPool },
+    { kTestUnitQueue,               "Queue",            TestUnitQueue },
+    { kTestUnitSignal,              "Signal",           TestUnitSignal },
+    { kTestUnitTxEndpoints,         "TxEndpoints",      TestUnitTxEndpoints },
+    { kTestUnitTxPacing,            "TxPacing",         TestUnitTxPacing },
+    { kTestUnitPacketizer,          "Packetizer",       TestUnitPacketizer },
+    { kTestUnitTxStalePayloads,     "TxStalePayloads",  TestUnitTxStalePayloads },
+    { kTestUnitRxCopyEngine,        "RxCopyEngine",     TestUnitRxCopyEngine },
+    { kTestUnitRxSlices,            "RxSlices",         TestUnitRxSlices },
     { CDI_INVALID_ENUM_VALUE, NULL, NULL } // End of the array
 };
 
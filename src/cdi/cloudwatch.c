@@ -81,10 +81,12 @@ static void FifoFullCallback(const CdiFifoFullCbData* cb_data_ptr)
     // Take timestamp and counter based data from the new stat.
     last_stats_ptr->timestamp_in_ms_since_epoch = new_stats_ptr->timestamp_in_ms_since_epoch;
     last_stats_ptr->payload_counter_stats = new_stats_ptr->payload_counter_stats;
+    last_stats_ptr->resource_stats = new_stats_ptr->resource_stats;
 
     // Accumulate time-interval based stats. Update the counters.
     dest_ptr->transfer_count += src_ptr->transfer_count;
     dest_ptr->transfer_time_sum += src_ptr->transfer_time_sum;
+    dest_ptr->tx_queue_time_sum += src_ptr->tx_queue_time_sum;
 
     // When dealing with percentiles, when the fifo is full, replace the last element with our new results only if the
     // new results are higher. That way, in the event of data loss, we preserve the worst-case numbers. The only case
@@ -104,6 +106,9 @@ static void FifoFullCallback(const CdiFifoFullCbData* cb_data_ptr)
     if (src_ptr->transfer_time_max > dest_ptr->transfer_time_max) {
         dest_ptr->transfer_time_max = src_ptr->transfer_time_max;
     }
+    if (src_ptr->tx_queue_time_max > dest_ptr->tx_queue_time_max) {
+        dest_ptr->tx_queue_time_max = src_ptr->tx_queue_time_max;
+    }
 }
 
 /**
@@ -138,6 +143,18 @@ static void CalculateDeltas(CloudWatchState* cw_state_ptr, const CdiTransferStat
 
         delta_stats_ptr->delta_probe_command_retry_count = endpoint_stats_ptr->probe_command_retry_count -
                                                            prev_endpoint_stats_ptr->probe_command_retry_count;
+
+        const CdiResourceStats* resource_stats_ptr = &transfer_stats_ptr->resource_stats;
+        const CdiResourceStats* prev_resource_stats_ptr = &cw_state_ptr->previous_stats.resource_stats;
+        delta_stats_ptr->delta_resource_grow_count =
+            (resource_stats_ptr->pool_grow_count + resource_stats_ptr->queue_grow_count) -
+            (prev_resource_stats_ptr->pool_grow_count + prev_resource_stats_ptr->queue_grow_count);
+
+        delta_stats_ptr->delta_pool_get_fail_count = resource_stats_ptr->pool_get_fail_count -
+                                                     prev_resource_stats_ptr->pool_get_fail_count;
+
+        delta_stats_ptr->delta_queue_push_fail_count = resource_stats_ptr->queue_push_fail_count -
+                                                       prev_resource_stats_ptr->queue_push_fail_count;
     }
 }
 
@@ -175,6 +192,8 @@ static CDI_THREAD CloudWatchThread(void* ptr)
                 .payload_time_interval_stats = transfer_stats.payload_time_interval_stats,
                 .connected = transfer_stats.endpoint_stats.connected,
                 .cpu_utilization = transfer_stats.endpoint_stats.poll_thread_load,
+                .pool_peak_usage_percent = transfer_stats.resource_stats.pool_peak_usage_percent,
+                .queue_peak_usage_percent = transfer_stats.resource_stats.queue_peak_usage_percent,
                 .is_receiver = cw_state_ptr->con_state_ptr->handle_type == kHandleTypeRx,
             };
             CdiOsStrCpy(cw_stats.dimension_stream_str, sizeof(cw_stats.dimension_stream_str),
@@ -356,6 +356,16 @@ CdiReturnStatus UserMetrics::Send(const CloudWatchTransferStats* stats_ptr)
             stats_ptr->count_based_delta_stats.delta_probe_command_retry_count, StandardUnit::Count);
     AddDatum(request, connection_str, direction_str, high_resolution, timestamp, "BytesTransferred",
             stats_ptr->count_based_delta_stats.delta_num_bytes_transferred, StandardUnit::Bytes);
+    AddDatum(request, connection_str, direction_str, high_resolution, timestamp, "ResourceGrowths",
+            stats_ptr->count_based_delta_stats.delta_resource_grow_count, StandardUnit::Count);
+    AddDatum(request, connection_str, direction_str, high_resolution, timestamp, "PoolGetFailures",
+            stats_ptr->count_based_delta_stats.delta_pool_get_fail_count, StandardUnit::Count);
+    AddDatum(request, connection_str, direction_str, high_resolution, timestamp, "QueuePushFailures",
+            stats_ptr->count_based_delta_stats.delta_queue_push_fail_count, StandardUnit::Count);
+    AddDatum(request, connection_str, direction_str, high_resolution, timestamp, "PoolPeakUsage",
+             stats_ptr->pool_peak_usage_percent, StandardUnit::Percent);
+    AddDatum(request, connection_str, direction_str, high_resolution, timestamp, "QueuePeakUsage",
+             stats_ptr->queue_peak_usage_percent, StandardUnit::Percent);
     AddDatum(request, connection_str, direction_str, high_resolution, timestamp, "PayloadTimeP50",
             stats_ptr->payload_time_interval_stats.transfer_time_P50, StandardUnit::Microseconds);
     AddDatum(request, connection_str, direction_str, high_resolution, timestamp, "PayloadTimeP90",
@@ -52,6 +52,15 @@ typedef struct {
 
     /// Number of bytes transferred over the stats period.
     uint64_t delta_num_bytes_transferred;
+
+    /// Number of times one of the connection's pools or queues had to be increased in size over the stats period.
+    uint32_t delta_resource_grow_count;
+
+    /// Number of pool gets that failed because one of the connection's pools was exhausted over the stats period.
+    uint32_t delta_pool_get_fail_count;
+
+    /// Number of queue pushes that failed because one of the connection's queues was full over the stats period.
+    uint32_t delta_queue_push_fail_count;
 } CloudWatchCounterBasedDeltas;
 
 /**
@@ -75,6 +84,9 @@ typedef struct {
     CloudWatchCounterBasedDeltas count_based_delta_stats;    ///< Counter based stats that contain delta values.
     CdiPayloadTimeIntervalStats payload_time_interval_stats; ///< Payload time stats.
 
+    uint32_t pool_peak_usage_percent;  ///< Largest high-water mark of any of the connection's pools, in percent.
+    uint32_t queue_peak_usage_percent; ///< Largest high-water mark of any of the connection's queues, in percent.
+
     bool connected;       ///< true if the connection is up, false if the connection is not connected.
     int cpu_utilization;  ///< CPU load of poll thread in hundreths of a percent.
     bool is_receiver;     ///< true if this endpoint is a receiver, false if a transmitter.
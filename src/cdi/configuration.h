@@ -27,9 +27,6 @@
 /// @brief Enable to debug poll thread sleep time. NOTE: This generates a lot of debug output.
 //#define DEBUG_POLL_THREAD_SLEEP_TIME
 
-/// @brief Enable to debug Tx packet SGL entry pool free item count.
-//#define DEBUG_TX_PACKET_SGL_ENTRY_POOL_FREE_COUNT
-
 /// @brief This is an example of how to use the queue debug function. It enables queue debugging of the
 /// tx_packet_queue_handle in adapter.c. NOTE: This feature is currently only available in a DEBUG build.
 //#define DEBUG_ENABLE_QUEUE_DEBUGGING
@@ -79,6 +76,21 @@
 /// @brief Maximum number out of order packets buffer can be increased by.
 #define MAX_RX_OUT_OF_ORDER_GROW            (8)
 
+/// @brief Number of packet slots in each page of the bitmap packet reorder engine (see
+/// CdiRxConfigData.bitmap_packet_reorder). Must be a multiple of 64, the number of bits in a word of the bitmap.
+#define RX_REORDER_PAGE_SLOT_COUNT          (1024)
+/// @brief Number of pages that cover all of the packet sequence numbers of a payload, which are 16 bits.
+#define RX_REORDER_PAGE_COUNT               ((UINT16_MAX + 1) / RX_REORDER_PAGE_SLOT_COUNT)
+/// @brief Number of pages of the bitmap packet reorder engine initially allocated for a connection.
+#define RX_REORDER_PAGE_POOL_SIZE           (8)
+/// @brief Number of pages of the bitmap packet reorder engine that the pool of a connection grows by.
+#define RX_REORDER_PAGE_POOL_SIZE_GROW      (8)
+
+/// @brief Number of packets past the end of the contiguous data at the start of a payload that are tracked to report
+/// slices (see CdiRxConfigData.slice_cb_ptr). Once a packet arrives further ahead, no more slices are reported for the
+/// payload. Must be a power of two no larger than 65536, so the window stays aligned when packet sequence numbers wrap.
+#define RX_SLICE_WINDOW_PACKET_COUNT        (128)
+
 /// @brief Maximum length of error string message.
 #define MAX_ERROR_STRING_LENGTH             (1024)
 
@@ -108,11 +120,6 @@
 /// DMA Tx memory region.
 #define TX_AVM_PACKET_HEADER_POOL_SIZE_PER_CONNECTION   (100)
 
-/// @brief Initial number of SGL entries in a tx payload.
-#define TX_PACKET_SGL_ENTRY_SIZE_PER_CONNECTION        (3000*HD_TO_4K_FACTOR)
-/// @brief Number of entries the tx payload SGL list may be increased by.
-#define TX_PACKET_SGL_ENTRY_SIZE_PER_CONNECTION_GROW   (500)
-
 /// @brief Maximum number of transmit packets per payload. Additional objects are needed due to the asynchronous nature
 /// of the API. Multiple payload transmissions may overlap.
 #define MAX_TX_PACKETS_PER_CONNECTION                  (3000*HD_TO_4K_FACTOR)
@@ -125,13 +132,33 @@
 /// @brief Number of entries the tx packet queue may be increased by.
 #define TX_PACKET_SEND_QUEUE_SIZE_GROW                 (10)
 
-/// @brief Maximum number of SGL entries for a single transmit packet.
+/// @brief Maximum number of SGL entries for a single transmit packet. The entries are embedded in each Tx packet work
+/// request (TxPacketWorkRequest), so adapters that support more are limited to this number.
 #define MAX_TX_SGL_PACKET_ENTRIES                      (4)
 
+/// @brief Number of completed Tx packet work requests, and of their headers, that are put back into their pools with a
+/// single pool operation.
+#define MAX_TX_WORK_REQUEST_PUT_BATCH_SIZE             (64)
+
 /// @brief Maximum number of packets that can be simultaneously queued for transmission without receiving a
 /// corresponding completion event (ACK or error).
 #define SIMULTANEOUS_TX_PACKET_LIMIT                   (50)
 
+/// @brief Maximum number of Tx payloads sent to a connection by CdiAvmEndpointTxPayloadMultiple() with a single payload
+/// state pool operation and a single payload queue push.
+#define MAX_TX_PAYLOAD_BATCH_ITEM_COUNT                (64)
+
+/// @brief Maximum number of Tx payload cancel requests that can wait to be processed by a connection. See
+/// CdiCoreTxPayloadCancel().
+#define MAX_TX_PAYLOAD_CANCEL_REQUESTS_PER_CONNECTION  (16)
+
+/// @brief Default maximum number of bytes a Tx packet pacer sends back to back. See CdiTxPacingConfig.burst_bytes.
+#define TX_PACING_DEFAULT_BURST_BYTES                  (32*1024)
+
+/// @brief Maximum time a Tx poll thread sleeps while its only work is waiting for the packet pacer. Packets of other
+/// endpoints that become ready during the sleep are delayed by up to this amount.
+#define TX_PACING_MAX_SLEEP_MICROSECONDS               (1000)
+
 /// @brief Maximum number of completion queue messages to process in a single Tx poll call.
 #define MAX_TX_BULK_COMPLETION_QUEUE_MESSAGES          (SIMULTANEOUS_TX_PACKET_LIMIT)
 
@@ -148,15 +175,54 @@
 /// @brief Number of entries the rx socket list may be increased by.
 #define RX_SOCKET_BUFFER_SIZE_GROW                     (100)
 
+/// @brief Number of payload bytes assumed to be carried by each EFA packet when sizing a connection's resources from
+/// its CdiResourceProfile. Smaller than the actual EFA packet payload size to leave room for CDI packet headers.
+#define RESOURCE_PROFILE_EFA_PACKET_PAYLOAD_BYTES      (8192)
+/// @brief Number of payload bytes assumed to be carried by each socket adapter packet when sizing a connection's
+/// resources from its CdiResourceProfile.
+#define RESOURCE_PROFILE_SOCKET_PACKET_PAYLOAD_BYTES   (1280)
+/// @brief Smallest number of packets a connection is sized for when using a CdiResourceProfile. Keeps small streams
+/// from stalling on bursts.
+#define RESOURCE_PROFILE_MIN_PACKET_COUNT              (64)
+
 /// @brief Size of the endpoint command queue used by the Endpoint Manager.
 #define MAX_ENDPOINT_COMMAND_QUEUE_SIZE                (10)
 
 /// @brief Maximum number of times a pool may grow in size before an error occurs.
 #define MAX_POOL_GROW_COUNT                            (5)
 
+/// @brief Maximum number of items held by each magazine of a pool created with kPoolFlagThreadCache. Each thread that
+/// uses the pool caches up to two magazines, so this also bounds the number of free items a thread can hold on to.
+#define POOL_MAGAZINE_ITEM_COUNT                       (32)
+
+/// @brief For pools created with kPoolFlagThreadCache, the magazine size is reduced for small pools so that no more
+/// than 1/POOL_MAGAZINE_MIN_DIVISOR of the pool's initial items fit into a single magazine.
+#define POOL_MAGAZINE_MIN_DIVISOR                      (8)
+
+/// @brief Number of pool slots added to the thread cache tables each time more pools created with kPoolFlagThreadCache
+/// exist than the tables can hold. All of these pools share a single thread data slot.
+#define POOL_THREAD_CACHE_SLOT_GROW_COUNT              (32)
+
+/// @brief Pools created with kPoolFlagHugePages only use huge pages for item arrays of at least this many bytes. Smaller
+/// arrays span few regular pages and would waste most of a huge page.
+#define POOL_HUGE_PAGES_MIN_BYTE_SIZE                  (256 * 1024)
+
+/// @brief Pool flags used by the large per-connection pools whose items are accessed for every packet (Tx work
+/// requests, Rx payload states and reorder entries). kPoolFlagHugePages backs them with huge
+/// pages when available to reduce TLB misses. Set to kPoolFlagNone to always use regular pages.
+#define CONNECTION_POOL_FLAGS                          (kPoolFlagHugePages)
+
+/// @brief Pool flags added to the flags of the per-connection CdiSglEntry pools. kPoolFlagSlimItems removes the pool
+/// item header, which is larger than a CdiSglEntry's own data. Set to kPoolFlagNone to use regular pool items.
+#define SGL_ENTRY_POOL_FLAGS                           (kPoolFlagSlimItems)
+
 /// @brief Maximum number of times a queue may grow in size before an error occurs.
 #define MAX_QUEUE_GROW_COUNT                           (5)
 
+/// @brief Maximum number of items moved by a single CdiQueuePushMultiple() or CdiQueuePopMultiple() call when the SDK
+/// hands off Tx work request completions and Rx payloads between threads.
+#define MAX_QUEUE_BATCH_ITEM_COUNT                     (16)
+
 /// @brief The space reserved for the libfabric message prefix in our packet header. This must be set to be
 /// equal or larger than the largest prefix size needed by the EFA provider. It must be a multiple of 8.
 /// See https://ofiwg.github.io/libfabric/v1.13.0/man/fi_msg.3.html#notes
@@ -257,6 +323,21 @@
 /// CdiCoreRxFreeBuffer() function.
 #define RX_LINEAR_BUFFER_COUNT                  (5)
 
+/// @brief Number of packet copies that can wait for each copy thread of a connection that copies received packets
+/// into linear receive buffers with copy threads (see CdiRxConfigData.copy_thread_count). When all copy threads have
+/// this many copies waiting, the poll thread copies packets itself.
+#define RX_COPY_QUEUE_SIZE                      (256)
+
+/// @brief Minimum size in bytes of a gather destination for the data to be written with non-temporal stores, which
+/// bypass the CPU caches. Destinations this large, such as linear receive buffers holding video frames, are written
+/// once and not read again by the thread doing the gather, so caching them only evicts data that is still in use. Used
+/// by CdiCoreGather() for the byte_count of a gather and by the linear receive path for the size of the linear buffer.
+#define GATHER_NON_TEMPORAL_MIN_BYTES           (1024*1024)
+
+/// @brief Minimum number of bytes copied from an SGL entry with non-temporal stores. Smaller copies are done with
+/// memcpy(), since they are dominated by the unaligned bytes at their start and end.
+#define GATHER_NON_TEMPORAL_MIN_ENTRY_BYTES     (256)
+
 //*********************************************************************************************************************
 //****************************************** SETTINGS FOR SYSTEM MONITORING *******************************************
 //*********************************************************************************************************************
@@ -979,6 +979,7 @@ CdiReturnStatus EndpointManagerTxCreateEndpoint(EndpointManagerHandle handle, bo
 
                 .msg_from_endpoint_func_ptr = TxPacketWorkRequestComplete,
                 .msg_from_endpoint_param_ptr = endpoint_ptr,
+                .tx_packets_complete_func_ptr = TxPacketWorkRequestsComplete,
 
                 .remote_address_str = dest_ip_addr_str,
                 .port_number = dest_port,
@@ -18,7 +18,11 @@
 #include <arpa/inet.h> // For inet_ntop()
 #include <inttypes.h>
 #include <stdarg.h>
+#include <stddef.h>
 #include <string.h>
+#if defined(__x86_64__) || defined(_M_X64)
+#include <emmintrin.h> // For SSE2 non-temporal stores.
+#endif
 
 #include "adapter_api.h"
 #include "adapter_control_interface.h"
@@ -36,6 +40,12 @@
 //***************************************** START OF DEFINITIONS AND TYPES ********************************************
 //*********************************************************************************************************************
 
+#if defined(__x86_64__) || defined(_M_X64)
+/// @brief Defined if CopyNonTemporal() uses non-temporal stores. SSE2 is part of the x86-64 baseline, so no runtime CPU
+/// check is needed. Wider stores don't help, since a non-temporal copy is limited by memory bandwidth.
+#define USE_NON_TEMPORAL_STORES
+#endif
+
 //*********************************************************************************************************************
 //*********************************************** START OF VARIABLES **************************************************
 //*********************************************************************************************************************
@@ -93,30 +103,28 @@ static CDI_THREAD AppCallbackPayloadThread(void* ptr)
     CdiLoggerThreadLogSet(con_state_ptr->log_handle);
 
     while (!CdiOsSignalGet(con_state_ptr->shutdown_signal)) {
-        // Wait for work to do. If the queue is empty, we will wait for data or the shutdown signal.
-        AppPayloadCallbackData app_cb_data;
-        if (CdiQueuePopWait(con_state_ptr->app_payload_message_queue_handle, CDI_INFINITE,
-                            con_state_ptr->shutdown_signal, (void**)&app_cb_data)) {
+        // Wait for work to do. If the queue is empty, we will wait for data or the shutdown signal. The callback data
+        // is used in place in the queue and released once the application callback has returned.
+        AppPayloadCallbackData* app_cb_data_ptr = NULL;
+        if (CdiQueuePopPeekWait(con_state_ptr->app_payload_message_queue_handle, CDI_INFINITE,
+                                con_state_ptr->shutdown_signal, (void**)&app_cb_data_ptr)) {
             // Invoke application payload callback function.
             if (con_state_ptr->handle_type == kHandleTypeTx) {
                 // Tx connection. All packets in the payload have been acknowledged as being received by the
                 // receiver. Put the Tx payload entries and payload state data back in the pool. We do this here on
                 // this thread to reduce the amount of work on the Tx Poll() thread.
-                CdiSglEntry* entry_ptr = app_cb_data.tx_source_sgl.sgl_head_ptr;
-                while (entry_ptr) {
-                    CdiSglEntry* next_ptr = entry_ptr->next_ptr; // Save next entry, since Put() will free its memory.
-                    CdiPoolPut(con_state_ptr->tx_state.payload_sgl_entry_pool_handle, entry_ptr);
-                    entry_ptr = next_ptr;
-                }
+                FreeSglEntries(con_state_ptr->tx_state.payload_sgl_entry_pool_handle,
+                               app_cb_data_ptr->tx_source_sgl.sgl_head_ptr);
                 // Notify the application.
-                TxInvokeAppPayloadCallback(con_state_ptr, &app_cb_data);
+                TxInvokeAppPayloadCallback(con_state_ptr, app_cb_data_ptr);
             } else {
                 // Rx connection. The SGL from the queue represents a received packet. Need to reassemble it into a
                 // payload and send the payload SGL to the application.
-                RxInvokeAppPayloadCallback(con_state_ptr, &app_cb_data);
+                RxInvokeAppPayloadCallback(con_state_ptr, app_cb_data_ptr);
             }
             // If error message exists, return it to pool.
-            PayloadErrorFreeBuffer(con_state_ptr->error_message_pool, &app_cb_data);
+            PayloadErrorFreeBuffer(con_state_ptr->error_message_pool, app_cb_data_ptr);
+            CdiQueuePopRelease(con_state_ptr->app_payload_message_queue_handle);
         }
     }
 
@@ -244,6 +252,49 @@ static void CleanupGlobalResources(void)
     cdi_global_context.sdk_initialized = false;
 }
 
+/**
+ * Copy memory using non-temporal stores, which write the data to memory without first reading the destination's cache
+ * lines into the CPU caches. The destination bytes before the first 16 byte boundary and after the last one are copied
+ * with memcpy(). On CPUs without non-temporal stores, the whole copy is done with memcpy(). The caller must issue a
+ * store fence after the copy, before the data is made visible to another thread.
+ *
+ * @param dest_ptr Pointer to the destination.
+ * @param src_ptr Pointer to the source.
+ * @param byte_count Number of bytes to copy.
+ */
+static void CopyNonTemporal(uint8_t* dest_ptr, const uint8_t* src_ptr, int byte_count)
+{
+#ifdef USE_NON_TEMPORAL_STORES
+    int head_bytes = CDI_MIN(byte_count, (int)((16 - ((uintptr_t)dest_ptr & 15)) & 15));
+    memcpy(dest_ptr, src_ptr, head_bytes);
+    dest_ptr += head_bytes;
+    src_ptr += head_bytes;
+    byte_count -= head_bytes;
+
+    // Copy a cache line per iteration.
+    while (byte_count >= 64) {
+        __m128i data0 = _mm_loadu_si128((const __m128i*)src_ptr);
+        __m128i data1 = _mm_loadu_si128((const __m128i*)(src_ptr + 16));
+        __m128i data2 = _mm_loadu_si128((const __m128i*)(src_ptr + 32));
+        __m128i data3 = _mm_loadu_si128((const __m128i*)(src_ptr + 48));
+        _mm_stream_si128((__m128i*)dest_ptr, data0);
+        _mm_stream_si128((__m128i*)(dest_ptr + 16), data1);
+        _mm_stream_si128((__m128i*)(dest_ptr + 32), data2);
+        _mm_stream_si128((__m128i*)(dest_ptr + 48), data3);
+        dest_ptr += 64;
+        src_ptr += 64;
+        byte_count -= 64;
+    }
+    while (byte_count >= 16) {
+        _mm_stream_si128((__m128i*)dest_ptr, _mm_loadu_si128((const __m128i*)src_ptr));
+        dest_ptr += 16;
+        src_ptr += 16;
+        byte_count -= 16;
+    }
+#endif
+    memcpy(dest_ptr, src_ptr, byte_count);
+}
+
 //*********************************************************************************************************************
 //******************************************* START OF PUBLIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
@@ -363,7 +414,7 @@ CdiReturnStatus CdiGlobalInitialization(const CdiCoreConfigData* core_config_ptr
     return rs;
 }
 
-int CdiGatherInternal(const CdiSgList* sgl_ptr, int offset, void* dest_data_ptr, int byte_count)
+int CdiGatherInternal(const CdiSgList* sgl_ptr, int offset, void* dest_data_ptr, int byte_count, bool non_temporal)
 {
     int bytes_skipped = 0;
     int bytes_copied = 0;
@@ -390,7 +441,11 @@ int CdiGatherInternal(const CdiSgList* sgl_ptr, int offset, void* dest_data_ptr,
 
             if (num_bytes > 0) {
                 // copy the source bytes to the linear buffer
-                memcpy(p, src_ptr, num_bytes);
+                if (non_temporal && num_bytes >= GATHER_NON_TEMPORAL_MIN_ENTRY_BYTES) {
+                    CopyNonTemporal(p, src_ptr, num_bytes);
+                } else {
+                    memcpy(p, src_ptr, num_bytes);
+                }
 
                 // account for the number of bytes copied
                 bytes_copied += num_bytes;
@@ -406,6 +461,12 @@ int CdiGatherInternal(const CdiSgList* sgl_ptr, int offset, void* dest_data_ptr,
             }
         }
     }
+#ifdef USE_NON_TEMPORAL_STORES
+    if (non_temporal) {
+        // Non-temporal stores are weakly ordered, so make them visible before any store that hands the data over.
+        _mm_sfence();
+    }
+#endif
     return bytes_copied;
 }
 
@@ -550,6 +611,26 @@ CdiReturnStatus NetworkAdapterDestroyInternal(CdiAdapterHandle handle)
 }
 
 
+int ResourceProfilePacketCount(CdiAdapterTypeSelection adapter_type, const CdiResourceProfile* profile_ptr,
+                               int payload_count, int worst_case_count)
+{
+    if (0 == profile_ptr->max_payload_byte_size) {
+        return worst_case_count;
+    }
+
+    uint64_t packet_payload_bytes = (kCdiAdapterTypeEfa == adapter_type) ? RESOURCE_PROFILE_EFA_PACKET_PAYLOAD_BYTES :
+                                                                           RESOURCE_PROFILE_SOCKET_PACKET_PAYLOAD_BYTES;
+    // Add one packet per payload, since the first packet also carries the payload's extra data.
+    uint64_t packets_per_payload = (profile_ptr->max_payload_byte_size + packet_payload_bytes - 1) /
+                                   packet_payload_bytes + 1;
+    uint64_t packet_count = packets_per_payload * payload_count;
+
+    if (packet_count < RESOURCE_PROFILE_MIN_PACKET_COUNT) {
+        packet_count = RESOURCE_PROFILE_MIN_PACKET_COUNT;
+    }
+    return (packet_count < (uint64_t)worst_case_count) ? (int)packet_count : worst_case_count;
+}
+
 CdiReturnStatus ConnectionCommonResourcesCreate(CdiConnectionHandle handle, CdiCoreStatsCallback stats_cb_ptr,
                                                 CdiUserCbParameter stats_user_cb_param,
                                                 const CdiStatsConfigData* stats_config_ptr)
@@ -573,11 +654,16 @@ CdiReturnStatus ConnectionCommonResourcesCreate(CdiConnectionHandle handle, CdiC
     }
 
     if (kCdiStatusOk == rs) {
-        // Create payload receive message queue that is used to send messages to the application callback thread.
+        // Create payload receive message queue that is used to send messages to the application callback thread. On
+        // Tx, TxPayloadThread() completes payloads that are skipped or cancelled before being sent while the poll
+        // thread completes the payloads it has sent, so the queue must be thread safe for multiple writers.
+        CdiQueueSignalMode signal_mode = kQueueSignalPopWait; // Queue can block on pops.
+        if (kHandleTypeTx == handle->handle_type) {
+            signal_mode |= kQueueMultipleWritersFlag;
+        }
         if (!CdiQueueCreate("PayloadRequests AppPayloadCallbackData Queue", MAX_PAYLOADS_PER_CONNECTION,
                             CDI_FIXED_QUEUE_SIZE, CDI_FIXED_QUEUE_SIZE, sizeof(AppPayloadCallbackData),
-                            kQueueSignalPopWait, // Queue can block on pops.
-                            &handle->app_payload_message_queue_handle)) {
+                            signal_mode, &handle->app_payload_message_queue_handle)) {
             rs = kCdiStatusNotEnoughMemory;
         }
     }
@@ -761,24 +847,8 @@ CdiReturnStatus SdkShutdownInternal(void)
 
 bool FreeSglEntries(CdiPoolHandle pool_handle, CdiSglEntry* sgl_entry_head_ptr)
 {
-    bool ret = true;
-
-    // Put back SGL entry for each one in the list.
-    CdiSglEntry* sgl_entry_ptr = sgl_entry_head_ptr;
-    while (sgl_entry_ptr) {
-        CdiSglEntry* sgl_entry_next_ptr = sgl_entry_ptr->next_ptr; // Save next entry, since Put() will free its memory.
-        CdiPoolPut(pool_handle, sgl_entry_ptr);
-
-        // Check for infinite loop (using same pointer)?
-        if (sgl_entry_ptr == sgl_entry_next_ptr) {
-            assert(false);
-            ret = false;
-            break;
-        }
-        sgl_entry_ptr = sgl_entry_next_ptr;
-    }
-
-    return ret;
+    // Put back all of the SGL entries in the list using a single pool operation.
+    return CdiPoolPutList(pool_handle, sgl_entry_head_ptr, offsetof(CdiSglEntry, next_ptr));
 }
 
 void DumpPayloadConfiguration(const CdiCoreExtraData* core_extra_data_ptr, int extra_data_size,
@@ -124,12 +124,14 @@ CdiReturnStatus CdiGlobalInitialization(const CdiCoreConfigData* core_config_ptr
  * @param offset Number of bytes to skip in SGL before starting the copy.
  * @param dest_data_ptr Where to write the gathered data in linear format.
  * @param byte_count The number of bytes to copy.
+ * @param non_temporal If true, the data is written with non-temporal stores, which bypass the CPU caches. Use for large
+ *                     destinations that are not read again soon by this thread. See GATHER_NON_TEMPORAL_MIN_BYTES.
  *
  * @return The number of bytes copied. This will be less than byte_count if fewer than that number of bytes are present
  *         in the source SGL starting from the specified offset. A value of -1 indicates that a fatal error was
  *         encountered.
  */
-int CdiGatherInternal(const CdiSgList* sgl_ptr, int offset, void* dest_data_ptr, int byte_count);
+int CdiGatherInternal(const CdiSgList* sgl_ptr, int offset, void* dest_data_ptr, int byte_count, bool non_temporal);
 
 /**
  * Initialize an adapter.
@@ -177,6 +179,21 @@ void EndpointDestroyInternal(CdiEndpointHandle handle);
  */
 CdiReturnStatus SdkShutdownInternal(void);
 
+/**
+ * Get the number of packets a connection must be able to hold at the same time to carry the specified number of
+ * payloads of the stream described by a resource profile. The result is never larger than worst_case_count, which is
+ * also returned if the profile is not used (see CdiResourceProfile).
+ *
+ * @param adapter_type Type of the adapter used by the connection. Determines the assumed packet payload size.
+ * @param profile_ptr Pointer to the connection's resource profile.
+ * @param payload_count Number of payloads to make room for.
+ * @param worst_case_count Number of packets used when not sizing from the profile.
+ *
+ * @return Number of packets.
+ */
+int ResourceProfilePacketCount(CdiAdapterTypeSelection adapter_type, const CdiResourceProfile* profile_ptr,
+                               int payload_count, int worst_case_count);
+
 /**
  * Create connection resources that are common to both Tx and Rx connection types. These are OS level resources that
  * must be created prior to the creation of any child threads related to this connection.
@@ -24,6 +24,7 @@
 #include "private.h"
 #include "private_avm.h"
 #include "receive_buffer.h"
+#include "rx_copy_engine.h"
 #include "rx_reorder_packets.h"
 #include "rx_reorder_payloads.h"
 #include "statistics.h"
@@ -277,6 +278,7 @@ static bool InitializePayloadState(CdiProtocolHandle protocol_handle, CdiEndpoin
         payload_state_ptr->data_bytes_received = 0;
         payload_state_ptr->expected_payload_data_size = 0;
         payload_state_ptr->reorder_list_ptr = NULL;
+        payload_state_ptr->reorder_held_packet_count = 0;
 
         if (0 == packet_sequence_num) {
             UpdatePayloadStateDataFromCDIPacket0(payload_state_ptr, header_ptr);
@@ -296,6 +298,18 @@ static bool InitializePayloadState(CdiProtocolHandle protocol_handle, CdiEndpoin
                     app_payload_cb_data_ptr->core_extra_data.origination_ptp_timestamp.seconds,
                     app_payload_cb_data_ptr->core_extra_data.origination_ptp_timestamp.nanoseconds);
                 ret = false;
+            } else if (con_state_ptr->rx_state.slice_state_pool_handle) {
+                // The pool holds one entry per linear buffer, so this can't fail. If it did, the payload would still
+                // be received, without slices.
+                RxSliceState* slice_state_ptr = NULL;
+                if (CdiPoolGet(con_state_ptr->rx_state.slice_state_pool_handle, (void**)&slice_state_ptr)) {
+                    slice_state_ptr->next_sequence_num = 0;
+                    slice_state_ptr->contiguous_size = 0;
+                    slice_state_ptr->reported_size = 0;
+                    slice_state_ptr->window_overflow = false;
+                    memset(slice_state_ptr->end_offset_array, 0, sizeof(slice_state_ptr->end_offset_array));
+                }
+                payload_state_ptr->slice_state_ptr = slice_state_ptr;
             }
         } else {
             payload_state_ptr->linear_buffer_ptr = NULL;
@@ -303,6 +317,7 @@ static bool InitializePayloadState(CdiProtocolHandle protocol_handle, CdiEndpoin
             ret = RxReorderPacketPayloadStateInit(protocol_handle,
                                                   con_state_ptr->rx_state.payload_sgl_entry_pool_handle,
                                                   con_state_ptr->rx_state.reorder_entries_pool_handle,
+                                                  con_state_ptr->rx_state.reorder_pages_pool_handle,
                                                   payload_state_ptr, &packet_ptr->sg_list,
                                                   header_ptr->encoded_header_size, packet_sequence_num);
         }
@@ -311,22 +326,84 @@ static bool InitializePayloadState(CdiProtocolHandle protocol_handle, CdiEndpoin
     return ret;
 }
 
+/**
+ * Returns the packet buffers of the copies that the connection's copy threads have completed to the adapter.
+ *
+ * @param con_state_ptr Pointer to connection state structure.
+ */
+static void RxCopiesFree(CdiConnectionState* con_state_ptr)
+{
+    RxCopyRequest request_array[MAX_QUEUE_BATCH_ITEM_COUNT];
+    int count = 0;
+    do {
+        count = RxCopyEngineGetCompleted(con_state_ptr->rx_state.copy_engine_handle, request_array,
+                                         CDI_ARRAY_ELEMENT_COUNT(request_array));
+        for (int i = 0; i < count; i++) {
+            const RxCopyRequest* request_ptr = &request_array[i];
+            CdiAdapterFreeBuffer(request_ptr->endpoint_ptr->adapter_endpoint_ptr, &request_ptr->packet_sgl);
+            RxPayloadState* payload_state_ptr = request_ptr->payload_state_ptr;
+            if (payload_state_ptr->slice_state_ptr) {
+                RxSlicePacketCopied(con_state_ptr, payload_state_ptr, request_ptr->packet_sequence_num,
+                                    (int)(request_ptr->dest_ptr + request_ptr->byte_count -
+                                          payload_state_ptr->linear_buffer_ptr));
+            }
+        }
+    } while (count == CDI_ARRAY_ELEMENT_COUNT(request_array));
+}
+
+/**
+ * Waits for all of the copies posted to the connection's copy threads to complete and frees their packet buffers. Must
+ * be used before a payload's linear buffer is handed to the application or returned to its pool. Does nothing if the
+ * connection does not use copy threads.
+ *
+ * @param con_state_ptr Pointer to connection state structure.
+ */
+static void RxCopiesWait(CdiConnectionState* con_state_ptr)
+{
+    if (con_state_ptr->rx_state.copy_engine_handle) {
+        RxCopyEngineWaitIdle(con_state_ptr->rx_state.copy_engine_handle);
+        RxCopiesFree(con_state_ptr);
+    }
+}
+
+/**
+ * Returns a payload's slice state to its pool once no more slices can be reported for the payload. Must be used after
+ * RxCopiesWait(), since completed copies record packets in the slice state. Does nothing if the payload has no slice
+ * state.
+ *
+ * @param con_state_ptr Pointer to connection state structure.
+ * @param payload_state_ptr Pointer to payload state.
+ */
+static void SliceStateFree(CdiConnectionState* con_state_ptr, RxPayloadState* payload_state_ptr)
+{
+    if (payload_state_ptr->slice_state_ptr) {
+        CdiPoolPut(con_state_ptr->rx_state.slice_state_pool_handle, payload_state_ptr->slice_state_ptr);
+        payload_state_ptr->slice_state_ptr = NULL;
+    }
+}
+
 /**
  * Copy the packet payloads's contents to its proper location within the current linear receive payload buffer. It takes
  * into account the case of packets with a data offset in the case where a packet's size somewhere in the payload was
- * reduced to limit the number of SGL entries required.
+ * reduced to limit the number of SGL entries required. If the connection uses copy threads, the copy is posted to them
+ * unless the packet completes the payload, in which case the copy is done here.
  *
  * @param con_state_ptr Pointer to connection state structure.
+ * @param endpoint_ptr Pointer to the endpoint that received the packet.
  * @param packet_ptr Pointer to packet whose contents are to be copied.
  * @param payload_state_ptr Pointer to payload structure being updated.
  * @param header_ptr Pointer to CDI header that contains data to be added to payload state.
+ * @param ret_posted_ptr Address where to write true if the copy was posted to a copy thread, in which case the packet's
+ *                       buffers are freed once the copy completes.
  *
  * @return true if the function completed successfully, false if a problem was encountered.
  */
-static bool CopyToLinearBuffer(CdiConnectionState* con_state_ptr, const Packet* packet_ptr,
-                               RxPayloadState* payload_state_ptr, const CdiDecodedPacketHeader* header_ptr)
+static bool CopyToLinearBuffer(CdiConnectionState* con_state_ptr, CdiEndpointState* endpoint_ptr,
+                               const Packet* packet_ptr, RxPayloadState* payload_state_ptr,
+                               const CdiDecodedPacketHeader* header_ptr, bool* ret_posted_ptr)
 {
     bool ret = true;
+    *ret_posted_ptr = false;
 
     // Using linear memory buffer.
     int offset = 0;
@@ -344,12 +421,39 @@ static bool CopyToLinearBuffer(CdiConnectionState* con_state_ptr, const Packet*
         ret = false;
     } else {
         // Copy the data from the packet(s) into the desired buffer at the payload's offset, skipping the header
-        // portion.
-        const int bytes_gathered = CdiCoreGather(&packet_ptr->sg_list, header_ptr->encoded_header_size,
-                                                 payload_state_ptr->linear_buffer_ptr + offset, byte_count);
-        assert(-1 != bytes_gathered); // -1 means error
-        assert(bytes_gathered <= byte_count);
-        payload_state_ptr->data_bytes_received += bytes_gathered;
+        // portion. A large linear buffer is only read by the application, so bypass the caches when writing to it.
+        const bool non_temporal = linear_buffer_size >= GATHER_NON_TEMPORAL_MIN_BYTES;
+        const bool last_packet = payload_state_ptr->data_bytes_received + byte_count >=
+                                 payload_state_ptr->expected_payload_data_size;
+        if (con_state_ptr->rx_state.copy_engine_handle && !last_packet) {
+            // Return the packet buffers of the copies completed so far, which also makes room for this one.
+            RxCopiesFree(con_state_ptr);
+            RxCopyRequest request = {
+                .endpoint_ptr = endpoint_ptr,
+                .packet_sgl = packet_ptr->sg_list,
+                .offset = header_ptr->encoded_header_size,
+                .dest_ptr = payload_state_ptr->linear_buffer_ptr + offset,
+                .byte_count = byte_count,
+                .non_temporal = non_temporal,
+                .payload_state_ptr = payload_state_ptr,
+                .packet_sequence_num = header_ptr->packet_sequence_num
+            };
+            *ret_posted_ptr = RxCopyEnginePost(con_state_ptr->rx_state.copy_engine_handle, &request);
+        }
+        if (*ret_posted_ptr) {
+            payload_state_ptr->data_bytes_received += byte_count;
+        } else {
+            const int bytes_gathered = CdiGatherInternal(&packet_ptr->sg_list, header_ptr->encoded_header_size,
+                                                         payload_state_ptr->linear_buffer_ptr + offset, byte_count,
+                                                         non_temporal);
+            assert(-1 != bytes_gathered); // -1 means error
+            assert(bytes_gathered <= byte_count);
+            payload_state_ptr->data_bytes_received += bytes_gathered;
+            if (payload_state_ptr->slice_state_ptr) {
+                RxSlicePacketCopied(con_state_ptr, payload_state_ptr, header_ptr->packet_sequence_num,
+                                    offset + bytes_gathered);
+            }
+        }
     }
 
     return ret;
@@ -446,8 +550,10 @@ static bool FinalizePayload(CdiConnectionState* con_state_ptr, RxPayloadState* p
     // If the above logic fails, we still want to execute this logic to provide possible additional error information
     // and to free resources used.
     if (kCdiSgl == con_state_ptr->rx_state.config_data.rx_buffer_type) {
-        // If all data received, then there can only be one list and the next and prev pointers must be NULL.
-        if (payload_state_ptr->reorder_list_ptr->next_ptr || payload_state_ptr->reorder_list_ptr->prev_ptr) {
+        // If all data received, then there can only be one list and the next and prev pointers must be NULL. The bitmap
+        // packet reorder engine must not be holding any packets.
+        if (payload_state_ptr->reorder_list_ptr->next_ptr || payload_state_ptr->reorder_list_ptr->prev_ptr ||
+            payload_state_ptr->reorder_held_packet_count) {
             CDI_LOG_THREAD(kLogError, "All payload data received but there are unattached lists present.");
             CDI_LOG_THREAD(kLogError, "Throwing away this payload[%d]. Timestamp[%u:%u] Expected Size[%d] Received[%d]",
                            payload_state_ptr->payload_num,
@@ -463,9 +569,9 @@ static bool FinalizePayload(CdiConnectionState* con_state_ptr, RxPayloadState* p
              }
 #endif
             // Return the memory space back to the respective pools.
-            RxReorderPacketFreeLists(payload_state_ptr->reorder_list_ptr,
-                                     con_state_ptr->rx_state.payload_sgl_entry_pool_handle,
-                                     con_state_ptr->rx_state.reorder_entries_pool_handle);
+            RxReorderPacketFreeLists(payload_state_ptr, con_state_ptr->rx_state.payload_sgl_entry_pool_handle,
+                                     con_state_ptr->rx_state.reorder_entries_pool_handle,
+                                     con_state_ptr->rx_state.reorder_pages_pool_handle);
             ret = false;
         } else {
             // Update SGL's total data size and pointers.
@@ -521,32 +627,35 @@ static bool FinalizePayload(CdiConnectionState* con_state_ptr, RxPayloadState* p
 static void QueueBackPressurePayloadToApp(CdiConnectionState* con_state_ptr, CdiEndpointState* endpoint_ptr,
                                           const CdiDecodedPacketHeader* decoded_header_ptr)
 {
-    AppPayloadCallbackData cb_data = {
-        .payload_status_code = kCdiStatusRxPayloadBackPressure
-    };
+    // Increment the dropped payload count. This value is also incremented in TxPayloadThread(), so use atomic
+    // operation here.
+    CDI_STATIC_ASSERT(sizeof(uint64_t) == sizeof(endpoint_ptr->transfer_stats.payload_counter_stats.num_payloads_dropped),
+        "counter is 64 bit");
+    CdiOsAtomicInc64(&endpoint_ptr->transfer_stats.payload_counter_stats.num_payloads_dropped);
+
+    // Build the callback data in place in the queue that sends it to the application.
+    CdiQueueHandle queue_handle = con_state_ptr->rx_state.active_payload_complete_queue_handle;
+    AppPayloadCallbackData* cb_data_ptr = NULL;
+    if (!CdiQueuePushReserve(queue_handle, (void**)&cb_data_ptr)) {
+        CDI_LOG_THREAD(kLogError, "Queue[%s] full, push failed.", CdiQueueGetName(queue_handle));
+        return;
+    }
+
+    memset(cb_data_ptr, 0, sizeof(*cb_data_ptr));
+    cb_data_ptr->payload_status_code = kCdiStatusRxPayloadBackPressure;
     if (0 == decoded_header_ptr->packet_sequence_num) {
-        UpdateApplicationCallbackDataFromCdiPacket0(&cb_data, &decoded_header_ptr->num0_info);
+        UpdateApplicationCallbackDataFromCdiPacket0(cb_data_ptr, &decoded_header_ptr->num0_info);
     }
 
     // If the protocol is AVM and no extra data exist we must at least provide an entry for a stream identifer,
     // otherwise downstream logic will generate an error (since AVM protocol must contain extra data).
-    if (kProtocolTypeAvm == con_state_ptr->protocol_type && 0 == cb_data.extra_data_size) {
-        cb_data.extra_data_size = sizeof(CDIPacketAvmUnion);
-        CDIPacketAvmUnion* avm_union_ptr = (CDIPacketAvmUnion*)cb_data.extra_data_array;
+    if (kProtocolTypeAvm == con_state_ptr->protocol_type && 0 == cb_data_ptr->extra_data_size) {
+        cb_data_ptr->extra_data_size = sizeof(CDIPacketAvmUnion);
+        CDIPacketAvmUnion* avm_union_ptr = (CDIPacketAvmUnion*)cb_data_ptr->extra_data_array;
         avm_union_ptr->common_header.avm_extra_data.stream_identifier = -1; // Unknown stream ID
     }
 
-    // Increment the dropped payload count. This value is also incremented in TxPayloadThread(), so use atomic
-    // operation here.
-    CDI_STATIC_ASSERT(sizeof(uint64_t) == sizeof(endpoint_ptr->transfer_stats.payload_counter_stats.num_payloads_dropped),
-        "counter is 64 bit");
-    CdiOsAtomicInc64(&endpoint_ptr->transfer_stats.payload_counter_stats.num_payloads_dropped);
-
-    // Place the callback data in the queue to be sent to the application.
-    if (!CdiQueuePush(con_state_ptr->rx_state.active_payload_complete_queue_handle, (void*)&cb_data)) {
-        CDI_LOG_THREAD(kLogError, "Queue[%s] full, push failed.",
-                       CdiQueueGetName(con_state_ptr->rx_state.active_payload_complete_queue_handle));
-    }
+    CdiQueuePushCommit(queue_handle);
 }
 
 //*********************************************************************************************************************
@@ -570,6 +679,7 @@ CdiReturnStatus RxCreateInternal(CdiConnectionProtocolType protocol_type, CdiRxC
     con_state_ptr->handle_type = kHandleTypeRx;
     con_state_ptr->protocol_type = protocol_type;
     con_state_ptr->magic = kMagicConnection;
+    con_state_ptr->numa_node = CdiOsGetCpuNumaNode(config_data_ptr->thread_core_num);
     memcpy(&con_state_ptr->rx_state.config_data, config_data_ptr, sizeof *config_data_ptr);
     con_state_ptr->rx_state.cb_ptr = rx_cb_ptr;
     // Now that we have a connection logger, we can use the CDI_LOG_HANDLE() macro to add log messages to it. Since this
@@ -637,39 +747,89 @@ CdiReturnStatus RxCreateInternal(CdiConnectionProtocolType protocol_type, CdiRxC
                                              config_data_ptr->stats_user_cb_param, &config_data_ptr->stats_config);
     }
 
-    int reserve_packet_buffers = MAX_RX_PACKETS_PER_CONNECTION;
-    if (con_state_ptr->rx_state.config_data.buffer_delay_ms) {
+    // Size the packet buffers for the stream described by the resource profile, if one was provided.
+    const CdiResourceProfile* profile_ptr = &config_data_ptr->resource_profile;
+    CdiAdapterTypeSelection adapter_type = con_state_ptr->adapter_state_ptr->adapter_data.adapter_type;
+    int payload_count = profile_ptr->max_in_flight_payloads ? profile_ptr->max_in_flight_payloads : max_rx_payloads;
+    int reserve_packet_buffers = ResourceProfilePacketCount(adapter_type, profile_ptr, payload_count,
+                                                            MAX_RX_PACKETS_PER_CONNECTION);
+    int buffer_delay_ms = con_state_ptr->rx_state.config_data.buffer_delay_ms;
+    if (buffer_delay_ms) {
         // Rx buffer delay is enabled, so we need to allocate additional Rx buffers.
-        reserve_packet_buffers += (MAX_RX_PACKETS_PER_CONNECTION * con_state_ptr->rx_state.config_data.buffer_delay_ms)
-                                  / CDI_RX_BUFFER_DELAY_BUFFER_MS_DIVISOR;
+        int delay_packet_buffers = (MAX_RX_PACKETS_PER_CONNECTION * buffer_delay_ms)
+                                   / CDI_RX_BUFFER_DELAY_BUFFER_MS_DIVISOR;
+        if (profile_ptr->payloads_per_second) {
+            // Make room for the payloads that arrive while the delay holds on to them.
+            int delayed_payload_count = (int)(((uint64_t)profile_ptr->payloads_per_second * buffer_delay_ms + 999)
+                                              / 1000);
+            delay_packet_buffers = ResourceProfilePacketCount(adapter_type, profile_ptr, delayed_payload_count,
+                                                              delay_packet_buffers);
+        }
+        reserve_packet_buffers += delay_packet_buffers;
     }
 
+    // The pools below are mostly used by the poll thread, so allocate them on its NUMA node.
     if (kCdiStatusOk == rs) {
-        if (!CdiPoolCreate("Connection Rx CdiSglEntry Pool", reserve_packet_buffers,
-                           MAX_RX_PACKETS_PER_CONNECTION_GROW, MAX_POOL_GROW_COUNT,
-                           sizeof(CdiSglEntry), true, // true= Make thread-safe
-                           &con_state_ptr->rx_state.payload_sgl_entry_pool_handle)) {
+        // Entries are taken by the poll thread and returned by the application's thread, so use thread caches.
+        if (!CdiPoolCreateOnNumaNode("Connection Rx CdiSglEntry Pool", reserve_packet_buffers,
+                                     MAX_RX_PACKETS_PER_CONNECTION_GROW, MAX_POOL_GROW_COUNT,
+                                     sizeof(CdiSglEntry), kPoolFlagThreadCache | SGL_ENTRY_POOL_FLAGS,
+                                     con_state_ptr->numa_node,
+                                     &con_state_ptr->rx_state.payload_sgl_entry_pool_handle, NULL, NULL)) {
             rs = kCdiStatusNotEnoughMemory;
         }
     }
 
     if (kCdiStatusOk == rs) {
-        if (!CdiPoolCreate("Rx CdiReorderList Out of Order Pool", MAX_RX_OUT_OF_ORDER,
-                           MAX_RX_OUT_OF_ORDER_GROW, MAX_POOL_GROW_COUNT,
-                           sizeof(CdiReorderList), true, // true= Make thread-safe
-                           &con_state_ptr->rx_state.reorder_entries_pool_handle)) {
+        if (!CdiPoolCreateOnNumaNode("Rx CdiReorderList Out of Order Pool", MAX_RX_OUT_OF_ORDER,
+                                     MAX_RX_OUT_OF_ORDER_GROW, MAX_POOL_GROW_COUNT,
+                                     sizeof(CdiReorderList), kPoolFlagThreadSafe | CONNECTION_POOL_FLAGS,
+                                     con_state_ptr->numa_node,
+                                     &con_state_ptr->rx_state.reorder_entries_pool_handle, NULL, NULL)) {
+            rs = kCdiStatusNotEnoughMemory;
+        }
+    }
+
+    if (kCdiStatusOk == rs && kCdiSgl == config_data_ptr->rx_buffer_type && config_data_ptr->bitmap_packet_reorder) {
+        if (!CdiPoolCreateOnNumaNode("Rx Reorder Page Pool", RX_REORDER_PAGE_POOL_SIZE,
+                                     RX_REORDER_PAGE_POOL_SIZE_GROW, MAX_POOL_GROW_COUNT,
+                                     sizeof(RxReorderPage), kPoolFlagThreadSafe | CONNECTION_POOL_FLAGS,
+                                     con_state_ptr->numa_node,
+                                     &con_state_ptr->rx_state.reorder_pages_pool_handle, NULL, NULL)) {
             rs = kCdiStatusNotEnoughMemory;
         }
     }
 
     if (kCdiStatusOk == rs && kCdiLinearBuffer == config_data_ptr->rx_buffer_type) {
         // Allocate an extra couple of buffers for payloads being reassembled.
-        if (!CdiPoolCreate("Rx Linear Buffer Pool", RX_LINEAR_BUFFER_COUNT + 2, NO_GROW_SIZE, NO_GROW_COUNT,
-                           config_data_ptr->linear_buffer_size, true, &con_state_ptr->linear_buffer_pool)) {
+        if (!CdiPoolCreateOnNumaNode("Rx Linear Buffer Pool", RX_LINEAR_BUFFER_COUNT + 2, NO_GROW_SIZE,
+                                     NO_GROW_COUNT, config_data_ptr->linear_buffer_size, kPoolFlagThreadSafe,
+                                     con_state_ptr->numa_node, &con_state_ptr->linear_buffer_pool, NULL, NULL)) {
+            rs = kCdiStatusNotEnoughMemory;
+        }
+    }
+
+    if (kCdiStatusOk == rs && kCdiLinearBuffer == config_data_ptr->rx_buffer_type && config_data_ptr->slice_cb_ptr) {
+        // A payload only needs its slice state while it is reassembled into a linear buffer, so one per buffer.
+        if (!CdiPoolCreateOnNumaNode("Rx Slice State Pool", RX_LINEAR_BUFFER_COUNT + 2, NO_GROW_SIZE, NO_GROW_COUNT,
+                                     sizeof(RxSliceState), kPoolFlagThreadSafe, con_state_ptr->numa_node,
+                                     &con_state_ptr->rx_state.slice_state_pool_handle, NULL, NULL)) {
             rs = kCdiStatusNotEnoughMemory;
         }
     }
 
+    if (kCdiStatusOk == rs && kCdiLinearBuffer == config_data_ptr->rx_buffer_type &&
+        0 != config_data_ptr->copy_thread_count) {
+        if (config_data_ptr->copy_thread_count < 0 || config_data_ptr->copy_thread_count > CDI_MAX_RX_COPY_THREADS) {
+            CDI_LOG_HANDLE(con_state_ptr->log_handle, kLogError, "Invalid copy_thread_count[%d]. Must be 0 to [%d].",
+                           config_data_ptr->copy_thread_count, CDI_MAX_RX_COPY_THREADS);
+            rs = kCdiStatusInvalidParameter;
+        } else {
+            rs = RxCopyEngineCreate(con_state_ptr->log_handle, config_data_ptr->copy_thread_count,
+                                    config_data_ptr->copy_thread_core_num, &con_state_ptr->rx_state.copy_engine_handle);
+        }
+    }
+
     if (kCdiStatusOk == rs) {
         // Set up receive buffer handling if enabled; either way, set payload complete queue to point to the right one.
         if (0 != con_state_ptr->rx_state.config_data.buffer_delay_ms) {
@@ -752,6 +912,9 @@ CdiReturnStatus RxEndpointCreateDynamicPools(CdiEndpointHandle handle)
     // Add one to the maximum value so we get the actual number of entries required.
     int required_size = endpoint_ptr->adapter_endpoint_ptr->protocol_handle->payload_num_max + 1;
 
+    // The statistics threads read the pools, so keep them from doing so while the pools are replaced.
+    StatsResourcesLock(con_state_ptr->stats_state_ptr);
+
     // Payload state pool.
     if (con_state_ptr->rx_state.rx_payload_state_pool_handle) {
         int current_size = CdiPoolGetTotalItemCount(con_state_ptr->rx_state.rx_payload_state_pool_handle);
@@ -761,9 +924,10 @@ CdiReturnStatus RxEndpointCreateDynamicPools(CdiEndpointHandle handle)
         }
     }
     if (NULL == con_state_ptr->rx_state.rx_payload_state_pool_handle) {
-        if (!CdiPoolCreate("Rx Payload State Pool", required_size, NO_GROW_SIZE, NO_GROW_COUNT,
-                           sizeof(RxPayloadState), true,
-                           &con_state_ptr->rx_state.rx_payload_state_pool_handle)) {
+        if (!CdiPoolCreateOnNumaNode("Rx Payload State Pool", required_size, NO_GROW_SIZE, NO_GROW_COUNT,
+                                     sizeof(RxPayloadState), kPoolFlagThreadSafe | CONNECTION_POOL_FLAGS,
+                                     con_state_ptr->numa_node,
+                                     &con_state_ptr->rx_state.rx_payload_state_pool_handle, NULL, NULL)) {
             rs = kCdiStatusNotEnoughMemory;
         }
     }
@@ -778,14 +942,17 @@ CdiReturnStatus RxEndpointCreateDynamicPools(CdiEndpointHandle handle)
             }
         }
         if (NULL == con_state_ptr->rx_state.payload_memory_state_pool_handle) {
-            if (!CdiPoolCreate("Connection Rx CdiMemoryState Pool", required_size, NO_GROW_SIZE, NO_GROW_COUNT,
-                            sizeof(CdiMemoryState), true, // true= Make thread-safe
-                            &con_state_ptr->rx_state.payload_memory_state_pool_handle)) {
+            if (!CdiPoolCreateOnNumaNode("Connection Rx CdiMemoryState Pool", required_size, NO_GROW_SIZE,
+                                         NO_GROW_COUNT, sizeof(CdiMemoryState), kPoolFlagThreadSafe,
+                                         con_state_ptr->numa_node,
+                                         &con_state_ptr->rx_state.payload_memory_state_pool_handle, NULL, NULL)) {
                 rs = kCdiStatusNotEnoughMemory;
             }
         }
     }
 
+    StatsResourcesUnlock(con_state_ptr->stats_state_ptr);
+
     return rs;
 }
 
@@ -810,9 +977,13 @@ void RxEndpointFlushResources(CdiEndpointState* endpoint_ptr)
         }
         endpoint_ptr->rx_state.rxreorder_buffered_packet_count = 0; // Reset packet count window.
 
+        // Return the packet buffers of any copies still held by the copy threads.
+        RxCopiesWait(endpoint_ptr->connection_state_ptr);
+
         // Entries used by the connection pools below are not freed here. They are either freed in the logic above or
         // by the application:
         //   rx_state.reorder_entries_pool_handle
+        //   rx_state.reorder_pages_pool_handle
         //   rx_state.payload_sgl_entry_pool_handle
         //   rx_state.payload_memory_state_pool_handle
 
@@ -841,11 +1012,25 @@ void RxConnectionDestroyInternal(CdiConnectionHandle con_handle)
         RxBufferDestroy(con_state_ptr->rx_state.receive_buffer_handle);
         con_state_ptr->rx_state.receive_buffer_handle = NULL;
 
+        // The copy threads write to the linear buffers, so stop them before freeing the buffers.
+        RxCopyEngineDestroy(con_state_ptr->rx_state.copy_engine_handle);
+        con_state_ptr->rx_state.copy_engine_handle = NULL;
+
+        // Destroying the connection, so ensure all pool entries are freed.
+        CdiPoolPutAll(con_state_ptr->rx_state.slice_state_pool_handle);
+        CdiPoolDestroy(con_state_ptr->rx_state.slice_state_pool_handle);
+        con_state_ptr->rx_state.slice_state_pool_handle = NULL;
+
         // Destroying the connection, so ensure all pool entries are freed.
         CdiPoolPutAll(con_state_ptr->linear_buffer_pool);
         CdiPoolDestroy(con_state_ptr->linear_buffer_pool);
         con_state_ptr->linear_buffer_pool = NULL;
 
+        // Destroying the connection, so ensure all pool entries are freed.
+        CdiPoolPutAll(con_state_ptr->rx_state.reorder_pages_pool_handle);
+        CdiPoolDestroy(con_state_ptr->rx_state.reorder_pages_pool_handle);
+        con_state_ptr->rx_state.reorder_pages_pool_handle = NULL;
+
         // Destroying the connection, so ensure all pool entries are freed.
         CdiPoolPutAll(con_state_ptr->rx_state.reorder_entries_pool_handle);
         CdiPoolDestroy(con_state_ptr->rx_state.reorder_entries_pool_handle);
@@ -966,16 +1151,19 @@ void RxPacketReceive(void* param_ptr, Packet* packet_ptr, EndpointMessageType me
                 // The packet reordering logic does not need to be invoked if the connection was configured for a linear
                 // receive buffer.
                 still_ok = RxReorderPacket(protocol_handle, con_state_ptr->rx_state.payload_sgl_entry_pool_handle,
-                                           con_state_ptr->rx_state.reorder_entries_pool_handle, payload_state_ptr,
+                                           con_state_ptr->rx_state.reorder_entries_pool_handle,
+                                           con_state_ptr->rx_state.reorder_pages_pool_handle, payload_state_ptr,
                                            &packet_ptr->sg_list, cdi_header_size, packet_sequence_num);
             }
         }
     }
 
+    bool packet_posted = false; // True if a copy thread owns the packet's SGL.
     if (still_ok && kCdiLinearBuffer == con_state_ptr->rx_state.config_data.rx_buffer_type) {
         assert(NULL != payload_state_ptr->linear_buffer_ptr);
         // Gather this packet into the linear receive buffer.
-        still_ok = CopyToLinearBuffer(con_state_ptr, packet_ptr, payload_state_ptr, &decoded_header);
+        still_ok = CopyToLinearBuffer(con_state_ptr, endpoint_ptr, packet_ptr, payload_state_ptr, &decoded_header,
+                                      &packet_posted);
     }
 
     if (!still_ok && payload_state_ptr &&
@@ -988,7 +1176,10 @@ void RxPacketReceive(void* param_ptr, Packet* packet_ptr, EndpointMessageType me
     if (still_ok && kPayloadInProgress == payload_state_ptr->payload_state &&
         payload_state_ptr->data_bytes_received >= payload_state_ptr->expected_payload_data_size) {
         // The entire payload has been received, so finalize it and add it to the payload reordering list in the correct
-        // order.
+        // order. Copy threads may still be writing to its linear buffer, so wait for them first.
+        RxCopiesWait(con_state_ptr);
+        // All of the payload's data has arrived, so no more slices are reported for it.
+        SliceStateFree(con_state_ptr, payload_state_ptr);
         still_ok = FinalizePayload(con_state_ptr, payload_state_ptr);
         payload_state_ptr->payload_state = kPayloadComplete;
         if (still_ok) {
@@ -1010,7 +1201,7 @@ void RxPacketReceive(void* param_ptr, Packet* packet_ptr, EndpointMessageType me
         // CdiAdapterFreeBuffer().
         // NOTE: The size of the endpoint SGL list is updated in SglMoveEntries().
         SglMoveEntries(&payload_memory_state_ptr->endpoint_packet_buffer_sgl, &packet_ptr->sg_list);
-    } else {
+    } else if (!packet_posted) {
         // The SGL passed in to the function was not consumed. Send it back to the adapter now.
         CdiAdapterFreeBuffer(endpoint_ptr->adapter_endpoint_ptr, &packet_ptr->sg_list);
     }
@@ -1032,29 +1223,115 @@ void RxPacketReceive(void* param_ptr, Packet* packet_ptr, EndpointMessageType me
 }
 
 void RxSendPayload(CdiEndpointState* endpoint_ptr, RxPayloadState* payload_state_ptr)
+{
+    RxSendPayloads(endpoint_ptr, &payload_state_ptr, 1);
+}
+
+void RxSendPayloads(CdiEndpointState* endpoint_ptr, RxPayloadState** payload_state_array, int payload_count)
 {
     CdiConnectionState* con_state_ptr = endpoint_ptr->connection_state_ptr;
+    CdiQueueHandle queue_handle = con_state_ptr->rx_state.active_payload_complete_queue_handle;
+    int pushed_count = 0;
 
-    // Update payload statistics data.
-    UpdatePayloadStats(endpoint_ptr, &payload_state_ptr->work_request_state);
+    assert(payload_count > 0 && payload_count <= MAX_QUEUE_BATCH_ITEM_COUNT);
+    for (int i = 0; i < payload_count; i++) {
+        // Update payload statistics data.
+        UpdatePayloadStats(endpoint_ptr, &payload_state_array[i]->work_request_state);
+    }
+
+    // Add the Rx payload SGL messages to the AppCallbackPayloadThread() queue. The callback data is copied straight
+    // into the queue's storage and the payloads are made visible to the consumer with a single commit, unless the
+    // queue has to move on to another segment part way through. Reserving then fails until the payloads reserved so
+    // far are committed.
+    AppPayloadCallbackData* cb_data_ptr = NULL;
+    while (pushed_count < payload_count) {
+        int reserved_count = 0;
+        while (pushed_count + reserved_count < payload_count &&
+               CdiQueuePushReserve(queue_handle, (void**)&cb_data_ptr)) {
+            *cb_data_ptr = payload_state_array[pushed_count + reserved_count]->work_request_state.app_payload_cb_data;
+            reserved_count++;
+        }
+        if (0 == reserved_count) {
+            break; // Queue is full.
+        }
+        CdiQueuePushCommit(queue_handle);
+        pushed_count += reserved_count;
+    }
 
-    // Add the Rx payload SGL message to the AppCallbackPayloadThread() queue.
-    if (!CdiQueuePush(con_state_ptr->rx_state.active_payload_complete_queue_handle,
-                      (void*)&payload_state_ptr->work_request_state.app_payload_cb_data)) {
-        CDI_LOG_THREAD(kLogError, "[%s] full, payload push failed.  Application callback might be too slow.",
-                       CdiQueueGetName(con_state_ptr->rx_state.active_payload_complete_queue_handle));
+    for (int i = 0; i < payload_count; i++) {
+        RxPayloadState* payload_state_ptr = payload_state_array[i];
+        if (i >= pushed_count) {
+            CDI_LOG_THREAD(kLogError, "[%s] full, payload push failed.  Application callback might be too slow.",
+                           CdiQueueGetName(queue_handle));
 
-        // If payload is in state kPayloadComplete, its resources need to be freed. If in one of the other states, the
-        // payload's resources have already been freed or no resources have been allocated.
-        if (payload_state_ptr->payload_state == kPayloadComplete) {
-            RxFreePayloadResources(endpoint_ptr, payload_state_ptr, true);
+            // If payload is in state kPayloadComplete, its resources need to be freed. If in one of the other states,
+            // the payload's resources have already been freed or no resources have been allocated.
+            if (payload_state_ptr->payload_state == kPayloadComplete) {
+                RxFreePayloadResources(endpoint_ptr, payload_state_ptr, true);
+            }
+            PayloadErrorFreeBuffer(con_state_ptr->error_message_pool,
+                                   &payload_state_ptr->work_request_state.app_payload_cb_data);
+        } else {
+            // Queue passes a copy of app_payload_cb_data to AppCallbackPayloadThread(), which frees the buffer. So
+            // set the pointer to NULL here, so it doesn't get re-used.
+            payload_state_ptr->work_request_state.app_payload_cb_data.error_message_str = NULL;
         }
-        PayloadErrorFreeBuffer(con_state_ptr->error_message_pool,
-                               &payload_state_ptr->work_request_state.app_payload_cb_data);
-    } else {
-        // Queue passes a copy of app_payload_cb_data to AppCallbackPayloadThread(), which frees the buffer. So
-        // set the pointer to NULL here, so it doesn't get re-used.
-        payload_state_ptr->work_request_state.app_payload_cb_data.error_message_str = NULL;
+    }
+}
+
+void RxSlicePacketCopied(CdiConnectionState* con_state_ptr, RxPayloadState* payload_state_ptr,
+                         int packet_sequence_num, int end_offset)
+{
+    RxSliceState* slice_state_ptr = payload_state_ptr->slice_state_ptr;
+
+    // Packets of a payload in error are not reported. Neither are packets of a payload whose packet #0 has not arrived
+    // yet, but they are tracked since the contiguous data can't grow until it arrives.
+    if (kPayloadInProgress != payload_state_ptr->payload_state &&
+        kPayloadPacketZeroPending != payload_state_ptr->payload_state) {
+        return;
+    }
+
+    // Sequence numbers are 16 bits, so they wrap in payloads of more than 65536 packets. Every packet that is copied
+    // follows the contiguous data, so the distance to it is taken modulo 65536.
+    const int distance = (packet_sequence_num - slice_state_ptr->next_sequence_num) & UINT16_MAX;
+    if (slice_state_ptr->window_overflow) {
+        return;
+    }
+    if (distance >= RX_SLICE_WINDOW_PACKET_COUNT) {
+        // Too far ahead to remember, so the contiguous data can't grow past this packet's predecessor.
+        slice_state_ptr->window_overflow = true;
+        return;
+    }
+    slice_state_ptr->end_offset_array[packet_sequence_num % RX_SLICE_WINDOW_PACKET_COUNT] = end_offset;
+
+    // Advance past every packet that has been copied. Packets always hold at least one byte of data, so their end
+    // offset is never zero.
+    int* end_offset_ptr = &slice_state_ptr->end_offset_array[slice_state_ptr->next_sequence_num %
+                                                               RX_SLICE_WINDOW_PACKET_COUNT];
+    while (*end_offset_ptr) {
+        slice_state_ptr->contiguous_size = *end_offset_ptr;
+        *end_offset_ptr = 0;
+        slice_state_ptr->next_sequence_num = (slice_state_ptr->next_sequence_num + 1) & UINT16_MAX;
+        end_offset_ptr = &slice_state_ptr->end_offset_array[slice_state_ptr->next_sequence_num %
+                                                             RX_SLICE_WINDOW_PACKET_COUNT];
+    }
+
+    // The data that completes the payload is reported by the Rx callback instead.
+    const CdiRxConfigData* config_data_ptr = &con_state_ptr->rx_state.config_data;
+    const int new_size = slice_state_ptr->contiguous_size - slice_state_ptr->reported_size;
+    if (kPayloadInProgress == payload_state_ptr->payload_state && new_size > 0 &&
+        new_size >= config_data_ptr->slice_size &&
+        slice_state_ptr->contiguous_size < payload_state_ptr->expected_payload_data_size) {
+        CdiCoreRxSliceCbData cb_data = {
+            .connection_handle = (CdiConnectionHandle)con_state_ptr,
+            .core_extra_data = payload_state_ptr->work_request_state.app_payload_cb_data.core_extra_data,
+            .payload_buffer_ptr = payload_state_ptr->linear_buffer_ptr,
+            .slice_offset = slice_state_ptr->reported_size,
+            .slice_size = new_size,
+            .slice_user_cb_param = config_data_ptr->slice_user_cb_param
+        };
+        (config_data_ptr->slice_cb_ptr)(&cb_data);
+        slice_state_ptr->reported_size = slice_state_ptr->contiguous_size;
     }
 }
 
@@ -1064,6 +1341,10 @@ void RxFreePayloadResources(CdiEndpointState* endpoint_ptr, RxPayloadState* payl
     CdiConnectionState* con_state_ptr = endpoint_ptr->connection_state_ptr;
     CdiSgList* payload_sgl_ptr = &payload_state_ptr->work_request_state.app_payload_cb_data.payload_sgl;
 
+    // Copy threads may still be writing to the payload's linear buffer, so wait for them before freeing it.
+    RxCopiesWait(con_state_ptr);
+    SliceStateFree(con_state_ptr, payload_state_ptr);
+
     // Free adapter Rx packet buffer resources.
     CdiMemoryState* memory_state_ptr = (CdiMemoryState*)payload_sgl_ptr->internal_data_ptr;
     if (memory_state_ptr) {
@@ -1081,10 +1362,9 @@ void RxFreePayloadResources(CdiEndpointState* endpoint_ptr, RxPayloadState* payl
     }
 
     // Free Rx-reorder lists.
-    RxReorderPacketFreeLists(payload_state_ptr->reorder_list_ptr,
-                             con_state_ptr->rx_state.payload_sgl_entry_pool_handle,
-                             con_state_ptr->rx_state.reorder_entries_pool_handle);
-    payload_state_ptr->reorder_list_ptr = NULL; // List freed and no longer valid, so clear it.
+    RxReorderPacketFreeLists(payload_state_ptr, con_state_ptr->rx_state.payload_sgl_entry_pool_handle,
+                             con_state_ptr->rx_state.reorder_entries_pool_handle,
+                             con_state_ptr->rx_state.reorder_pages_pool_handle);
 
     // Clear SGL sent to application's Rx callback. Don't clear internal_data_ptr here (see logic above).
     app_payload_cb_data_ptr->payload_sgl.sgl_head_ptr = NULL;
@@ -82,6 +82,30 @@ void RxPacketReceive(void* param_ptr, Packet* packet_ptr, EndpointMessageType me
  */
 void RxSendPayload(CdiEndpointState* endpoint_ptr, RxPayloadState* send_payload_state_ptr);
 
+/**
+ * Send multiple payloads on to the next stage because they are complete or determined to be in error. The payloads are
+ * pushed to the next stage's queue with a single CdiQueuePushMultiple(), so its consumer is signaled at most once.
+ *
+ * @param endpoint_ptr Pointer to endpoint state structure.
+ * @param payload_state_array Array of pointers to the payload states, in the order they are to be sent.
+ * @param payload_count Number of payloads in the array. Must not exceed MAX_QUEUE_BATCH_ITEM_COUNT.
+ */
+void RxSendPayloads(CdiEndpointState* endpoint_ptr, RxPayloadState** payload_state_array, int payload_count);
+
+/**
+ * Records that a packet of a payload being received into a linear buffer has been copied to it. If this extends the
+ * data received at the start of the payload by at least CdiRxConfigData.slice_size bytes, the new data is reported to
+ * the application's slice callback, unless it completes the payload. Must only be used if the payload has slice state
+ * (RxPayloadState.slice_state_ptr is not NULL).
+ *
+ * @param con_state_ptr Pointer to connection state structure.
+ * @param payload_state_ptr Pointer to the payload the packet belongs to.
+ * @param packet_sequence_num Sequence number of the packet, as carried by its 16-bit header field.
+ * @param end_offset Offset in bytes of the end of the packet's data within the payload.
+ */
+void RxSlicePacketCopied(CdiConnectionState* con_state_ptr, RxPayloadState* payload_state_ptr,
+                         int packet_sequence_num, int end_offset);
+
 /**
  * Free payload resources.
  *
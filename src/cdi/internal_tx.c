@@ -15,6 +15,7 @@
 
 #include "internal_tx.h"
 
+#include <assert.h>
 #include <string.h>
 
 #include "cdi_queue_api.h"
@@ -28,6 +29,38 @@
 //***************************************** START OF DEFINITIONS AND TYPES ********************************************
 //*********************************************************************************************************************
 
+/**
+ * @brief State of the payloads of one endpoint of a connection that TxPayloadThread() is sending. Each endpoint that
+ * has payloads to send uses its own lane, which holds the endpoint's payloads in the order they were sent and the
+ * packetizer state of the one being sent. TxPayloadThread() gives a lane a turn to packetize and enqueue a batch of
+ * packets, choosing the lane by priority and deadline (see TxEndpointLaneNext()), so a large payload (such as a video
+ * frame) does not delay the payloads of the connection's other endpoints (such as audio) until all of its packets have
+ * been queued.
+ */
+typedef struct {
+    CdiEndpointHandle endpoint_handle;       ///< Endpoint using this lane. NULL if the lane is not in use.
+    CdiTxPriority priority;                  ///< Priority of the endpoint using this lane.
+    CdiSinglyLinkedList payload_list;        ///< Payloads waiting to be sent (TxPayloadState list_entry).
+    CdiPacketizerStateHandle packetizer_state_handle; ///< Packetizer state of the payload being sent.
+
+    /// Processing state of the payload being sent. See TxEndpointLaneRun() for details.
+    enum {
+        kPayloadStateIdle,           ///< No payload is in process: get the next one from payload_list.
+        kPayloadStateWorkReceived,   ///< A payload was received to be transmitted: initialize for first packet.
+        kPayloadStateGetWorkRequest, ///< Payload and packetizer initialized: get a work request from pool.
+        kPayloadStatePacketizing,    ///< Have work request: build SGL.
+        kPayloadStateEnqueuing       ///< Have completed list of work requests: queued to the adapter.
+    } payload_processing_state;
+
+    TxPayloadState* payload_state_ptr;       ///< Payload being sent. NULL if kPayloadStateIdle.
+    TxPacketWorkRequest* work_request_ptr;   ///< Work request of the packet being built.
+    CdiSinglyLinkedList packet_list;         ///< Packets built for the current batch that have not been enqueued.
+    int batch_size;                          ///< Number of packets in the current batch.
+    uint64_t pacing_bytes_per_second;        ///< Pacing rate of the payload being sent. 0 if not paced.
+    uint64_t paced_until_time;               ///< Earliest time the pacer can have sent the lane's queued packets.
+    bool last_packet;                        ///< True if the last packet of the payload has been built.
+} TxEndpointLane;
+
 //*********************************************************************************************************************
 //*********************************************** START OF VARIABLES **************************************************
 //*********************************************************************************************************************
@@ -115,6 +148,66 @@ static void PutWorkRequestInPool(CdiConnectionState* con_state_ptr, TxPacketWork
     CdiPoolPut(con_state_ptr->tx_state.work_request_pool_handle, work_request_ptr);
 }
 
+/**
+ * Payload transfer has completed either successfully or in error. Update stats and queue payload message to
+ * application.
+ *
+ * @param endpoint_ptr Pointer to endpoint state data.
+ * @param payload_state_ptr Pointer to payload state data. The pointer is no longer valid after function returns.
+ */
+static void PayloadTransferComplete(CdiEndpointState* endpoint_ptr, TxPayloadState* payload_state_ptr)
+{
+    CdiConnectionState* con_state_ptr = (CdiConnectionState*)endpoint_ptr->connection_state_ptr;
+
+    StatsGatherPayloadStatsFromConnection(endpoint_ptr,
+        kCdiStatusOk == payload_state_ptr->app_payload_cb_data.payload_status_code,
+        payload_state_ptr->start_time, payload_state_ptr->max_latency_microsecs,
+        payload_state_ptr->data_bytes_transferred);
+
+    // Copy the payload's source SGL to the callback data, so we can free the SGL entries in AppCallbackPayloadThread()
+    // to reduce the amount of work required here by the Tx Poll() thread. This also allows the payload_state_ptr to
+    // be freed in this function, since it is no longer needed.
+    payload_state_ptr->app_payload_cb_data.tx_source_sgl = payload_state_ptr->source_sgl;
+
+    // Post message to notify application that payload transfer has completed.
+    if (!CdiQueuePush(con_state_ptr->app_payload_message_queue_handle, &payload_state_ptr->app_payload_cb_data)) {
+        CDI_LOG_THREAD(kLogError, "Queue[%s] full, push failed.",
+                        CdiQueueGetName(con_state_ptr->app_payload_message_queue_handle));
+
+        // Since queue was full, need to free the resources associated with the payload.
+        FreeSglEntries(con_state_ptr->tx_state.payload_sgl_entry_pool_handle,
+                       payload_state_ptr->app_payload_cb_data.tx_source_sgl.sgl_head_ptr);
+        // If error message exists, return it to pool.
+        PayloadErrorFreeBuffer(con_state_ptr->error_message_pool, &payload_state_ptr->app_payload_cb_data);
+    }
+
+    // Done with payload state data, so free it.
+    CdiPoolPut(con_state_ptr->tx_state.payload_state_pool_handle, payload_state_ptr);
+}
+
+/**
+ * Return the rate at which the packets of a payload are to be sent. See CdiTxPacingConfig.
+ *
+ * @param pacing_ptr Pointer to the connection's pacing configuration.
+ * @param payload_state_ptr Pointer to the payload's state.
+ *
+ * @return Rate in bytes per second, or 0 if the payload's packets are not paced.
+ */
+static uint64_t GetPacingRate(const CdiTxPacingConfig* pacing_ptr, const TxPayloadState* payload_state_ptr)
+{
+    uint64_t rate = pacing_ptr->rate_bits_per_second / 8;
+    uint64_t spread_time = (uint64_t)payload_state_ptr->max_latency_microsecs * pacing_ptr->latency_percent / 100;
+    if (spread_time) {
+        // Rate that sends the payload's data within spread_time. Packet headers are not included, so the last packet
+        // is sent slightly later.
+        uint64_t spread_rate = (uint64_t)payload_state_ptr->source_sgl.total_data_size * 1000000 / spread_time;
+        if (spread_rate > rate) {
+            rate = spread_rate;
+        }
+    }
+    return rate;
+}
+
 /**
  * Pop all items in the work request completion queue freeing resources associated with each one.
  *
@@ -122,30 +215,519 @@ static void PutWorkRequestInPool(CdiConnectionState* con_state_ptr, TxPacketWork
  */
 static void ProcessWorkRequestCompletionQueue(CdiConnectionState* con_state_ptr)
 {
-    CdiSinglyLinkedList packet_list = { 0 };
-    while (CdiQueuePop(con_state_ptr->tx_state.work_req_comp_queue_handle, (void*)&packet_list)) {
+    // Work requests and headers are collected in arrays and put back into their pools with bulk operations.
+    // NOTE: These pools are not thread-safe, so must ensure that only one thread is accessing them at a time.
+    CdiPoolHandle work_request_pool_handle = con_state_ptr->tx_state.work_request_pool_handle;
+    CdiPoolHandle header_pool_handle = con_state_ptr->adapter_connection_ptr->tx_header_pool_handle;
+    void* work_request_array[MAX_TX_WORK_REQUEST_PUT_BATCH_SIZE];
+    void* header_array[MAX_TX_WORK_REQUEST_PUT_BATCH_SIZE];
+    int work_request_count = 0;
+    int header_count = 0;
+
+    CdiSinglyLinkedList packet_list_array[MAX_QUEUE_BATCH_ITEM_COUNT];
+    int list_count = 0;
+    while (0 != (list_count = CdiQueuePopMultiple(con_state_ptr->tx_state.work_req_comp_queue_handle,
+                                                  packet_list_array, CDI_ARRAY_ELEMENT_COUNT(packet_list_array)))) {
         // Free resources used by the packets that are no longer needed.
+        for (int i = 0; i < list_count; i++) {
+            CdiSinglyLinkedList* packet_list_ptr = &packet_list_array[i];
+            for (void* item_ptr = CdiSinglyLinkedListPopHead(packet_list_ptr) ; NULL != item_ptr ;
+                 item_ptr = CdiSinglyLinkedListPopHead(packet_list_ptr)) {
+                Packet* packet_ptr = CONTAINER_OF(item_ptr, Packet, list_entry);
+                TxPacketWorkRequest* work_request_ptr = (TxPacketWorkRequest*)packet_ptr->sg_list.internal_data_ptr;
+
+                // Headers with extra data are only used by the first packet of some payloads, so put those back one
+                // at a time.
+                if (work_request_ptr->union_ptr) {
+                    if (header_pool_handle == work_request_ptr->header_pool_handle) {
+                        header_array[header_count++] = work_request_ptr->union_ptr;
+                    } else {
+                        CdiPoolPut(work_request_ptr->header_pool_handle, work_request_ptr->union_ptr);
+                    }
+                    work_request_ptr->header_pool_handle = NULL;
+                    work_request_ptr->union_ptr = NULL;
+                }
+
+                // Its packet SGL entries are embedded, so they go back along with the work request.
+                work_request_array[work_request_count++] = work_request_ptr;
+                if (CDI_ARRAY_ELEMENT_COUNT(work_request_array) == work_request_count) {
+                    CdiPoolPutMultiple(header_pool_handle, header_count, header_array);
+                    CdiPoolPutMultiple(work_request_pool_handle, work_request_count, work_request_array);
+                    header_count = 0;
+                    work_request_count = 0;
+                }
+            }
+        }
+    }
+
+    CdiPoolPutMultiple(header_pool_handle, header_count, header_array);
+    CdiPoolPutMultiple(work_request_pool_handle, work_request_count, work_request_array);
+}
+
+/**
+ * Return the lane used by the specified endpoint. If the endpoint does not have a lane, an unused one is assigned to it.
+ *
+ * @param lane_array Array of CDI_MAX_ENDPOINTS_PER_CONNECTION lanes.
+ * @param endpoint_handle Handle of the endpoint.
+ *
+ * @return Pointer to the endpoint's lane.
+ */
+static TxEndpointLane* TxEndpointLaneGet(TxEndpointLane* lane_array, CdiEndpointHandle endpoint_handle)
+{
+    TxEndpointLane* unused_lane_ptr = NULL;
+    for (int i = 0; i < CDI_MAX_ENDPOINTS_PER_CONNECTION; i++) {
+        if (endpoint_handle == lane_array[i].endpoint_handle) {
+            return &lane_array[i];
+        }
+        if (NULL == unused_lane_ptr && NULL == lane_array[i].endpoint_handle) {
+            unused_lane_ptr = &lane_array[i];
+        }
+    }
+
+    // A connection has at most CDI_MAX_ENDPOINTS_PER_CONNECTION endpoints, so an unused lane must be available.
+    assert(NULL != unused_lane_ptr);
+    unused_lane_ptr->endpoint_handle = endpoint_handle;
+    unused_lane_ptr->priority = endpoint_handle->tx_priority;
+    unused_lane_ptr->paced_until_time = 0;
+    return unused_lane_ptr;
+}
 
-        for (void* item_ptr = CdiSinglyLinkedListPopHead(&packet_list) ; NULL != item_ptr ;
-             item_ptr = CdiSinglyLinkedListPopHead(&packet_list)) {
-            Packet* packet_ptr = CONTAINER_OF(item_ptr, Packet, list_entry);
-            TxPacketWorkRequest* work_request_ptr = (TxPacketWorkRequest*)packet_ptr->sg_list.internal_data_ptr;
-
-            CdiSglEntry* packet_entry_hdr_ptr = work_request_ptr->packet.sg_list.sgl_head_ptr;
-#ifdef USE_MEMORY_POOL_APPENDED_LISTS
-            // Since we used CdiPoolGetAppend(), all the pool entries are linked to the first entry and are freed with a
-            // single call to CdiPoolPut().
-            CdiPoolPut(con_state_ptr->tx_state.packet_sgl_entry_pool_handle, packet_entry_hdr_ptr);
-#else
-            // Put back SGL entry for each one in the list.
-            FreeSglEntries(con_state_ptr->tx_state.packet_sgl_entry_pool_handle, packet_entry_hdr_ptr);
+/**
+ * Return the deadline of a lane's payload in progress or, if none is in progress, of the next payload in its list. The
+ * deadline is the time the payload was sent plus its maximum latency, so payloads sent with a maximum latency of 0
+ * are ordered by the time they were sent.
+ *
+ * @param lane_ptr Pointer to a lane that has at least one payload.
+ *
+ * @return Deadline in microseconds.
+ */
+static uint64_t TxEndpointLaneDeadline(TxEndpointLane* lane_ptr)
+{
+    TxPayloadState* payload_state_ptr = lane_ptr->payload_state_ptr;
+    if (NULL == payload_state_ptr) {
+        CdiSinglyLinkedListEntry* entry_ptr = CdiSinglyLinkedListGetHead(&lane_ptr->payload_list);
+        payload_state_ptr = CONTAINER_OF(entry_ptr, TxPayloadState, list_entry);
+    }
+    return payload_state_ptr->start_time + payload_state_ptr->max_latency_microsecs;
+}
+
+/**
+ * Return the lane that should get the next turn. Lanes of higher priority endpoints are chosen first and lanes of
+ * endpoints with the same priority are chosen in order of the deadline of their next payload. Lanes that have run out of
+ * payloads are made available to other endpoints.
+ *
+ * @param lane_array Array of CDI_MAX_ENDPOINTS_PER_CONNECTION lanes.
+ * @param tried_mask_ptr Pointer to a bit mask of the lanes that have already had a turn without making progress. The
+ *                       bit of the returned lane is set.
+ *
+ * @return Pointer to the lane, or NULL if no lane that has not been tried has any payloads.
+ */
+static TxEndpointLane* TxEndpointLaneNext(TxEndpointLane* lane_array, uint32_t* tried_mask_ptr)
+{
+    TxEndpointLane* next_lane_ptr = NULL;
+    uint64_t next_deadline = 0;
+    int next_index = 0;
+    for (int i = 0; i < CDI_MAX_ENDPOINTS_PER_CONNECTION; i++) {
+        TxEndpointLane* lane_ptr = &lane_array[i];
+        if (NULL == lane_ptr->endpoint_handle || (*tried_mask_ptr & (1 << i))) {
+            continue;
+        }
+        if (NULL == lane_ptr->payload_state_ptr && CdiSinglyLinkedListIsEmpty(&lane_ptr->payload_list)) {
+            // Nothing left to send, so make the lane available to other endpoints.
+            lane_ptr->endpoint_handle = NULL;
+            continue;
+        }
+        uint64_t deadline = TxEndpointLaneDeadline(lane_ptr);
+        if (NULL == next_lane_ptr || lane_ptr->priority > next_lane_ptr->priority ||
+            (lane_ptr->priority == next_lane_ptr->priority && deadline < next_deadline)) {
+            next_lane_ptr = lane_ptr;
+            next_deadline = deadline;
+            next_index = i;
+        }
+    }
+    if (next_lane_ptr) {
+        *tried_mask_ptr |= 1 << next_index;
+    }
+    return next_lane_ptr;
+}
+
+/**
+ * Reset all lanes to their unused state. Called when the Endpoint Manager has flushed (or queued to be flushed) the
+ * connection's Tx resources, which include the payloads held by the lanes.
+ *
+ * @param lane_array Array of CDI_MAX_ENDPOINTS_PER_CONNECTION lanes.
+ */
+static void TxEndpointLanesReset(TxEndpointLane* lane_array)
+{
+    for (int i = 0; i < CDI_MAX_ENDPOINTS_PER_CONNECTION; i++) {
+        TxEndpointLane* lane_ptr = &lane_array[i];
+        lane_ptr->endpoint_handle = NULL;
+        CdiSinglyLinkedListInit(&lane_ptr->payload_list);
+        lane_ptr->payload_processing_state = kPayloadStateIdle;
+        lane_ptr->payload_state_ptr = NULL;
+        lane_ptr->work_request_ptr = NULL;
+        CdiSinglyLinkedListInit(&lane_ptr->packet_list);
+        lane_ptr->paced_until_time = 0;
+    }
+}
+
+/**
+ * Return the earliest time the pacer can have sent a payload's packets if it is started now, after the packets the
+ * lane has already queued. A pacer that is idle can send its first burst at once. If the payload's packets are not
+ * paced, the time can't be known so the current time is returned.
+ *
+ * @param con_state_ptr Pointer to connection state data.
+ * @param lane_ptr Pointer to the lane of the payload.
+ * @param payload_state_ptr Pointer to the state of the payload.
+ * @param current_time Current time in microseconds.
+ *
+ * @return Time in microseconds.
+ */
+static uint64_t TxEndpointLanePacedUntil(const CdiConnectionState* con_state_ptr, const TxEndpointLane* lane_ptr,
+                                         const TxPayloadState* payload_state_ptr, uint64_t current_time)
+{
+    const CdiTxPacingConfig* pacing_ptr = &con_state_ptr->tx_state.config_data.pacing;
+    uint64_t rate = GetPacingRate(pacing_ptr, payload_state_ptr);
+    if (0 == rate) {
+        return current_time;
+    }
+    uint64_t byte_count = (uint64_t)payload_state_ptr->source_sgl.total_data_size;
+    uint64_t start_time = lane_ptr->paced_until_time;
+    if (start_time <= current_time) {
+        start_time = current_time;
+        byte_count = (byte_count > pacing_ptr->burst_bytes) ? byte_count - pacing_ptr->burst_bytes : 0;
+    }
+    return start_time + byte_count * 1000000 / rate;
+}
+
+/**
+ * Return true if two payloads sent to the same endpoint belong to the same stream. Payloads of an AVM connection carry
+ * the identifier of their stream in their extra data. Other connections send a single stream to each endpoint.
+ *
+ * @param con_state_ptr Pointer to connection state data.
+ * @param payload_state_ptr Pointer to the state of one payload.
+ * @param other_payload_state_ptr Pointer to the state of the other payload.
+ *
+ * @return true if the payloads belong to the same stream.
+ */
+static bool TxPayloadIsSameStream(const CdiConnectionState* con_state_ptr, const TxPayloadState* payload_state_ptr,
+                                  const TxPayloadState* other_payload_state_ptr)
+{
+    if (kProtocolTypeAvm != con_state_ptr->protocol_type) {
+        return true;
+    }
+    const CDIPacketAvmUnion* avm_union_ptr =
+        (const CDIPacketAvmUnion*)payload_state_ptr->app_payload_cb_data.extra_data_array;
+    const CDIPacketAvmUnion* other_avm_union_ptr =
+        (const CDIPacketAvmUnion*)other_payload_state_ptr->app_payload_cb_data.extra_data_array;
+    return avm_union_ptr->common_header.avm_extra_data.stream_identifier ==
+           other_avm_union_ptr->common_header.avm_extra_data.stream_identifier;
+}
+
+/**
+ * Return true if a payload that is about to be started should be skipped, as configured by the connection's
+ * CdiTxStalePayloadConfig. A payload is late if it cannot be sent before its deadline, even if it was sent at once or,
+ * if it is paced, after the packets queued ahead of it (see TxEndpointLanePacedUntil()). A payload is superseded if a
+ * newer payload of the same stream is waiting in its lane.
+ *
+ * @param con_state_ptr Pointer to connection state data.
+ * @param lane_ptr Pointer to the lane of the payload. The payload must already have been removed from its list.
+ * @param payload_state_ptr Pointer to the state of the payload.
+ *
+ * @return true if the payload is stale and must be skipped.
+ */
+static bool TxPayloadIsStale(const CdiConnectionState* con_state_ptr, const TxEndpointLane* lane_ptr,
+                             const TxPayloadState* payload_state_ptr)
+{
+    const CdiTxConfigData* config_data_ptr = &con_state_ptr->tx_state.config_data;
+
+    if (config_data_ptr->stale_payloads.skip_superseded) {
+        for (CdiSinglyLinkedListEntry* entry_ptr = CdiSinglyLinkedListGetHead(&lane_ptr->payload_list);
+             NULL != entry_ptr; entry_ptr = CdiSinglyLinkedListNextEntry(entry_ptr)) {
+            if (TxPayloadIsSameStream(con_state_ptr, payload_state_ptr,
+                                      CONTAINER_OF(entry_ptr, TxPayloadState, list_entry))) {
+                return true;
+            }
+        }
+    }
+
+    if (config_data_ptr->stale_payloads.skip_late && payload_state_ptr->max_latency_microsecs) {
+        uint64_t deadline = payload_state_ptr->start_time + payload_state_ptr->max_latency_microsecs;
+        if (TxEndpointLanePacedUntil(con_state_ptr, lane_ptr, payload_state_ptr, CdiOsGetMicroseconds()) > deadline) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/**
+ * Complete a payload that is waiting in a lane without sending it. Called by TxPayloadThread() while the poll thread may
+ * be completing sent payloads, which is why the application's payload message queue accepts multiple writers.
+ *
+ * @param payload_state_ptr Pointer to payload state data. The pointer is no longer valid after function returns.
+ * @param status_code Status passed to the application's Tx callback.
+ */
+static void TxPayloadWithdraw(TxPayloadState* payload_state_ptr, CdiReturnStatus status_code)
+{
+    CdiEndpointState* endpoint_ptr = payload_state_ptr->cdi_endpoint_handle;
+
+    // The payload has not been started, so it holds no in-flight reference.
+    payload_state_ptr->app_payload_cb_data.payload_status_code = status_code;
+    PayloadTransferComplete(endpoint_ptr, payload_state_ptr);
+}
+
+/**
+ * Cancel payloads that are waiting in a lane. Either the payloads of the same stream as a replacement payload or the
+ * payloads sent with a user callback parameter before a cancel request are cancelled. The payload being sent by the
+ * lane is not affected.
+ *
+ * @param con_state_ptr Pointer to connection state data.
+ * @param lane_ptr Pointer to the lane.
+ * @param replacement_payload_state_ptr Pointer to the state of the replacement payload, or NULL to perform
+ *                                      cancel_request_ptr.
+ * @param cancel_request_ptr Pointer to the cancel request. Not used if replacement_payload_state_ptr is not NULL.
+ */
+static void TxEndpointLaneCancel(const CdiConnectionState* con_state_ptr, TxEndpointLane* lane_ptr,
+                                 const TxPayloadState* replacement_payload_state_ptr,
+                                 const TxCancelRequest* cancel_request_ptr)
+{
+    CdiSinglyLinkedList kept_list;
+    CdiSinglyLinkedListInit(&kept_list);
+    for (CdiSinglyLinkedListEntry* entry_ptr = CdiSinglyLinkedListPopHead(&lane_ptr->payload_list); NULL != entry_ptr;
+         entry_ptr = CdiSinglyLinkedListPopHead(&lane_ptr->payload_list)) {
+        TxPayloadState* payload_state_ptr = CONTAINER_OF(entry_ptr, TxPayloadState, list_entry);
+        // Payloads sent after the cancel request was made are in the lanes by the time it is performed, so they are
+        // told apart by their sequence numbers, which may wrap.
+        bool cancel = replacement_payload_state_ptr ?
+                      TxPayloadIsSameStream(con_state_ptr, payload_state_ptr, replacement_payload_state_ptr) :
+                      (cancel_request_ptr->user_cb_param ==
+                       payload_state_ptr->app_payload_cb_data.tx_payload_user_cb_param &&
+                       (int32_t)(payload_state_ptr->send_sequence_num - cancel_request_ptr->send_sequence_num) <= 0);
+        if (cancel) {
+            TxPayloadWithdraw(payload_state_ptr, kCdiStatusTxPayloadCancelled);
+        } else {
+            CdiSinglyLinkedListPushTail(&kept_list, entry_ptr);
+        }
+    }
+    lane_ptr->payload_list = kept_list;
+}
+
+/**
+ * Pop all payloads from the connection's payload queue and add each one to the lane of its endpoint.
+ *
+ * @param con_state_ptr Pointer to connection state data.
+ * @param lane_array Array of CDI_MAX_ENDPOINTS_PER_CONNECTION lanes.
+ */
+static void TxEndpointLanesFill(CdiConnectionState* con_state_ptr, TxEndpointLane* lane_array)
+{
+    TxPayloadState* payload_state_array[MAX_QUEUE_BATCH_ITEM_COUNT];
+    int payload_count = 0;
+    while (0 != (payload_count = CdiQueuePopMultiple(con_state_ptr->tx_state.payload_queue_handle,
+                                                     payload_state_array,
+                                                     CDI_ARRAY_ELEMENT_COUNT(payload_state_array)))) {
+        for (int i = 0; i < payload_count; i++) {
+            TxPayloadState* payload_state_ptr = payload_state_array[i];
+            TxEndpointLane* lane_ptr = TxEndpointLaneGet(lane_array, payload_state_ptr->cdi_endpoint_handle);
+            if (payload_state_ptr->replace) {
+                TxEndpointLaneCancel(con_state_ptr, lane_ptr, payload_state_ptr, NULL);
+            }
+            CdiSinglyLinkedListPushTail(&lane_ptr->payload_list, &payload_state_ptr->list_entry);
+        }
+    }
+}
+
+/**
+ * Give a lane its turn to send packets. Packets of the lane's current payload are built and added to a list, which is
+ * enqueued to the adapter as a batch. The turn ends when a batch has been enqueued or a pool or the adapter's queue runs
+ * dry. In the latter case, enough state is kept to resume on the lane's next turn.
+ *
+ * The state machine goes through the states like:
+ *
+ *   +-----> idle -+
+ *   |             |
+ *   |     +-------+
+ *   |     |
+ *   |     +-> work received ->+
+ *   |                         |
+ *   |     +-------------------+
+ *   |     |
+ *   |  +->+-> get work request ->+
+ *   |  |                         |
+ *   |  |     +-------------------+
+ *   |  |     |
+ *   |  |     +-> packetizing ->+
+ *   |  |                       |
+ *   |  +<----------------------+  <-- list of packets to enqueue is incomplete
+ *   |  ^                       |
+ *   |  |  +--------------------+  <-- list of packets to enqueue is complete
+ *   |  |  |
+ *   |  |  +-> enqueueing ->+
+ *   |  |                   |
+ *   |  +-------------------+  <-- not last packet of payload (end of turn)
+ *   |                      |
+ *   +----------------------+  <-- last packet of the payload has been successfully queued (end of turn)
+ *
+ * @param con_state_ptr Pointer to connection state data.
+ * @param lane_ptr Pointer to the lane.
+ *
+ * @return true if any progress was made, false if the lane has no work or is waiting for resources.
+ */
+static bool TxEndpointLaneRun(CdiConnectionState* con_state_ptr, TxEndpointLane* lane_ptr)
+{
+    bool progress = false;
+
+    if (kPayloadStateIdle == lane_ptr->payload_processing_state) {
+        // Get the next payload, skipping stale ones. Stale payloads haven't been given a payload number, so the
+        // receiver doesn't see a gap.
+        TxPayloadState* next_payload_state_ptr = NULL;
+        CdiSinglyLinkedListEntry* entry_ptr = NULL;
+        while (NULL == next_payload_state_ptr &&
+               NULL != (entry_ptr = CdiSinglyLinkedListPopHead(&lane_ptr->payload_list))) {
+            next_payload_state_ptr = CONTAINER_OF(entry_ptr, TxPayloadState, list_entry);
+            if (TxPayloadIsStale(con_state_ptr, lane_ptr, next_payload_state_ptr)) {
+                TxPayloadWithdraw(next_payload_state_ptr, kCdiStatusTxPayloadStale);
+                next_payload_state_ptr = NULL;
+                progress = true;
+            }
+        }
+        if (NULL == next_payload_state_ptr) {
+            return progress;
+        }
+        lane_ptr->payload_state_ptr = next_payload_state_ptr;
+        lane_ptr->payload_processing_state = kPayloadStateWorkReceived;
+
+        // Increment reference counter once at the start of each payload. This will keep the PollThread() working as
+        // long as we have payloads and their related packets to send. Payloads still waiting in a lane don't hold a
+        // reference, so a backlog of them doesn't keep the poll thread busy.
+        CdiOsAtomicInc32(&next_payload_state_ptr->cdi_endpoint_handle->adapter_endpoint_ptr->tx_in_flight_ref_count);
+        CdiOsSignalSet(con_state_ptr->adapter_connection_ptr->tx_poll_do_work_signal);
+    }
+    TxPayloadState* payload_state_ptr = lane_ptr->payload_state_ptr;
+
+    // Either resume work on a payload in progress or start a new one.
+    if (kPayloadStateWorkReceived == lane_ptr->payload_processing_state) {
+        // No packet was in progress so start by initializing for the first one.
+
+        // Increment payload number. NOTE: This is done here on the read side of the queue rather than on the write
+        // side of the queue because the write side fails if the queue is full. This would cause payload_num to
+        // increment erroneously. By incrementing here on the read side, this problem is avoided. Payloads of an
+        // endpoint are always started in the order they were sent, since they use the same lane.
+        payload_state_ptr->payload_packet_state.payload_num = GetNextPayloadNum(payload_state_ptr->cdi_endpoint_handle);
+
+        StatsGatherTxQueueTime(payload_state_ptr->cdi_endpoint_handle,
+                               CdiOsGetMicroseconds() - payload_state_ptr->start_time);
+
+        if (CdiLogComponentIsEnabled(con_state_ptr, kLogComponentPayloadConfig)) {
+            // Dump payload configuration to log or stdout.
+            DumpPayloadConfiguration(&payload_state_ptr->app_payload_cb_data.core_extra_data,
+                                     payload_state_ptr->app_payload_cb_data.extra_data_size,
+                                     payload_state_ptr->app_payload_cb_data.extra_data_array,
+                                     con_state_ptr->protocol_type);
+        }
+
+        // Prepare packetizer for first packet.
+        PayloadPacketizerStateInit(lane_ptr->packetizer_state_handle);
+
+        CdiSinglyLinkedListInit(&lane_ptr->packet_list);
+        lane_ptr->batch_size = 1;
+        lane_ptr->last_packet = false;
+        lane_ptr->pacing_bytes_per_second = GetPacingRate(&con_state_ptr->tx_state.config_data.pacing,
+                                                          payload_state_ptr);
+        lane_ptr->paced_until_time = TxEndpointLanePacedUntil(con_state_ptr, lane_ptr, payload_state_ptr,
+                                                              CdiOsGetMicroseconds());
+
+        lane_ptr->payload_processing_state = kPayloadStateGetWorkRequest;  // Advance the state machine.
+        progress = true;
+    }
+
+    // When the connection goes down, no need to use resources to continue creating packets or adding them to the
+    // adapter's queue. If the adapter's queue gets full it will start generating queue full log message errors.
+    AdapterEndpointHandle adapter_endpoint_handle =
+        EndpointManagerEndpointToAdapterEndpoint(payload_state_ptr->cdi_endpoint_handle);
+    bool keep_going = kCdiConnectionStatusConnected == adapter_endpoint_handle->connection_status_code;
+    while (keep_going) {
+        if (kPayloadStateGetWorkRequest == lane_ptr->payload_processing_state) {
+            // NOTE: This pool is not thread-safe, so must ensure that only one thread is accessing it at a time.
+            if (!CdiPoolGet(con_state_ptr->tx_state.work_request_pool_handle, (void**)&lane_ptr->work_request_ptr)) {
+                keep_going = false;
+            } else {
+                TxPacketWorkRequest* work_request_ptr = lane_ptr->work_request_ptr;
+                // If first packet of a payload and uses extra data, use the extra data pool.
+                if (0 == payload_state_ptr->payload_packet_state.packet_sequence_num &&
+                    payload_state_ptr->app_payload_cb_data.extra_data_size) {
+                    work_request_ptr->header_pool_handle =
+                        con_state_ptr->adapter_connection_ptr->tx_extra_header_pool_handle;
+
+                } else {
+                    work_request_ptr->header_pool_handle = con_state_ptr->adapter_connection_ptr->tx_header_pool_handle;
+                }
+                if (!CdiPoolGet(work_request_ptr->header_pool_handle, (void**)&work_request_ptr->union_ptr)) {
+                    keep_going = false;
+                }
+                lane_ptr->payload_processing_state = kPayloadStatePacketizing;
+            }
+        }
+
+        if (keep_going && kPayloadStatePacketizing == lane_ptr->payload_processing_state) {
+            TxPacketWorkRequest* work_request_ptr = lane_ptr->work_request_ptr;
+            PayloadPacketizerPacketGet(adapter_endpoint_handle->protocol_handle, lane_ptr->packetizer_state_handle,
+                                       (char*)work_request_ptr->union_ptr,
+                                       CdiPoolGetItemSize(work_request_ptr->header_pool_handle),
+                                       work_request_ptr->sgl_entry_array, payload_state_ptr,
+                                       &work_request_ptr->packet.sg_list, &lane_ptr->last_packet);
+#ifdef DEBUG_TX_PACKET_SGL_ENTRIES
+            DebugTxPacketSglEntries(adapter_endpoint_handle->protocol_handle, work_request_ptr);
 #endif
+            // Fill in the work request with the specifics of the packet.
+            work_request_ptr->payload_state_ptr = payload_state_ptr;
+            work_request_ptr->payload_num = payload_state_ptr->payload_packet_state.payload_num;
+            work_request_ptr->packet_payload_size = payload_state_ptr->payload_packet_state.packet_payload_data_size;
+            work_request_ptr->packet.tx_state.pacing_bytes_per_second = lane_ptr->pacing_bytes_per_second;
+
+            // This pointer will be used later by TxPacketWorkRequestComplete() to get access to work_request_ptr (a
+            // pointer to a TxPacketWorkRequest structure).
+            work_request_ptr->packet.sg_list.internal_data_ptr = work_request_ptr;
+
+            // Set flag for last packet of the payload so ACKs received can keep track of the number of in-flight
+            // payloads.
+            work_request_ptr->packet.payload_last_packet = lane_ptr->last_packet;
+
+            // Add the packet to a list to be enqueued to the adapter.
+            CdiSinglyLinkedListPushTail(&lane_ptr->packet_list, &work_request_ptr->packet.list_entry);
+            // Increment reference counter once for each packet.
+            CdiOsAtomicInc32(&payload_state_ptr->cdi_endpoint_handle->adapter_endpoint_ptr->tx_in_flight_ref_count);
+            progress = true;
 
-            // Put back work request into the pool.
-            PutWorkRequestInPool(con_state_ptr, work_request_ptr);
-            work_request_ptr = NULL; // Pointer is no longer valid, so clear it.
+            lane_ptr->payload_processing_state =
+                (lane_ptr->last_packet || CdiSinglyLinkedListSize(&lane_ptr->packet_list) >= lane_ptr->batch_size) ?
+                kPayloadStateEnqueuing : kPayloadStateGetWorkRequest;
+        }
+
+        if (kPayloadStateEnqueuing == lane_ptr->payload_processing_state) {
+            // Enqueue packets. packet_list is copied so it can simply be initialized here to start fresh.
+            if (kCdiStatusOk != CdiAdapterEnqueueSendPackets(adapter_endpoint_handle, &lane_ptr->packet_list)) {
+                keep_going = false;
+            } else {
+                CdiSinglyLinkedListInit(&lane_ptr->packet_list);
+                lane_ptr->batch_size *= 2;
+                progress = true;
+                keep_going = false; // The batch has been queued, so give the other lanes a turn.
+
+                if (lane_ptr->last_packet) {
+                    // The last packet of the payload has been sent; reset to start a new one.
+                    lane_ptr->payload_processing_state = kPayloadStateIdle;
+                    lane_ptr->payload_state_ptr = NULL;
+                    // Successfully put all packets for a payload into Tx queue, so reset the back pressure state.
+                    con_state_ptr->back_pressure_state = kCdiBackPressureNone;
+                } else {
+                    lane_ptr->payload_processing_state = kPayloadStateGetWorkRequest;
+                }
+            }
         }
     }
+
+    return progress;
 }
 
 /**
@@ -159,16 +741,24 @@ static CDI_THREAD TxPayloadThread(void* ptr)
 {
     CdiConnectionState* con_state_ptr = (CdiConnectionState*)ptr;
 
-    // Get a state tracker object for the packetizer.
-    CdiPacketizerStateHandle packetizer_state_handle = PayloadPacketizerCreate();
-    if (NULL == packetizer_state_handle) {
-        CDI_LOG_THREAD(kLogError, "Failed to create packetizer state.");
-        return 0;
-    }
-
     // Set this thread to use the connection's log. Can now use CDI_LOG_THREAD() for logging within this thread.
     CdiLoggerThreadLogSet(con_state_ptr->log_handle);
 
+    // Get a state tracker object for the packetizer of each lane.
+    TxEndpointLane lane_array[CDI_MAX_ENDPOINTS_PER_CONNECTION];
+    memset(lane_array, 0, sizeof(lane_array));
+    for (int i = 0; i < CDI_MAX_ENDPOINTS_PER_CONNECTION; i++) {
+        lane_array[i].packetizer_state_handle = PayloadPacketizerCreate();
+        if (NULL == lane_array[i].packetizer_state_handle) {
+            CDI_LOG_THREAD(kLogError, "Failed to create packetizer state.");
+            for (int j = 0; j < i; j++) {
+                PayloadPacketizerDestroy(lane_array[j].packetizer_state_handle);
+            }
+            return 0;
+        }
+    }
+    TxEndpointLanesReset(lane_array);
+
     EndpointManagerHandle mgr_handle = con_state_ptr->endpoint_manager_handle;
 
     // Register this thread with the Endpoint Manager as being part of this connection.
@@ -176,88 +766,29 @@ static CDI_THREAD TxPayloadThread(void* ptr)
                                             CdiOsThreadGetName(con_state_ptr->payload_thread_id));
 
     CdiSignalType comp_queue_signal = CdiQueueGetPopWaitSignal(con_state_ptr->tx_state.work_req_comp_queue_handle);
+    CdiSignalType payload_queue_signal = CdiQueueGetPopWaitSignal(con_state_ptr->tx_state.payload_queue_handle);
+    CdiSignalType cancel_queue_signal = CdiQueueGetPopWaitSignal(con_state_ptr->tx_state.cancel_queue_handle);
 
-    CdiSignalType signal_array[2] = { notification_signal, comp_queue_signal };
-
-    // Packets are sent to the endpoint in batches starting with a single packet. The number is doubled with each
-    // batch. This gives a quick start but as the queue backs up, the larger batch sizes lead to higher efficiency
-    // per batch.
-    int batch_size = 1;
+    CdiSignalType signal_array[4] = { notification_signal, comp_queue_signal, payload_queue_signal,
+                                      cancel_queue_signal };
 
-    // These variable are used only within the scope of the while loop below but they must be declared outside of it
-    // since their values need to start initialized but not get reinitialized every time through.
-    bool last_packet = false;
-    TxPacketWorkRequest* work_request_ptr = NULL;
-    CdiSinglyLinkedList packet_list;
-    CdiSinglyLinkedListInit(&packet_list);
-
-    // The state machine goes through the states like:
-    //
-    //   +-----> idle -+
-    //   |             |
-    //   |     +-------+
-    //   |     |
-    //   |     +-> work received ->+
-    //   |                         |
-    //   |     +-------------------+
-    //   |     |
-    //   |  +->+-> get work request ->+
-    //   |  |                         |
-    //   |  |     +-------------------+
-    //   |  |     |
-    //   |  |     +-> packetizing ->+
-    //   |  |                       |
-    //   |  +<----------------------+  <-- list of packets to enqueue is incomplete
-    //   |  ^                       |
-    //   |  |  +--------------------+  <-- list of packets to enqueue is complete
-    //   |  |  |
-    //   |  |  +-> enqueueing ->+
-    //   |  |                   |
-    //   |  +-------------------+  <-- not last packet of payload
-    //   |                      |
-    //   +----------------------+  <-- last packet of the payload has been successfully queued
-    enum {
-        kPayloadStateIdle,           // No payload is in process: wait for payload from queue.
-        kPayloadStateWorkReceived,   // A payload was received to be transmitted: initialize for first packet.
-        kPayloadStateGetWorkRequest, // Payload and packetizer initialized: get a work request from pool.
-        kPayloadStatePacketizing,    // Have work request: build SGL.
-        kPayloadStateEnqueuing       // Have completed list of work requests: queued to the adapter.
-    } payload_processing_state = kPayloadStateIdle;
-
-    // This loop should only block at the call to CdiQueuePopWaitMultiple(). If a pool runs dry or the output queue is
-    // full, the logic inside of the loop should maintain enough state to suspend the process of packetizing the current
-    // payload and resume when resources are available.
-    TxPayloadState* payload_state_ptr = NULL;
+    // This loop should only block at the call to CdiOsSignalsWait() when none of the lanes can make progress. If a pool
+    // runs dry or the output queue is full, each lane maintains enough state to suspend the process of packetizing its
+    // current payload and resume when resources are available.
+    bool progress = false;
     while (!CdiOsSignalGet(con_state_ptr->shutdown_signal) && !EndpointManagerIsConnectionShuttingDown(mgr_handle)) {
-        uint32_t signal_index = 0;
-        bool payload_received = false;
-        if (kPayloadStateIdle == payload_processing_state) {
-            // Wait for work from the payload queue, the work request complete queue, or a signal from the endpoint
-            // manager.
-            payload_received = CdiQueuePopWaitMultiple(con_state_ptr->tx_state.payload_queue_handle, CDI_INFINITE,
-                                                       signal_array, 2, &signal_index, (void**)&payload_state_ptr);
-        } else {
-            // A payload is currently in process. Wait for completion requests or a signal from the Endpoint Manager.
-            CdiOsSignalsWait(signal_array, 2, false, CDI_INFINITE, &signal_index);
-        }
-        if (!payload_received) {
-            // Either processing an existing payload or did not get a new one. Got a signal from either the Endpoint
-            // Manager or work_req_comp_queue_handle (the queue contains data).
-            if (0 == signal_index) {
-                // Got a notification_signal. The endpoint state has changed, so wait until it has completed.
-                EndpointManagerThreadWait(mgr_handle);
-                // An Endpoint Manager state change means that Tx resources have been flushed or queued to be flushed,
-                // including the current Tx payload that we could be processing. Reset our current payload state back to
-                // idle. Allow the logic to drop below so if needed ProcessWorkRequestCompletionQueue() is invoked.
-                payload_processing_state = kPayloadStateIdle;
-                payload_state_ptr = NULL;
-            }
-        } else {
-            payload_processing_state = kPayloadStateWorkReceived;
-            // Increment reference counter once at the start of each payload. This will keep the PollThread() working as
-            // long as we have payloads and their related packets to send.
-            CdiOsAtomicInc32(&payload_state_ptr->cdi_endpoint_handle->adapter_endpoint_ptr->tx_in_flight_ref_count);
-            CdiOsSignalSet(con_state_ptr->adapter_connection_ptr->tx_poll_do_work_signal);
+        // Wait for payloads from the payload queue, completed work requests or a signal from the Endpoint Manager. If
+        // a lane made progress during the previous turn, only check the signals and don't wait.
+        uint32_t signal_index = CDI_OS_SIG_TIMEOUT;
+        CdiOsSignalsWait(signal_array, CDI_ARRAY_ELEMENT_COUNT(signal_array), false, progress ? 0 : CDI_INFINITE,
+                         &signal_index);
+        if (0 == signal_index) {
+            // Got a notification_signal. The endpoint state has changed, so wait until it has completed.
+            EndpointManagerThreadWait(mgr_handle);
+            // An Endpoint Manager state change means that Tx resources have been flushed or queued to be flushed,
+            // including the Tx payloads that we could be processing. Reset the lanes back to idle. Allow the logic to
+            // drop below so if needed ProcessWorkRequestCompletionQueue() is invoked.
+            TxEndpointLanesReset(lane_array);
         }
 
         // Always check the completion queue here. Don't want to starve it in case either several Endpoint Manager
@@ -266,133 +797,41 @@ static CDI_THREAD TxPayloadThread(void* ptr)
             ProcessWorkRequestCompletionQueue(con_state_ptr);
         }
 
-        // Either resume work on a payload in progress or start a new one.
-        if (kPayloadStateWorkReceived == payload_processing_state) {
-            // No packet was in progress so start by initializing for the first one.
-
-            // Increment payload number. NOTE: This is done here on the read side of the queue rather than on the write
-            // side of the queue because the write side fails if the queue is full. This would cause payload_num to
-            // increment erroneously. By incrementing here on the read side, this problem is avoided.
-            payload_state_ptr->payload_packet_state.payload_num =
-                GetNextPayloadNum(payload_state_ptr->cdi_endpoint_handle);
-
-            if (CdiLogComponentIsEnabled(con_state_ptr, kLogComponentPayloadConfig)) {
-                // Dump payload configuration to log or stdout.
-                DumpPayloadConfiguration(&payload_state_ptr->app_payload_cb_data.core_extra_data,
-                                         payload_state_ptr->app_payload_cb_data.extra_data_size,
-                                         payload_state_ptr->app_payload_cb_data.extra_data_array,
-                                         con_state_ptr->protocol_type);
-            }
-
-            // Prepare packetizer for first packet.
-            PayloadPacketizerStateInit(packetizer_state_handle);
-
-            CdiSinglyLinkedListInit(&packet_list);
-            batch_size = 1;
-            last_packet = false;
-
-            payload_processing_state = kPayloadStateGetWorkRequest;  // Advance the state machine.
+        // Get cancel requests before adding new payloads to the lanes, so the payloads sent before a request are in
+        // the lanes when it is applied.
+        TxCancelRequest cancel_request_array[MAX_TX_PAYLOAD_CANCEL_REQUESTS_PER_CONNECTION];
+        int cancel_count = 0;
+        if (CdiOsSignalReadState(cancel_queue_signal)) {
+            cancel_count = CdiQueuePopMultiple(con_state_ptr->tx_state.cancel_queue_handle, cancel_request_array,
+                                               CDI_ARRAY_ELEMENT_COUNT(cancel_request_array));
         }
 
-        bool keep_going = kPayloadStateGetWorkRequest == payload_processing_state ||
-                          kPayloadStatePacketizing == payload_processing_state ||
-                          kPayloadStateEnqueuing == payload_processing_state;
-        while (keep_going) {
-            // When the connection goes down, no need to use resources to continue creating packets or adding them to
-            // the adapter's queue. If the adapter's queue gets full it will start generating queue full log message
-            // errors.
-            AdapterEndpointHandle adapter_endpoint_handle =
-                EndpointManagerEndpointToAdapterEndpoint(payload_state_ptr->cdi_endpoint_handle);
-            if (kCdiConnectionStatusConnected != adapter_endpoint_handle->connection_status_code) {
-                break;
-            }
-            if (kPayloadStateGetWorkRequest == payload_processing_state) {
-                // NOTE: This pool is not thread-safe, so must ensure that only one thread is accessing it at a time.
-                if (!CdiPoolGet(con_state_ptr->tx_state.work_request_pool_handle, (void**)&work_request_ptr)) {
-                    keep_going = false;
-                } else {
-                    // If first packet of a payload and uses extra data, use the extra data pool.
-                    if (0 == payload_state_ptr->payload_packet_state.packet_sequence_num &&
-                        payload_state_ptr->app_payload_cb_data.extra_data_size) {
-                        work_request_ptr->header_pool_handle =
-                            con_state_ptr->adapter_connection_ptr->tx_extra_header_pool_handle;
-
-                    } else {
-                        work_request_ptr->header_pool_handle =
-                            con_state_ptr->adapter_connection_ptr->tx_header_pool_handle;
-                    }
-                    if (!CdiPoolGet(work_request_ptr->header_pool_handle, (void**)&work_request_ptr->union_ptr)) {
-                        keep_going = false;
-                    }
-                    payload_processing_state = kPayloadStatePacketizing;
-                }
-            }
-
-            if (keep_going && kPayloadStatePacketizing == payload_processing_state) {
-                // NOTE: These pools are not thread-safe, so must ensure that only one thread is accessing them at a
-                // time.
-                if (!PayloadPacketizerPacketGet(adapter_endpoint_handle->protocol_handle,
-                                                packetizer_state_handle, (char*)work_request_ptr->union_ptr,
-                                                CdiPoolGetItemSize(work_request_ptr->header_pool_handle),
-                                                con_state_ptr->tx_state.packet_sgl_entry_pool_handle,
-                                                payload_state_ptr, &work_request_ptr->packet.sg_list, &last_packet))
-                {
-                    // Pool is empty; suspend processing the payload for now, retry after resources are freed.
-                    keep_going = false;
-                } else {
-#ifdef DEBUG_TX_PACKET_SGL_ENTRIES
-                    DebugTxPacketSglEntries(adapter_endpoint_handle->protocol_handle, work_request_ptr);
-#endif
-                    // Fill in the work request with the specifics of the packet.
-                    work_request_ptr->payload_state_ptr = payload_state_ptr;
-                    work_request_ptr->payload_num = payload_state_ptr->payload_packet_state.payload_num;
-                    work_request_ptr->packet_payload_size =
-                        payload_state_ptr->payload_packet_state.packet_payload_data_size;
-
-                    // This pointer will be used later by TxPacketWorkRequestComplete() to get access to
-                    // work_request_ptr (a pointer to a TxPacketWorkRequest structure).
-                    work_request_ptr->packet.sg_list.internal_data_ptr = work_request_ptr;
-
-                    // Set flag for last packet of the payload so ACKs received can keep track of the number of
-                    // in-flight payloads.
-                    work_request_ptr->packet.payload_last_packet = last_packet;
-
-                    // Add the packet to a list to be enqueued to the adapter.
-                    CdiSinglyLinkedListPushTail(&packet_list, &work_request_ptr->packet.list_entry);
-                    // Increment reference counter once for each packet.
-                    CdiOsAtomicInc32(&payload_state_ptr->cdi_endpoint_handle->adapter_endpoint_ptr->tx_in_flight_ref_count);
-
-                    payload_processing_state = (last_packet || CdiSinglyLinkedListSize(&packet_list) >= batch_size) ?
-                        kPayloadStateEnqueuing : kPayloadStateGetWorkRequest;
+        // Add new payloads to the lanes of their endpoints.
+        if (cancel_count || CdiOsSignalReadState(payload_queue_signal)) {
+            TxEndpointLanesFill(con_state_ptr, lane_array);
+        }
+        for (int i = 0; i < cancel_count; i++) {
+            for (int j = 0; j < CDI_MAX_ENDPOINTS_PER_CONNECTION; j++) {
+                if (lane_array[j].endpoint_handle) {
+                    TxEndpointLaneCancel(con_state_ptr, &lane_array[j], NULL, &cancel_request_array[i]);
                 }
             }
+        }
 
-            if (kPayloadStateEnqueuing == payload_processing_state) {
-                // Enqueue packets. packet_list is copied so it can simply be initialized here to start fresh.
-                if (kCdiStatusOk != CdiAdapterEnqueueSendPackets(
-                        EndpointManagerEndpointToAdapterEndpoint(payload_state_ptr->cdi_endpoint_handle),
-                        &packet_list)) {
-                    keep_going = false;
-                } else {
-                    CdiSinglyLinkedListInit(&packet_list);
-                    batch_size *= 2;
-
-                    if (last_packet) {
-                        // The last packet of the payload has been sent; reset to start a new one.
-                        payload_processing_state = kPayloadStateIdle;
-                        payload_state_ptr = NULL;
-                        keep_going = false;
-                        // Successfully put all packets for a payload into Tx queue, so reset the back pressure state.
-                        con_state_ptr->back_pressure_state = kCdiBackPressureNone;
-                    } else {
-                        payload_processing_state = kPayloadStateGetWorkRequest;
-                    }
-                }
-            }
+        // Give a turn to the first lane in order of priority and deadline that can make progress. Then return to the
+        // top of the loop to pick up new payloads, so a payload of a higher priority endpoint preempts a payload that
+        // is in progress between its batches of packets.
+        progress = false;
+        uint32_t tried_mask = 0;
+        TxEndpointLane* lane_ptr = NULL;
+        while (!progress && NULL != (lane_ptr = TxEndpointLaneNext(lane_array, &tried_mask))) {
+            progress = TxEndpointLaneRun(con_state_ptr, lane_ptr);
         }
     }
 
-    PayloadPacketizerDestroy(packetizer_state_handle);
+    for (int i = 0; i < CDI_MAX_ENDPOINTS_PER_CONNECTION; i++) {
+        PayloadPacketizerDestroy(lane_array[i].packetizer_state_handle);
+    }
     if (EndpointManagerIsConnectionShuttingDown(mgr_handle)) {
         // Since this thread was registered with the Endpoint Manager using EndpointManagerThreadRegister(), need to
         // wait for the Endpoint Manager to complete the shutdown.
@@ -440,6 +879,13 @@ static CdiReturnStatus TxCreateConnection(CdiConnectionProtocolType protocol_typ
 {
     CdiReturnStatus rs = kCdiStatusOk;
 
+    if (config_data_ptr->pacing.latency_percent < 0 || config_data_ptr->pacing.latency_percent > 100) {
+        CDI_LOG_HANDLE(cdi_global_context.global_log_handle, kLogError,
+                       "Pacing latency_percent[%d] must be between 0 and 100.",
+                       config_data_ptr->pacing.latency_percent);
+        return kCdiStatusInvalidParameter;
+    }
+
     int max_tx_payloads = CDI_MAX_SIMULTANEOUS_TX_PAYLOADS_PER_CONNECTION;
 
     // If max_simultaneous_tx_payloads has been set use that value otherwise use
@@ -466,9 +912,13 @@ static CdiReturnStatus TxCreateConnection(CdiConnectionProtocolType protocol_typ
         con_state_ptr->handle_type = kHandleTypeTx;
         con_state_ptr->protocol_type = protocol_type;
         con_state_ptr->magic = kMagicConnection;
+        con_state_ptr->numa_node = CdiOsGetCpuNumaNode(config_data_ptr->thread_core_num);
 
         // Make a copy of the configuration data.
         memcpy(&con_state_ptr->tx_state.config_data, config_data_ptr, sizeof *config_data_ptr);
+        if (0 == con_state_ptr->tx_state.config_data.pacing.burst_bytes) {
+            con_state_ptr->tx_state.config_data.pacing.burst_bytes = TX_PACING_DEFAULT_BURST_BYTES;
+        }
 
         // Make a copy of configuration data strings and update the copy of the config data to use them. NOTE: The
         // connection_name_str is updated in logic below (see saved_connection_name_str).
@@ -545,6 +995,16 @@ static CdiReturnStatus TxCreateConnection(CdiConnectionProtocolType protocol_typ
         }
     }
 
+    if (kCdiStatusOk == rs) {
+        // Create queue used to send payload cancel requests to the TxPayloadThread() thread.
+        if (!CdiQueueCreate("Tx payload cancel request queue", MAX_TX_PAYLOAD_CANCEL_REQUESTS_PER_CONNECTION,
+                            CDI_FIXED_QUEUE_SIZE, CDI_FIXED_QUEUE_SIZE, sizeof(TxCancelRequest),
+                            kQueueSignalPopWait | kQueueMultipleWritersFlag,
+                            &con_state_ptr->tx_state.cancel_queue_handle)) {
+            rs = kCdiStatusNotEnoughMemory;
+        }
+    }
+
     if (kCdiStatusOk == rs) {
         // Create worker thread.
         if (!CdiOsThreadCreate(TxPayloadThread, &con_state_ptr->payload_thread_id, "TxPayload", con_state_ptr,
@@ -553,43 +1013,53 @@ static CdiReturnStatus TxCreateConnection(CdiConnectionProtocolType protocol_typ
         }
     }
 
-    // Create memory pools. NOTE: These pools do not use any resource locks and are therefore not thread-safe.
-    // TxPayloadThread() is the only user of the pools, except when restarting/shutting down the connection which is
-    // done by EndpointManagerThread() while TxPayloadThread() is blocked.
+    // Size the packet resources for the stream described by the resource profile, if one was provided.
+    int max_tx_packets = MAX_TX_PACKET_WORK_REQUESTS_PER_CONNECTION;
+    int tx_packet_queue_size = MAX_TX_PACKETS_PER_CONNECTION;
     if (kCdiStatusOk == rs) {
-        if (!CdiPoolCreate("Connection Tx TxPacketWorkRequest Pool",
-                MAX_TX_PACKET_WORK_REQUESTS_PER_CONNECTION, NO_GROW_COUNT, NO_GROW_COUNT,
-                sizeof(TxPacketWorkRequest), false, // false= Not thread-safe (no resource locks)
-                &con_state_ptr->tx_state.work_request_pool_handle)) {
-            rs = kCdiStatusNotEnoughMemory;
-        }
+        const CdiResourceProfile* profile_ptr = &config_data_ptr->resource_profile;
+        CdiAdapterTypeSelection adapter_type = con_state_ptr->adapter_state_ptr->adapter_data.adapter_type;
+        int payload_count = profile_ptr->max_in_flight_payloads ? profile_ptr->max_in_flight_payloads :
+                                                                  max_tx_payloads;
+        max_tx_packets = ResourceProfilePacketCount(adapter_type, profile_ptr, payload_count, max_tx_packets);
+        tx_packet_queue_size = ResourceProfilePacketCount(adapter_type, profile_ptr, payload_count,
+                                                          tx_packet_queue_size);
     }
+
+    // Create memory pools. NOTE: These pools do not use any resource locks and are therefore not thread-safe.
+    // TxPayloadThread() is the only user of the pools, except when restarting/shutting down the connection which is
+    // done by EndpointManagerThread() while TxPayloadThread() is blocked. Work requests, which embed their packet SGL
+    // entries, are handed to the poll thread, so they are allocated on its NUMA node.
     if (kCdiStatusOk == rs) {
-        if (!CdiPoolCreate("Connection Tx CdiSglEntry Pool", TX_PACKET_SGL_ENTRY_SIZE_PER_CONNECTION, NO_GROW_SIZE,
-                           NO_GROW_COUNT, sizeof(CdiSglEntry), false, // false= Not thread-safe (no resource locks)
-                           &con_state_ptr->tx_state.packet_sgl_entry_pool_handle)) {
+        if (!CdiPoolCreateOnNumaNode("Connection Tx TxPacketWorkRequest Pool",
+                                     max_tx_packets, NO_GROW_COUNT, NO_GROW_COUNT,
+                                     sizeof(TxPacketWorkRequest), CONNECTION_POOL_FLAGS, con_state_ptr->numa_node,
+                                     &con_state_ptr->tx_state.work_request_pool_handle, NULL, NULL)) {
             rs = kCdiStatusNotEnoughMemory;
         }
     }
     if (kCdiStatusOk == rs) {
         // There is a limit on the number of simultaneous Tx payloads per connection, so don't allow this pool to grow.
-        if (!CdiPoolCreate("Connection Tx Payload State Pool", max_tx_payloads,
-                           NO_GROW_SIZE, NO_GROW_COUNT, sizeof(TxPayloadState), true, // true= Is thread-safe.
-                           &con_state_ptr->tx_state.payload_state_pool_handle)) {
+        if (!CdiPoolCreateOnNumaNode("Connection Tx Payload State Pool", max_tx_payloads,
+                                     NO_GROW_SIZE, NO_GROW_COUNT, sizeof(TxPayloadState), kPoolFlagThreadSafe,
+                                     con_state_ptr->numa_node, &con_state_ptr->tx_state.payload_state_pool_handle,
+                                     NULL, NULL)) {
             rs = kCdiStatusNotEnoughMemory;
         }
     }
     if (kCdiStatusOk == rs) {
-        if (!CdiPoolCreate("Connection Tx Payload CdiSglEntry Pool",
-                           max_tx_payload_sgl_entries, NO_GROW_SIZE, NO_GROW_COUNT,
-                           sizeof(CdiSglEntry), true, // true= Is thread-safe.
-                           &con_state_ptr->tx_state.payload_sgl_entry_pool_handle)) {
+        // Entries are taken by the application's thread and returned by the payload thread, so use thread caches.
+        if (!CdiPoolCreateOnNumaNode("Connection Tx Payload CdiSglEntry Pool",
+                                     max_tx_payload_sgl_entries, NO_GROW_SIZE, NO_GROW_COUNT,
+                                     sizeof(CdiSglEntry), kPoolFlagThreadCache | SGL_ENTRY_POOL_FLAGS,
+                                     con_state_ptr->numa_node,
+                                     &con_state_ptr->tx_state.payload_sgl_entry_pool_handle, NULL, NULL)) {
             rs = kCdiStatusNotEnoughMemory;
         }
     }
 
     if (kCdiStatusOk == rs) {
-        if (!CdiQueueCreate("Connection Tx TxPacketWorkRequest* Queue", MAX_TX_PACKETS_PER_CONNECTION,
+        if (!CdiQueueCreate("Connection Tx TxPacketWorkRequest* Queue", tx_packet_queue_size,
                             TX_PACKET_POOL_SIZE_GROW, MAX_POOL_GROW_COUNT,
                             sizeof(CdiSinglyLinkedList), kQueueSignalPopWait, // Make a blockable reader.
                             &con_state_ptr->tx_state.work_req_comp_queue_handle)) {
@@ -617,6 +1087,7 @@ static CdiReturnStatus TxCreateConnection(CdiConnectionProtocolType protocol_typ
             .direction = kEndpointDirectionSend,
             .port_number = con_state_ptr->tx_state.config_data.dest_port,
             .bind_ip_addr_str = con_state_ptr->tx_state.config_data.bind_ip_addr_str,
+            .tx_state.reserve_packet_headers = max_tx_packets, // One header for each work request.
 
             // This endpoint is used for normal data transmission (not used for control). This means that the Endpoint
             // Manager is used for managing threads related to the connection.
@@ -638,64 +1109,163 @@ static CdiReturnStatus TxCreateConnection(CdiConnectionProtocolType protocol_typ
 }
 
 /**
- * Payload transfer has completed either successfully or in error. Update stats and queue payload message to
- * application.
+ * Flush a payload that did not complete transferring. This will set the payload's status and queue a payload message
+ * to the application.
  *
  * @param endpoint_ptr Pointer to endpoint state data.
- * @param payload_state_ptr Pointer to payload state data. The pointer is no longer valid after function returns.
+ * @param payload_state_ptr Pointer to payload state data. The pointer is not longer valid after function returns.
  */
-static void PayloadTransferComplete(CdiEndpointState* endpoint_ptr, TxPayloadState* payload_state_ptr)
+static void FlushFailedPayload(CdiEndpointState* endpoint_ptr, TxPayloadState* payload_state_ptr)
 {
-    CdiConnectionState* con_state_ptr = (CdiConnectionState*)endpoint_ptr->connection_state_ptr;
+    if (kCdiStatusOk == payload_state_ptr->app_payload_cb_data.payload_status_code) {
+        payload_state_ptr->app_payload_cb_data.payload_status_code = kCdiStatusSendFailed;
+    }
 
-    StatsGatherPayloadStatsFromConnection(endpoint_ptr,
-        kCdiStatusOk == payload_state_ptr->app_payload_cb_data.payload_status_code,
-        payload_state_ptr->start_time, payload_state_ptr->max_latency_microsecs,
-        payload_state_ptr->data_bytes_transferred);
+    // Clear this list. It will be cleared by TxPayloadThreadFlushResources(). See work_request_pool_handle pool.
+    CdiSinglyLinkedListInit(&payload_state_ptr->completed_packets_list);
 
-    // Copy the payload's source SGL to the callback data, so we can free the SGL entries in AppCallbackPayloadThread()
-    // to reduce the amount of work required here by the Tx Poll() thread. This also allows the payload_state_ptr to
-    // be freed in this function, since it is no longer needed.
-    payload_state_ptr->app_payload_cb_data.tx_source_sgl = payload_state_ptr->source_sgl;
+    // Queue message to the application.
+    PayloadTransferComplete(endpoint_ptr, payload_state_ptr);
+}
 
-    // Post message to notify application that payload transfer has completed.
-    if (!CdiQueuePush(con_state_ptr->app_payload_message_queue_handle, &payload_state_ptr->app_payload_cb_data)) {
-        CDI_LOG_THREAD(kLogError, "Queue[%s] full, push failed.",
-                        CdiQueueGetName(con_state_ptr->app_payload_message_queue_handle));
+/**
+ * Initialize the state of a payload that is about to be sent, taking the SGL entries it needs from the connection's
+ * pool.
+ *
+ * @param request_ptr Pointer to the payload to send.
+ * @param start_time Time the payload was sent in microseconds.
+ * @param payload_state_ptr Pointer to the payload state to initialize.
+ *
+ * @return true if successful, false if the SGL entries could not be allocated.
+ */
+static bool TxPayloadStateInit(const TxPayloadRequest* request_ptr, uint64_t start_time,
+                               TxPayloadState* payload_state_ptr)
+{
+    const CdiCoreTxPayloadConfig* core_payload_config_ptr = request_ptr->core_payload_config_ptr;
+    assert(request_ptr->sgl_ptr->total_data_size > 0);
+
+    memset((void*)payload_state_ptr, 0, sizeof(TxPayloadState));
+
+    payload_state_ptr->app_payload_cb_data.core_extra_data = core_payload_config_ptr->core_extra_data;
+    payload_state_ptr->app_payload_cb_data.tx_payload_user_cb_param = core_payload_config_ptr->user_cb_param;
+    payload_state_ptr->start_time = start_time;
+    payload_state_ptr->max_latency_microsecs = request_ptr->max_latency_microsecs;
+    payload_state_ptr->replace = request_ptr->replace;
+    payload_state_ptr->send_sequence_num =
+        CdiOsAtomicInc32(&request_ptr->endpoint_ptr->connection_state_ptr->tx_state.send_sequence_num);
+    CdiSinglyLinkedListInit(&payload_state_ptr->completed_packets_list);
 
-        // Since queue was full, need to free the resources associated with the payload.
-        CdiSglEntry* entry_ptr = payload_state_ptr->app_payload_cb_data.tx_source_sgl.sgl_head_ptr;
-        while (entry_ptr) {
-            CdiSglEntry* next_ptr = entry_ptr->next_ptr; // Save next entry, since Put() will free its memory.
-            CdiPoolPut(con_state_ptr->tx_state.payload_sgl_entry_pool_handle, entry_ptr);
-            entry_ptr = next_ptr;
+    // Calculate the size of a group of units of unit_size.
+    int group_size = 1; // How many units of unit_size need to be grouped to be byte aligned.
+    if (core_payload_config_ptr->unit_size > 0) {
+        switch (core_payload_config_ptr->unit_size % 8) {
+            case 0:
+                group_size = 1;
+                break;
+            case 2:
+                group_size = 4;
+                break;
+            case 4:
+                group_size = 2;
+                break;
+            case 6:
+                group_size = 4;
+                break;
+            default: // For a fixed unit_size worst case of 8 units together will always be byte aligned.
+                group_size = 8;
+                break;
         }
-        // If error message exists, return it to pool.
-        PayloadErrorFreeBuffer(con_state_ptr->error_message_pool, &payload_state_ptr->app_payload_cb_data);
     }
+    payload_state_ptr->group_size_bytes = (group_size * core_payload_config_ptr->unit_size) / 8;
 
-    // Done with payload state data, so free it.
+    payload_state_ptr->app_payload_cb_data.extra_data_size = request_ptr->extra_data_size;
+    if (request_ptr->extra_data_size) {
+        memcpy(&payload_state_ptr->app_payload_cb_data.extra_data_array, request_ptr->extra_data_ptr,
+               request_ptr->extra_data_size);
+    }
+
+    payload_state_ptr->cdi_endpoint_handle = request_ptr->endpoint_ptr; // Save the endpoint used to send this payload.
+
+    return PayloadInit(request_ptr->endpoint_ptr->connection_state_ptr, request_ptr->sgl_ptr, payload_state_ptr);
+}
+
+/**
+ * Free a payload that could not be sent. Its SGL entries, if any were taken by TxPayloadStateInit(), and its state are
+ * put back into their pools.
+ *
+ * @param con_state_ptr Pointer to connection state data.
+ * @param payload_state_ptr Pointer to payload state data. The pointer is no longer valid after function returns.
+ */
+static void TxPayloadStateFree(CdiConnectionState* con_state_ptr, TxPayloadState* payload_state_ptr)
+{
+    FreeSglEntries(con_state_ptr->tx_state.payload_sgl_entry_pool_handle, payload_state_ptr->source_sgl.sgl_head_ptr);
     CdiPoolPut(con_state_ptr->tx_state.payload_state_pool_handle, payload_state_ptr);
 }
 
 /**
- * Flush a payload that did not complete transferring. This will set the payload's status and queue a payload message
- * to the application.
+ * Send payloads to endpoints of the same connection. The payload states are taken from their pool with a single pool
+ * operation and pushed to the payload queue with a single queue operation, which wakes up TxPayloadThread() once.
  *
- * @param endpoint_ptr Pointer to endpoint state data.
- * @param payload_state_ptr Pointer to payload state data. The pointer is not longer valid after function returns.
+ * @param con_state_ptr Pointer to connection state data.
+ * @param request_array Array of payloads to send. Their order is kept.
+ * @param request_count Number of payloads in request_array. Must not exceed MAX_TX_PAYLOAD_BATCH_ITEM_COUNT.
+ * @param ret_status_array Array where the status of each payload is written.
  */
-static void FlushFailedPayload(CdiEndpointState* endpoint_ptr, TxPayloadState* payload_state_ptr)
+static void TxPayloadSendRun(CdiConnectionState* con_state_ptr, const TxPayloadRequest* request_array,
+                             int request_count, CdiReturnStatus* ret_status_array)
 {
-    if (kCdiStatusOk == payload_state_ptr->app_payload_cb_data.payload_status_code) {
-        payload_state_ptr->app_payload_cb_data.payload_status_code = kCdiStatusSendFailed;
+    assert(request_count <= MAX_TX_PAYLOAD_BATCH_ITEM_COUNT);
+    uint64_t start_time = CdiOsGetMicroseconds();
+
+    // Index in request_array of each payload to send. Payloads to endpoints that aren't connected are not sent.
+    int request_index_array[MAX_TX_PAYLOAD_BATCH_ITEM_COUNT];
+    int send_count = 0;
+    for (int i = 0; i < request_count; i++) {
+        AdapterEndpointHandle adapter_endpoint_handle = request_array[i].endpoint_ptr->adapter_endpoint_ptr;
+        if (kCdiConnectionStatusConnected != adapter_endpoint_handle->connection_status_code) {
+            ret_status_array[i] = kCdiStatusNotConnected;
+        } else {
+            ret_status_array[i] = kCdiStatusOk;
+            request_index_array[send_count++] = i;
+        }
     }
 
-    // Clear this list. It will be cleared by TxPayloadThreadFlushResources(). See packet_sgl_entry_pool_handle pool.
-    CdiSinglyLinkedListInit(&payload_state_ptr->completed_packets_list);
+    // Get the payload states. If there aren't enough for all of them, get as many as there are. NOTE: This pool is
+    // thread-safe, since it is used by application thread(s) here and by TxPayloadThread().
+    TxPayloadState* payload_state_array[MAX_TX_PAYLOAD_BATCH_ITEM_COUNT];
+    int state_count = send_count;
+    if (!CdiPoolGetMultiple(con_state_ptr->tx_state.payload_state_pool_handle, send_count,
+                            (void**)payload_state_array)) {
+        state_count = 0;
+        while (state_count < send_count && CdiPoolGet(con_state_ptr->tx_state.payload_state_pool_handle,
+                                                      (void**)&payload_state_array[state_count])) {
+            state_count++;
+        }
+    }
 
-    // Queue message to the application.
-    PayloadTransferComplete(endpoint_ptr, payload_state_ptr);
+    // Initialize the payloads. The ones that fail are dropped from payload_state_array, so it can be pushed as is.
+    int push_count = 0;
+    for (int i = 0; i < send_count; i++) {
+        int request_index = request_index_array[i];
+        if (i >= state_count) {
+            // Since the payload state pool does not grow, the payload queue must be full.
+            ret_status_array[request_index] = kCdiStatusQueueFull;
+        } else if (!TxPayloadStateInit(&request_array[request_index], start_time, payload_state_array[i])) {
+            ret_status_array[request_index] = kCdiStatusAllocationFailed;
+            TxPayloadStateFree(con_state_ptr, payload_state_array[i]);
+        } else {
+            request_index_array[push_count] = request_index;
+            payload_state_array[push_count++] = payload_state_array[i];
+        }
+    }
+
+    int pushed_count = CdiQueuePushMultiple(con_state_ptr->tx_state.payload_queue_handle, payload_state_array,
+                                            push_count);
+    for (int i = pushed_count; i < push_count; i++) {
+        // Queue was full, put the allocated memory back in the pools.
+        ret_status_array[request_index_array[i]] = kCdiStatusQueueFull;
+        TxPayloadStateFree(con_state_ptr, payload_state_array[i]);
+    }
 }
 
 //*********************************************************************************************************************
@@ -725,14 +1295,20 @@ CdiReturnStatus TxStreamConnectionCreateInternal(CdiTxConfigData* config_data_pt
 CdiReturnStatus TxStreamEndpointCreateInternal(CdiConnectionHandle handle, CdiTxConfigDataStream* stream_config_ptr,
                                                CdiEndpointHandle* ret_handle_ptr)
 {
-    return EndpointManagerTxCreateEndpoint(handle->endpoint_manager_handle, true,
-                                           stream_config_ptr->dest_ip_addr_str, stream_config_ptr->dest_port,
-                                           stream_config_ptr->stream_name_str, ret_handle_ptr);
+    CdiReturnStatus rs = EndpointManagerTxCreateEndpoint(handle->endpoint_manager_handle, true,
+                                                         stream_config_ptr->dest_ip_addr_str,
+                                                         stream_config_ptr->dest_port,
+                                                         stream_config_ptr->stream_name_str, ret_handle_ptr);
+    if (kCdiStatusOk == rs) {
+        // Set before the handle is returned, so it is in place before any payload is sent to the endpoint.
+        (*ret_handle_ptr)->tx_priority = stream_config_ptr->priority;
+    }
+    return rs;
 }
 
 CdiReturnStatus TxPayloadInternal(CdiEndpointState* endpoint_ptr, const CdiCoreTxPayloadConfig* core_payload_config_ptr,
                                   const CdiSgList* sgl_ptr, int max_latency_microsecs, int extra_data_size,
-                                  uint8_t* extra_data_ptr)
+                                  uint8_t* extra_data_ptr, bool replace)
 {
     assert(sgl_ptr->total_data_size > 0);
 
@@ -753,45 +1329,16 @@ CdiReturnStatus TxPayloadInternal(CdiEndpointState* endpoint_ptr, const CdiCoreT
         // so return the queue full status here.
         rs = kCdiStatusQueueFull;
     } else {
-        memset((void*)payload_state_ptr, 0, sizeof(TxPayloadState));
-
-        payload_state_ptr->app_payload_cb_data.core_extra_data = core_payload_config_ptr->core_extra_data;
-        payload_state_ptr->app_payload_cb_data.tx_payload_user_cb_param = core_payload_config_ptr->user_cb_param;
-        payload_state_ptr->start_time = start_time;
-        payload_state_ptr->max_latency_microsecs = max_latency_microsecs;
-        CdiSinglyLinkedListInit(&payload_state_ptr->completed_packets_list);
-
-        // Calculate the size of a group of units of unit_size.
-        int group_size = 1; // How many units of unit_size need to be grouped to be byte aligned.
-        if (core_payload_config_ptr->unit_size > 0) {
-            switch (core_payload_config_ptr->unit_size % 8) {
-                case 0:
-                    group_size = 1;
-                    break;
-                case 2:
-                    group_size = 4;
-                    break;
-                case 4:
-                    group_size = 2;
-                    break;
-                case 6:
-                    group_size = 4;
-                    break;
-                default: // For a fixed unit_size worst case of 8 units together will always be byte aligned.
-                    group_size = 8;
-                    break;
-            }
-        }
-        payload_state_ptr->group_size_bytes = (group_size * core_payload_config_ptr->unit_size) / 8;
-
-        payload_state_ptr->app_payload_cb_data.extra_data_size = extra_data_size;
-        if (extra_data_size) {
-            memcpy(&payload_state_ptr->app_payload_cb_data.extra_data_array, extra_data_ptr, extra_data_size);
-        }
-
-        payload_state_ptr->cdi_endpoint_handle = endpoint_ptr; // Save the endpoint used to send this payload.
-
-        if (!PayloadInit(con_state_ptr, sgl_ptr, payload_state_ptr)) {
+        const TxPayloadRequest request = {
+            .endpoint_ptr = endpoint_ptr,
+            .core_payload_config_ptr = core_payload_config_ptr,
+            .sgl_ptr = sgl_ptr,
+            .max_latency_microsecs = max_latency_microsecs,
+            .extra_data_size = extra_data_size,
+            .extra_data_ptr = extra_data_ptr,
+            .replace = replace
+        };
+        if (!TxPayloadStateInit(&request, start_time, payload_state_ptr)) {
             rs = kCdiStatusAllocationFailed;
         } else {
             // Put Tx payload message into the payload queue. The TxPayloadThread() thread will then process the
@@ -803,23 +1350,55 @@ CdiReturnStatus TxPayloadInternal(CdiEndpointState* endpoint_ptr, const CdiCoreT
         }
 
         if (kCdiStatusOk != rs) {
-            // An error occurred, so free pool buffers reserved here and in CdiPayloadInit().
-            CdiSglEntry* entry_ptr = payload_state_ptr->source_sgl.sgl_head_ptr;
-            while (entry_ptr) {
-                CdiSglEntry* next_ptr = entry_ptr->next_ptr; // Save next entry, since Put() will free its memory.
-                CdiPoolPut(con_state_ptr->tx_state.payload_sgl_entry_pool_handle, entry_ptr);
-                entry_ptr = next_ptr;
-            }
-            CdiPoolPut(con_state_ptr->tx_state.payload_state_pool_handle, payload_state_ptr);
+            TxPayloadStateFree(con_state_ptr, payload_state_ptr);
         }
     }
     return rs;
 }
 
+CdiReturnStatus TxPayloadMultipleInternal(const TxPayloadRequest* request_array, int request_count,
+                                          CdiReturnStatus* ret_status_array)
+{
+    // Send each run of consecutive requests to the endpoints of the same connection as a batch.
+    int run_start = 0;
+    while (run_start < request_count) {
+        CdiConnectionState* con_state_ptr = request_array[run_start].endpoint_ptr->connection_state_ptr;
+        int run_count = 1;
+        while (run_start + run_count < request_count && run_count < MAX_TX_PAYLOAD_BATCH_ITEM_COUNT &&
+               con_state_ptr == request_array[run_start + run_count].endpoint_ptr->connection_state_ptr) {
+            run_count++;
+        }
+        TxPayloadSendRun(con_state_ptr, &request_array[run_start], run_count, &ret_status_array[run_start]);
+        run_start += run_count;
+    }
+
+    for (int i = 0; i < request_count; i++) {
+        if (kCdiStatusOk != ret_status_array[i]) {
+            return ret_status_array[i];
+        }
+    }
+    return kCdiStatusOk;
+}
+
+CdiReturnStatus TxPayloadCancelInternal(CdiConnectionHandle con_handle, CdiUserCbParameter user_cb_param)
+{
+    // The payloads are owned by TxPayloadThread(), so it performs the request. By then, payloads sent after this
+    // function returns may have reached the lanes, so the request only applies to the sequence numbers taken so far.
+    TxCancelRequest request = {
+        .user_cb_param = user_cb_param,
+        .send_sequence_num = CdiOsAtomicRead32(&con_handle->tx_state.send_sequence_num)
+    };
+    if (!CdiQueuePush(con_handle->tx_state.cancel_queue_handle, &request)) {
+        return kCdiStatusQueueFull;
+    }
+    return kCdiStatusOk;
+}
+
 void TxPayloadThreadFlushResources(CdiEndpointState* endpoint_ptr)
 {
     CdiConnectionState* con_state_ptr = (CdiConnectionState*)endpoint_ptr->connection_state_ptr;
     CdiQueueFlush(con_state_ptr->tx_state.payload_queue_handle);
+    CdiQueueFlush(con_state_ptr->tx_state.cancel_queue_handle);
 
     // Process items in the work request completion queue. This will drain the queue and free associated resources
     // (ie. work_request_pool_handle) before we manually remove resources below. PayloadTransferComplete() has already
@@ -843,15 +1422,7 @@ void TxPayloadThreadFlushResources(CdiEndpointState* endpoint_ptr)
             }
         }
 
-        // Free all packet SGL entries related to this work request. This will free all entries that have been
-        // completed successfully and ones that have not.
-        CdiSglEntry* packet_entry_hdr_ptr = work_request_ptr->packet.sg_list.sgl_head_ptr;
-        if (packet_entry_hdr_ptr) {
-            // Put back SGL entry for each one in the list.
-            FreeSglEntries(con_state_ptr->tx_state.packet_sgl_entry_pool_handle, packet_entry_hdr_ptr);
-        }
-
-        // Put back work request into the pool.
+        // Put back work request into the pool. Its packet SGL entries are embedded, so go with it.
         PutWorkRequestInPool(con_state_ptr, work_request_ptr);
         work_request_ptr = NULL; // Pointer is no longer valid, so clear it.
     }
@@ -874,7 +1445,6 @@ void TxPayloadThreadFlushResources(CdiEndpointState* endpoint_ptr)
     CdiPoolPutAll(con_state_ptr->tx_state.payload_state_pool_handle);
     // Don't free tx_state.payload_sgl_entry_pool_handle here. AppCallbackPayloadThread() frees them. When a connection
     // is destroyed, the pool is flushed in TxConnectionDestroyInternal().
-    CdiPoolPutAll(con_state_ptr->tx_state.packet_sgl_entry_pool_handle);
 
     // NOTE: Don't flush app_payload_message_queue_handle here. Entries are popped using AppCallbackPayloadThread().
     // When a connection is destroyed, they are flushed in TxConnectionDestroyInternal().
@@ -924,9 +1494,6 @@ void TxConnectionDestroyInternal(CdiConnectionHandle con_handle)
         CdiPoolDestroy(con_state_ptr->tx_state.payload_state_pool_handle);
         con_state_ptr->tx_state.payload_state_pool_handle = NULL;
 
-        CdiPoolDestroy(con_state_ptr->tx_state.packet_sgl_entry_pool_handle);
-        con_state_ptr->tx_state.packet_sgl_entry_pool_handle = NULL;
-
         // Free Tx header pool entries from each item in the work request pool.
         CdiPoolForEachItem(con_state_ptr->tx_state.work_request_pool_handle, TxPacketWorkRequestPoolItemFree, NULL);
         CdiPoolDestroy(con_state_ptr->tx_state.work_request_pool_handle);
@@ -935,6 +1502,9 @@ void TxConnectionDestroyInternal(CdiConnectionHandle con_handle)
         CdiQueueDestroy(con_state_ptr->tx_state.payload_queue_handle);
         con_state_ptr->tx_state.payload_queue_handle = NULL;
 
+        CdiQueueDestroy(con_state_ptr->tx_state.cancel_queue_handle);
+        con_state_ptr->tx_state.cancel_queue_handle = NULL;
+
         // NOTE: con_state_ptr is freed by the caller.
     }
 }
@@ -951,55 +1521,75 @@ void TxPacketWorkRequestComplete(void* param_ptr, Packet* packet_ptr, EndpointMe
 {
     assert(kEndpointMessageTypePacketSent == message_type);
     (void)message_type;
+
+    TxPacketWorkRequestsComplete(param_ptr, &packet_ptr, 1);
+}
+
+void TxPacketWorkRequestsComplete(void* param_ptr, Packet** packet_array, int packet_count)
+{
     CdiEndpointState* endpoint_ptr = (CdiEndpointState*)param_ptr;
     CdiConnectionState* con_state_ptr = endpoint_ptr->connection_state_ptr;
 
-    CdiAdapterTxPacketComplete(endpoint_ptr->adapter_endpoint_ptr, packet_ptr);
+    CdiAdapterTxPacketsComplete(endpoint_ptr->adapter_endpoint_ptr, packet_array, packet_count);
 
-    if (kAdapterPacketStatusNotConnected == packet_ptr->tx_state.ack_status) {
-        return;
-    }
+    // Work requests of the payloads completed by this batch of packets. They are queued with a single push, so
+    // TxPayloadThread() can free the allocated resources.
+    CdiSinglyLinkedList completed_list;
+    CdiSinglyLinkedListInit(&completed_list);
 
-    // The internal_data_ptr contains a work request pointer that was set in TxPayloadThread().
-    TxPacketWorkRequest* work_request_ptr = (TxPacketWorkRequest*)packet_ptr->sg_list.internal_data_ptr;
+    for (int i = 0; i < packet_count; i++) {
+        Packet* packet_ptr = packet_array[i];
+        if (kAdapterPacketStatusNotConnected == packet_ptr->tx_state.ack_status) {
+            continue;
+        }
 
-    // Now that we have our work request, we can setup additional state data pointers.
-    TxPayloadState* payload_state_ptr = work_request_ptr->payload_state_ptr;
+        // The internal_data_ptr contains a work request pointer that was set in TxPayloadThread().
+        TxPacketWorkRequest* work_request_ptr = (TxPacketWorkRequest*)packet_ptr->sg_list.internal_data_ptr;
 
-    // Check if the packet is from the payload that we are currently processing.
-    if (payload_state_ptr->payload_packet_state.payload_num != work_request_ptr->payload_num) {
-        CDI_LOG_THREAD(kLogWarning, "Connection[%s] packet for payload[%d] not from current payload[%d]",
-                       endpoint_ptr->connection_state_ptr->saved_connection_name_str,
-                       payload_state_ptr->payload_packet_state.payload_num, work_request_ptr->payload_num);
-    } else {
+        // Now that we have our work request, we can setup additional state data pointers.
+        TxPayloadState* payload_state_ptr = work_request_ptr->payload_state_ptr;
+
+        // Check if the packet is from the payload that we are currently processing.
+        if (payload_state_ptr->payload_packet_state.payload_num != work_request_ptr->payload_num) {
+            CDI_LOG_THREAD(kLogWarning, "Connection[%s] packet for payload[%d] not from current payload[%d]",
+                           endpoint_ptr->connection_state_ptr->saved_connection_name_str,
+                           payload_state_ptr->payload_packet_state.payload_num, work_request_ptr->payload_num);
+            continue;
+        }
         payload_state_ptr->data_bytes_transferred += work_request_ptr->packet_payload_size;
 
         if (kPayloadTypeKeepAlive == payload_state_ptr->payload_packet_state.payload_type) {
             // Payload type is keep alive. Keep it internal and do not use the application callback. Nothing special to
             // do here, unless payload data was allocated dynamically using a pool. If so, will need to free it here.
-        } else {
-            CdiSinglyLinkedListPushTail(&payload_state_ptr->completed_packets_list,
-                                        (void*)&work_request_ptr->packet.list_entry);
-
-            if (payload_state_ptr->data_bytes_transferred >= payload_state_ptr->source_sgl.total_data_size) {
-                // Payload transfer complete. Pointer is freed below in PayloadTransferComplete(). Clear it now so it
-                // cannot be accidentally used later.
-                work_request_ptr->payload_state_ptr = NULL;
-
-                // Put list of work requests in queue so TxPayloadThread() can free the allocated resources.
-                if (!CdiQueuePush(con_state_ptr->tx_state.work_req_comp_queue_handle,
-                                  &payload_state_ptr->completed_packets_list)) {
-                    CDI_LOG_THREAD(kLogError, "Queue[%s] full, push failed.",
-                                   CdiQueueGetName(con_state_ptr->tx_state.work_req_comp_queue_handle));
-                }
-                work_request_ptr = NULL; // Pointer may no longer be valid, so clear it now.
-
-                // Updates stats and puts message in queue to call the user registered Tx callback function.
-                PayloadTransferComplete(endpoint_ptr, payload_state_ptr);
-                payload_state_ptr = NULL; // Pointer is no longer valid.
-            }
+            continue;
+        }
+        CdiSinglyLinkedListPushTail(&payload_state_ptr->completed_packets_list,
+                                    (void*)&work_request_ptr->packet.list_entry);
+
+        if (payload_state_ptr->data_bytes_transferred >= payload_state_ptr->source_sgl.total_data_size) {
+            // Payload transfer complete. Pointer is freed below in PayloadTransferComplete(). Clear it now so it cannot
+            // be accidentally used later.
+            work_request_ptr->payload_state_ptr = NULL;
+            work_request_ptr = NULL; // Pointer may no longer be valid once queued, so clear it now.
+
+            // Move the payload's list of work requests to the batch's list.
+            CdiSinglyLinkedList* packet_list_ptr = &payload_state_ptr->completed_packets_list;
+            CdiSinglyLinkedListPushListHead(&completed_list, packet_list_ptr->head_ptr, packet_list_ptr->tail_ptr,
+                                            packet_list_ptr->num_entries);
+            CdiSinglyLinkedListInit(packet_list_ptr);
+
+            // Updates stats and puts message in queue to call the user registered Tx callback function.
+            PayloadTransferComplete(endpoint_ptr, payload_state_ptr);
+            payload_state_ptr = NULL; // Pointer is no longer valid.
         }
     }
+
+    // Put list of work requests in queue so TxPayloadThread() can free the allocated resources.
+    if (!CdiSinglyLinkedListIsEmpty(&completed_list) &&
+        !CdiQueuePush(con_state_ptr->tx_state.work_req_comp_queue_handle, &completed_list)) {
+        CDI_LOG_THREAD(kLogError, "Queue[%s] full, push failed.",
+                       CdiQueueGetName(con_state_ptr->tx_state.work_req_comp_queue_handle));
+    }
 }
 
 void TxInvokeAppPayloadCallback(CdiConnectionState* con_state_ptr, AppPayloadCallbackData* app_cb_data_ptr)
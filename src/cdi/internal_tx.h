@@ -48,6 +48,9 @@ typedef struct {
     uint16_t payload_num;              ///< Packet payload number.
     uint16_t packet_payload_size;      ///< Size of payload, not including the packet header.
     Packet packet;                     ///< The top level packet structure for the data in this work request.
+    /// @brief SGL entries of the packet. Entry zero holds the packet header, the others reference payload data. They are
+    /// owned by the work request, so they are released along with it.
+    CdiSglEntry sgl_entry_array[MAX_TX_SGL_PACKET_ENTRIES];
 
     /// @brief Handle of pool associated with header pointer in structure below. If non-null then header pointer is
     /// valid. If payload_state_ptr->app_payload_cb_data.extra_data_size is non-zero, then extra_header_ptr is used,
@@ -64,6 +67,19 @@ typedef struct {
     };
 } TxPacketWorkRequest;
 
+/**
+ * @brief A payload to send with TxPayloadMultipleInternal(). The members are the parameters of TxPayloadInternal().
+ */
+typedef struct {
+    CdiEndpointState* endpoint_ptr;                         ///< Endpoint to send the payload to.
+    const CdiCoreTxPayloadConfig* core_payload_config_ptr;  ///< Pointer to core payload configuration.
+    const CdiSgList* sgl_ptr;                               ///< SGL of the payload's data.
+    int max_latency_microsecs;                              ///< Maximum latency of the payload in microseconds.
+    int extra_data_size;                                    ///< Number of extra data bytes.
+    const uint8_t* extra_data_ptr;                          ///< Pointer to extra data bytes.
+    bool replace;                                           ///< See CdiAvmEndpointTxPayloadReplace().
+} TxPayloadRequest;
+
 //*********************************************************************************************************************
 //******************************************* START OF PUBLIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
@@ -80,10 +96,27 @@ CdiReturnStatus TxStreamConnectionCreateInternal(CdiTxConfigData* config_data_pt
 CdiReturnStatus TxStreamEndpointCreateInternal(CdiConnectionHandle handle, CdiTxConfigDataStream* stream_config_ptr,
                                                CdiEndpointHandle* ret_handle_ptr);
 
-/// @see CdiRawTxPayload
+/// @see CdiRawTxPayload. If replace is true, see CdiAvmEndpointTxPayloadReplace.
 CdiReturnStatus TxPayloadInternal(CdiEndpointState* endpoint_ptr, const CdiCoreTxPayloadConfig* core_payload_config_ptr,
                                   const CdiSgList* sgl_ptr, int max_latency_microsecs, int extra_data_size,
-                                  uint8_t* extra_data_ptr);
+                                  uint8_t* extra_data_ptr, bool replace);
+
+/**
+ * Send multiple payloads, which can be sent to endpoints of different connections. Each run of consecutive payloads to
+ * endpoints of the same connection, up to MAX_TX_PAYLOAD_BATCH_ITEM_COUNT long, takes its payload states with a single
+ * pool operation and is pushed to the connection's payload queue with a single queue operation.
+ *
+ * @param request_array Array of payloads to send.
+ * @param request_count Number of payloads in request_array.
+ * @param ret_status_array Array where the status of each payload is written.
+ *
+ * @return kCdiStatusOk if all the payloads were sent, otherwise the status of the first one that was not.
+ */
+CdiReturnStatus TxPayloadMultipleInternal(const TxPayloadRequest* request_array, int request_count,
+                                          CdiReturnStatus* ret_status_array);
+
+/// @see CdiCoreTxPayloadCancel
+CdiReturnStatus TxPayloadCancelInternal(CdiConnectionHandle con_handle, CdiUserCbParameter user_cb_param);
 
 /**
  * Join Tx connection threads as part of shutting down a connection. This function waits for them to stop.
@@ -112,6 +145,17 @@ void TxEndpointDestroy(CdiEndpointHandle handle);
  */
 void TxPacketWorkRequestComplete(void* param_ptr, Packet* packet_ptr, EndpointMessageType message_type);
 
+/**
+ * An array of packets has been acknowledged. Same as TxPacketWorkRequestComplete() for each packet, except that the
+ * work requests of all the payloads completed by the packets are queued for TxPayloadThread() to free with a single
+ * queue operation.
+ *
+ * @param param_ptr Pointer to the endpoint that the packets were transmitted on as a void*.
+ * @param packet_array Array of pointers to packet state data.
+ * @param packet_count Number of packets in packet_array.
+ */
+void TxPacketWorkRequestsComplete(void* param_ptr, Packet** packet_array, int packet_count);
+
 /**
  * Invoke the user registered Tx callback function for a payload.
  *
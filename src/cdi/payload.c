@@ -29,20 +29,10 @@
 //*********************************************************************************************************************
 
 /**
- * @brief Structure to store the current state of a packet being constructed. Its purpose is to allow for the suspension
- * of the creation of a packet if a pool from which items need to be allocated is empty. A state object is passed in to
- * CdiPayloadInit() prior to calls to CdiPayloadParseCDIPacket() for a given payload.
+ * @brief Structure to store the state of the packet being constructed. A state object is passed in to
+ * PayloadPacketizerStateInit() prior to calls to PayloadPacketizerPacketGet() for a given payload.
  */
 typedef struct {
-    /// The state of the packetizer so that CdiPayloadPacketizerPacketGet()'s progress on a given packet can be
-    /// suspended for lack of resources and resumed in a subsequent call.
-    enum {
-        kStateInactive,     ///< This is the first time CdiPayloadPacketizerPacketGet() has been called for a given packet.
-        kStateAddingHeader, ///< The packetizer is attempting to add the SGL entry for the CDI packet header.
-        kStateAddingEntries ///< The packetizer is adding the payload SGL entries.
-    } state;
-
-    CdiSglEntry* packet_entry_hdr_ptr; ///< Pointer to the current payload SGL entry being consumed.
     int header_size;                   ///< The size of the header computed for this packet.
     int accumulated_payload_bytes;     ///< The number of payload bytes collected so far into the current packet.
     int sgl_entry_count;               ///< The number of SGL entries used so far to represent the current packet.
@@ -58,6 +48,30 @@ typedef struct {
 //******************************************* START OF STATIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
 
+/**
+ * Get the maximum number of payload data bytes that can be put into a packet.
+ *
+ * @param maximum_packet_byte_size Maximum size of packets in bytes.
+ * @param header_size Size in bytes of the message prefix and CDI header of the packet.
+ * @param group_size_bytes Packet payload data must be a multiple of this size, if not zero.
+ *
+ * @return Maximum number of payload data bytes.
+ */
+static int MaxPacketPayloadBytes(int maximum_packet_byte_size, int header_size, int group_size_bytes)
+{
+    int max_payload_bytes = maximum_packet_byte_size - header_size;
+    if (group_size_bytes > 0) {
+        // If the pattern size is larger than the max payload then do not modify the payload size.
+        if (group_size_bytes <= max_payload_bytes) {
+            max_payload_bytes = PrevMultipleOf(max_payload_bytes, group_size_bytes);
+        } else {
+            CDI_LOG_THREAD(kLogWarning, "Payload unit size [%d] bytes is larger than available packet data [%d] bytes",
+                           group_size_bytes, max_payload_bytes);
+        }
+    }
+    return max_payload_bytes;
+}
+
 //*********************************************************************************************************************
 //******************************************* START OF PUBLIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
@@ -72,8 +86,10 @@ bool PayloadInit(CdiConnectionState* con_state_ptr, const CdiSgList* source_sgl_
     packet_state_ptr->payload_type = kPayloadTypeData;
     packet_state_ptr->maximum_packet_byte_size =
         payload_state_ptr->cdi_endpoint_handle->adapter_endpoint_ptr->maximum_payload_bytes;
+    // Packet SGL entries are embedded in the Tx packet work requests, which limits how many a packet can use.
     packet_state_ptr->maximum_tx_sgl_entries =
-        payload_state_ptr->cdi_endpoint_handle->adapter_endpoint_ptr->maximum_tx_sgl_entries;
+        CDI_MIN(payload_state_ptr->cdi_endpoint_handle->adapter_endpoint_ptr->maximum_tx_sgl_entries,
+                MAX_TX_SGL_PACKET_ENTRIES);
     packet_state_ptr->payload_num = 0;
     packet_state_ptr->packet_sequence_num = 0;
     // NOTE: source_entry_ptr is set below to point to the head of the copy of the SGL.
@@ -120,7 +136,7 @@ CdiPacketizerStateHandle PayloadPacketizerCreate(void)
 
 void PayloadPacketizerStateInit(CdiPacketizerStateHandle packetizer_state_handle)
 {
-    ((CdiPacketizerState*)packetizer_state_handle)->state = kStateInactive;
+    memset(packetizer_state_handle, 0, sizeof(CdiPacketizerState));
 }
 
 void PayloadPacketizerDestroy(CdiPacketizerStateHandle packetizer_state_handle)
@@ -130,146 +146,96 @@ void PayloadPacketizerDestroy(CdiPacketizerStateHandle packetizer_state_handle)
     }
 }
 
-bool PayloadPacketizerPacketGet(CdiProtocolHandle protocol_handle, CdiPacketizerStateHandle packetizer_state_handle,
-                                char* header_ptr, int header_buffer_size, CdiPoolHandle packet_sgl_entry_pool_handle,
+void PayloadPacketizerPacketGet(CdiProtocolHandle protocol_handle, CdiPacketizerStateHandle packetizer_state_handle,
+                                char* header_ptr, int header_buffer_size, CdiSglEntry* sgl_entry_array,
                                 TxPayloadState* payload_state_ptr, CdiSgList* packet_sgl_ptr,
                                 bool* ret_is_last_packet_ptr)
 {
-    bool ret = true;
-
     CdiPacketizerState* packetizer_state_ptr = (CdiPacketizerState*)packetizer_state_handle;
     CdiPayloadPacketState* packet_state_ptr = &payload_state_ptr->payload_packet_state;
 
-    if (kStateInactive == packetizer_state_ptr->state) {
-        // Initialize all data and pointers used in the SGL list.
-        memset((void*)packet_sgl_ptr, 0, sizeof(*packet_sgl_ptr));
-
-        // Create new SGL entry for the payload data to hold the CDI header and first part of the payload data.
-        packetizer_state_ptr->packet_entry_hdr_ptr = NULL;
-
-        packetizer_state_ptr->state = kStateAddingHeader;
-    }
-
-    if (kStateAddingHeader == packetizer_state_ptr->state) {
-        // NOTE: All the pools used in this function are not thread-safe, so must ensure that only one thread is
-        // accessing them at a time.
-#ifdef USE_MEMORY_POOL_APPENDED_LISTS
-        ret = CdiPoolGetAndAppend(packet_sgl_entry_pool_handle, packet_sgl_ptr->sgl_tail_ptr,
-                                  (void**)&packetizer_state_ptr->packet_entry_hdr_ptr);
-#else
-        ret = CdiPoolGet(packet_sgl_entry_pool_handle, (void**)&packetizer_state_ptr->packet_entry_hdr_ptr);
-#endif
-        if (ret) {
-            // Initialize SGL entry.
-            packetizer_state_ptr->packet_entry_hdr_ptr->next_ptr = NULL;
-            packetizer_state_ptr->packet_entry_hdr_ptr->internal_data_ptr = NULL;
-
-            // Include message prefix buffer space in header part.
-            int msg_prefix_size = payload_state_ptr->cdi_endpoint_handle->adapter_endpoint_ptr->msg_prefix_size;
-            packetizer_state_ptr->header_size = msg_prefix_size;
-
-            // Initialize the protocol specific packet header data.
-            payload_state_ptr->payload_packet_state.packet_id = payload_state_ptr->cdi_endpoint_handle->tx_state.packet_id;
-            packetizer_state_ptr->header_size += ProtocolPayloadHeaderInit(protocol_handle,
-                header_ptr + msg_prefix_size, header_buffer_size, payload_state_ptr);
-
-            // Setup SGL entry for our header and add it to the packet SGL.
-            packetizer_state_ptr->packet_entry_hdr_ptr->address_ptr = header_ptr;
-            packetizer_state_ptr->packet_entry_hdr_ptr->size_in_bytes = packetizer_state_ptr->header_size;
-            SglAppend(packet_sgl_ptr, packetizer_state_ptr->packet_entry_hdr_ptr); // NOTE: SGL list size is updated.
-
-            // Try to fill an entire packet, either by using part of a large SGL entry and/or multiple smaller SGL
-            // entries.
-            packetizer_state_ptr->max_payload_bytes =
-                packet_state_ptr->maximum_packet_byte_size - packetizer_state_ptr->header_size;
-            if (payload_state_ptr->group_size_bytes > 0) {
-                // If the pattern size is larger than the max payload then do not modify the payload size.
-                if (payload_state_ptr->group_size_bytes <= packetizer_state_ptr->max_payload_bytes) {
-                    packetizer_state_ptr->max_payload_bytes = PrevMultipleOf(packetizer_state_ptr->max_payload_bytes,
-                                                                             payload_state_ptr->group_size_bytes);
-                } else {
-                    CDI_LOG_THREAD(kLogWarning,
-                                   "Payload unit size [%d] bytes is larger than available packet data [%d] bytes",
-                                   payload_state_ptr->group_size_bytes, packetizer_state_ptr->max_payload_bytes);
-                }
-            }
-
-            packetizer_state_ptr->accumulated_payload_bytes = 0;
-            packetizer_state_ptr->sgl_entry_count = 1; // Allow for CDI header created above.
-            packetizer_state_ptr->data_addr_ptr = (uint8_t*)packet_state_ptr->source_entry_ptr->address_ptr +
-                                                  packet_state_ptr->source_entry_address_offset;
-
-            packetizer_state_ptr->state = kStateAddingEntries;
+    // Initialize all data and pointers used in the SGL list.
+    memset((void*)packet_sgl_ptr, 0, sizeof(*packet_sgl_ptr));
+
+    // Include message prefix buffer space in header part.
+    int msg_prefix_size = payload_state_ptr->cdi_endpoint_handle->adapter_endpoint_ptr->msg_prefix_size;
+    packetizer_state_ptr->header_size = msg_prefix_size;
+
+    // Initialize the protocol specific packet header data. Data offset packets only differ in a few fields, so their
+    // headers are copied from a template that is built along with the header of packet #0.
+    packet_state_ptr->packet_id = payload_state_ptr->cdi_endpoint_handle->tx_state.packet_id;
+    if (0 != packet_state_ptr->packet_sequence_num && kPayloadTypeDataOffset == packet_state_ptr->payload_type) {
+        packetizer_state_ptr->header_size += ProtocolPayloadHeaderFromTemplate(protocol_handle,
+            &packet_state_ptr->header_template, header_ptr + msg_prefix_size, header_buffer_size, packet_state_ptr);
+    } else {
+        packetizer_state_ptr->header_size += ProtocolPayloadHeaderInit(protocol_handle, header_ptr + msg_prefix_size,
+                                                                       header_buffer_size, payload_state_ptr);
+        if (0 == packet_state_ptr->packet_sequence_num) {
+            ProtocolPayloadHeaderTemplateInit(protocol_handle, &packet_state_ptr->header_template, payload_state_ptr);
         }
     }
 
-    if (kStateAddingEntries == packetizer_state_ptr->state) {
-        // Break out of this loop if we filled the packet, or we ran out of source SGL entries, or we have reached the
-        // maximum number of SGL entries supported by the underlying adapter.
-        while (ret &&
-               packetizer_state_ptr->accumulated_payload_bytes < packetizer_state_ptr->max_payload_bytes &&
-               packetizer_state_ptr->sgl_entry_count < packet_state_ptr->maximum_tx_sgl_entries &&
-               NULL != packet_state_ptr->source_entry_ptr) {
-            // Create new SGL entry for the payload data and add it to the packet SGL.
-            CdiSglEntry *packet_entry_ptr = NULL;
-#ifdef USE_MEMORY_POOL_APPENDED_LISTS
-            ret = CdiPoolGetAndAppend(packet_sgl_entry_pool_handle, packet_sgl_ptr->sgl_tail_ptr,
-                                        (void**)&packet_entry_data_ptr);
-#else
-            ret = CdiPoolGet(packet_sgl_entry_pool_handle, (void**)&packet_entry_ptr);
-#endif
-            if (ret) {
-                const int sgl_data_size = CDI_MIN(packet_state_ptr->source_entry_ptr->size_in_bytes -
-                                                  packet_state_ptr->source_entry_address_offset,
-                                                  packetizer_state_ptr->max_payload_bytes -
-                                                  packetizer_state_ptr->accumulated_payload_bytes);
-
-                // Initialize SGL entry.
-                packet_entry_ptr->next_ptr = NULL;
-                packet_entry_ptr->internal_data_ptr = NULL;
-
-                // Set SGL entry data and add it to the SGL list.
-                packet_entry_ptr->address_ptr = packetizer_state_ptr->data_addr_ptr;
-                packet_entry_ptr->size_in_bytes = sgl_data_size;
-                SglAppend(packet_sgl_ptr, packet_entry_ptr); // NOTE: SGL list size is updated in this call.
-                packetizer_state_ptr->sgl_entry_count++;
-
-                packetizer_state_ptr->accumulated_payload_bytes += sgl_data_size;
-                packetizer_state_ptr->data_addr_ptr += sgl_data_size;
-                packet_state_ptr->payload_data_offset += sgl_data_size;
-
-                packet_state_ptr->source_entry_address_offset += sgl_data_size;
-                if (packet_state_ptr->source_entry_address_offset >=
-                    packet_state_ptr->source_entry_ptr->size_in_bytes) {
-                    packet_state_ptr->source_entry_ptr = packet_state_ptr->source_entry_ptr->next_ptr;
-                    packet_state_ptr->source_entry_address_offset = 0;
-                    if (NULL != packet_state_ptr->source_entry_ptr) {
-                        packetizer_state_ptr->data_addr_ptr = packet_state_ptr->source_entry_ptr->address_ptr;
-                    }
-                }
-
-                packet_state_ptr->packet_payload_data_size = packetizer_state_ptr->accumulated_payload_bytes;
-            }
-        }
-
-        *ret_is_last_packet_ptr = false;
-        if (ret) {
-            // Packet was successfully obtained, so update returned last state flag, increment packet counters and
-            // initialize the packet state.
-            if (NULL == packet_state_ptr->source_entry_ptr) {
-                *ret_is_last_packet_ptr = true;
-            } else {
-                // Force subsequent packets to include a data offset in their headers; this packet doesn't need the
-                // offset to be correctly placed on the receive side. The data offset is needed for the receive side
-                // to know where to place the data when its using a linear buffer since packets can arrive out of
-                // order.
-                packet_state_ptr->payload_type = kPayloadTypeDataOffset;
+    // Setup SGL entry zero for our header and add it to the packet SGL.
+    CdiSglEntry* packet_entry_hdr_ptr = &sgl_entry_array[0];
+    packet_entry_hdr_ptr->address_ptr = header_ptr;
+    packet_entry_hdr_ptr->size_in_bytes = packetizer_state_ptr->header_size;
+    packet_entry_hdr_ptr->internal_data_ptr = NULL;
+    packet_entry_hdr_ptr->next_ptr = NULL;
+    SglAppend(packet_sgl_ptr, packet_entry_hdr_ptr); // NOTE: SGL list size is updated.
+
+    // Try to fill an entire packet, either by using part of a large SGL entry and/or multiple smaller SGL entries.
+    packetizer_state_ptr->max_payload_bytes = MaxPacketPayloadBytes(packet_state_ptr->maximum_packet_byte_size,
+        packetizer_state_ptr->header_size, payload_state_ptr->group_size_bytes);
+
+    packetizer_state_ptr->accumulated_payload_bytes = 0;
+    packetizer_state_ptr->sgl_entry_count = 1; // Allow for CDI header created above.
+    packetizer_state_ptr->data_addr_ptr = (uint8_t*)packet_state_ptr->source_entry_ptr->address_ptr +
+                                          packet_state_ptr->source_entry_address_offset;
+
+    // Break out of this loop if we filled the packet, or we ran out of source SGL entries, or we have reached the
+    // maximum number of SGL entries supported by the underlying adapter.
+    while (packetizer_state_ptr->accumulated_payload_bytes < packetizer_state_ptr->max_payload_bytes &&
+           packetizer_state_ptr->sgl_entry_count < packet_state_ptr->maximum_tx_sgl_entries &&
+           NULL != packet_state_ptr->source_entry_ptr) {
+        const int sgl_data_size = CDI_MIN(packet_state_ptr->source_entry_ptr->size_in_bytes -
+                                          packet_state_ptr->source_entry_address_offset,
+                                          packetizer_state_ptr->max_payload_bytes -
+                                          packetizer_state_ptr->accumulated_payload_bytes);
+
+        // Set the next SGL entry to the payload data and add it to the SGL list.
+        CdiSglEntry* packet_entry_ptr = &sgl_entry_array[packetizer_state_ptr->sgl_entry_count];
+        packet_entry_ptr->address_ptr = packetizer_state_ptr->data_addr_ptr;
+        packet_entry_ptr->size_in_bytes = sgl_data_size;
+        packet_entry_ptr->internal_data_ptr = NULL;
+        packet_entry_ptr->next_ptr = NULL;
+        SglAppend(packet_sgl_ptr, packet_entry_ptr); // NOTE: SGL list size is updated in this call.
+        packetizer_state_ptr->sgl_entry_count++;
+
+        packetizer_state_ptr->accumulated_payload_bytes += sgl_data_size;
+        packetizer_state_ptr->data_addr_ptr += sgl_data_size;
+        packet_state_ptr->payload_data_offset += sgl_data_size;
+
+        packet_state_ptr->source_entry_address_offset += sgl_data_size;
+        if (packet_state_ptr->source_entry_address_offset >= packet_state_ptr->source_entry_ptr->size_in_bytes) {
+            packet_state_ptr->source_entry_ptr = packet_state_ptr->source_entry_ptr->next_ptr;
+            packet_state_ptr->source_entry_address_offset = 0;
+            if (NULL != packet_state_ptr->source_entry_ptr) {
+                packetizer_state_ptr->data_addr_ptr = packet_state_ptr->source_entry_ptr->address_ptr;
             }
-            packet_state_ptr->packet_sequence_num++;
-            payload_state_ptr->cdi_endpoint_handle->tx_state.packet_id++;
-            packetizer_state_ptr->state = kStateInactive;
         }
     }
-
-    return ret;
+    packet_state_ptr->packet_payload_data_size = packetizer_state_ptr->accumulated_payload_bytes;
+
+    // Update returned last state flag, increment packet counters and initialize the packet state.
+    *ret_is_last_packet_ptr = false;
+    if (NULL == packet_state_ptr->source_entry_ptr) {
+        *ret_is_last_packet_ptr = true;
+    } else {
+        // Force subsequent packets to include a data offset in their headers; this packet doesn't need the offset to be
+        // correctly placed on the receive side. The data offset is needed for the receive side to know where to place
+        // the data when its using a linear buffer since packets can arrive out of order.
+        packet_state_ptr->payload_type = kPayloadTypeDataOffset;
+    }
+    packet_state_ptr->packet_sequence_num++;
+    payload_state_ptr->cdi_endpoint_handle->tx_state.packet_id++;
 }
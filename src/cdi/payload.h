@@ -35,6 +35,20 @@ typedef enum {
                             ///  callbacks).
 } CdiPayloadType;
 
+/// @brief Size in bytes of the buffer in CdiPacketHeaderTemplate. Must be large enough to hold the data offset packet
+/// header of every protocol version.
+#define CDI_PACKET_HEADER_TEMPLATE_SIZE  (16)
+
+/**
+ * @brief Pre-encoded CDI header of the data offset packets of a payload (all packets other than packet #0). It is built
+ * once per payload by ProtocolPayloadHeaderTemplateInit() so that ProtocolPayloadHeaderFromTemplate() only has to
+ * patch the fields that change from packet to packet.
+ */
+typedef struct {
+    uint8_t header[CDI_PACKET_HEADER_TEMPLATE_SIZE]; ///< Encoded header. Layout is specific to the protocol version.
+    int header_size;                                 ///< Size of the encoded header in bytes.
+} CdiPacketHeaderTemplate;
+
 /**
  * @brief Structure used to hold state data for a single payload.
  */
@@ -55,9 +69,11 @@ typedef struct {
                                          ///  data size of the source SGL entry is larger than the CDI packet data
                                          ///  size (the SGL entry spans more than 1 CDI packet).
     uint32_t payload_data_offset;        ///< Current offset of payload data.
+
+    CdiPacketHeaderTemplate header_template; ///< Header template built when packet #0 of the payload is created.
 } CdiPayloadPacketState;
 
-/// An opaque type for the packetizer to keep track of its progress in case it must be suspended for lack of resources.
+/// An opaque type for the packetizer to keep track of the packet being constructed.
 typedef struct CdiPacketizerState* CdiPacketizerStateHandle;
 
 /// Forward reference of structure to create pointers later.
@@ -114,26 +130,20 @@ void PayloadPacketizerDestroy(CdiPacketizerStateHandle packetizer_state_handle);
 void PayloadPacketizerStateInit(CdiPacketizerStateHandle packetizer_state_handle);
 
 /**
- * Get the next packet for a payload. Must use CdiPayloadPacketizerStateInit() for a new payload before using this
- * function. If false is returned, one of the pools from which required resources are taken is dry so this function
- * should be called again until it returns true.
- *
- * NOTE: All the pools used in this function are not thread-safe, so must ensure that only one thread is accessing them
- * at a time.
+ * Get the next packet for a payload. Must use PayloadPacketizerStateInit() for a new payload before using this
+ * function. The packet's SGL entries are written to the caller provided array, so no resources are allocated.
  *
  * @param protocol_handle Handle of protocol to use.
  * @param packetizer_state_handle Handle of the packetizer state for this connection.
  * @param header_ptr Pointer to the header data structure to be filled in for the new packet.
  * @param header_buffer_size Size of header data buffer in bytes.
- * @param packet_sgl_entry_pool_handle CDI packet SGL list entry pool.
+ * @param sgl_entry_array Array of MAX_TX_SGL_PACKET_ENTRIES SGL entries that the packet SGL list is built from.
  * @param payload_state_ptr Pointer to payload state data.
  * @param packet_sgl_ptr Pointer to returned packet SGL list
  * @param ret_is_last_packet_ptr Pointer to returned last packet state. True if last packet, otherwise false.
- *
- * @return true if packet returned, otherwise a pool was empty so false is returned.
  */
-bool PayloadPacketizerPacketGet(CdiProtocolHandle protocol_handle, CdiPacketizerStateHandle packetizer_state_handle,
-                                char* header_ptr, int header_buffer_size, CdiPoolHandle packet_sgl_entry_pool_handle,
+void PayloadPacketizerPacketGet(CdiProtocolHandle protocol_handle, CdiPacketizerStateHandle packetizer_state_handle,
+                                char* header_ptr, int header_buffer_size, CdiSglEntry* sgl_entry_array,
                                 TxPayloadState* payload_state_ptr, CdiSgList* packet_sgl_ptr,
                                 bool* ret_is_last_packet_ptr);
 
@@ -88,6 +88,8 @@ typedef struct CdiStatsCallbackState* CdiStatsCallbackHandle;
 typedef struct ReceiveBufferState ReceiveBufferState;
 /// Forward reference of structure to create pointers later.
 typedef struct ReceiveBufferState* ReceiveBufferHandle;
+/// Forward reference of structure to create pointers later.
+typedef struct RxCopyEngineState* RxCopyEngineHandle;
 
 /**
  * @brief This enumeration is used in the CdiConnectionState and CdiEndpointState structures to indicate which of the
@@ -139,6 +141,8 @@ typedef struct TxPayloadState TxPayloadState;
  * @brief This defines a structure that contains all of the state information for sending a single payload.
  */
 struct TxPayloadState {
+    /// @brief Allows this structure to be used as part of the list of payloads waiting to be sent by TxPayloadThread().
+    CdiSinglyLinkedListEntry list_entry;
     CdiSgList source_sgl;                       ///< Scatter-Gather List of payload entries to free.
     uint64_t start_time;                        ///< Time payload Tx started.
     uint32_t max_latency_microsecs;             ///< Maximum latency in microseconds of time to transfer the payload.
@@ -154,6 +158,12 @@ struct TxPayloadState {
     CdiSinglyLinkedList completed_packets_list; ///< List of packets for current payload that have been acknowledged.
 
     CdiEndpointHandle cdi_endpoint_handle;  ///< CDI endpoint to use to send this payload.
+    /// @brief Value of TxConState.send_sequence_num taken when the payload was sent. Tells a cancel request which
+    /// payloads were sent before it.
+    uint32_t send_sequence_num;
+    /// @brief True if the payload replaces the payloads of its stream that are waiting to be sent. See
+    /// CdiAvmEndpointTxPayloadReplace().
+    bool replace;
 };
 
 /**
@@ -163,6 +173,16 @@ struct TxPayloadState {
  */
 typedef void (*CdiCallback)(const void* param_ptr);
 
+/**
+ * @brief A request to cancel the payloads sent with a user callback parameter. See CdiCoreTxPayloadCancel().
+ */
+typedef struct {
+    CdiUserCbParameter user_cb_param; ///< User callback parameter of the payloads to cancel.
+    /// @brief Value of TxConState.send_sequence_num when the request was made. Only payloads with this sequence number
+    /// or an earlier one are cancelled.
+    uint32_t send_sequence_num;
+} TxCancelRequest;
+
 /**
  * @brief This defines a structure that contains all of the state information for the sending side of a single flow.
  */
@@ -174,6 +194,12 @@ typedef struct {
     CdiCallback cb_ptr;                         ///< Callback function address.
 
     CdiQueueHandle payload_queue_handle;        ///< Queue of TxPayloadState structures.
+    /// @brief Queue of payload cancel requests (TxCancelRequest). See CdiCoreTxPayloadCancel().
+    CdiQueueHandle cancel_queue_handle;
+
+    /// @brief Sequence number of the last payload sent on the connection. Incremented using atomic operations, since
+    /// payloads can be sent by several application threads.
+    uint32_t send_sequence_num;
 
     /// @brief Memory pool for payload state (TxPayloadState).
     CdiPoolHandle payload_state_pool_handle;
@@ -184,9 +210,6 @@ typedef struct {
     /// @brief Memory pool for work requests (TxPacketWorkRequest). Not thread-safe.
     CdiPoolHandle work_request_pool_handle;
 
-    /// @brief Memory pool for packet SGL entries (CdiSglEntry). Not thread-safe.
-    CdiPoolHandle packet_sgl_entry_pool_handle;
-
     /// @brief Queue of completed work requests that need their resources freed (TxPacketWorkRequest*).
     CdiQueueHandle work_req_comp_queue_handle;
 } TxConState;
@@ -225,6 +248,38 @@ struct CdiReorderList {
     CdiSgList sglist;          ///< Sgl in this reorder list.
 };
 
+/**
+ * @brief A slot of the bitmap packet reorder engine, holding the payload SGL entries of a packet.
+ */
+typedef struct {
+    CdiSglEntry* head_ptr; ///< First payload SGL entry of the packet.
+    CdiSglEntry* tail_ptr; ///< Last payload SGL entry of the packet.
+} RxReorderSlot;
+
+/**
+ * @brief A page of the bitmap packet reorder engine. It holds the packets of RX_REORDER_PAGE_SLOT_COUNT consecutive
+ * sequence numbers that arrived before the packets ahead of them.
+ */
+typedef struct {
+    uint64_t used_bitmap[RX_REORDER_PAGE_SLOT_COUNT / 64]; ///< Bit set for each slot that holds a packet.
+    int used_count;                                        ///< Number of slots that hold a packet.
+    RxReorderSlot slot_array[RX_REORDER_PAGE_SLOT_COUNT];  ///< Slots, indexed by sequence number within the page.
+} RxReorderPage;
+
+/**
+ * @brief Tracks the contiguous data at the start of a payload being received into a linear buffer, so slices of it can
+ * be reported to the application (see CdiRxConfigData.slice_cb_ptr).
+ */
+typedef struct {
+    int next_sequence_num;  ///< Sequence number of the packet that follows the contiguous data, modulo 65536.
+    int contiguous_size;    ///< Number of bytes at the start of the payload that have been copied.
+    int reported_size;      ///< Number of bytes at the start of the payload reported to the application.
+    bool window_overflow;   ///< True if a packet arrived too far ahead to be tracked. No more slices are reported.
+    /// @brief Offset of the end of each copied packet past next_sequence_num, indexed by sequence number modulo
+    /// RX_SLICE_WINDOW_PACKET_COUNT. Zero if the packet has not been copied yet.
+    int end_offset_array[RX_SLICE_WINDOW_PACKET_COUNT];
+} RxSliceState;
+
 /**
  * @brief Enumeration used to maintain payload state.
  */
@@ -256,8 +311,20 @@ typedef struct {
     int expected_payload_data_size;   ///< Expected total payload size in bytes obtained from CDI packet #0 header.
     int data_bytes_received;          ///< Number of payload bytes received.
     CdiReorderList* reorder_list_ptr; ///< Pointer to what will end up being the single SGL that comprises the payload
+    /// @brief Sequence number of the next packet to append to reorder_list_ptr. Only used by the bitmap packet reorder
+    /// engine, which keeps a single list.
+    int reorder_next_sequence_num;
+    /// @brief Number of packets held in reorder_page_array. Only used by the bitmap packet reorder engine.
+    int reorder_held_packet_count;
+    /// @brief Pages of the packets that arrived ahead of reorder_next_sequence_num, indexed by sequence number divided
+    /// by RX_REORDER_PAGE_SLOT_COUNT. A page is only allocated while it holds packets. Only used by the bitmap packet
+    /// reorder engine.
+    RxReorderPage* reorder_page_array[RX_REORDER_PAGE_COUNT];
     uint32_t last_total_packet_count; ///< Value of total_packet_count when most recent packet of the payload was received.
     uint8_t* linear_buffer_ptr;       ///< Address to be used if assembling into a linear buffer.
+    /// @brief Contiguous data reported to the application, from rx_state.slice_state_pool_handle. NULL if slices are not
+    /// reported for the payload.
+    RxSliceState* slice_state_ptr;
 } RxPayloadState;
 
 /**
@@ -275,9 +342,17 @@ typedef struct {
     /// @brief Memory pool for payload SGL entries that arrive out of order (CdiReorderList).
     CdiPoolHandle reorder_entries_pool_handle;
 
+    /// @brief Memory pool for the pages of the bitmap packet reorder engine (RxReorderPage). NULL if the connection
+    /// does not use it (see CdiRxConfigData.bitmap_packet_reorder).
+    CdiPoolHandle reorder_pages_pool_handle;
+
     /// @brief Pool used to hold state data while receiving payloads.
     CdiPoolHandle rx_payload_state_pool_handle;
 
+    /// @brief Memory pool for the slice state of the payloads being received (RxSliceState). NULL if the connection
+    /// does not report slices (see CdiRxConfigData.slice_cb_ptr).
+    CdiPoolHandle slice_state_pool_handle;
+
     /// @brief This is true if the first payload has been received after a connection has been established. This is set
     /// to false whenever a connection is changed and remains false until a payload is received after the connection has
     /// been restablished.
@@ -291,6 +366,11 @@ typedef struct {
     /// @brief Handle to the receive buffer object if the receive delay buffer is enabled. If the receive delay buffer
     /// is disabled, this value is NULL.
     ReceiveBufferHandle receive_buffer_handle;
+
+    /// @brief Handle to the copy engine that copies received packets into linear receive buffers, if the connection
+    /// uses linear buffers and copy threads (see CdiRxConfigData.copy_thread_count). Otherwise, this value is NULL and
+    /// the poll thread copies the packets.
+    RxCopyEngineHandle copy_engine_handle;
 } RxConState;
 
 /**
@@ -344,6 +424,9 @@ struct CdiEndpointState {
     /// statistics data.
     char stream_name_str[CDI_MAX_STREAM_NAME_STRING_LENGTH];
 
+    /// Priority of the payloads sent on this endpoint. Only used by Tx endpoints.
+    CdiTxPriority tx_priority;
+
     union {
         /// The internal state of the structure if ConnectionHandleType is kHandleTypeTx.
         TxEndpointState tx_state;
@@ -401,6 +484,10 @@ struct CdiConnectionState {
     /// Pool of linear buffers in which to store incoming payloads if the connection was created with kCdiLinearBuffer.
     CdiPoolHandle linear_buffer_pool;
 
+    /// @brief NUMA node of the CPU core that the connection's poll thread is pinned to, or CDI_NUMA_NODE_ANY if it is
+    /// not pinned. Pools used by the poll thread are allocated on this node.
+    int numa_node;
+
     /// Indicates which structure of the union is valid.
     ConnectionHandleType handle_type;
     union {
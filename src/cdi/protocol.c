@@ -134,6 +134,22 @@ int ProtocolPayloadHeaderInit(CdiProtocolHandle protocol_handle, void* header_pt
     return (protocol_ptr->api_ptr->header_init)(header_ptr, header_buffer_size, payload_state_ptr);
 }
 
+void ProtocolPayloadHeaderTemplateInit(CdiProtocolHandle protocol_handle, CdiPacketHeaderTemplate* template_ptr,
+                                       const TxPayloadState* payload_state_ptr)
+{
+    CdiProtocolState* protocol_ptr = (CdiProtocolState*)protocol_handle;
+    (protocol_ptr->api_ptr->header_template_init)(template_ptr, payload_state_ptr);
+}
+
+int ProtocolPayloadHeaderFromTemplate(CdiProtocolHandle protocol_handle, const CdiPacketHeaderTemplate* template_ptr,
+                                      void* header_ptr, int header_buffer_size,
+                                      const CdiPayloadPacketState* packet_state_ptr)
+{
+    CdiProtocolState* protocol_ptr = (CdiProtocolState*)protocol_handle;
+    return (protocol_ptr->api_ptr->header_from_template)(template_ptr, header_ptr, header_buffer_size,
+                                                         packet_state_ptr);
+}
+
 void ProtocolPayloadHeaderDecode(CdiProtocolHandle protocol_handle, void* encoded_data_ptr, int encoded_data_size,
                                  CdiDecodedPacketHeader* dest_header_ptr)
 {
@@ -252,6 +252,12 @@ typedef void (*VtblPayloadHeaderDecode)(const void* encoded_data_ptr, int encode
 /// Prototype of function used for protocol version VTable API.
 typedef int (*VtblPayloadHeaderInit)(void* header_ptr, int header_buffer_size, const TxPayloadState* payload_state_ptr);
 /// Prototype of function used for protocol version VTable API.
+typedef void (*VtblPayloadHeaderTemplateInit)(CdiPacketHeaderTemplate* template_ptr,
+                                              const TxPayloadState* payload_state_ptr);
+/// Prototype of function used for protocol version VTable API.
+typedef int (*VtblPayloadHeaderFromTemplate)(const CdiPacketHeaderTemplate* template_ptr, void* header_ptr,
+                                             int header_buffer_size, const CdiPayloadPacketState* packet_state_ptr);
+/// Prototype of function used for protocol version VTable API.
 typedef void (*VtblPayloadPacketRxReorderInfo)(const CdiRawPacketHeader* header_ptr,
                                                CdiPacketRxReorderInfo* ret_info_ptr);
 /// Prototype of function used for protocol version VTable API.
@@ -266,6 +272,8 @@ typedef int (*VtblProbeHeaderEncode)(const CdiDecodedProbeHeader* state_ptr, Cdi
 typedef struct {
     VtblPayloadHeaderDecode header_decode; ///< Function pointer used to decode a raw packet header.
     VtblPayloadHeaderInit header_init; ///< Function pointer used to initialize a raw packet header.
+    VtblPayloadHeaderTemplateInit header_template_init; ///< Function pointer used to build a packet header template.
+    VtblPayloadHeaderFromTemplate header_from_template; ///< Function pointer used to copy and patch a header template.
     VtblPayloadPacketRxReorderInfo rx_reorder_info; ///< Function pointer used to get packet Rx reorder information.
     VtblProbeHeaderDecode probe_decode; ///< Function pointer used to decode a raw probe header.
     VtblProbeHeaderEncode probe_encode; ///< Function pointer used to encode a raw probe header.
@@ -324,6 +332,34 @@ void ProtocolPayloadHeaderDecode(CdiProtocolHandle protocol_handle, void* encode
 int ProtocolPayloadHeaderInit(CdiProtocolHandle protocol_handle, void* header_ptr, int header_buffer_size,
                               const TxPayloadState* payload_state_ptr);
 
+/**
+ * @brief Build the header template used for the data offset packets of a payload (all packets other than packet #0).
+ * Only the fields that are the same for every one of these packets are meaningful in the template.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param template_ptr Address where to write the header template.
+ * @param payload_state_ptr Pointer to TX payload state data.
+ */
+void ProtocolPayloadHeaderTemplateInit(CdiProtocolHandle protocol_handle, CdiPacketHeaderTemplate* template_ptr,
+                                       const TxPayloadState* payload_state_ptr);
+
+/**
+ * @brief Initialize the raw header of a data offset packet by copying a template built by
+ * ProtocolPayloadHeaderTemplateInit() and setting the packet sequence number, packet ID and payload data offset. The
+ * result is the same as ProtocolPayloadHeaderInit() for the same packet state.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param template_ptr Pointer to the header template of the payload.
+ * @param header_ptr Address where to write raw packet header.
+ * @param header_buffer_size Size of header buffer in bytes.
+ * @param packet_state_ptr Pointer to packet state data of the payload.
+ *
+ * @return Size of payload header in bytes.
+ */
+int ProtocolPayloadHeaderFromTemplate(CdiProtocolHandle protocol_handle, const CdiPacketHeaderTemplate* template_ptr,
+                                      void* header_ptr, int header_buffer_size,
+                                      const CdiPayloadPacketState* packet_state_ptr);
+
 /**
  * @brief Get Rx reorder information for the specified packet.
  *
@@ -101,6 +101,9 @@ CDI_STATIC_ASSERT(CDI_RAW_PACKET_HEADER_SIZE_V2 == sizeof(PacketHeaderUnion), "T
 // Enable the line below to force a compile error to see the size of the internal structure.
 //char __foo[sizeof(PacketHeaderUnion) + 1] = {[sizeof(PacketHeaderUnion)] = ""};
 
+/// @brief Ensure a data offset header fits in a header template.
+CDI_STATIC_ASSERT(CDI_PACKET_HEADER_TEMPLATE_SIZE >= sizeof(PacketDataOffsetHeader), "Header template is too small!");
+
 /**
  * @brief Common header for all probe control packets. NOTE: Last digit of Protocol Version is the probe version. This
  * file supports probe version 4.
@@ -176,6 +179,11 @@ static void HeaderDecode(const void* encoded_data_ptr, int encoded_data_size, Cd
 /// Forward declaration of function.
 static int HeaderInit(void* header_ptr, int header_buffer_size, const TxPayloadState* payload_state_ptr);
 /// Forward declaration of function.
+static void HeaderTemplateInit(CdiPacketHeaderTemplate* template_ptr, const TxPayloadState* payload_state_ptr);
+/// Forward declaration of function.
+static int HeaderFromTemplate(const CdiPacketHeaderTemplate* template_ptr, void* header_ptr, int header_buffer_size,
+                              const CdiPayloadPacketState* packet_state_ptr);
+/// Forward declaration of function.
 static void PacketRxReorderInfo(const CdiRawPacketHeader* header_ptr, CdiPacketRxReorderInfo* ret_info_ptr);
 /// Forward declaration of function.
 static CdiReturnStatus ProbeHeaderDecode(const void* encoded_data_ptr, int encoded_data_size,
@@ -189,6 +197,8 @@ static int ProbeHeaderEncode(const CdiDecodedProbeHeader* src_header_ptr, CdiRaw
 static CdiProtocolVTableApi vtable_api = {
     HeaderDecode,
     HeaderInit,
+    HeaderTemplateInit,
+    HeaderFromTemplate,
     PacketRxReorderInfo,
     ProbeHeaderDecode,
     ProbeHeaderEncode,
@@ -293,6 +303,34 @@ static int HeaderInit(void* header_ptr, int header_buffer_size, const TxPayloadS
     return header_size;
 }
 
+// See documentation for ProtocolPayloadHeaderTemplateInit().
+static void HeaderTemplateInit(CdiPacketHeaderTemplate* template_ptr, const TxPayloadState* payload_state_ptr)
+{
+    PacketDataOffsetHeader* hdr_ptr = (PacketDataOffsetHeader*)template_ptr->header;
+    hdr_ptr->hdr.payload_type = kPayloadTypeDataOffset;
+    hdr_ptr->hdr.packet_sequence_num = 0;
+    hdr_ptr->hdr.payload_num = payload_state_ptr->payload_packet_state.payload_num;
+    hdr_ptr->hdr.packet_id = 0;
+    hdr_ptr->payload_data_offset = 0;
+    template_ptr->header_size = sizeof(PacketDataOffsetHeader);
+}
+
+// See documentation for ProtocolPayloadHeaderFromTemplate().
+static int HeaderFromTemplate(const CdiPacketHeaderTemplate* template_ptr, void* header_ptr, int header_buffer_size,
+                              const CdiPayloadPacketState* packet_state_ptr)
+{
+    (void)header_buffer_size; // Not used in release build, so suppress warning.
+    assert(header_buffer_size >= (int)sizeof(PacketDataOffsetHeader));
+
+    PacketDataOffsetHeader* ptr = (PacketDataOffsetHeader*)header_ptr;
+    *ptr = *(const PacketDataOffsetHeader*)template_ptr->header;
+    ptr->hdr.packet_sequence_num = packet_state_ptr->packet_sequence_num;
+    ptr->hdr.packet_id = packet_state_ptr->packet_id;
+    ptr->payload_data_offset = packet_state_ptr->payload_data_offset;
+
+    return sizeof(PacketDataOffsetHeader);
+}
+
 // See documentation for PayloadPacketRxReorderInfo().
 static void PacketRxReorderInfo(const CdiRawPacketHeader* header_ptr, CdiPacketRxReorderInfo* ret_info_ptr)
 {
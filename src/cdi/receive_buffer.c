@@ -85,12 +85,13 @@ CDI_THREAD ReceiveBufferThread(void* ptr)
     uint32_t timeout_ms = CDI_INFINITE;
 
     while (!CdiOsSignalGet(state_ptr->shutdown_signal)) {
-        // Wait for work to do. If the queue is empty, we will wait for data or the shutdown signal.
-        AppPayloadCallbackData app_cb_data;
-        if (CdiQueuePopWait(state_ptr->input_queue_handle, timeout_ms, state_ptr->shutdown_signal,
-                            (void**)&app_cb_data)) {
+        // Wait for work to do. If the queue is empty, we will wait for data or the shutdown signal. The callback data
+        // is read in place in the input queue and only copied to wherever it goes next.
+        AppPayloadCallbackData* input_cb_data_ptr = NULL;
+        if (CdiQueuePopPeekWait(state_ptr->input_queue_handle, timeout_ms, state_ptr->shutdown_signal,
+                                (void**)&input_cb_data_ptr)) {
             const uint64_t payload_timestamp_us =
-                CdiUtilityPtpTimestampToMicroseconds(&app_cb_data.core_extra_data.origination_ptp_timestamp);
+                CdiUtilityPtpTimestampToMicroseconds(&input_cb_data_ptr->core_extra_data.origination_ptp_timestamp);
             const uint64_t now = TaiNowMicroseconds();
 
             // Reset t_offset if necessary. This is done before incrementing missed_count so that the offset is set to
@@ -110,22 +111,23 @@ CDI_THREAD ReceiveBufferThread(void* ptr)
 
             // Put the payload into the output queue if it's already late.
             if (send_time <= now) {
-                app_cb_data.receive_buffer_send_time = send_time;
-                CdiQueuePush(state_ptr->output_queue_handle, &app_cb_data);
+                input_cb_data_ptr->receive_buffer_send_time = send_time;
+                CdiQueuePush(state_ptr->output_queue_handle, input_cb_data_ptr);
             } else {
                 // Cap send time to now + delay.
-                app_cb_data.receive_buffer_send_time = CDI_MIN(send_time, now + state_ptr->buffer_delay_microseconds);
+                input_cb_data_ptr->receive_buffer_send_time = CDI_MIN(send_time,
+                                                                      now + state_ptr->buffer_delay_microseconds);
 
-                // The input and output queues provide copies of the AppPayloadCallbackData structure. Get an item out
-                // of the pool to store the data in while it's being delayed.
+                // The input queue item is released below. Get an item out of the pool to store the data in while it's
+                // being delayed.
                 AppPayloadCallbackData* pool_item_ptr = NULL;
                 if (!CdiPoolGet(state_ptr->delay_pool_handle, (void**)&pool_item_ptr)) {
                     CDI_LOG_THREAD(kLogCritical,
                                    "Failed to get AppPayloadCallbackData from pool. Throwing away payload [%10u.%09u]",
-                                   app_cb_data.core_extra_data.origination_ptp_timestamp.seconds,
-                                   app_cb_data.core_extra_data.origination_ptp_timestamp.nanoseconds);
+                                   input_cb_data_ptr->core_extra_data.origination_ptp_timestamp.seconds,
+                                   input_cb_data_ptr->core_extra_data.origination_ptp_timestamp.nanoseconds);
                 } else {
-                    *pool_item_ptr = app_cb_data;  // Copy the callback data into the pool item storage.
+                    *pool_item_ptr = *input_cb_data_ptr;  // Copy the callback data into the pool item storage.
 
                     // Place the payload int the delay line with its position determined by send time.
                     CdiListIterator list_iterator;
@@ -133,7 +135,7 @@ CDI_THREAD ReceiveBufferThread(void* ptr)
                     AppPayloadCallbackData* entry_ptr;
                     while (NULL != (entry_ptr = (AppPayloadCallbackData*)CdiListIteratorGetNext(&list_iterator))) {
                         const uint64_t entry_send_time = entry_ptr->receive_buffer_send_time;
-                        if (entry_send_time > app_cb_data.receive_buffer_send_time) {
+                        if (entry_send_time > pool_item_ptr->receive_buffer_send_time) {
                             CdiListAddBefore(&delay_list, &pool_item_ptr->list_entry, &entry_ptr->list_entry);
                             break;
                         }
@@ -143,6 +145,7 @@ CDI_THREAD ReceiveBufferThread(void* ptr)
                     }
                 }
             }
+            CdiQueuePopRelease(state_ptr->input_queue_handle);
         }
 
         // Take items out of the delay line until the first one that needs to remain in it is encountered.
@@ -0,0 +1,249 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains the implementation of the Rx copy engine. Each copy thread has its own input queue, which only
+ * the poll thread pushes to. Completed copies are pushed by all of the copy threads to a single output queue, which
+ * only the poll thread pops from. The poll thread keeps ownership of everything else: the copy threads only read the
+ * packet buffers and write the linear receive buffers.
+ */
+
+#include "rx_copy_engine.h"
+
+#include <stdio.h>
+
+#include "cdi_os_api.h"
+#include "configuration.h"
+#include "internal.h"
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// Forward declaration of the copy engine state, so a copy thread can point to it.
+typedef struct RxCopyEngineState RxCopyEngineState;
+
+/**
+ * @brief State of a copy thread.
+ */
+typedef struct {
+    RxCopyEngineState* engine_ptr;   ///< Pointer to the copy engine the thread belongs to.
+    CdiQueueHandle input_queue_handle; ///< Queue of RxCopyRequest structures for the thread to perform.
+    CdiThreadID thread_id;           ///< ID of the copy thread.
+} RxCopyThreadState;
+
+/**
+ * Internal state of a copy engine "object."
+ */
+struct RxCopyEngineState {
+    CdiLogHandle log_handle;         ///< Logger handle used by the copy threads.
+    CdiSignalType shutdown_signal;   ///< Signal to set in order to tell the copy threads to stop running.
+    CdiQueueHandle output_queue_handle; ///< Queue of RxCopyRequest structures that have been performed.
+    int pending_count;               ///< Number of copies posted and not yet returned. Only used by the poll thread.
+    /// @brief Number of copies posted and not yet performed by a copy thread. Updated using atomic operations.
+    int32_t in_progress_count;
+    CdiSignalType idle_signal;       ///< Set by the copy thread that brings in_progress_count to zero.
+    int next_thread_index;           ///< Index of the copy thread to post the next copy to.
+    int thread_count;                ///< Number of copy threads in thread_array.
+    RxCopyThreadState thread_array[CDI_MAX_RX_COPY_THREADS]; ///< State of each copy thread.
+};
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * The main function of a copy thread. It takes copies from its input queue, performs them and pushes them to the copy
+ * engine's output queue.
+ *
+ * @param ptr Pointer to thread specific data. In this case, a pointer to RxCopyThreadState.
+ *
+ * @return The return value is not used.
+ */
+static CDI_THREAD RxCopyThread(void* ptr)
+{
+    RxCopyThreadState* thread_ptr = (RxCopyThreadState*)ptr;
+    RxCopyEngineState* engine_ptr = thread_ptr->engine_ptr;
+
+    // Set this thread to use the connection's log. Can now use CDI_LOG_THREAD() for logging within this thread.
+    CdiLoggerThreadLogSet(engine_ptr->log_handle);
+
+    RxCopyRequest request;
+    while (!CdiOsSignalGet(engine_ptr->shutdown_signal)) {
+        if (CdiQueuePopWait(thread_ptr->input_queue_handle, CDI_INFINITE, engine_ptr->shutdown_signal, &request)) {
+            CdiGatherInternal(&request.packet_sgl, request.offset, request.dest_ptr, request.byte_count,
+                              request.non_temporal);
+            // The output queue holds as many copies as can be pending, so this can't fail.
+            CdiQueuePush(engine_ptr->output_queue_handle, &request);
+            if (0 == CdiOsAtomicDec32(&engine_ptr->in_progress_count)) {
+                CdiOsSignalSet(engine_ptr->idle_signal);
+            }
+        }
+    }
+
+    return 0; // Return value is not used.
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus RxCopyEngineCreate(CdiLogHandle log_handle, int thread_count, int core_num,
+                                   RxCopyEngineHandle* ret_handle_ptr)
+{
+    assert(thread_count > 0 && thread_count <= CDI_MAX_RX_COPY_THREADS);
+
+    CdiReturnStatus rs = kCdiStatusOk;
+    RxCopyEngineState* engine_ptr = CdiOsMemAllocZero(sizeof(RxCopyEngineState));
+    if (NULL == engine_ptr) {
+        rs = kCdiStatusNotEnoughMemory;
+    }
+
+    if (kCdiStatusOk == rs) {
+        engine_ptr->log_handle = log_handle;
+        if (!CdiOsSignalCreate(&engine_ptr->shutdown_signal) || !CdiOsSignalCreate(&engine_ptr->idle_signal)) {
+            rs = kCdiStatusNotEnoughMemory;
+        }
+    }
+
+    if (kCdiStatusOk == rs) {
+        // All of the copy threads push to this queue.
+        if (!CdiQueueCreate("Rx Copy Engine Output Queue", thread_count * RX_COPY_QUEUE_SIZE, CDI_FIXED_QUEUE_SIZE,
+                            CDI_FIXED_QUEUE_SIZE, sizeof(RxCopyRequest), kQueueSignalNone | kQueueMultipleWritersFlag,
+                            &engine_ptr->output_queue_handle)) {
+            rs = kCdiStatusNotEnoughMemory;
+        }
+    }
+
+    for (int i = 0; kCdiStatusOk == rs && i < thread_count; i++) {
+        RxCopyThreadState* thread_ptr = &engine_ptr->thread_array[i];
+        thread_ptr->engine_ptr = engine_ptr;
+        if (!CdiQueueCreate("Rx Copy Thread Input Queue", RX_COPY_QUEUE_SIZE, CDI_FIXED_QUEUE_SIZE,
+                            CDI_FIXED_QUEUE_SIZE, sizeof(RxCopyRequest), kQueueSignalPopWait, // Queue can block on pops.
+                            &thread_ptr->input_queue_handle)) {
+            rs = kCdiStatusNotEnoughMemory;
+        } else {
+            char thread_name_str[CDI_MAX_THREAD_NAME];
+            snprintf(thread_name_str, sizeof(thread_name_str), "RxCopy%d", i);
+            if (!CdiOsThreadCreatePinned(RxCopyThread, &thread_ptr->thread_id, thread_name_str, thread_ptr, NULL,
+                                         core_num < 0 ? -1 : core_num + i)) {
+                rs = kCdiStatusNotEnoughMemory;
+            }
+        }
+        engine_ptr->thread_count = i + 1;
+    }
+
+    if (kCdiStatusOk == rs) {
+        *ret_handle_ptr = engine_ptr;
+    } else {
+        RxCopyEngineDestroy(engine_ptr);
+    }
+
+    return rs;
+}
+
+void RxCopyEngineDestroy(RxCopyEngineHandle handle)
+{
+    RxCopyEngineState* engine_ptr = handle;
+
+    if (NULL != engine_ptr) {
+        if (NULL != engine_ptr->shutdown_signal) {
+            CdiOsSignalSet(engine_ptr->shutdown_signal);
+        }
+
+        for (int i = 0; i < engine_ptr->thread_count; i++) {
+            RxCopyThreadState* thread_ptr = &engine_ptr->thread_array[i];
+            if (NULL != thread_ptr->thread_id) {
+                CdiOsThreadJoin(thread_ptr->thread_id, CDI_INFINITE, NULL);
+                thread_ptr->thread_id = NULL;
+            }
+            if (NULL != thread_ptr->input_queue_handle) {
+                CdiQueueDestroy(thread_ptr->input_queue_handle);
+                thread_ptr->input_queue_handle = NULL;
+            }
+        }
+
+        if (NULL != engine_ptr->output_queue_handle) {
+            CdiQueueDestroy(engine_ptr->output_queue_handle);
+            engine_ptr->output_queue_handle = NULL;
+        }
+
+        if (NULL != engine_ptr->shutdown_signal) {
+            CdiOsSignalDelete(engine_ptr->shutdown_signal);
+            engine_ptr->shutdown_signal = NULL;
+        }
+        if (NULL != engine_ptr->idle_signal) {
+            CdiOsSignalDelete(engine_ptr->idle_signal);
+            engine_ptr->idle_signal = NULL;
+        }
+
+        CdiOsMemFree(engine_ptr);
+    }
+}
+
+bool RxCopyEnginePost(RxCopyEngineHandle handle, const RxCopyRequest* request_ptr)
+{
+    RxCopyEngineState* engine_ptr = handle;
+
+    // Limit the number of pending copies to what the output queue can hold, so the copy threads never fail to push.
+    if (engine_ptr->pending_count >= engine_ptr->thread_count * RX_COPY_QUEUE_SIZE) {
+        return false;
+    }
+
+    // Try each copy thread in turn, starting with the one after the thread that got the last copy.
+    for (int i = 0; i < engine_ptr->thread_count; i++) {
+        RxCopyThreadState* thread_ptr = &engine_ptr->thread_array[engine_ptr->next_thread_index];
+        if (++engine_ptr->next_thread_index >= engine_ptr->thread_count) {
+            engine_ptr->next_thread_index = 0;
+        }
+        // Count the copy before the copy thread can perform it.
+        CdiOsAtomicInc32(&engine_ptr->in_progress_count);
+        if (CdiQueuePush(thread_ptr->input_queue_handle, request_ptr)) {
+            engine_ptr->pending_count++;
+            return true;
+        }
+        CdiOsAtomicDec32(&engine_ptr->in_progress_count);
+    }
+
+    return false;
+}
+
+int RxCopyEngineGetCompleted(RxCopyEngineHandle handle, RxCopyRequest* ret_request_array, int max_count)
+{
+    RxCopyEngineState* engine_ptr = handle;
+
+    int count = CdiQueuePopMultiple(engine_ptr->output_queue_handle, ret_request_array, max_count);
+    engine_ptr->pending_count -= count;
+
+    return count;
+}
+
+void RxCopyEngineWaitIdle(RxCopyEngineHandle handle)
+{
+    RxCopyEngineState* engine_ptr = handle;
+
+    // Only the calling thread posts copies, so the count can't rise while waiting. Clear the signal before checking the
+    // count, so a copy thread that brings the count to zero after the check sets it again.
+    CdiSignalType signal_array[] = { engine_ptr->idle_signal, engine_ptr->shutdown_signal };
+    while (true) {
+        CdiOsSignalClear(engine_ptr->idle_signal);
+        if (0 == CdiOsAtomicLoad32(&engine_ptr->in_progress_count) || CdiOsSignalGet(engine_ptr->shutdown_signal)) {
+            break;
+        }
+        CdiOsSignalsWait(signal_array, CDI_ARRAY_ELEMENT_COUNT(signal_array), false, CDI_INFINITE, NULL);
+    }
+}
+
+int RxCopyEngineGetPendingCount(RxCopyEngineHandle handle)
+{
+    return handle->pending_count;
+}
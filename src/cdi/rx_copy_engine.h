@@ -0,0 +1,112 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains the external definitions for the Rx copy engine, a set of threads that copy the data of received
+ * packets into linear receive buffers on behalf of a connection's poll thread.
+ */
+
+#ifndef RX_COPY_ENGINE_H__
+#define RX_COPY_ENGINE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cdi_log_api.h"
+#include "private.h"
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/**
+ * @brief A copy of the data of a received packet into a linear receive buffer.
+ */
+typedef struct {
+    CdiEndpointState* endpoint_ptr; ///< Endpoint that received the packet. Its adapter endpoint owns the packet buffers.
+    CdiSgList packet_sgl;           ///< SGL of the received packet. Its buffers must not be freed until it is copied.
+    int offset;                     ///< Number of bytes at the start of the packet to skip, such as its CDI header.
+    uint8_t* dest_ptr;              ///< Where to write the packet's data.
+    int byte_count;                 ///< Number of bytes to copy.
+    bool non_temporal;              ///< If true, the data is written with non-temporal stores. See CdiGatherInternal().
+    RxPayloadState* payload_state_ptr; ///< Payload the packet belongs to. Not used by the copy engine.
+    int packet_sequence_num;        ///< Sequence number of the packet. Not used by the copy engine.
+} RxCopyRequest;
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Creates a copy engine with the specified number of copy threads, allocating all of the associated resources.
+ *
+ * @param log_handle Handle to the logger to be used by the copy threads.
+ * @param thread_count Number of copy threads to create.
+ * @param core_num The core to pin the first copy thread to. The following threads are pinned to the following cores. A
+ *                 value of -1 disables pinning.
+ * @param ret_handle_ptr Address of where to write the copy engine's handle if successfully created.
+ *
+ * @return kCdiStatusOk if the copy engine was successfully created or kCdiStatusNotEnoughMemory if memory was
+ *         insufficient to allocate all of the required resources.
+ */
+CdiReturnStatus RxCopyEngineCreate(CdiLogHandle log_handle, int thread_count, int core_num,
+                                   RxCopyEngineHandle* ret_handle_ptr);
+
+/**
+ * Destroys the copy engine specified by the handle. The copy threads are shut down and joined and all resources are
+ * freed. Copies that are still pending are not performed and their packet buffers are not freed, so first use
+ * RxCopyEngineGetCompleted() until RxCopyEngineGetPendingCount() returns zero.
+ *
+ * @param handle Handle of the copy engine to destroy.
+ */
+void RxCopyEngineDestroy(RxCopyEngineHandle handle);
+
+/**
+ * Posts a copy to one of the copy threads. Copies are handed to the threads in turn. Only one thread at a time can use
+ * this function, RxCopyEngineGetCompleted() and RxCopyEngineGetPendingCount().
+ *
+ * @param handle Handle of the copy engine.
+ * @param request_ptr Pointer to the copy to perform. The request is copied.
+ *
+ * @return true if the copy was posted, false if too many copies are already pending (RX_COPY_QUEUE_SIZE per copy
+ *         thread) or all copy threads have a full queue. The caller must then perform the copy itself.
+ */
+bool RxCopyEnginePost(RxCopyEngineHandle handle, const RxCopyRequest* request_ptr);
+
+/**
+ * Gets copies that the copy threads have completed, so their packet buffers can be freed. Copies are not necessarily
+ * returned in the order they were posted.
+ *
+ * @param handle Handle of the copy engine.
+ * @param ret_request_array Array where the completed copies are written.
+ * @param max_count Maximum number of copies to write to ret_request_array.
+ *
+ * @return Number of copies written to ret_request_array.
+ */
+int RxCopyEngineGetCompleted(RxCopyEngineHandle handle, RxCopyRequest* ret_request_array, int max_count);
+
+/**
+ * Blocks until the copy threads have performed all of the posted copies, without polling. The last copy thread to
+ * finish sets a signal that this function waits on. The completed copies must still be returned using
+ * RxCopyEngineGetCompleted(). Returns early if the copy engine is being destroyed. Must be used by the thread that
+ * posts copies.
+ *
+ * @param handle Handle of the copy engine.
+ */
+void RxCopyEngineWaitIdle(RxCopyEngineHandle handle);
+
+/**
+ * Gets the number of copies that have been posted and not yet returned by RxCopyEngineGetCompleted().
+ *
+ * @param handle Handle of the copy engine.
+ *
+ * @return Number of pending copies.
+ */
+int RxCopyEngineGetPendingCount(RxCopyEngineHandle handle);
+
+#endif  // RX_COPY_ENGINE_H__
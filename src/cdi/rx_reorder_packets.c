@@ -166,11 +166,25 @@
  * \endhtmlonly
  *
  * At this point there is one list (0-7), which represents the entire example payload.
+ *
+ * @section bitmap_reorder Bitmap packet reorder engine
+ *
+ * Placing a packet in the reorder lists requires walking them, so the time taken grows with the number of runs of<br>
+ * packets that are waiting for the packets between them. When packets are heavily reordered, such as when they are<br>
+ * sprayed over multiple network paths, there are many such runs. A connection can instead use the bitmap packet<br>
+ * reorder engine (see CdiRxConfigData.bitmap_packet_reorder). It keeps a single RxReorderList holding the packets<br>
+ * received in order so far and the sequence number of the next packet to append to it. A packet that arrives ahead<br>
+ * of that is held in the slot of an RxReorderPage indexed by its sequence number, and its bit is set in the page's<br>
+ * bitmap. When the next packet arrives, it is appended to the list followed by the packets held for the sequence<br>
+ * numbers that follow it. Placing a packet therefore takes a constant time. Pages are taken from a pool when their<br>
+ * first packet is held and returned when their last one is appended.
  * <br><br><br><br>
  *
  */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
 
 #include "rx_reorder_packets.h"
 
@@ -531,73 +545,255 @@ static bool ProcessList(CdiProtocolHandle protocol_handle, CdiPoolHandle reorder
     return ret;
 }
 
+/**
+ * @brief Appends the packets held by the bitmap packet reorder engine for the sequence numbers that follow the last
+ * packet of the payload's reorder list to the list. Pages are returned to their pool once their last packet is
+ * appended.
+ *
+ * @param reorder_pages_pool_handle Handle for free reorder page memory.
+ * @param payload_state_ptr Current state of the payload.
+ */
+static void AppendHeldPackets(CdiPoolHandle reorder_pages_pool_handle, RxPayloadState* payload_state_ptr)
+{
+    CdiReorderList* list_ptr = payload_state_ptr->reorder_list_ptr;
+    int next_sequence_num = payload_state_ptr->reorder_next_sequence_num;
+
+    while (payload_state_ptr->reorder_held_packet_count && next_sequence_num <= UINT16_MAX) {
+        const int page_index = next_sequence_num / RX_REORDER_PAGE_SLOT_COUNT;
+        const int slot_index = next_sequence_num % RX_REORDER_PAGE_SLOT_COUNT;
+        const uint64_t bit = 1ULL << (slot_index % 64);
+        RxReorderPage* page_ptr = payload_state_ptr->reorder_page_array[page_index];
+        if (NULL == page_ptr || 0 == (page_ptr->used_bitmap[slot_index / 64] & bit)) {
+            break; // The next packet has not arrived yet.
+        }
+
+        // Attach the packet's SGL entries to the bottom of the list.
+        const RxReorderSlot* slot_ptr = &page_ptr->slot_array[slot_index];
+        list_ptr->sglist.sgl_tail_ptr->next_ptr = slot_ptr->head_ptr;
+        list_ptr->sglist.sgl_tail_ptr = slot_ptr->tail_ptr;
+        page_ptr->used_bitmap[slot_index / 64] &= ~bit;
+        payload_state_ptr->reorder_held_packet_count--;
+        if (0 == --page_ptr->used_count) {
+            CdiPoolPut(reorder_pages_pool_handle, page_ptr);
+            payload_state_ptr->reorder_page_array[page_index] = NULL;
+        }
+        next_sequence_num++;
+    }
+
+    list_ptr->bot_sequence_num = next_sequence_num - 1;
+    payload_state_ptr->reorder_next_sequence_num = next_sequence_num;
+}
+
+/**
+ * @brief Adds an SGL list to the payload using the bitmap packet reorder engine. If it is the next packet of the
+ * payload, it is appended to the payload's reorder list along with the held packets that follow it, otherwise it is
+ * held in the slot for its sequence number. First SGL entry of SGL list may have offset.
+ *
+ * @param protocol_handle Handle for protocol being used.
+ * @param payload_sgl_entry_pool_handle Handle for free SGL memory.
+ * @param reorder_pages_pool_handle Handle for free reorder page memory.
+ * @param payload_state_ptr Current state of the payload.
+ * @param new_sglist_ptr Pointer to entry to be added to the payload.
+ * @param sequence_num The sequence number of this SGL list.
+ * @param initial_offset First SGL entry will have this offset applied.
+ * @param num_bytes_added_ptr Pointer to the number of bytes that were successfully added to the payload.
+ * @return True if adding SGL list is successful.
+ */
+static bool ProcessBitmap(CdiProtocolHandle protocol_handle, CdiPoolHandle payload_sgl_entry_pool_handle,
+                          CdiPoolHandle reorder_pages_pool_handle, RxPayloadState* payload_state_ptr,
+                          const CdiSgList* new_sglist_ptr, int sequence_num, int initial_offset,
+                          int* num_bytes_added_ptr)
+{
+    bool ret = true;
+
+    if (sequence_num == payload_state_ptr->reorder_next_sequence_num) {
+        ret = AddSgListToReorderList(protocol_handle, payload_sgl_entry_pool_handle,
+                                     &payload_state_ptr->reorder_list_ptr->sglist, new_sglist_ptr, initial_offset,
+                                     num_bytes_added_ptr);
+        if (ret) {
+            payload_state_ptr->reorder_next_sequence_num++;
+            AppendHeldPackets(reorder_pages_pool_handle, payload_state_ptr);
+        }
+    } else if (sequence_num < payload_state_ptr->reorder_next_sequence_num || sequence_num > UINT16_MAX) {
+        CDI_LOG_THREAD(kLogWarning, "Sequence number[%d] has already been received! Skipping.", sequence_num);
+        ret = false;
+    } else {
+        const int page_index = sequence_num / RX_REORDER_PAGE_SLOT_COUNT;
+        const int slot_index = sequence_num % RX_REORDER_PAGE_SLOT_COUNT;
+        const uint64_t bit = 1ULL << (slot_index % 64);
+        RxReorderPage* page_ptr = payload_state_ptr->reorder_page_array[page_index];
+        if (NULL == page_ptr) {
+            // This memory is not initialized for performance reasons. Only the slots whose bit is set are used.
+            if (CdiPoolGet(reorder_pages_pool_handle, (void**)&page_ptr)) {
+                memset(page_ptr->used_bitmap, 0, sizeof(page_ptr->used_bitmap));
+                page_ptr->used_count = 0;
+                payload_state_ptr->reorder_page_array[page_index] = page_ptr;
+            } else {
+                ret = false;
+            }
+        } else if (page_ptr->used_bitmap[slot_index / 64] & bit) {
+            CDI_LOG_THREAD(kLogWarning, "Sequence number[%d] has already been received! Skipping.", sequence_num);
+            ret = false;
+        }
+
+        if (ret) {
+            CdiSgList sglist = { 0 };
+            ret = AddSgListToReorderList(protocol_handle, payload_sgl_entry_pool_handle, &sglist, new_sglist_ptr,
+                                         initial_offset, num_bytes_added_ptr);
+            if (ret) {
+#ifdef DEBUG_RX_REORDER_ALL
+                CDI_LOG_THREAD(kLogInfo, "Got sequence[%d] and holding it until sequence[%d] arrives.", sequence_num,
+                               payload_state_ptr->reorder_next_sequence_num);
+#endif
+                page_ptr->slot_array[slot_index].head_ptr = sglist.sgl_head_ptr;
+                page_ptr->slot_array[slot_index].tail_ptr = sglist.sgl_tail_ptr;
+                page_ptr->used_bitmap[slot_index / 64] |= bit;
+                page_ptr->used_count++;
+                payload_state_ptr->reorder_held_packet_count++;
+            } else {
+                FreeSglEntries(payload_sgl_entry_pool_handle, sglist.sgl_head_ptr);
+            }
+        }
+
+        if (page_ptr && 0 == page_ptr->used_count) {
+            // Don't keep an empty page.
+            CdiPoolPut(reorder_pages_pool_handle, page_ptr);
+            payload_state_ptr->reorder_page_array[page_index] = NULL;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * @brief Returns the SGL entries of the packets held by the bitmap packet reorder engine and the pages that hold them
+ * to their pools.
+ *
+ * @param payload_state_ptr Current state of the payload.
+ * @param payload_sgl_entry_pool_handle Handle for free SGL memory.
+ * @param reorder_pages_pool_handle Handle for free reorder page memory.
+ */
+static void FreeHeldPackets(RxPayloadState* payload_state_ptr, CdiPoolHandle payload_sgl_entry_pool_handle,
+                            CdiPoolHandle reorder_pages_pool_handle)
+{
+    for (int i = 0; payload_state_ptr->reorder_held_packet_count && i < RX_REORDER_PAGE_COUNT; i++) {
+        RxReorderPage* page_ptr = payload_state_ptr->reorder_page_array[i];
+        if (page_ptr) {
+            for (int j = 0; j < CDI_ARRAY_ELEMENT_COUNT(page_ptr->used_bitmap); j++) {
+                uint64_t bits = page_ptr->used_bitmap[j];
+                for (int k = 0; bits; k++, bits >>= 1) {
+                    if ((bits & 1) &&
+                        !FreeSglEntries(payload_sgl_entry_pool_handle, page_ptr->slot_array[j * 64 + k].head_ptr)) {
+                        CDI_LOG_THREAD(kLogError, "Failed to return SGL entry to free pool.");
+                    }
+                }
+            }
+            payload_state_ptr->reorder_held_packet_count -= page_ptr->used_count;
+            CdiPoolPut(reorder_pages_pool_handle, page_ptr);
+            payload_state_ptr->reorder_page_array[i] = NULL;
+        }
+    }
+}
+
 //*********************************************************************************************************************
 //******************************************* START OF PUBLIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
 
-void RxReorderPacketFreeLists(CdiReorderList* reorder_list_ptr, CdiPoolHandle payload_sgl_entry_pool_handle,
-                              CdiPoolHandle reorder_entries_pool_handle)
+void RxReorderPacketFreeLists(RxPayloadState* payload_state_ptr, CdiPoolHandle payload_sgl_entry_pool_handle,
+                              CdiPoolHandle reorder_entries_pool_handle, CdiPoolHandle reorder_pages_pool_handle)
 {
-    while (reorder_list_ptr) {
-        // First remove the SGL that is in this reorder list.
-        if (!FreeSglEntries(payload_sgl_entry_pool_handle, reorder_list_ptr->sglist.sgl_head_ptr)) {
+    CdiReorderList* reorder_list_ptr = payload_state_ptr->reorder_list_ptr;
+
+    // First remove the SGL that is in each reorder list.
+    for (CdiReorderList* list_ptr = reorder_list_ptr; list_ptr; list_ptr = list_ptr->next_ptr) {
+        if (!FreeSglEntries(payload_sgl_entry_pool_handle, list_ptr->sglist.sgl_head_ptr)) {
             CDI_LOG_THREAD(kLogError, "Failed to return SGL entry to free pool.");
         }
+    }
 
-        CdiReorderList* reorder_list_next_ptr = reorder_list_ptr->next_ptr;
-        // Now remove this reorder list.
-        CdiPoolPut(reorder_entries_pool_handle, (void*)reorder_list_ptr);
-        reorder_list_ptr = reorder_list_next_ptr;
-        if (reorder_list_ptr) {
-            reorder_list_ptr->prev_ptr = NULL;
-        }
+    // Now remove all of the reorder lists using a single pool operation.
+    if (!CdiPoolPutList(reorder_entries_pool_handle, reorder_list_ptr, offsetof(CdiReorderList, next_ptr))) {
+        CDI_LOG_THREAD(kLogError, "Failed to return reorder list to free pool.");
+    }
+    payload_state_ptr->reorder_list_ptr = NULL; // List freed and no longer valid, so clear it.
+
+    if (reorder_pages_pool_handle) {
+        FreeHeldPackets(payload_state_ptr, payload_sgl_entry_pool_handle, reorder_pages_pool_handle);
     }
 }
 
 bool RxReorderPacketPayloadStateInit(CdiProtocolHandle protocol_handle, CdiPoolHandle payload_sgl_entry_pool_handle,
-                                     CdiPoolHandle reorder_entries_pool_handle, RxPayloadState* payload_state_ptr,
+                                     CdiPoolHandle reorder_entries_pool_handle,
+                                     CdiPoolHandle reorder_pages_pool_handle, RxPayloadState* payload_state_ptr,
                                      const CdiSgList* new_sglist_ptr, int initial_offset, int sequence_num)
 {
     bool ret = true;
     CdiReorderList* new_reorder_list_ptr = NULL;
     int num_bytes_added = 0;
 
+    payload_state_ptr->reorder_next_sequence_num = 0;
+    payload_state_ptr->reorder_held_packet_count = 0;
+
+    if (reorder_pages_pool_handle) {
+        // The bitmap packet reorder engine keeps a single list, which starts empty since it holds the packets that
+        // precede the next sequence number.
+        memset(payload_state_ptr->reorder_page_array, 0, sizeof(payload_state_ptr->reorder_page_array));
+        // This memory is not initialized for performance reasons. All pointers must be explicitly initialized.
+        if (CdiPoolGet(reorder_entries_pool_handle, (void**)&new_reorder_list_ptr)) {
+            new_reorder_list_ptr->next_ptr = NULL;
+            new_reorder_list_ptr->prev_ptr = NULL;
+            new_reorder_list_ptr->sglist.total_data_size = 0;
+            new_reorder_list_ptr->sglist.sgl_head_ptr = NULL;
+            new_reorder_list_ptr->sglist.sgl_tail_ptr = NULL;
+            new_reorder_list_ptr->top_sequence_num = 0;
+            new_reorder_list_ptr->bot_sequence_num = 0;
+            payload_state_ptr->reorder_list_ptr = new_reorder_list_ptr;
+            ret = ProcessBitmap(protocol_handle, payload_sgl_entry_pool_handle, reorder_pages_pool_handle,
+                                payload_state_ptr, new_sglist_ptr, sequence_num, initial_offset, &num_bytes_added);
+        } else {
+            ret = false;
+        }
     // Because this is initialization, need only create a new rxreorder list and finish.
-    if (CreateAndInsertRxReorderList(protocol_handle, reorder_entries_pool_handle, payload_sgl_entry_pool_handle,
-                                     new_sglist_ptr, sequence_num, initial_offset, &num_bytes_added,
-                                     NULL, NULL, &new_reorder_list_ptr)) {
+    } else if (CreateAndInsertRxReorderList(protocol_handle, reorder_entries_pool_handle,
+                                            payload_sgl_entry_pool_handle, new_sglist_ptr, sequence_num,
+                                            initial_offset, &num_bytes_added, NULL, NULL, &new_reorder_list_ptr)) {
         payload_state_ptr->reorder_list_ptr = new_reorder_list_ptr;
-        payload_state_ptr->data_bytes_received = num_bytes_added;
     } else {
         ret = false;
     }
 
-    if (!ret) {
-        RxReorderPacketFreeLists(payload_state_ptr->reorder_list_ptr, payload_sgl_entry_pool_handle,
-                                 reorder_entries_pool_handle);
-        payload_state_ptr->reorder_list_ptr = NULL; // List freed and no longer valid, so clear it.
+    if (ret) {
+        payload_state_ptr->data_bytes_received = num_bytes_added;
+    } else {
+        RxReorderPacketFreeLists(payload_state_ptr, payload_sgl_entry_pool_handle, reorder_entries_pool_handle,
+                                 reorder_pages_pool_handle);
     }
 
     return ret;
 }
 
 bool RxReorderPacket(CdiProtocolHandle protocol_handle, CdiPoolHandle payload_sgl_entry_pool_handle,
-                     CdiPoolHandle reorder_entries_pool_handle, RxPayloadState* payload_state_ptr,
-                     const CdiSgList* new_sglist_ptr, int initial_offset, int sequence_num)
+                     CdiPoolHandle reorder_entries_pool_handle, CdiPoolHandle reorder_pages_pool_handle,
+                     RxPayloadState* payload_state_ptr, const CdiSgList* new_sglist_ptr, int initial_offset,
+                     int sequence_num)
 {
     bool ret = true;
     int num_bytes_added = 0;
 
-    // Search for a place to put this sequence number.
-    ret = ProcessList(protocol_handle, reorder_entries_pool_handle, payload_sgl_entry_pool_handle,
-                      &num_bytes_added, &payload_state_ptr->reorder_list_ptr, new_sglist_ptr,
-                      sequence_num, initial_offset);
+    if (reorder_pages_pool_handle) {
+        ret = ProcessBitmap(protocol_handle, payload_sgl_entry_pool_handle, reorder_pages_pool_handle,
+                            payload_state_ptr, new_sglist_ptr, sequence_num, initial_offset, &num_bytes_added);
+    } else {
+        // Search for a place to put this sequence number.
+        ret = ProcessList(protocol_handle, reorder_entries_pool_handle, payload_sgl_entry_pool_handle,
+                          &num_bytes_added, &payload_state_ptr->reorder_list_ptr, new_sglist_ptr,
+                          sequence_num, initial_offset);
+    }
     if (ret) {
         payload_state_ptr->data_bytes_received += num_bytes_added;
     } else {
-        RxReorderPacketFreeLists(payload_state_ptr->reorder_list_ptr, payload_sgl_entry_pool_handle,
-                                 reorder_entries_pool_handle);
-        payload_state_ptr->reorder_list_ptr = NULL; // List freed and no longer valid, so clear it.
+        RxReorderPacketFreeLists(payload_state_ptr, payload_sgl_entry_pool_handle, reorder_entries_pool_handle,
+                                 reorder_pages_pool_handle);
     }
 
     return ret;
@@ -31,6 +31,8 @@
  * @param protocol_handle Handle for protocol being used.
  * @param payload_sgl_entry_pool_handle Handle to memory pool of payload SGL entries.
  * @param reorder_entries_pool_handle Handle to memory pool of rx_reorder entries.
+ * @param reorder_pages_pool_handle Handle to memory pool of RxReorderPage structures if the bitmap packet reorder
+ *                                  engine is to be used, otherwise NULL.
  * @param payload_state_ptr Current state of the payload, specifically a single rx_reorder entry.
  * @param new_sglist_ptr An SGL to be added to the end of the payload sgl.
  * @param initial_offset First SGL entry will have this offset applied.
@@ -39,7 +41,8 @@
  * @return True if successful.
  */
 bool RxReorderPacketPayloadStateInit(CdiProtocolHandle protocol_handle, CdiPoolHandle payload_sgl_entry_pool_handle,
-                                     CdiPoolHandle reorder_entries_pool_handle, RxPayloadState* payload_state_ptr,
+                                     CdiPoolHandle reorder_entries_pool_handle,
+                                     CdiPoolHandle reorder_pages_pool_handle, RxPayloadState* payload_state_ptr,
                                      const CdiSgList* new_sglist_ptr, int initial_offset, int sequence_num);
 
 /**
@@ -51,9 +54,15 @@ bool RxReorderPacketPayloadStateInit(CdiProtocolHandle protocol_handle, CdiPoolH
  * and payload_state_ptr->reorder_list_ptr->prev_ptr will be NULL, otherwise there are dangling lists that have
  * not been attached to the single payload list.
  *
+ * If reorder_pages_pool_handle is not NULL, the bitmap packet reorder engine is used instead. A packet that is out of
+ * order is held in the slot of an RxReorderPage for its sequence number until the packets before it arrive. Once all
+ * of the data for a payload is received, payload_state_ptr->reorder_held_packet_count will be zero.
+ *
  * @param protocol_handle Handle for protocol being used.
  * @param payload_sgl_entry_pool_handle Handle to memory pool of payload SGL entries.
  * @param reorder_entries_pool_handle Handle to memory pool of rx_reorder entries.
+ * @param reorder_pages_pool_handle Handle to memory pool of RxReorderPage structures if the bitmap packet reorder
+ *                                  engine is to be used, otherwise NULL.
  * @param payload_state_ptr Current state of the payload, specifically a single rx_reorder entry.
  * @param new_sglist_ptr An SGL to be added to the end of the payload sgl.
  * @param initial_offset First SGL entry will have this offset applied
@@ -62,17 +71,21 @@ bool RxReorderPacketPayloadStateInit(CdiProtocolHandle protocol_handle, CdiPoolH
  * @return True if successful.
  */
 bool RxReorderPacket(CdiProtocolHandle protocol_handle, CdiPoolHandle payload_sgl_entry_pool_handle,
-                     CdiPoolHandle reorder_entries_pool_handle, RxPayloadState* payload_state_ptr,
-                     const CdiSgList* new_sglist_ptr, int initial_offset, int sequence_num);
+                     CdiPoolHandle reorder_entries_pool_handle, CdiPoolHandle reorder_pages_pool_handle,
+                     RxPayloadState* payload_state_ptr, const CdiSgList* new_sglist_ptr, int initial_offset,
+                     int sequence_num);
 
 /**
- * @brief removes all lists and sgls used in processing the out of order packets
+ * @brief removes all lists, pages and sgls used in processing the out of order packets of a payload and clears
+ * payload_state_ptr->reorder_list_ptr
  *
- * @param reorder_list_ptr pointer to a single list entry to start the removal process
+ * @param payload_state_ptr current state of the payload
  * @param payload_sgl_entry_pool_handle handle to memory pool of sgls
  * @param reorder_entries_pool_handle handle to memory pool of rx reorder lists
+ * @param reorder_pages_pool_handle handle to memory pool of rx reorder pages, NULL if the bitmap packet reorder engine
+ *                                  is not used
  */
-void RxReorderPacketFreeLists(CdiReorderList* reorder_list_ptr, CdiPoolHandle payload_sgl_entry_pool_handle,
-                              CdiPoolHandle reorder_entries_pool_handle);
+void RxReorderPacketFreeLists(RxPayloadState* payload_state_ptr, CdiPoolHandle payload_sgl_entry_pool_handle,
+                              CdiPoolHandle reorder_entries_pool_handle, CdiPoolHandle reorder_pages_pool_handle);
 
 #endif  // RX_REORDER_H__
@@ -102,39 +102,72 @@ static void FreePayloadState(CdiEndpointState* endpoint_ptr, int index)
 }
 
 /**
- * @brief Send the payload if it is ready.
+ * @brief Send the run of consecutive payloads that are complete or in error, starting at the specified index. The
+ * payloads are sent using a single RxSendPayloads(), so the next stage is signaled at most once for the whole run.
+ * Complete payloads are removed from the Rx reorder list and freed. Erred payloads are changed to the ignore state.
  *
  * @param endpoint_ptr Pointer to endpoint state data.
- * @param index Index of payload state pointer in payload_state_array_ptr.
+ * @param index Index of first payload state pointer in payload_state_array_ptr.
+ * @param max_payload_count Maximum number of payloads to send. Must not exceed MAX_QUEUE_BATCH_ITEM_COUNT.
  *
- * @return true if payload was sent, otherwise false.
+ * @return Number of payloads sent.
  */
-static bool SendPayloadIfCompleteOrError(CdiEndpointState* endpoint_ptr, int index)
+static int SendReadyPayloads(CdiEndpointState* endpoint_ptr, int index, int max_payload_count)
 {
-    bool sent = false;
-    RxPayloadState* payload_state_ptr = endpoint_ptr->rx_state.payload_state_array_ptr[index];
-
-    if (kPayloadComplete == payload_state_ptr->payload_state) {
-        // Send the payload down stream, remove it from the Rx reorder list and free payload_state_ptr.
-        DecreasePacketWindowCount(&endpoint_ptr->rx_state, payload_state_ptr->packet_count);
-        RxSendPayload(endpoint_ptr, payload_state_ptr);
-        FreePayloadState(endpoint_ptr, index);
-        sent = true;
-    } else if (kPayloadError == payload_state_ptr->payload_state) {
-        // Send the payload down stream and change the payload state to ignore.
+    int payload_num_max = endpoint_ptr->adapter_endpoint_ptr->protocol_handle->payload_num_max;
+    RxPayloadState* payload_state_array[MAX_QUEUE_BATCH_ITEM_COUNT];
+    int index_array[MAX_QUEUE_BATCH_ITEM_COUNT];
+    bool complete_array[MAX_QUEUE_BATCH_ITEM_COUNT];
+    int payload_count = 0;
+
+    assert(max_payload_count <= MAX_QUEUE_BATCH_ITEM_COUNT);
+    while (payload_count < max_payload_count) {
+        RxPayloadState* payload_state_ptr = endpoint_ptr->rx_state.payload_state_array_ptr[index];
+        if (NULL == payload_state_ptr || (kPayloadComplete != payload_state_ptr->payload_state &&
+                                          kPayloadError != payload_state_ptr->payload_state)) {
+            break;
+        }
         DecreasePacketWindowCount(&endpoint_ptr->rx_state, payload_state_ptr->packet_count);
-        RxSendPayload(endpoint_ptr, payload_state_ptr);
-        SetIgnoreState(payload_state_ptr);
-        sent = true;
+        payload_state_array[payload_count] = payload_state_ptr;
+        index_array[payload_count] = index;
+        complete_array[payload_count] = (kPayloadComplete == payload_state_ptr->payload_state);
+        payload_count++;
+
+        // Advance the index, taking into account maximum limits.
+        index = AdvanceStateArrayIndex(payload_num_max, index);
     }
 
-    if (sent) {
-        int payload_num_max = endpoint_ptr->adapter_endpoint_ptr->protocol_handle->payload_num_max;
-        // Set current index to next value, taking into account maximum limits.
-        endpoint_ptr->rx_state.rxreorder_current_index = AdvanceStateArrayIndex(payload_num_max, index);
+    if (payload_count) {
+        // Send the payloads down stream.
+        RxSendPayloads(endpoint_ptr, payload_state_array, payload_count);
+
+        for (int i = 0; i < payload_count; i++) {
+            if (complete_array[i]) {
+                // Remove the payload from the Rx reorder list and free payload_state_ptr.
+                FreePayloadState(endpoint_ptr, index_array[i]);
+            } else {
+                SetIgnoreState(payload_state_array[i]);
+            }
+        }
+
+        // Set current index to the payload following the last one sent.
+        endpoint_ptr->rx_state.rxreorder_current_index = index;
     }
 
-    return sent;
+    return payload_count;
+}
+
+/**
+ * @brief Send the payload if it is ready.
+ *
+ * @param endpoint_ptr Pointer to endpoint state data.
+ * @param index Index of payload state pointer in payload_state_array_ptr.
+ *
+ * @return true if payload was sent, otherwise false.
+ */
+static bool SendPayloadIfCompleteOrError(CdiEndpointState* endpoint_ptr, int index)
+{
+    return 1 == SendReadyPayloads(endpoint_ptr, index, 1);
 }
 
 /**
@@ -187,6 +220,7 @@ void RxReorderPayloadResetState(RxPayloadState* payload_state_ptr, int payload_n
     payload_state_ptr->packet_count = 0;
     payload_state_ptr->last_total_packet_count = 0;
     payload_state_ptr->suspend_warnings = false;
+    payload_state_ptr->slice_state_ptr = NULL;
 }
 
 void RxReorderPayloadError(CdiEndpointState* endpoint_ptr, RxPayloadState* payload_state_ptr)
@@ -245,16 +279,11 @@ RxPayloadState* RxReorderPayloadStateGet(CdiEndpointState* endpoint_ptr, CdiPool
 
 void RxReorderPayloadSendReadyPayloads(CdiEndpointState* endpoint_ptr)
 {
-    int payload_num_max = endpoint_ptr->adapter_endpoint_ptr->protocol_handle->payload_num_max;
-
-    // Start index at window start.
-    int idx = endpoint_ptr->rx_state.rxreorder_current_index;
-
-    // Send payloads while they are in the completed or error state. Stop on all other conditions.
-    while (NULL != endpoint_ptr->rx_state.payload_state_array_ptr[idx] &&
-        SendPayloadIfCompleteOrError(endpoint_ptr, idx)) {
-        // Advance the index, taking into account maximum limits.
-        idx = AdvanceStateArrayIndex(payload_num_max, idx);
+    // Starting at the window start, send payloads while they are in the completed or error state, in batches of up to
+    // MAX_QUEUE_BATCH_ITEM_COUNT. Stop on all other conditions.
+    while (MAX_QUEUE_BATCH_ITEM_COUNT == SendReadyPayloads(endpoint_ptr, endpoint_ptr->rx_state.rxreorder_current_index,
+                                                           MAX_QUEUE_BATCH_ITEM_COUNT)) {
+        // Sent a full batch, so there may be more.
     }
 
     // Now, check if we are at or above the maximum number of buffered packets used to reorder payloads.
@@ -15,6 +15,7 @@
 
 #include "statistics.h"
 
+#include "adapter_api.h"
 #include "cdi_logger_api.h"
 #include "cdi_os_api.h"
 #include "cloudwatch.h"
@@ -96,6 +97,109 @@ static const int metrics_gathering_period_ms = 60000;
 //******************************************* START OF STATIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
 
+/**
+ * Return the percentage of item_count that high_water_count represents.
+ *
+ * @param high_water_count Largest number of items used.
+ * @param item_count Number of items available.
+ *
+ * @return Percentage of items used, or zero if item_count is zero.
+ */
+static uint32_t UsagePercent(int high_water_count, int item_count)
+{
+    return (item_count > 0) ? (uint32_t)(((int64_t)high_water_count * 100) / item_count) : 0;
+}
+
+/**
+ * Add the statistics of a pool to a connection's resource statistics.
+ *
+ * @param pool_handle Handle of the pool. Nothing is added if NULL.
+ * @param resource_stats_ptr Pointer to the resource statistics to add to.
+ */
+static void AddPoolStats(CdiPoolHandle pool_handle, CdiResourceStats* resource_stats_ptr)
+{
+    if (pool_handle) {
+        CdiPoolStats pool_stats;
+        CdiPoolGetStats(pool_handle, &pool_stats);
+        resource_stats_ptr->pool_item_count += pool_stats.total_item_count;
+        resource_stats_ptr->pool_free_item_count += pool_stats.free_item_count;
+        resource_stats_ptr->pool_high_water_item_count += pool_stats.high_water_item_count;
+        resource_stats_ptr->pool_grow_count += pool_stats.grow_count;
+        resource_stats_ptr->pool_get_fail_count += pool_stats.get_fail_count;
+        resource_stats_ptr->pool_byte_size += pool_stats.byte_size;
+        uint32_t percent = UsagePercent(pool_stats.high_water_item_count, pool_stats.total_item_count);
+        if (percent > resource_stats_ptr->pool_peak_usage_percent) {
+            resource_stats_ptr->pool_peak_usage_percent = percent;
+        }
+    }
+}
+
+/**
+ * Add the statistics of a queue to a connection's resource statistics.
+ *
+ * @param queue_handle Handle of the queue. Nothing is added if NULL.
+ * @param resource_stats_ptr Pointer to the resource statistics to add to.
+ */
+static void AddQueueStats(CdiQueueHandle queue_handle, CdiResourceStats* resource_stats_ptr)
+{
+    if (queue_handle) {
+        CdiQueueStats queue_stats;
+        CdiQueueGetStats(queue_handle, &queue_stats);
+        resource_stats_ptr->queue_item_count += queue_stats.item_count;
+        resource_stats_ptr->queue_free_item_count += queue_stats.item_count - queue_stats.occupancy;
+        resource_stats_ptr->queue_high_water_item_count += queue_stats.high_water_item_count;
+        resource_stats_ptr->queue_grow_count += queue_stats.grow_count;
+        resource_stats_ptr->queue_push_fail_count += queue_stats.push_fail_count;
+        resource_stats_ptr->queue_byte_size += queue_stats.byte_size;
+        uint32_t percent = UsagePercent(queue_stats.high_water_item_count, queue_stats.item_count);
+        if (percent > resource_stats_ptr->queue_peak_usage_percent) {
+            resource_stats_ptr->queue_peak_usage_percent = percent;
+        }
+    }
+}
+
+/**
+ * Aggregate the statistics of the pools and queues used by a connection and its adapter connection. NOTE: this function
+ * assumes that stats_data_lock has been reserved, so none of the pools can be replaced while they are being read (see
+ * StatsResourcesLock()).
+ *
+ * @param con_state_ptr Pointer to connection state data.
+ * @param ret_resource_stats_ptr Address where to write the aggregated statistics.
+ */
+static void GetResourceStats(CdiConnectionState* con_state_ptr, CdiResourceStats* ret_resource_stats_ptr)
+{
+    memset(ret_resource_stats_ptr, 0, sizeof(*ret_resource_stats_ptr));
+
+    if (kHandleTypeTx == con_state_ptr->handle_type) {
+        TxConState* tx_state_ptr = &con_state_ptr->tx_state;
+        AddPoolStats(tx_state_ptr->payload_state_pool_handle, ret_resource_stats_ptr);
+        AddPoolStats(tx_state_ptr->payload_sgl_entry_pool_handle, ret_resource_stats_ptr);
+        AddPoolStats(tx_state_ptr->work_request_pool_handle, ret_resource_stats_ptr);
+        AddQueueStats(tx_state_ptr->payload_queue_handle, ret_resource_stats_ptr);
+        AddQueueStats(tx_state_ptr->cancel_queue_handle, ret_resource_stats_ptr);
+        AddQueueStats(tx_state_ptr->work_req_comp_queue_handle, ret_resource_stats_ptr);
+    } else {
+        RxConState* rx_state_ptr = &con_state_ptr->rx_state;
+        AddPoolStats(rx_state_ptr->payload_memory_state_pool_handle, ret_resource_stats_ptr);
+        AddPoolStats(rx_state_ptr->payload_sgl_entry_pool_handle, ret_resource_stats_ptr);
+        AddPoolStats(rx_state_ptr->reorder_entries_pool_handle, ret_resource_stats_ptr);
+        AddPoolStats(rx_state_ptr->reorder_pages_pool_handle, ret_resource_stats_ptr);
+        AddPoolStats(rx_state_ptr->rx_payload_state_pool_handle, ret_resource_stats_ptr);
+        AddPoolStats(con_state_ptr->linear_buffer_pool, ret_resource_stats_ptr);
+        AddPoolStats(rx_state_ptr->slice_state_pool_handle, ret_resource_stats_ptr);
+        AddQueueStats(rx_state_ptr->active_payload_complete_queue_handle, ret_resource_stats_ptr);
+    }
+    AddPoolStats(con_state_ptr->error_message_pool, ret_resource_stats_ptr);
+    AddQueueStats(con_state_ptr->app_payload_message_queue_handle, ret_resource_stats_ptr);
+
+    AdapterConnectionState* adapter_con_ptr = con_state_ptr->adapter_connection_ptr;
+    if (adapter_con_ptr) {
+        AddPoolStats(adapter_con_ptr->tx_header_pool_handle, ret_resource_stats_ptr);
+        AddPoolStats(adapter_con_ptr->tx_extra_header_pool_handle, ret_resource_stats_ptr);
+        ret_resource_stats_ptr->rx_packet_buffer_byte_size = adapter_con_ptr->rx_packet_buffer_byte_size;
+    }
+}
+
 /**
  * Get current transfer statistics data for the specified connection and write to the provided address.
  *
@@ -125,8 +229,10 @@ static void GetStats(CdiEndpointState* endpoint_ptr, CdiTransferStats* ret_stats
     TDigestGetPercentileValue(td_handle, 100, &interval_ptr->transfer_time_max);
     interval_ptr->transfer_count = TDigestGetCount(td_handle);
 
-    // Copy the stats series to returned stats.
+    // Copy the stats series to returned stats. Resource stats are gathered from the connection, since the pools and
+    // queues are shared by all of its endpoints.
     *ret_stats_ptr = endpoint_ptr->transfer_stats;
+    GetResourceStats(endpoint_ptr->connection_state_ptr, &ret_stats_ptr->resource_stats);
 
     // Reset the payload time interval stats.
     memset(interval_ptr, 0, sizeof(*interval_ptr));
@@ -474,6 +580,30 @@ CdiReturnStatus StatsConfigure(StatisticsHandle handle, const CdiStatsConfigData
     return rs;
 }
 
+void StatsResourcesLock(StatisticsHandle handle)
+{
+    StatisticsState* stats_state_ptr = (StatisticsState*)handle;
+    if (stats_state_ptr) {
+        CdiOsCritSectionReserve(stats_state_ptr->stats_data_lock);
+    }
+}
+
+void StatsResourcesUnlock(StatisticsHandle handle)
+{
+    StatisticsState* stats_state_ptr = (StatisticsState*)handle;
+    if (stats_state_ptr) {
+        CdiOsCritSectionRelease(stats_state_ptr->stats_data_lock);
+    }
+}
+
+void StatsGetResourceStats(StatisticsHandle handle, CdiResourceStats* ret_stats_ptr)
+{
+    StatisticsState* stats_state_ptr = (StatisticsState*)handle;
+    CdiOsCritSectionReserve(stats_state_ptr->stats_data_lock);
+    GetResourceStats(stats_state_ptr->con_state_ptr, ret_stats_ptr);
+    CdiOsCritSectionRelease(stats_state_ptr->stats_data_lock);
+}
+
 void StatsGatherPayloadStatsFromConnection(CdiEndpointState* endpoint_ptr, bool payload_ok,
                                            uint64_t start_time, uint64_t max_latency_microsecs,
                                            uint64_t bytes_transferred)
@@ -530,3 +660,22 @@ void StatsGatherPayloadStatsFromConnection(CdiEndpointState* endpoint_ptr, bool
     // Done with stats data, so release the lock.
     CdiOsCritSectionRelease(stats_state_ptr->stats_data_lock);
 }
+
+void StatsGatherTxQueueTime(CdiEndpointState* endpoint_ptr, uint64_t queue_time)
+{
+    StatisticsState* stats_state_ptr = endpoint_ptr->connection_state_ptr->stats_state_ptr;
+    // If the connection is being shutdown, the statistics object will not exist.
+    if (NULL == stats_state_ptr) {
+        return;
+    }
+
+    CdiPayloadTimeIntervalStats* interval_stats_ptr = &endpoint_ptr->transfer_stats.payload_time_interval_stats;
+
+    // NOTE: Need to synchronize with StatsThread(), which resets the interval stats.
+    CdiOsCritSectionReserve(stats_state_ptr->stats_data_lock);
+    interval_stats_ptr->tx_queue_time_sum += queue_time;
+    if (queue_time > interval_stats_ptr->tx_queue_time_max) {
+        interval_stats_ptr->tx_queue_time_max = (uint32_t)queue_time;
+    }
+    CdiOsCritSectionRelease(stats_state_ptr->stats_data_lock);
+}
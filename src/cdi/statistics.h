@@ -69,6 +69,29 @@ CdiReturnStatus StatsDestroy(StatisticsHandle handle);
  */
 CdiReturnStatus StatsConfigure(StatisticsHandle handle, const CdiStatsConfigData* stats_config_ptr);
 
+/**
+ * Prevent the statistics threads from reading the connection's pools and queues, so one of them can be destroyed and
+ * replaced while the connection is running. Must be followed by a call to StatsResourcesUnlock().
+ *
+ * @param handle Handle of statistics component. Nothing is done if NULL.
+ */
+void StatsResourcesLock(StatisticsHandle handle);
+
+/**
+ * Allow the statistics threads to read the connection's pools and queues again. See StatsResourcesLock().
+ *
+ * @param handle Handle of statistics component. Nothing is done if NULL.
+ */
+void StatsResourcesUnlock(StatisticsHandle handle);
+
+/**
+ * Get the current pool and queue usage of the connection.
+ *
+ * @param handle Handle of statistics component.
+ * @param ret_stats_ptr Address where to write the statistics.
+ */
+void StatsGetResourceStats(StatisticsHandle handle, CdiResourceStats* ret_stats_ptr);
+
 /**
  * Gather transfer time statistics for a single payload from a connection.
  *
@@ -81,4 +104,12 @@ CdiReturnStatus StatsConfigure(StatisticsHandle handle, const CdiStatsConfigData
 void StatsGatherPayloadStatsFromConnection(CdiEndpointState* endpoint_ptr, bool payload_ok, uint64_t start_time,
                                            uint64_t max_latency_microsecs, uint64_t bytes_transferred);
 
+/**
+ * Gather the time a Tx payload waited before its packetization started.
+ *
+ * @param endpoint_ptr Pointer to endpoint state data.
+ * @param queue_time Time in microseconds the payload waited.
+ */
+void StatsGatherTxQueueTime(CdiEndpointState* endpoint_ptr, uint64_t queue_time);
+
 #endif  // CDI_STATISTICS_H__
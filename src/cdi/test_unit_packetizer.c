@@ -0,0 +1,447 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains a unit test of the Tx packetizer. Video frames are split into packets by
+ * PayloadPacketizerPacketGet() without an adapter, for each protocol version and a range of packet sizes. The headers
+ * of the packets are decoded and checked against the packet state, headers built from a template are compared with
+ * headers built by ProtocolPayloadHeaderInit(), packets of a frame split into many SGL entries are compared with
+ * packets of the same frame in a single entry and a benchmark of the packet rate of the packetizer is logged.
+ */
+
+#include "adapter_api.h"
+#include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "internal.h"
+#include "payload.h"
+#include "private.h"
+#include "protocol.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// Number of payload bytes in a 1080p 4:2:2 10-bit video frame.
+#define FRAME_BYTES                     (1920 * 1080 * 20 / 8)
+
+/// Size in bytes of a pixel group of 4:2:2 10-bit video, which packet payload data must be a multiple of.
+#define PGROUP_BYTES                    (5)
+
+/// Number of SGL entries a frame is split into by CheckMultipleEntries().
+#define FRAME_SGL_ENTRY_COUNT           (16)
+
+/// Number of frames packetized by each pass of the benchmark. The first frame of a pass is also checked.
+#define FRAME_COUNT                     (20)
+
+/// Number of header slots the packetizer writes to in turn, like the slots of the Tx header pool.
+#define HEADER_SLOT_COUNT               (64)
+
+/// Maximum number of SGL entries in a packet. The source SGL has a single entry, so a packet uses at most two.
+#define MAX_TX_SGL_ENTRIES              (2)
+
+/// @brief Largest number of packets a frame is split into, using the smallest packet size of the benchmark. Packets
+/// that end early at the end of a source SGL entry can add one packet per entry.
+#define MAX_FRAME_PACKETS               (FRAME_BYTES / (1024 - (int)sizeof(CdiRawPacketHeader)) + 1 + \
+                                         FRAME_SGL_ENTRY_COUNT)
+
+/// Number of headers built by each pass of the header benchmark.
+#define HEADER_BENCHMARK_COUNT          (1000000)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+/**
+ * @brief State of the payload being packetized and of the resources used to packetize it.
+ */
+typedef struct {
+    CdiConnectionState con_state;          ///< Connection state. Only the Tx payload SGL entry pool is used.
+    CdiEndpointState endpoint;             ///< Endpoint state. Only the Tx packet ID is used.
+    AdapterEndpointState adapter_endpoint; ///< Adapter endpoint state. Only the packet size limits are used.
+    TxPayloadState payload_state;          ///< State of the payload being packetized.
+    CdiPacketizerStateHandle packetizer_state_handle; ///< Packetizer state.
+    CdiSglEntry frame_entry_array[FRAME_SGL_ENTRY_COUNT]; ///< SGL entries of the frame.
+    CdiSgList frame_sgl;                   ///< SGL of the frame.
+} PacketizerTestState;
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+/// Packet sizes in bytes used by the benchmark.
+static const int packet_size_array[] = { 1024, 2048, 4096, 8192, 9216 };
+
+/// Header slots written by the packetizer.
+static uint8_t header_slot_array[HEADER_SLOT_COUNT][sizeof(CdiRawPacketHeader)];
+
+/// Packet SGL entries of each header slot, like the ones embedded in a Tx packet work request.
+static CdiSglEntry packet_entry_slot_array[HEADER_SLOT_COUNT][MAX_TX_SGL_PACKET_ENTRIES];
+
+/// Frame data. It is never read, so it only provides valid addresses for the SGL entries of the frame.
+static uint8_t frame_buffer[FRAME_BYTES];
+
+/// Payload data sizes of the packets of a frame split into FRAME_SGL_ENTRY_COUNT SGL entries.
+static uint16_t multi_entry_packet_bytes_array[MAX_FRAME_PACKETS];
+
+/// Payload data sizes of the packets of a frame in a single SGL entry.
+static uint16_t single_entry_packet_bytes_array[MAX_FRAME_PACKETS];
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Check the header of a packet returned by the packetizer against the state of the packetizer when it was created.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param packet_sgl_ptr Pointer to SGL of the packet.
+ * @param payload_num Payload number of the frame.
+ * @param packet_sequence_num Expected packet sequence number.
+ * @param packet_id Expected packet ID.
+ * @param payload_data_offset Expected payload data offset.
+ *
+ * @return kCdiStatusOk if the header is correct, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus CheckPacketHeader(CdiProtocolHandle protocol_handle, const CdiSgList* packet_sgl_ptr,
+                                         int payload_num, int packet_sequence_num, uint32_t packet_id,
+                                         uint32_t payload_data_offset)
+{
+    CdiDecodedPacketHeader decoded_header = { 0 };
+    ProtocolPayloadHeaderDecode(protocol_handle, packet_sgl_ptr->sgl_head_ptr->address_ptr,
+                                packet_sgl_ptr->sgl_head_ptr->size_in_bytes, &decoded_header);
+
+    CHECK(decoded_header.encoded_header_size == packet_sgl_ptr->sgl_head_ptr->size_in_bytes);
+    CHECK(decoded_header.packet_sequence_num == packet_sequence_num);
+    CHECK(decoded_header.payload_num == payload_num);
+    if (protocol_handle->negotiated_version.version_num >= 2) {
+        CHECK(decoded_header.packet_id == packet_id);
+    }
+    if (0 == packet_sequence_num) {
+        CHECK(decoded_header.payload_type == kPayloadTypeData);
+        CHECK(decoded_header.num0_info.total_payload_size == FRAME_BYTES);
+    } else {
+        CHECK(decoded_header.payload_type == kPayloadTypeDataOffset);
+        CHECK((uint32_t)decoded_header.data_offset_info.payload_data_offset == payload_data_offset);
+    }
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Set the SGL of the frame to split the frame buffer into a number of entries. The last entry is split in two, the
+ * first of which is 1000 bytes, so the packets that span it use one more SGL entry.
+ *
+ * @param state_ptr Pointer to test state.
+ * @param entry_count Number of SGL entries.
+ */
+static void FrameSglInit(PacketizerTestState* state_ptr, int entry_count)
+{
+    const int last_entry_bytes = 1000;
+    int entry_bytes = FRAME_BYTES / (entry_count > 1 ? entry_count - 1 : 1);
+    uint8_t* address_ptr = frame_buffer;
+    memset(&state_ptr->frame_sgl, 0, sizeof(state_ptr->frame_sgl));
+    for (int i = 0; i < entry_count; i++) {
+        CdiSglEntry* entry_ptr = &state_ptr->frame_entry_array[i];
+        if (i == entry_count - 1) {
+            entry_ptr->size_in_bytes = frame_buffer + FRAME_BYTES - address_ptr;
+        } else if (i == entry_count - 2) {
+            entry_ptr->size_in_bytes = frame_buffer + FRAME_BYTES - address_ptr - last_entry_bytes;
+        } else {
+            entry_ptr->size_in_bytes = entry_bytes;
+        }
+        entry_ptr->address_ptr = address_ptr;
+        entry_ptr->next_ptr = NULL;
+        address_ptr += entry_ptr->size_in_bytes;
+        SglAppend(&state_ptr->frame_sgl, entry_ptr);
+    }
+}
+
+/**
+ * Split a frame into packets. If check is true, the header and size of each packet are checked.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param state_ptr Pointer to test state.
+ * @param payload_num Payload number of the frame.
+ * @param check True to check the packets.
+ * @param packet_bytes_array Array where to write the payload data size of each packet. May be NULL.
+ * @param ret_packet_count_ptr Address where to add the number of packets the frame was split into.
+ *
+ * @return kCdiStatusOk if successful, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus PacketizeFrame(CdiProtocolHandle protocol_handle, PacketizerTestState* state_ptr,
+                                      int payload_num, bool check, uint16_t* packet_bytes_array,
+                                      uint64_t* ret_packet_count_ptr)
+{
+    TxPayloadState* payload_state_ptr = &state_ptr->payload_state;
+    CdiPayloadPacketState* packet_state_ptr = &payload_state_ptr->payload_packet_state;
+
+    // PayloadInit() expects a cleared payload_data_offset, like the Tx payload state pool items cleared by
+    // TxPayloadInternal().
+    packet_state_ptr->payload_data_offset = 0;
+    CHECK(PayloadInit(&state_ptr->con_state, &state_ptr->frame_sgl, payload_state_ptr));
+    packet_state_ptr->payload_num = payload_num;
+    PayloadPacketizerStateInit(state_ptr->packetizer_state_handle);
+
+    bool last_packet = false;
+    int packet_count = 0;
+    int total_data_bytes = 0;
+    while (!last_packet) {
+        int packet_sequence_num = packet_state_ptr->packet_sequence_num;
+        uint32_t packet_id = state_ptr->endpoint.tx_state.packet_id;
+        uint32_t payload_data_offset = packet_state_ptr->payload_data_offset;
+
+        CdiSgList packet_sgl;
+        CdiSglEntry* packet_entry_array = packet_entry_slot_array[packet_count % HEADER_SLOT_COUNT];
+        PayloadPacketizerPacketGet(protocol_handle, state_ptr->packetizer_state_handle,
+                                   (char*)header_slot_array[packet_count % HEADER_SLOT_COUNT],
+                                   sizeof(header_slot_array[0]), packet_entry_array, payload_state_ptr, &packet_sgl,
+                                   &last_packet);
+        if (check) {
+            // The packet SGL must be built from the provided entries, in order, within the adapter's limit.
+            int entry_count = 0;
+            for (const CdiSglEntry* entry_ptr = packet_sgl.sgl_head_ptr; entry_ptr; entry_ptr = entry_ptr->next_ptr) {
+                CHECK(entry_count < MAX_TX_SGL_PACKET_ENTRIES);
+                CHECK(entry_ptr == &packet_entry_array[entry_count]);
+                entry_count++;
+            }
+            CHECK(entry_count <= state_ptr->adapter_endpoint.maximum_tx_sgl_entries);
+            CHECK(kCdiStatusOk == CheckPacketHeader(protocol_handle, &packet_sgl, payload_num, packet_sequence_num,
+                                                    packet_id, payload_data_offset));
+            CHECK(packet_sgl.total_data_size <= state_ptr->adapter_endpoint.maximum_payload_bytes);
+            total_data_bytes += packet_state_ptr->packet_payload_data_size;
+            if (!last_packet && PGROUP_BYTES == payload_state_ptr->group_size_bytes &&
+                packet_state_ptr->source_entry_address_offset != 0) {
+                // Packets that don't end at the end of a source SGL entry must hold whole pixel groups.
+                CHECK(0 == packet_state_ptr->packet_payload_data_size % PGROUP_BYTES);
+            }
+        }
+        if (packet_bytes_array) {
+            CHECK(packet_count < MAX_FRAME_PACKETS);
+            packet_bytes_array[packet_count] = packet_state_ptr->packet_payload_data_size;
+        }
+        packet_count++;
+    }
+    if (check) {
+        CHECK(total_data_bytes == FRAME_BYTES);
+    }
+
+    // Return the SGL entries of the frame.
+    CdiPoolPutAll(state_ptr->con_state.tx_state.payload_sgl_entry_pool_handle);
+    *ret_packet_count_ptr += packet_count;
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Check that the packet boundaries of a frame don't depend on how the frame is split into SGL entries, as long as the
+ * packets don't reach the SGL entry limit. Then check packets that end early at the end of an SGL entry because they
+ * reach the limit.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param state_ptr Pointer to test state.
+ *
+ * @return kCdiStatusOk if successful, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus CheckMultipleEntries(CdiProtocolHandle protocol_handle, PacketizerTestState* state_ptr)
+{
+    state_ptr->adapter_endpoint.maximum_payload_bytes = packet_size_array[0];
+    state_ptr->adapter_endpoint.maximum_tx_sgl_entries = MAX_TX_SGL_PACKET_ENTRIES;
+
+    uint64_t multi_entry_packet_count = 0;
+    FrameSglInit(state_ptr, FRAME_SGL_ENTRY_COUNT);
+    CHECK(kCdiStatusOk == PacketizeFrame(protocol_handle, state_ptr, 0, true, multi_entry_packet_bytes_array,
+                                         &multi_entry_packet_count));
+
+    uint64_t single_entry_packet_count = 0;
+    FrameSglInit(state_ptr, 1);
+    CHECK(kCdiStatusOk == PacketizeFrame(protocol_handle, state_ptr, 1, true, single_entry_packet_bytes_array,
+                                         &single_entry_packet_count));
+
+    CHECK(multi_entry_packet_count == single_entry_packet_count);
+    CHECK(0 == memcmp(multi_entry_packet_bytes_array, single_entry_packet_bytes_array,
+                      multi_entry_packet_count * sizeof(multi_entry_packet_bytes_array[0])));
+
+    // Check packets that end early at the end of an SGL entry.
+    state_ptr->adapter_endpoint.maximum_tx_sgl_entries = MAX_TX_SGL_ENTRIES;
+    multi_entry_packet_count = 0;
+    FrameSglInit(state_ptr, FRAME_SGL_ENTRY_COUNT);
+    CHECK(kCdiStatusOk == PacketizeFrame(protocol_handle, state_ptr, 2, true, NULL, &multi_entry_packet_count));
+    CHECK(multi_entry_packet_count > single_entry_packet_count);
+
+    // The benchmark uses a frame with a single SGL entry.
+    FrameSglInit(state_ptr, 1);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Compare headers built from a template with headers built by ProtocolPayloadHeaderInit() and log how long each takes
+ * to build a header.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param state_ptr Pointer to test state.
+ *
+ * @return kCdiStatusOk if successful, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus HeaderBenchmark(CdiProtocolHandle protocol_handle, PacketizerTestState* state_ptr)
+{
+    TxPayloadState* payload_state_ptr = &state_ptr->payload_state;
+    CdiPayloadPacketState* packet_state_ptr = &payload_state_ptr->payload_packet_state;
+
+    packet_state_ptr->payload_num = 1;
+    packet_state_ptr->packet_sequence_num = 0;
+    ProtocolPayloadHeaderTemplateInit(protocol_handle, &packet_state_ptr->header_template, payload_state_ptr);
+    packet_state_ptr->payload_type = kPayloadTypeDataOffset;
+
+    // The headers must be identical for every packet after packet #0.
+    for (int i = 1; i < HEADER_SLOT_COUNT; i++) {
+        packet_state_ptr->packet_sequence_num = i;
+        packet_state_ptr->packet_id = 0x10000 * i + i;
+        packet_state_ptr->payload_data_offset = 1400 * i;
+        CdiRawPacketHeader init_header = { 0 };
+        CdiRawPacketHeader template_header = { 0 };
+        int init_size = ProtocolPayloadHeaderInit(protocol_handle, &init_header, sizeof(init_header),
+                                                  payload_state_ptr);
+        int template_size = ProtocolPayloadHeaderFromTemplate(protocol_handle, &packet_state_ptr->header_template,
+                                                              &template_header, sizeof(template_header),
+                                                              packet_state_ptr);
+        CHECK(init_size == template_size);
+        CHECK(0 == memcmp(&init_header, &template_header, init_size));
+    }
+
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int i = 1; i <= HEADER_BENCHMARK_COUNT; i++) {
+        packet_state_ptr->packet_sequence_num = i;
+        ProtocolPayloadHeaderInit(protocol_handle, header_slot_array[i % HEADER_SLOT_COUNT],
+                                  sizeof(header_slot_array[0]), payload_state_ptr);
+    }
+    uint64_t init_time = CdiOsGetMicroseconds() - start_time;
+
+    start_time = CdiOsGetMicroseconds();
+    for (int i = 1; i <= HEADER_BENCHMARK_COUNT; i++) {
+        packet_state_ptr->packet_sequence_num = i;
+        ProtocolPayloadHeaderFromTemplate(protocol_handle, &packet_state_ptr->header_template,
+                                          header_slot_array[i % HEADER_SLOT_COUNT], sizeof(header_slot_array[0]),
+                                          packet_state_ptr);
+    }
+    uint64_t template_time = CdiOsGetMicroseconds() - start_time;
+
+    CDI_LOG_THREAD(kLogInfo, "Header benchmark [v%d]: Init[%"PRIu64"]ns Template[%"PRIu64"]ns per header.",
+                   protocol_handle->negotiated_version.version_num,
+                   init_time * 1000 / HEADER_BENCHMARK_COUNT, template_time * 1000 / HEADER_BENCHMARK_COUNT);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Run the packetizer benchmark for one protocol version.
+ *
+ * @param version_num Protocol version number.
+ * @param state_ptr Pointer to test state.
+ *
+ * @return kCdiStatusOk if successful, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus RunPacketizerTest(int version_num, PacketizerTestState* state_ptr)
+{
+    CdiProtocolHandle protocol_handle = NULL;
+    CdiProtocolVersionNumber version = {
+        .version_num = version_num,
+        .major_version_num = 0,
+        .probe_version_num = 0
+    };
+    ProtocolVersionSet(&version, &protocol_handle);
+    CHECK(NULL != protocol_handle);
+    CHECK(version_num == protocol_handle->negotiated_version.version_num);
+
+    CdiReturnStatus rs = CheckMultipleEntries(protocol_handle, state_ptr);
+
+    int payload_num = 3;
+    for (int i = 0; kCdiStatusOk == rs && i < (int)CDI_ARRAY_ELEMENT_COUNT(packet_size_array); i++) {
+        state_ptr->adapter_endpoint.maximum_payload_bytes = packet_size_array[i];
+
+        // Check the first frame of the pass, then time the others.
+        uint64_t packet_count = 0;
+        rs = PacketizeFrame(protocol_handle, state_ptr, payload_num++, true, NULL, &packet_count);
+
+        packet_count = 0;
+        uint64_t start_time = CdiOsGetMicroseconds();
+        for (int j = 1; kCdiStatusOk == rs && j < FRAME_COUNT; j++) {
+            rs = PacketizeFrame(protocol_handle, state_ptr, payload_num++, false, NULL, &packet_count);
+        }
+        uint64_t elapsed_time = CdiOsGetMicroseconds() - start_time;
+
+        if (kCdiStatusOk == rs) {
+            CDI_LOG_THREAD(kLogInfo, "Packetizer benchmark [v%d]: Packet size[%d] Packets[%"PRIu64"] "
+                           "Rate[%"PRIu64"] packets/second.", version_num, packet_size_array[i], packet_count,
+                           elapsed_time ? packet_count * 1000000 / elapsed_time : 0);
+        }
+    }
+
+    if (kCdiStatusOk == rs) {
+        rs = HeaderBenchmark(protocol_handle, state_ptr);
+    }
+
+    ProtocolVersionDestroy(protocol_handle);
+
+    return rs;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitPacketizer(void)
+{
+    CdiReturnStatus rs = kCdiStatusOk;
+
+    static PacketizerTestState test_state;
+    PacketizerTestState* state_ptr = &test_state;
+    memset(state_ptr, 0, sizeof(*state_ptr));
+
+    state_ptr->endpoint.adapter_endpoint_ptr = &state_ptr->adapter_endpoint;
+    state_ptr->adapter_endpoint.maximum_tx_sgl_entries = MAX_TX_SGL_ENTRIES;
+    state_ptr->payload_state.cdi_endpoint_handle = &state_ptr->endpoint;
+    state_ptr->payload_state.group_size_bytes = PGROUP_BYTES;
+
+    state_ptr->packetizer_state_handle = PayloadPacketizerCreate();
+    if (NULL == state_ptr->packetizer_state_handle ||
+        !CdiPoolCreate("Packetizer Test Payload SGL Entry Pool", CDI_ARRAY_ELEMENT_COUNT(state_ptr->frame_entry_array),
+                       0, 0, sizeof(CdiSglEntry), false,
+                       &state_ptr->con_state.tx_state.payload_sgl_entry_pool_handle)) {
+        rs = kCdiStatusNotEnoughMemory;
+    }
+
+    if (kCdiStatusOk == rs) {
+        rs = RunPacketizerTest(1, state_ptr);
+    }
+    if (kCdiStatusOk == rs) {
+        rs = RunPacketizerTest(2, state_ptr);
+    }
+
+    CdiPoolDestroy(state_ptr->con_state.tx_state.payload_sgl_entry_pool_handle);
+    PayloadPacketizerDestroy(state_ptr->packetizer_state_handle);
+
+    return rs;
+}
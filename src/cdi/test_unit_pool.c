@@ -0,0 +1,1093 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains a unit test for the CdiPool functionality, including pools that use per-thread caches (and free
+ * items cached by idle or exited threads), the bulk get/put functions, pools placed on a NUMA node and pools backed by
+ * huge pages. It also logs a contention benchmark that compares locked pools against thread cached pools, a per-frame
+ * benchmark that compares freeing SGL sized lists one item at a time against CdiPoolPutList() and
+ * CdiPoolPutMultiple(), a NUMA benchmark that runs a poll thread like workload on a CPU core of each NUMA node against a
+ * pool placed on each NUMA node and a benchmark that compares random item accesses of heap and huge page backed pools.
+ * Slim item pools are tested and a benchmark compares their memory use and get/put rate with regular pools of SGL
+ * entries.
+ */
+
+#include "cdi_core_api.h"
+#include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "cdi_pool_api.h"
+#include "configuration.h"
+#include "utilities_api.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// Number of items in the pool used for the single threaded tests.
+#define SINGLE_THREAD_ITEM_COUNT        (64)
+
+/// Number of items in the pool used for the multi-threaded tests.
+#define MULTI_THREAD_ITEM_COUNT         (1024)
+
+/// Maximum number of threads used by the multi-threaded tests.
+#define MAX_TEST_THREADS                (8)
+
+/// Number of pools created by ManyPoolsTest(). More than the number of thread data slots Linux provides (1024).
+#define MANY_POOLS_COUNT                (1100)
+
+/// Number of items each thread holds at one time in the multi-threaded tests.
+#define ITEMS_PER_BATCH                 (16)
+
+/// Number of batches each thread gets and puts in the correctness test.
+#define CORRECTNESS_BATCH_COUNT         (10000)
+
+/// Number of batches each thread gets and puts in the benchmark.
+#define BENCHMARK_BATCH_COUNT           (20000)
+
+/// Typical number of payload bytes in each packet when using the EFA adapter.
+#define FRAME_BENCHMARK_PACKET_BYTES    (8928)
+
+/// Number of payload bytes in a 1080p 4:2:2 10-bit video frame.
+#define FRAME_BENCHMARK_1080P_BYTES     (1920 * 1080 * 20 / 8)
+
+/// Number of payload bytes in a 2160p 4:2:2 10-bit video frame.
+#define FRAME_BENCHMARK_2160P_BYTES     (3840 * 2160 * 20 / 8)
+
+/// Number of frames used by the per-frame benchmark (one second at 60 frames per second).
+#define FRAME_BENCHMARK_FRAME_COUNT     (60)
+
+/// Number of items in the pool used for the per-frame benchmark. Must hold one 2160p frame's worth of packets.
+#define FRAME_BENCHMARK_ITEM_COUNT      (4096)
+
+/// Highest CPU core number (plus one) that the NUMA benchmark looks at when searching for a core on each NUMA node.
+#define NUMA_BENCHMARK_MAX_CPUS         (1024)
+
+/// Maximum number of NUMA nodes used by the NUMA benchmark.
+#define NUMA_BENCHMARK_MAX_NODES        (8)
+
+/// @brief Number of items in the pool used by the NUMA benchmark. Sized so the pool (64MB) is larger than the last
+/// level cache, so accesses go to memory.
+#define NUMA_BENCHMARK_ITEM_COUNT       (64 * 1024)
+
+/// Size of the data in each item of the pool used by the NUMA benchmark.
+#define NUMA_BENCHMARK_ITEM_BYTES       (1024)
+
+/// Number of times the NUMA benchmark thread gets, writes and puts every item in the pool.
+#define NUMA_BENCHMARK_PASS_COUNT       (4)
+
+/// Number of items in the pool used by the huge page test. Large enough for the pool to use huge pages.
+#define HUGE_PAGE_TEST_ITEM_COUNT       (16 * 1024)
+
+/// @brief Number of items in the pool used by the huge page benchmark. Each item is on its own cache line and the pool
+/// spans 4096 regular pages (16MB), which is more than the TLB holds.
+#define HUGE_PAGE_BENCHMARK_ITEM_COUNT  (64 * 1024)
+
+/// Size of the data in each item of the pool used by the huge page benchmark.
+#define HUGE_PAGE_BENCHMARK_ITEM_BYTES  (256 - 24)
+
+/// Number of random item accesses made by the huge page benchmark.
+#define HUGE_PAGE_BENCHMARK_ACCESS_COUNT (4 * 1024 * 1024)
+
+/// Number of SGL entry sized items in the pools used by the slim items benchmark.
+#define SLIM_BENCHMARK_ITEM_COUNT       (28000)
+
+/// Number of times the slim items benchmark gets and puts every item in the pool.
+#define SLIM_BENCHMARK_PASS_COUNT       (100)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+/// Forward reference.
+typedef struct TestPoolItem TestPoolItem;
+
+/**
+ * @brief Structure of the items stored in the test pools.
+ */
+struct TestPoolItem {
+    TestPoolItem* next_ptr; ///< Pointer to next item in a list, used with CdiPoolPutList().
+    int owner;              ///< Non-zero while a thread owns the item.
+    int sequence;           ///< Value written by the owner, used to detect items that are handed out twice.
+};
+
+/**
+ * @brief State passed to each of the test threads.
+ */
+typedef struct {
+    CdiPoolHandle pool_handle; ///< Pool being tested.
+    int thread_number;         ///< Number of this thread (starting at 1).
+    int batch_count;           ///< Number of batches of items to get and put.
+    bool check_items;          ///< If true, verify that no other thread owns an item that was returned by the pool.
+    CdiSignalType start_signal; ///< Signal used to start all threads at the same time.
+    int* ready_count_ptr;      ///< Pointer to the number of threads that are waiting for start_signal.
+    bool pass;                 ///< Set to false by the thread if an error was detected.
+} TestThreadState;
+
+/**
+ * @brief State passed to the NUMA benchmark thread.
+ */
+typedef struct {
+    CdiPoolHandle pool_handle; ///< Pool being used.
+    void** item_array;         ///< Array large enough to hold every item of the pool.
+    uint64_t elapsed_us;       ///< Time taken by the thread to get, write and put every item in the pool.
+    bool pass;                 ///< Set to false by the thread if an error was detected.
+    CdiSignalType done_signal; ///< Set by the thread when it is done.
+} NumaBenchmarkState;
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Thread that repeatedly gets a batch of items from a pool and then puts them back.
+ *
+ * @param arg_ptr Pointer to the thread's TestThreadState.
+ *
+ * @return The return value is not used.
+ */
+static CDI_THREAD PoolTestThread(void* arg_ptr)
+{
+    TestThreadState* state_ptr = (TestThreadState*)arg_ptr;
+    TestPoolItem* item_array[ITEMS_PER_BATCH];
+
+    CdiOsAtomicInc32(state_ptr->ready_count_ptr);
+    CdiOsSignalWait(state_ptr->start_signal, CDI_INFINITE, NULL);
+
+    for (int batch = 0; state_ptr->pass && batch < state_ptr->batch_count; batch++) {
+        for (int i = 0; i < ITEMS_PER_BATCH; i++) {
+            if (!CdiPoolGet(state_ptr->pool_handle, (void**)&item_array[i])) {
+                CDI_LOG_THREAD(kLogError, "Thread[%d] failed to get pool item.", state_ptr->thread_number);
+                state_ptr->pass = false;
+                // Return the items that were obtained in this batch.
+                for (int j = 0; j < i; j++) {
+                    CdiPoolPut(state_ptr->pool_handle, item_array[j]);
+                }
+                break;
+            }
+            if (state_ptr->check_items) {
+                if (0 != item_array[i]->owner) {
+                    CDI_LOG_THREAD(kLogError, "Thread[%d] got item owned by thread[%d].", state_ptr->thread_number,
+                                   item_array[i]->owner);
+                    state_ptr->pass = false;
+                }
+                item_array[i]->owner = state_ptr->thread_number;
+                item_array[i]->sequence = batch;
+            }
+        }
+        if (!state_ptr->pass) {
+            break;
+        }
+        for (int i = 0; i < ITEMS_PER_BATCH; i++) {
+            if (state_ptr->check_items) {
+                if (state_ptr->thread_number != item_array[i]->owner || batch != item_array[i]->sequence) {
+                    CDI_LOG_THREAD(kLogError, "Thread[%d] item was modified by thread[%d].", state_ptr->thread_number,
+                                   item_array[i]->owner);
+                    state_ptr->pass = false;
+                }
+                item_array[i]->owner = 0;
+            }
+            CdiPoolPut(state_ptr->pool_handle, item_array[i]);
+        }
+    }
+
+    return 0; // Return value is not used.
+}
+
+/**
+ * Thread that gets a batch of items from a pool and puts them back, which leaves free items in its cache. Then waits
+ * until start_signal is set before exiting, without using the pool again.
+ *
+ * @param arg_ptr Pointer to the thread's TestThreadState.
+ *
+ * @return The return value is not used.
+ */
+static CDI_THREAD IdleCacheThread(void* arg_ptr)
+{
+    TestThreadState* state_ptr = (TestThreadState*)arg_ptr;
+    TestPoolItem* item_array[ITEMS_PER_BATCH];
+
+    if (!CdiPoolGetMultiple(state_ptr->pool_handle, ITEMS_PER_BATCH, (void**)item_array)) {
+        CDI_LOG_THREAD(kLogError, "Thread[%d] failed to get pool items.", state_ptr->thread_number);
+        state_ptr->pass = false;
+    } else {
+        CdiPoolPutMultiple(state_ptr->pool_handle, ITEMS_PER_BATCH, (void**)item_array);
+    }
+
+    CdiOsAtomicInc32(state_ptr->ready_count_ptr);
+    CdiOsSignalWait(state_ptr->start_signal, CDI_INFINITE, NULL);
+
+    return 0; // Return value is not used.
+}
+
+/**
+ * Run the test thread on the specified number of threads at the same time.
+ *
+ * @param pool_handle Pool to use.
+ * @param thread_count Number of threads to run.
+ * @param batch_count Number of batches each thread gets and puts.
+ * @param check_items If true, items are checked for concurrent ownership.
+ * @param ret_elapsed_us_ptr Address where to write the time in microseconds it took for all threads to complete.
+ *
+ * @return true if all threads were created and passed, otherwise false.
+ */
+static bool RunThreads(CdiPoolHandle pool_handle, int thread_count, int batch_count, bool check_items,
+                       uint64_t* ret_elapsed_us_ptr)
+{
+    bool pass = true;
+    TestThreadState state_array[MAX_TEST_THREADS];
+    CdiThreadID thread_id_array[MAX_TEST_THREADS] = { 0 };
+    CdiSignalType start_signal = NULL;
+    int ready_count = 0;
+
+    if (!CdiOsSignalCreate(&start_signal)) {
+        return false;
+    }
+
+    for (int i = 0; pass && i < thread_count; i++) {
+        state_array[i] = (TestThreadState) {
+            .pool_handle = pool_handle,
+            .thread_number = i + 1,
+            .batch_count = batch_count,
+            .check_items = check_items,
+            .start_signal = start_signal,
+            .ready_count_ptr = &ready_count,
+            .pass = true
+        };
+        pass = CdiOsThreadCreate(PoolTestThread, &thread_id_array[i], "PoolTest", &state_array[i], NULL);
+    }
+
+    // Wait for all of the threads to be running, so CdiOsThreadJoin() doesn't prevent a thread from starting.
+    while (pass && CdiOsAtomicLoad32(&ready_count) < thread_count) {
+        CdiOsSleepMicroseconds(100);
+    }
+
+    uint64_t start_time = CdiOsGetMicroseconds();
+    CdiOsSignalSet(start_signal);
+    for (int i = 0; i < thread_count; i++) {
+        if (thread_id_array[i]) {
+            CdiOsThreadJoin(thread_id_array[i], CDI_INFINITE, NULL);
+            pass = pass && state_array[i].pass;
+        }
+    }
+    *ret_elapsed_us_ptr = CdiOsGetMicroseconds() - start_time;
+
+    CdiOsSignalDelete(start_signal);
+
+    return pass;
+}
+
+/**
+ * Test a pool from a single thread, verifying that all of its items can be obtained and returned.
+ *
+ * @param flags Flags used to create the pool.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus SingleThreadTest(CdiPoolFlags flags)
+{
+    CdiPoolHandle pool_handle = NULL;
+    TestPoolItem* item_array[SINGLE_THREAD_ITEM_COUNT] = { NULL };
+
+    CHECK(CdiPoolCreateWithFlags("Test Pool", SINGLE_THREAD_ITEM_COUNT, 0, 0, sizeof(TestPoolItem), flags,
+                                 &pool_handle, NULL, NULL));
+    CHECK(SINGLE_THREAD_ITEM_COUNT == CdiPoolGetFreeItemCount(pool_handle));
+
+    // Get every item in the pool, ensuring that each one is unique.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        CHECK(CdiPoolGet(pool_handle, (void**)&item_array[i]));
+        CHECK(0 == item_array[i]->owner);
+        item_array[i]->owner = 1;
+    }
+    TestPoolItem* extra_item_ptr = NULL;
+    CHECK(!CdiPoolGet(pool_handle, (void**)&extra_item_ptr));
+    CHECK(0 == CdiPoolGetFreeItemCount(pool_handle));
+
+    // Return half of them, then use PutAll to return the rest.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT / 2; i++) {
+        item_array[i]->owner = 0;
+        CdiPoolPut(pool_handle, item_array[i]);
+    }
+    CHECK(SINGLE_THREAD_ITEM_COUNT / 2 == CdiPoolGetFreeItemCount(pool_handle));
+    for (int i = SINGLE_THREAD_ITEM_COUNT / 2; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        item_array[i]->owner = 0;
+    }
+    CdiPoolPutAll(pool_handle);
+    CHECK(SINGLE_THREAD_ITEM_COUNT == CdiPoolGetFreeItemCount(pool_handle));
+
+    // Get all of the items again after PutAll.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        CHECK(CdiPoolGet(pool_handle, (void**)&item_array[i]));
+        CHECK(0 == item_array[i]->owner);
+        item_array[i]->owner = 1;
+    }
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        item_array[i]->owner = 0;
+        CdiPoolPut(pool_handle, item_array[i]);
+    }
+    CHECK(SINGLE_THREAD_ITEM_COUNT == CdiPoolGetFreeItemCount(pool_handle));
+
+    CdiPoolDestroy(pool_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test a pool from multiple threads, verifying that no item is handed to more than one thread at a time.
+ *
+ * @param flags Flags used to create the pool.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus MultiThreadTest(CdiPoolFlags flags)
+{
+    CdiPoolHandle pool_handle = NULL;
+    uint64_t elapsed_us = 0;
+
+    CHECK(CdiPoolCreateWithFlags("Test Pool", MULTI_THREAD_ITEM_COUNT, 0, 0, sizeof(TestPoolItem), flags,
+                                 &pool_handle, NULL, NULL));
+    CHECK(RunThreads(pool_handle, MAX_TEST_THREADS, CORRECTNESS_BATCH_COUNT, true, &elapsed_us));
+    CHECK(MULTI_THREAD_ITEM_COUNT == CdiPoolGetFreeItemCount(pool_handle));
+    CdiPoolDestroy(pool_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test that free items cached by threads that are idle or have exited don't exhaust a pool that can't grow. Threads
+ * that together can cache more items than the pool holds each get and put a batch of items, one after the other, and
+ * then stay idle. All of the pool's items must then be available to another thread, both while the threads are idle
+ * and after they have exited.
+ *
+ * @param flags Flags used to create the pool.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus IdleThreadCacheTest(CdiPoolFlags flags)
+{
+    const int thread_count = 6;
+    CdiPoolHandle pool_handle = NULL;
+    TestPoolItem* item_array[SINGLE_THREAD_ITEM_COUNT] = { NULL };
+    TestThreadState state_array[MAX_TEST_THREADS];
+    CdiThreadID thread_id_array[MAX_TEST_THREADS] = { 0 };
+    CdiSignalType exit_signal = NULL;
+    int ready_count = 0;
+    bool pass = true;
+
+    CHECK(CdiPoolCreateWithFlags("Test Pool", SINGLE_THREAD_ITEM_COUNT, 0, 0, sizeof(TestPoolItem), flags,
+                                 &pool_handle, NULL, NULL));
+    CHECK(CdiOsSignalCreate(&exit_signal));
+
+    // Start the threads one at a time, so each one has the pool to itself while it gets its batch.
+    for (int i = 0; pass && i < thread_count; i++) {
+        state_array[i] = (TestThreadState) {
+            .pool_handle = pool_handle,
+            .thread_number = i + 1,
+            .start_signal = exit_signal,
+            .ready_count_ptr = &ready_count,
+            .pass = true
+        };
+        pass = CdiOsThreadCreate(IdleCacheThread, &thread_id_array[i], "PoolIdle", &state_array[i], NULL);
+        while (pass && CdiOsAtomicLoad32(&ready_count) <= i) {
+            CdiOsSleepMicroseconds(100);
+        }
+        pass = pass && state_array[i].pass;
+    }
+
+    // Get every item while the threads are idle.
+    for (int i = 0; pass && i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        pass = CdiPoolGet(pool_handle, (void**)&item_array[i]);
+    }
+    if (pass) {
+        CdiPoolPutMultiple(pool_handle, SINGLE_THREAD_ITEM_COUNT, (void**)item_array);
+    }
+
+    CdiOsSignalSet(exit_signal);
+    for (int i = 0; i < thread_count; i++) {
+        if (thread_id_array[i]) {
+            CdiOsThreadJoin(thread_id_array[i], CDI_INFINITE, NULL);
+        }
+    }
+    CdiOsSignalDelete(exit_signal);
+    CHECK(pass);
+
+    // The threads have exited, so the pool must hold all of the items and hand them out again.
+    CHECK(SINGLE_THREAD_ITEM_COUNT == CdiPoolGetFreeItemCount(pool_handle));
+    CHECK(CdiPoolGetMultiple(pool_handle, SINGLE_THREAD_ITEM_COUNT, (void**)item_array));
+    CdiPoolPutMultiple(pool_handle, SINGLE_THREAD_ITEM_COUNT, (void**)item_array);
+    CdiPoolDestroy(pool_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test that more pools created with kPoolFlagThreadCache can exist at the same time than the OS provides thread data
+ * slots, and that a pool that reuses the slot of a destroyed pool doesn't see the caches of the destroyed pool.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus ManyPoolsTest(void)
+{
+    static CdiPoolHandle pool_handle_array[MANY_POOLS_COUNT] = { NULL };
+    TestPoolItem* item_ptr = NULL;
+
+    for (int i = 0; i < MANY_POOLS_COUNT; i++) {
+        CHECK(CdiPoolCreateWithFlags("Test Pool", ITEMS_PER_BATCH, 0, 0, sizeof(TestPoolItem),
+                                     kPoolFlagThreadCache, &pool_handle_array[i], NULL, NULL));
+        CHECK(CdiPoolGet(pool_handle_array[i], (void**)&item_ptr));
+        CdiPoolPut(pool_handle_array[i], item_ptr);
+    }
+
+    // Replace every other pool while this thread still has caches for all of them.
+    for (int i = 0; i < MANY_POOLS_COUNT; i += 2) {
+        CdiPoolDestroy(pool_handle_array[i]);
+        CHECK(CdiPoolCreateWithFlags("Test Pool", ITEMS_PER_BATCH, 0, 0, sizeof(TestPoolItem),
+                                     kPoolFlagThreadCache, &pool_handle_array[i], NULL, NULL));
+    }
+    for (int i = 0; i < MANY_POOLS_COUNT; i++) {
+        CHECK(CdiPoolGet(pool_handle_array[i], (void**)&item_ptr));
+        CHECK(ITEMS_PER_BATCH - 1 == CdiPoolGetFreeItemCount(pool_handle_array[i]));
+        CdiPoolPut(pool_handle_array[i], item_ptr);
+    }
+
+    for (int i = 0; i < MANY_POOLS_COUNT; i++) {
+        CdiPoolDestroy(pool_handle_array[i]);
+    }
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test getting and putting multiple items using CdiPoolGetMultiple(), CdiPoolPutList() and CdiPoolPutMultiple().
+ *
+ * @param flags Flags used to create the pool.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus BulkTest(CdiPoolFlags flags)
+{
+    CdiPoolHandle pool_handle = NULL;
+    TestPoolItem* item_array[SINGLE_THREAD_ITEM_COUNT] = { NULL };
+    const int half_count = SINGLE_THREAD_ITEM_COUNT / 2;
+
+    CHECK(CdiPoolCreateWithFlags("Test Pool", SINGLE_THREAD_ITEM_COUNT, 0, 0, sizeof(TestPoolItem), flags,
+                                 &pool_handle, NULL, NULL));
+
+    // Get half of the items, then ensure that asking for more than what is left fails without taking any.
+    CHECK(CdiPoolGetMultiple(pool_handle, half_count, (void**)item_array));
+    CHECK(half_count == CdiPoolGetFreeItemCount(pool_handle));
+    CHECK(!CdiPoolGetMultiple(pool_handle, half_count + 1, (void**)&item_array[half_count]));
+    CHECK(half_count == CdiPoolGetFreeItemCount(pool_handle));
+    CHECK(CdiPoolGetMultiple(pool_handle, half_count, (void**)&item_array[half_count]));
+    CHECK(0 == CdiPoolGetFreeItemCount(pool_handle));
+
+    // Ensure that every item is unique.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        CHECK(0 == item_array[i]->owner);
+        item_array[i]->owner = 1;
+    }
+
+    // Link the items together and put them back with a single call.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        item_array[i]->owner = 0;
+        item_array[i]->next_ptr = (i + 1 < SINGLE_THREAD_ITEM_COUNT) ? item_array[i + 1] : NULL;
+    }
+    CHECK(CdiPoolPutList(pool_handle, item_array[0], offsetof(TestPoolItem, next_ptr)));
+    CHECK(SINGLE_THREAD_ITEM_COUNT == CdiPoolGetFreeItemCount(pool_handle));
+    CHECK(CdiPoolPutList(pool_handle, NULL, offsetof(TestPoolItem, next_ptr)));
+
+    // Get all the items again and put them back as an array, in two parts.
+    CHECK(CdiPoolGetMultiple(pool_handle, SINGLE_THREAD_ITEM_COUNT, (void**)item_array));
+    CHECK(0 == CdiPoolGetFreeItemCount(pool_handle));
+    CdiPoolPutMultiple(pool_handle, half_count, (void**)item_array);
+    CHECK(half_count == CdiPoolGetFreeItemCount(pool_handle));
+    CdiPoolPutMultiple(pool_handle, 0, (void**)item_array);
+    CdiPoolPutMultiple(pool_handle, SINGLE_THREAD_ITEM_COUNT - half_count, (void**)&item_array[half_count]);
+    CHECK(SINGLE_THREAD_ITEM_COUNT == CdiPoolGetFreeItemCount(pool_handle));
+
+    CdiPoolDestroy(pool_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test the usage statistics of a pool that grows and is then exhausted.
+ *
+ * @param flags Flags used to create the pool.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus StatsTest(CdiPoolFlags flags)
+{
+    CdiPoolHandle pool_handle = NULL;
+    const int max_item_count = SINGLE_THREAD_ITEM_COUNT + ITEMS_PER_BATCH;
+    TestPoolItem* item_array[SINGLE_THREAD_ITEM_COUNT + ITEMS_PER_BATCH] = { NULL };
+    CdiPoolStats stats;
+
+    CHECK(CdiPoolCreateWithFlags("Test Pool", SINGLE_THREAD_ITEM_COUNT, ITEMS_PER_BATCH, 1, sizeof(TestPoolItem),
+                                 flags, &pool_handle, NULL, NULL));
+    CdiPoolGetStats(pool_handle, &stats);
+    CHECK(SINGLE_THREAD_ITEM_COUNT == stats.total_item_count);
+    CHECK(SINGLE_THREAD_ITEM_COUNT == stats.free_item_count);
+    CHECK(0 == stats.high_water_item_count);
+    CHECK(0 == stats.grow_count);
+    CHECK(0 == stats.get_fail_count);
+    const uint64_t initial_byte_size = stats.byte_size;
+    CHECK(initial_byte_size >= SINGLE_THREAD_ITEM_COUNT * sizeof(TestPoolItem));
+
+    // Use every item, which requires the pool to grow once, then fail to get one more.
+    for (int i = 0; i < max_item_count; i++) {
+        CHECK(CdiPoolGet(pool_handle, (void**)&item_array[i]));
+    }
+    TestPoolItem* extra_item_ptr = NULL;
+    CHECK(!CdiPoolGet(pool_handle, (void**)&extra_item_ptr));
+    CHECK(!CdiPoolGetMultiple(pool_handle, 2, (void**)item_array));
+
+    CdiPoolGetStats(pool_handle, &stats);
+    CHECK(max_item_count == stats.total_item_count);
+    CHECK(0 == stats.free_item_count);
+    CHECK(max_item_count == stats.high_water_item_count);
+    CHECK(1 == stats.grow_count);
+    CHECK(2 == stats.get_fail_count);
+    CHECK(stats.byte_size == initial_byte_size * max_item_count / SINGLE_THREAD_ITEM_COUNT);
+
+    // Returning the items must not change the counters.
+    for (int i = 0; i < max_item_count; i++) {
+        CdiPoolPut(pool_handle, item_array[i]);
+    }
+    CdiPoolGetStats(pool_handle, &stats);
+    CHECK(max_item_count == stats.free_item_count);
+    CHECK(max_item_count == stats.high_water_item_count);
+    CHECK(2 == stats.get_fail_count);
+
+    CdiPoolDestroy(pool_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Pool item initialization function used to check that slim item pools reject initialization functions.
+ *
+ * @param context_ptr Not used.
+ * @param item_ptr Not used.
+ *
+ * @return Always true.
+ */
+static bool NopItemInit(const void* context_ptr, void* item_ptr)
+{
+    (void)context_ptr;
+    (void)item_ptr;
+    return true;
+}
+
+/**
+ * Pool item operator used to count the items in a pool.
+ *
+ * @param context_ptr Pointer to the count to increment.
+ * @param item_ptr Not used.
+ *
+ * @return Always true.
+ */
+static bool CountItem(const void* context_ptr, void* item_ptr)
+{
+    (void)item_ptr;
+    (*(int*)context_ptr)++;
+    return true;
+}
+
+/**
+ * Test pools created with kPoolFlagSlimItems, which have no item header and do not track items that are in use.
+ *
+ * @param flags Flags used to create the pools, in addition to kPoolFlagSlimItems.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus SlimItemsTest(CdiPoolFlags flags)
+{
+    CdiPoolHandle pool_handle = NULL;
+    CdiPoolHandle regular_pool_handle = NULL;
+    CdiSglEntry* item_array[SINGLE_THREAD_ITEM_COUNT + ITEMS_PER_BATCH] = { NULL };
+    const int max_item_count = CDI_ARRAY_ELEMENT_COUNT(item_array);
+    CdiPoolStats stats;
+    CdiPoolStats regular_stats;
+
+    // Item contents are not preserved while free, so an initialization function is not allowed.
+    CHECK(!CdiPoolCreateWithFlags("Test Pool", SINGLE_THREAD_ITEM_COUNT, 0, 0, sizeof(CdiSglEntry),
+                                  flags | kPoolFlagSlimItems, &pool_handle, NopItemInit, NULL));
+    CHECK(NULL == pool_handle);
+
+    CHECK(CdiPoolCreateWithFlags("Test Pool", SINGLE_THREAD_ITEM_COUNT, ITEMS_PER_BATCH, 1, sizeof(CdiSglEntry),
+                                 flags | kPoolFlagSlimItems, &pool_handle, NULL, NULL));
+    CHECK(CdiPoolCreateWithFlags("Test Pool", SINGLE_THREAD_ITEM_COUNT, ITEMS_PER_BATCH, 1, sizeof(CdiSglEntry),
+                                 flags, &regular_pool_handle, NULL, NULL));
+    CdiPoolGetStats(pool_handle, &stats);
+    CdiPoolGetStats(regular_pool_handle, &regular_stats);
+    CHECK(stats.byte_size >= SINGLE_THREAD_ITEM_COUNT * sizeof(CdiSglEntry));
+    CHECK(stats.byte_size < regular_stats.byte_size);
+    CdiPoolDestroy(regular_pool_handle);
+
+    // Use every item, which requires the pool to grow once. Items must not overlap.
+    for (int i = 0; i < max_item_count; i++) {
+        CHECK(CdiPoolGet(pool_handle, (void**)&item_array[i]));
+        memset(item_array[i], 0, sizeof(CdiSglEntry));
+        item_array[i]->size_in_bytes = i;
+    }
+    for (int i = 0; i < max_item_count; i++) {
+        CHECK(i == item_array[i]->size_in_bytes);
+    }
+    void* peek_item_ptr = NULL;
+    CHECK(!CdiPoolPeekInUse(pool_handle, &peek_item_ptr));
+    // Return half of the items as a list and the rest one at a time.
+    const int list_count = max_item_count / 2;
+    for (int i = 0; i < list_count; i++) {
+        item_array[i]->next_ptr = (i + 1 < list_count) ? item_array[i + 1] : NULL;
+    }
+    CHECK(CdiPoolPutList(pool_handle, item_array[0], offsetof(CdiSglEntry, next_ptr)));
+    for (int i = list_count; i < max_item_count; i++) {
+        CdiPoolPut(pool_handle, item_array[i]);
+    }
+    CHECK(max_item_count == CdiPoolGetFreeItemCount(pool_handle));
+    int item_count = 0;
+    CHECK(CdiPoolForEachItem(pool_handle, CountItem, &item_count));
+    CHECK(max_item_count == item_count);
+
+    // CdiPoolPutAll() rebuilds the free list from the pool's buffers, since in-use items are not tracked.
+    CHECK(CdiPoolGetMultiple(pool_handle, ITEMS_PER_BATCH, (void**)item_array));
+    CdiPoolPutAll(pool_handle);
+    CHECK(max_item_count == CdiPoolGetFreeItemCount(pool_handle));
+    CHECK(CdiPoolGetMultiple(pool_handle, max_item_count, (void**)item_array));
+    CHECK(0 == CdiPoolGetFreeItemCount(pool_handle));
+    for (int i = 0; i < max_item_count; i++) {
+        for (int j = i + 1; j < max_item_count; j++) {
+            CHECK(item_array[i] != item_array[j]);
+        }
+    }
+    CdiPoolPutAll(pool_handle);
+    CHECK(max_item_count == CdiPoolGetFreeItemCount(pool_handle));
+
+    CdiPoolDestroy(pool_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test pools placed on a NUMA node, including buffers added when the pool grows.
+ *
+ * @param flags Flags used to create the pools.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus NumaTest(CdiPoolFlags flags)
+{
+    const int numa_node = CdiOsGetCpuNumaNode(0);
+    const int grow_count = SINGLE_THREAD_ITEM_COUNT / 2;
+    const int max_grow_count = 2;
+    const int total_count = SINGLE_THREAD_ITEM_COUNT + grow_count * max_grow_count;
+    TestPoolItem* item_array[SINGLE_THREAD_ITEM_COUNT * 2];
+    CdiPoolHandle pool_handle = NULL;
+
+    CHECK(CDI_ARRAY_ELEMENT_COUNT(item_array) >= total_count);
+    CHECK(CdiPoolCreateOnNumaNode("Numa Pool", SINGLE_THREAD_ITEM_COUNT, grow_count, max_grow_count,
+                                  sizeof(TestPoolItem), flags, numa_node, &pool_handle, NULL, NULL));
+
+    // Getting every item forces the pool to grow to its maximum size.
+    for (int i = 0; i < total_count; i++) {
+        CHECK(CdiPoolGet(pool_handle, (void**)&item_array[i]));
+        item_array[i]->sequence = i;
+    }
+    CHECK(total_count == CdiPoolGetTotalItemCount(pool_handle));
+    if (CDI_NUMA_NODE_ANY != numa_node) {
+        const int placed_numa_node = CdiPoolGetNumaNode(pool_handle);
+        CHECK(CDI_NUMA_NODE_ANY == placed_numa_node || numa_node == placed_numa_node);
+    }
+    for (int i = 0; i < total_count; i++) {
+        CHECK(i == item_array[i]->sequence);
+        CdiPoolPut(pool_handle, item_array[i]);
+    }
+    CHECK(total_count == CdiPoolGetFreeItemCount(pool_handle));
+    CdiPoolDestroy(pool_handle);
+
+    // CDI_NUMA_NODE_ANY must behave the same as CdiPoolCreateWithFlags().
+    CHECK(CdiPoolCreateOnNumaNode("Numa Pool", SINGLE_THREAD_ITEM_COUNT, 0, 0, sizeof(TestPoolItem), flags,
+                                  CDI_NUMA_NODE_ANY, &pool_handle, NULL, NULL));
+    CHECK(CdiPoolGet(pool_handle, (void**)&item_array[0]));
+    CdiPoolPut(pool_handle, item_array[0]);
+    CdiPoolDestroy(pool_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test pools created with kPoolFlagHugePages, including buffers added when the pool grows. Huge pages are only used if
+ * the host has some available, so this mostly checks that pools work either way.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus HugePageTest(void)
+{
+    CdiPoolHandle pool_handle = NULL;
+
+    // Too small to be worth a huge page.
+    CHECK(CdiPoolCreateWithFlags("Huge Page Pool", SINGLE_THREAD_ITEM_COUNT, 0, 0, sizeof(TestPoolItem),
+                                 kPoolFlagThreadSafe | kPoolFlagHugePages, &pool_handle, NULL, NULL));
+    CHECK(!CdiPoolUsesHugePages(pool_handle));
+    CdiPoolDestroy(pool_handle);
+
+    const int grow_count = HUGE_PAGE_TEST_ITEM_COUNT / 2;
+    const int total_count = HUGE_PAGE_TEST_ITEM_COUNT + grow_count;
+    TestPoolItem** item_array = CdiOsMemAlloc(total_count * sizeof(TestPoolItem*));
+    CHECK(NULL != item_array);
+    CHECK(CdiPoolCreateWithFlags("Huge Page Pool", HUGE_PAGE_TEST_ITEM_COUNT, grow_count, 1, 64,
+                                 kPoolFlagThreadSafe | kPoolFlagHugePages, &pool_handle, NULL, NULL));
+    CDI_LOG_THREAD(kLogInfo, "Pool huge page test: huge pages are %savailable.",
+                   CdiPoolUsesHugePages(pool_handle) ? "" : "not ");
+    for (int i = 0; i < total_count; i++) {
+        CHECK(CdiPoolGet(pool_handle, (void**)&item_array[i]));
+        item_array[i]->sequence = i;
+    }
+    CHECK(total_count == CdiPoolGetTotalItemCount(pool_handle));
+    for (int i = 0; i < total_count; i++) {
+        CHECK(i == item_array[i]->sequence);
+        CdiPoolPut(pool_handle, item_array[i]);
+    }
+    CdiPoolDestroy(pool_handle);
+    CdiOsMemFree(item_array);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Log the time taken by random accesses to the items of a large pool, with and without kPoolFlagHugePages. This is how
+ * the SDK accesses its work request and payload state pools, since items are returned in completion order.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus HugePageBenchmark(void)
+{
+    const CdiPoolFlags flags_array[] = { kPoolFlagNone, kPoolFlagHugePages };
+    TestPoolItem** item_array = CdiOsMemAlloc(HUGE_PAGE_BENCHMARK_ITEM_COUNT * sizeof(TestPoolItem*));
+    CHECK(NULL != item_array);
+
+    for (int f = 0; f < CDI_ARRAY_ELEMENT_COUNT(flags_array); f++) {
+        CdiPoolHandle pool_handle = NULL;
+        CHECK(CdiPoolCreateWithFlags("Huge Page Benchmark Pool", HUGE_PAGE_BENCHMARK_ITEM_COUNT, 0, 0,
+                                     HUGE_PAGE_BENCHMARK_ITEM_BYTES, flags_array[f], &pool_handle, NULL, NULL));
+        const bool uses_huge_pages = CdiPoolUsesHugePages(pool_handle);
+        CHECK(CdiPoolGetMultiple(pool_handle, HUGE_PAGE_BENCHMARK_ITEM_COUNT, (void**)item_array));
+
+        // Use a linear congruential generator so every run makes the same accesses.
+        uint32_t random_value = 1;
+        int sum = 0;
+        uint64_t start_time = CdiOsGetMicroseconds();
+        for (int i = 0; i < HUGE_PAGE_BENCHMARK_ACCESS_COUNT; i++) {
+            random_value = random_value * 1664525 + 1013904223;
+            TestPoolItem* item_ptr = item_array[(random_value >> 8) % HUGE_PAGE_BENCHMARK_ITEM_COUNT];
+            item_ptr->sequence++;
+            sum += item_ptr->owner;
+        }
+        uint64_t elapsed_us = CdiOsGetMicroseconds() - start_time;
+
+        for (int i = 0; i < HUGE_PAGE_BENCHMARK_ITEM_COUNT; i++) {
+            CdiPoolPut(pool_handle, item_array[i]);
+        }
+        CdiPoolDestroy(pool_handle);
+        CHECK(0 == sum);
+
+        CDI_LOG_THREAD(kLogInfo, "Pool huge page benchmark [%s]: [%"PRIu64"]ps/random item access.",
+                       uses_huge_pages ? "huge pages" : "regular pages",
+                       (elapsed_us * 1000 * 1000) / HUGE_PAGE_BENCHMARK_ACCESS_COUNT);
+    }
+    CdiOsMemFree(item_array);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Thread used by the NUMA benchmark. Works like a poll thread: gets every item in the pool, writes all of its data and
+ * puts it back.
+ *
+ * @param arg_ptr Pointer to the thread's NumaBenchmarkState.
+ *
+ * @return The return value is not used.
+ */
+static CDI_THREAD NumaBenchmarkThread(void* arg_ptr)
+{
+    NumaBenchmarkState* state_ptr = (NumaBenchmarkState*)arg_ptr;
+
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int pass = 0; pass < NUMA_BENCHMARK_PASS_COUNT && state_ptr->pass; pass++) {
+        if (!CdiPoolGetMultiple(state_ptr->pool_handle, NUMA_BENCHMARK_ITEM_COUNT, state_ptr->item_array)) {
+            state_ptr->pass = false;
+        } else {
+            for (int i = 0; i < NUMA_BENCHMARK_ITEM_COUNT; i++) {
+                memset(state_ptr->item_array[i], pass, NUMA_BENCHMARK_ITEM_BYTES);
+            }
+            for (int i = 0; i < NUMA_BENCHMARK_ITEM_COUNT; i++) {
+                CdiPoolPut(state_ptr->pool_handle, state_ptr->item_array[i]);
+            }
+        }
+    }
+    state_ptr->elapsed_us = CdiOsGetMicroseconds() - start_time;
+    CdiOsSignalSet(state_ptr->done_signal);
+
+    return 0;
+}
+
+/**
+ * Log the time a poll thread like workload takes on a CPU core of each NUMA node, using a pool placed on each NUMA
+ * node. On hosts with a single NUMA node only one result is logged.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus NumaBenchmark(void)
+{
+    // Find the first CPU core of each NUMA node.
+    int node_cpu_array[NUMA_BENCHMARK_MAX_NODES];
+    for (int i = 0; i < NUMA_BENCHMARK_MAX_NODES; i++) {
+        node_cpu_array[i] = -1;
+    }
+    int node_count = 0;
+    for (int cpu = 0; cpu < NUMA_BENCHMARK_MAX_CPUS; cpu++) {
+        const int numa_node = CdiOsGetCpuNumaNode(cpu);
+        if (numa_node >= 0 && numa_node < NUMA_BENCHMARK_MAX_NODES && -1 == node_cpu_array[numa_node]) {
+            node_cpu_array[numa_node] = cpu;
+            node_count++;
+        }
+    }
+    if (0 == node_count) {
+        CDI_LOG_THREAD(kLogInfo, "Pool NUMA benchmark skipped. NUMA nodes of CPU cores are not known.");
+        return kCdiStatusOk;
+    }
+
+    NumaBenchmarkState state = { 0 };
+    state.item_array = CdiOsMemAlloc(NUMA_BENCHMARK_ITEM_COUNT * sizeof(void*));
+    CHECK(NULL != state.item_array);
+    CHECK(CdiOsSignalCreate(&state.done_signal));
+
+    for (int pool_node = 0; pool_node < NUMA_BENCHMARK_MAX_NODES; pool_node++) {
+        for (int thread_node = 0; thread_node < NUMA_BENCHMARK_MAX_NODES; thread_node++) {
+            if (-1 == node_cpu_array[pool_node] || -1 == node_cpu_array[thread_node]) {
+                continue;
+            }
+            CHECK(CdiPoolCreateOnNumaNode("Numa Benchmark Pool", NUMA_BENCHMARK_ITEM_COUNT, 0, 0,
+                                          NUMA_BENCHMARK_ITEM_BYTES, kPoolFlagNone, pool_node, &state.pool_handle,
+                                          NULL, NULL));
+            state.pass = true;
+            CdiOsSignalClear(state.done_signal);
+            CdiThreadID thread_id = NULL;
+            CHECK(CdiOsThreadCreatePinned(NumaBenchmarkThread, &thread_id, "NumaBench", &state, NULL,
+                                          node_cpu_array[thread_node]));
+            // Wait for the thread to finish before joining, so CdiOsThreadJoin() doesn't prevent it from starting.
+            CHECK(CdiOsSignalWait(state.done_signal, CDI_INFINITE, NULL));
+            CHECK(CdiOsThreadJoin(thread_id, CDI_INFINITE, NULL));
+            CdiPoolDestroy(state.pool_handle);
+            CHECK(state.pass);
+
+            const uint64_t item_count = (uint64_t)NUMA_BENCHMARK_ITEM_COUNT * NUMA_BENCHMARK_PASS_COUNT;
+            CDI_LOG_THREAD(kLogInfo, "Pool NUMA benchmark pool node[%d] thread CPU[%d] node[%d]: [%"PRIu64"]ns/item "
+                           "(%s).", pool_node, node_cpu_array[thread_node], thread_node,
+                           (state.elapsed_us * 1000) / item_count, (pool_node == thread_node) ? "local" : "remote");
+        }
+    }
+    CdiOsSignalDelete(state.done_signal);
+    CdiOsMemFree(state.item_array);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Log the CPU time used per frame to free a frame's worth of packet sized items, comparing one CdiPoolPut() per item
+ * against a single CdiPoolPutList() and against CdiPoolPutMultiple() calls of MAX_TX_WORK_REQUEST_PUT_BATCH_SIZE items,
+ * the way completed Tx work requests are freed.
+ *
+ * @param flags Flags used to create the pool.
+ * @param flags_str Name of flags used in log message.
+ * @param frame_name_str Name of the frame format used in log message.
+ * @param frame_bytes Number of payload bytes in a frame.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus FrameBenchmark(CdiPoolFlags flags, const char* flags_str, const char* frame_name_str,
+                                      int frame_bytes)
+{
+    CdiPoolHandle pool_handle = NULL;
+    const int entry_count = (frame_bytes + FRAME_BENCHMARK_PACKET_BYTES - 1) / FRAME_BENCHMARK_PACKET_BYTES;
+    uint64_t put_us = 0;
+    uint64_t put_list_us = 0;
+    uint64_t put_multiple_us = 0;
+
+    static TestPoolItem* item_array[FRAME_BENCHMARK_ITEM_COUNT];
+    CHECK(entry_count <= FRAME_BENCHMARK_ITEM_COUNT);
+    CHECK(CdiPoolCreateWithFlags("Benchmark Pool", FRAME_BENCHMARK_ITEM_COUNT, 0, 0, sizeof(TestPoolItem), flags,
+                                 &pool_handle, NULL, NULL));
+
+    for (int frame = 0; frame < FRAME_BENCHMARK_FRAME_COUNT * 3; frame++) {
+        CHECK(CdiPoolGetMultiple(pool_handle, entry_count, (void**)item_array));
+        for (int i = 0; i < entry_count; i++) {
+            item_array[i]->next_ptr = (i + 1 < entry_count) ? item_array[i + 1] : NULL;
+        }
+
+        uint64_t start_time = CdiOsGetMicroseconds();
+        if (1 == frame % 3) {
+            CdiPoolPutList(pool_handle, item_array[0], offsetof(TestPoolItem, next_ptr));
+            put_list_us += CdiOsGetMicroseconds() - start_time;
+        } else if (2 == frame % 3) {
+            for (int i = 0; i < entry_count; i += MAX_TX_WORK_REQUEST_PUT_BATCH_SIZE) {
+                CdiPoolPutMultiple(pool_handle, CDI_MIN(entry_count - i, MAX_TX_WORK_REQUEST_PUT_BATCH_SIZE),
+                                   (void**)&item_array[i]);
+            }
+            put_multiple_us += CdiOsGetMicroseconds() - start_time;
+        } else {
+            TestPoolItem* item_ptr = item_array[0];
+            while (item_ptr) {
+                TestPoolItem* next_ptr = item_ptr->next_ptr; // Save next item, since Put() will free its memory.
+                CdiPoolPut(pool_handle, item_ptr);
+                item_ptr = next_ptr;
+            }
+            put_us += CdiOsGetMicroseconds() - start_time;
+        }
+    }
+    CHECK(FRAME_BENCHMARK_ITEM_COUNT == CdiPoolGetFreeItemCount(pool_handle));
+    CdiPoolDestroy(pool_handle);
+
+    CDI_LOG_THREAD(kLogInfo, "Pool frame benchmark [%s] [%s] entries[%d]: CdiPoolPut() [%"PRIu64"]ns/frame, "
+                   "CdiPoolPutList() [%"PRIu64"]ns/frame, CdiPoolPutMultiple() [%"PRIu64"]ns/frame.", flags_str,
+                   frame_name_str, entry_count, (put_us * 1000) / FRAME_BENCHMARK_FRAME_COUNT,
+                   (put_list_us * 1000) / FRAME_BENCHMARK_FRAME_COUNT,
+                   (put_multiple_us * 1000) / FRAME_BENCHMARK_FRAME_COUNT);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Log the memory used by and the get/put rate of pools of SGL entries, with and without kPoolFlagSlimItems.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus SlimItemsBenchmark(void)
+{
+    const CdiPoolFlags flags_array[] = { kPoolFlagThreadSafe, kPoolFlagThreadSafe | kPoolFlagSlimItems };
+    const char* flags_str_array[] = { "regular", "slim" };
+    static CdiSglEntry* item_array[SLIM_BENCHMARK_ITEM_COUNT];
+
+    for (int f = 0; f < CDI_ARRAY_ELEMENT_COUNT(flags_array); f++) {
+        CdiPoolHandle pool_handle = NULL;
+        CdiPoolStats stats;
+        CHECK(CdiPoolCreateWithFlags("Benchmark Pool", SLIM_BENCHMARK_ITEM_COUNT, 0, 0, sizeof(CdiSglEntry),
+                                     flags_array[f], &pool_handle, NULL, NULL));
+        CdiPoolGetStats(pool_handle, &stats);
+
+        uint64_t start_time = CdiOsGetMicroseconds();
+        for (int pass = 0; pass < SLIM_BENCHMARK_PASS_COUNT; pass++) {
+            for (int i = 0; i < SLIM_BENCHMARK_ITEM_COUNT; i++) {
+                CHECK(CdiPoolGet(pool_handle, (void**)&item_array[i]));
+                item_array[i]->size_in_bytes = i;
+            }
+            for (int i = 0; i < SLIM_BENCHMARK_ITEM_COUNT; i++) {
+                CdiPoolPut(pool_handle, item_array[i]);
+            }
+        }
+        uint64_t elapsed_us = CdiOsGetMicroseconds() - start_time;
+        CdiPoolDestroy(pool_handle);
+
+        uint64_t op_count = (uint64_t)SLIM_BENCHMARK_PASS_COUNT * SLIM_BENCHMARK_ITEM_COUNT * 2;
+        CDI_LOG_THREAD(kLogInfo, "Pool slim items benchmark [%s] items[%d]: [%"PRIu64"] bytes ([%"PRIu64"] bytes/item), "
+                       "[%"PRIu64"] get/put operations/ms.", flags_str_array[f], SLIM_BENCHMARK_ITEM_COUNT,
+                       stats.byte_size, stats.byte_size / SLIM_BENCHMARK_ITEM_COUNT,
+                       elapsed_us ? (op_count * 1000) / elapsed_us : 0);
+    }
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Log the get/put rate of locked and thread cached pools using 1, 2, 4 and 8 threads.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus ContentionBenchmark(void)
+{
+    const CdiPoolFlags flags_array[] = { kPoolFlagThreadSafe, kPoolFlagThreadCache };
+    const char* flags_str_array[] = { "locked", "thread cache" };
+
+    for (int f = 0; f < CDI_ARRAY_ELEMENT_COUNT(flags_array); f++) {
+        for (int thread_count = 1; thread_count <= MAX_TEST_THREADS; thread_count *= 2) {
+            CdiPoolHandle pool_handle = NULL;
+            uint64_t elapsed_us = 0;
+            CHECK(CdiPoolCreateWithFlags("Benchmark Pool", MULTI_THREAD_ITEM_COUNT, 0, 0, sizeof(TestPoolItem),
+                                         flags_array[f], &pool_handle, NULL, NULL));
+            CHECK(RunThreads(pool_handle, thread_count, BENCHMARK_BATCH_COUNT, false, &elapsed_us));
+            CdiPoolDestroy(pool_handle);
+
+            // Each batch is ITEMS_PER_BATCH gets and the same number of puts.
+            uint64_t op_count = (uint64_t)thread_count * BENCHMARK_BATCH_COUNT * ITEMS_PER_BATCH * 2;
+            CDI_LOG_THREAD(kLogInfo, "Pool benchmark [%s] threads[%d]: [%"PRIu64"] get/put operations in "
+                           "[%"PRIu64"]us ([%"PRIu64"] operations/ms).", flags_str_array[f], thread_count, op_count,
+                           elapsed_us, elapsed_us ? (op_count * 1000) / elapsed_us : 0);
+        }
+    }
+
+    return kCdiStatusOk;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitPool(void)
+{
+    CHECK(kCdiStatusOk == SingleThreadTest(kPoolFlagThreadSafe));
+    CHECK(kCdiStatusOk == SingleThreadTest(kPoolFlagThreadCache));
+    CHECK(kCdiStatusOk == MultiThreadTest(kPoolFlagThreadSafe));
+    CHECK(kCdiStatusOk == MultiThreadTest(kPoolFlagThreadCache));
+    CHECK(kCdiStatusOk == IdleThreadCacheTest(kPoolFlagThreadSafe));
+    CHECK(kCdiStatusOk == IdleThreadCacheTest(kPoolFlagThreadCache));
+    CHECK(kCdiStatusOk == ManyPoolsTest());
+    CHECK(kCdiStatusOk == BulkTest(kPoolFlagThreadSafe));
+    CHECK(kCdiStatusOk == BulkTest(kPoolFlagThreadCache));
+    CHECK(kCdiStatusOk == StatsTest(kPoolFlagThreadSafe));
+    CHECK(kCdiStatusOk == StatsTest(kPoolFlagThreadCache));
+    CHECK(kCdiStatusOk == StatsTest(kPoolFlagThreadSafe | kPoolFlagSlimItems));
+    CHECK(kCdiStatusOk == SlimItemsTest(kPoolFlagThreadSafe));
+    CHECK(kCdiStatusOk == SlimItemsTest(kPoolFlagThreadCache));
+    CHECK(kCdiStatusOk == NumaTest(kPoolFlagThreadSafe));
+    CHECK(kCdiStatusOk == NumaTest(kPoolFlagThreadCache));
+    CHECK(kCdiStatusOk == HugePageTest());
+    CHECK(kCdiStatusOk == ContentionBenchmark());
+    CHECK(kCdiStatusOk == FrameBenchmark(kPoolFlagThreadSafe, "locked", "1080p60", FRAME_BENCHMARK_1080P_BYTES));
+    CHECK(kCdiStatusOk == FrameBenchmark(kPoolFlagThreadSafe, "locked", "2160p60", FRAME_BENCHMARK_2160P_BYTES));
+    CHECK(kCdiStatusOk == FrameBenchmark(kPoolFlagThreadCache, "thread cache", "1080p60",
+                                         FRAME_BENCHMARK_1080P_BYTES));
+    CHECK(kCdiStatusOk == FrameBenchmark(kPoolFlagThreadCache, "thread cache", "2160p60",
+                                         FRAME_BENCHMARK_2160P_BYTES));
+    CHECK(kCdiStatusOk == NumaBenchmark());
+    CHECK(kCdiStatusOk == HugePageBenchmark());
+    CHECK(kCdiStatusOk == SlimItemsBenchmark());
+
+    return kCdiStatusOk;
+}
@@ -0,0 +1,749 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains a unit test for the CdiQueue functionality, including wrapping, growing and single-producer/
+ * single-consumer ordering and the batched push/pop functions. It also logs single-producer/single-consumer throughput
+ * and latency benchmarks.
+ */
+
+#include "cdi_core_api.h"
+#include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "cdi_queue_api.h"
+#include "utilities_api.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// Number of items in the queue used for the single threaded tests. Deliberately not a power of two.
+#define SINGLE_THREAD_ITEM_COUNT        (5)
+
+/// Number of items the growable queue is increased by.
+#define GROW_ITEM_COUNT                 (3)
+
+/// Maximum number of times the growable queue may be increased.
+#define MAX_GROW_COUNT                  (4)
+
+/// Number of items in the queue used for the single-producer/single-consumer tests.
+#define SPSC_ITEM_COUNT                 (64)
+
+/// Number of items pushed by the producer thread in the single-producer/single-consumer ordering test.
+#define SPSC_CORRECTNESS_ITEM_COUNT     (100000)
+
+/// Number of items pushed by the producer thread in the throughput benchmark.
+#define THROUGHPUT_BENCHMARK_ITEM_COUNT (1000000)
+
+/// Number of items in the queue used for the throughput benchmark.
+#define THROUGHPUT_BENCHMARK_QUEUE_SIZE (1024)
+
+/// Number of round trips used by the latency benchmark.
+#define LATENCY_BENCHMARK_ROUND_TRIPS   (20000)
+
+/// Number of items moved by each CdiQueuePushMultiple()/CdiQueuePopMultiple() call in the batched tests.
+#define BATCH_ITEM_COUNT                (16)
+
+/// Number of push/pop pairs used by the uncontended benchmark.
+#define UNCONTENDED_BENCHMARK_OP_COUNT  (1000000)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+/**
+ * @brief Structure of the items stored in the test queues. Sized like the work request completion messages that are
+ * carried by the SDK's queues.
+ */
+typedef struct {
+    uint64_t sequence;  ///< Incrementing value written by the producer.
+    void* data_ptr;     ///< Unused, makes the item the same size as a typical queue message.
+    int data_size;      ///< Unused, makes the item the same size as a typical queue message.
+} TestQueueItem;
+
+/**
+ * @brief State passed to the producer and echo test threads.
+ */
+typedef struct {
+    CdiQueueHandle queue_handle;       ///< Queue the thread pushes to.
+    CdiQueueHandle return_queue_handle; ///< Queue the echo thread pops from. Only used by EchoTestThread().
+    int first_sequence;                ///< Sequence number of the first item pushed by ProducerTestThread().
+    int item_count;                    ///< Number of items to push.
+    int batch_count;                   ///< Number of items ProducerTestThread() pushes with each call.
+    int ready_count;                   ///< Set to 1 once the thread is running.
+    bool pass;                         ///< Set to false by the thread if an error was detected.
+} TestThreadState;
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+static CdiSignalType abort_signal = NULL; ///< Abort signal used by the wait functions. Never set.
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Thread that pushes incrementing sequence numbers to a queue, waiting whenever the queue is full.
+ *
+ * @param arg_ptr Pointer to the thread's TestThreadState.
+ *
+ * @return The return value is not used.
+ */
+static CDI_THREAD ProducerTestThread(void* arg_ptr)
+{
+    TestThreadState* state_ptr = (TestThreadState*)arg_ptr;
+    TestQueueItem item_array[BATCH_ITEM_COUNT] = { 0 };
+    CdiSignalType push_signal = CdiQueueGetPushWaitSignal(state_ptr->queue_handle);
+
+    CdiOsAtomicStore32(&state_ptr->ready_count, 1);
+    for (int i = 0; state_ptr->pass && i < state_ptr->item_count;) {
+        if (state_ptr->batch_count <= 1) {
+            item_array[0].sequence = state_ptr->first_sequence + i;
+            if (!CdiQueuePushWait(state_ptr->queue_handle, CDI_INFINITE, abort_signal, &item_array[0])) {
+                CDI_LOG_THREAD(kLogError, "Failed to push item[%d].", i);
+                state_ptr->pass = false;
+            }
+            i++;
+        } else {
+            int count = CDI_MIN(state_ptr->batch_count, state_ptr->item_count - i);
+            for (int j = 0; j < count; j++) {
+                item_array[j].sequence = state_ptr->first_sequence + i + j;
+            }
+            int pushed_count = CdiQueuePushMultiple(state_ptr->queue_handle, item_array, count);
+            if (0 == pushed_count) {
+                // Queue is full. Clear the signal before trying again, so a pop that happens after the attempt is not
+                // missed.
+                CdiOsSignalClear(push_signal);
+                pushed_count = CdiQueuePushMultiple(state_ptr->queue_handle, item_array, count);
+                if (0 == pushed_count) {
+                    CdiOsSignalWait(push_signal, CDI_INFINITE, NULL);
+                }
+            }
+            i += pushed_count;
+        }
+    }
+
+    return 0; // Return value is not used.
+}
+
+/**
+ * Thread that pops items from one queue and pushes them back on another.
+ *
+ * @param arg_ptr Pointer to the thread's TestThreadState.
+ *
+ * @return The return value is not used.
+ */
+static CDI_THREAD EchoTestThread(void* arg_ptr)
+{
+    TestThreadState* state_ptr = (TestThreadState*)arg_ptr;
+
+    CdiOsAtomicStore32(&state_ptr->ready_count, 1);
+    for (int i = 0; state_ptr->pass && i < state_ptr->item_count; i++) {
+        TestQueueItem item = { 0 };
+        if (!CdiQueuePopWait(state_ptr->return_queue_handle, CDI_INFINITE, abort_signal, &item) ||
+            !CdiQueuePushWait(state_ptr->queue_handle, CDI_INFINITE, abort_signal, &item)) {
+            CDI_LOG_THREAD(kLogError, "Failed to echo item[%d].", i);
+            state_ptr->pass = false;
+        }
+    }
+
+    return 0; // Return value is not used.
+}
+
+/**
+ * Start a test thread and wait until it is running, so CdiOsThreadJoin() doesn't prevent it from starting.
+ *
+ * @param thread_func Thread function to run.
+ * @param state_ptr Pointer to the thread's state.
+ * @param ret_thread_id_ptr Address where to write the ID of the new thread.
+ *
+ * @return true if the thread was started, otherwise false.
+ */
+static bool StartThread(CdiThreadFuncName thread_func, TestThreadState* state_ptr, CdiThreadID* ret_thread_id_ptr)
+{
+    if (!CdiOsThreadCreate(thread_func, ret_thread_id_ptr, "QueueTest", state_ptr, NULL)) {
+        return false;
+    }
+    while (0 == CdiOsAtomicLoad32(&state_ptr->ready_count)) {
+        CdiOsSleepMicroseconds(100);
+    }
+    return true;
+}
+
+/**
+ * Test a fixed size queue from a single thread, verifying the full and empty conditions, ordering across many wraps of
+ * the ring and flushing.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus SingleThreadTest(void)
+{
+    CdiQueueHandle queue_handle = NULL;
+    TestQueueItem item = { 0 };
+    uint64_t push_sequence = 0;
+    uint64_t pop_sequence = 0;
+
+    CHECK(CdiQueueCreate("Test Queue", SINGLE_THREAD_ITEM_COUNT, CDI_FIXED_QUEUE_SIZE, 0, sizeof(TestQueueItem),
+                         kQueueSignalNone, &queue_handle));
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CHECK(!CdiQueuePop(queue_handle, &item));
+
+    // The queue must hold exactly the number of items requested.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        item.sequence = push_sequence++;
+        CHECK(CdiQueuePush(queue_handle, &item));
+    }
+    CHECK(!CdiQueuePush(queue_handle, &item));
+    CHECK(!CdiQueueIsEmpty(queue_handle));
+
+    // Keep the queue partially full while wrapping around the ring many times, checking the order of the items.
+    for (int i = 0; i < 1000; i++) {
+        int pop_count = 1 + (i % SINGLE_THREAD_ITEM_COUNT);
+        for (int j = 0; j < pop_count; j++) {
+            CHECK(CdiQueuePop(queue_handle, &item));
+            CHECK(pop_sequence++ == item.sequence);
+        }
+        for (int j = 0; j < pop_count; j++) {
+            item.sequence = push_sequence++;
+            CHECK(CdiQueuePush(queue_handle, &item));
+        }
+    }
+
+    // Popping without a destination must still remove the item.
+    CHECK(CdiQueuePop(queue_handle, NULL));
+    pop_sequence++;
+    CHECK(CdiQueuePop(queue_handle, &item));
+    CHECK(pop_sequence++ == item.sequence);
+
+    CdiQueueFlush(queue_handle);
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CHECK(!CdiQueuePop(queue_handle, &item));
+
+    CdiQueueDestroy(queue_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test a growable queue from a single thread, verifying that items are popped in order while the queue grows with
+ * items still in it.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus GrowTest(void)
+{
+    CdiQueueHandle queue_handle = NULL;
+    TestQueueItem item = { 0 };
+    uint64_t push_sequence = 0;
+    uint64_t pop_sequence = 0;
+    const int max_item_count = SINGLE_THREAD_ITEM_COUNT + (GROW_ITEM_COUNT * MAX_GROW_COUNT);
+
+    CHECK(CdiQueueCreate("Test Queue", SINGLE_THREAD_ITEM_COUNT, GROW_ITEM_COUNT, MAX_GROW_COUNT,
+                         sizeof(TestQueueItem), kQueueSignalNone, &queue_handle));
+
+    // Pop a couple of items so the read position is not at the start of the ring, then fill it up and grow it several
+    // times.
+    for (int i = 0; i < 2; i++) {
+        item.sequence = push_sequence++;
+        CHECK(CdiQueuePush(queue_handle, &item));
+        CHECK(CdiQueuePop(queue_handle, &item));
+        CHECK(pop_sequence++ == item.sequence);
+    }
+    for (int i = 0; i < max_item_count; i++) {
+        item.sequence = push_sequence++;
+        CHECK(CdiQueuePush(queue_handle, &item));
+    }
+
+    // Drain part of it, push some more and then drain the rest.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        CHECK(CdiQueuePop(queue_handle, &item));
+        CHECK(pop_sequence++ == item.sequence);
+    }
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        item.sequence = push_sequence++;
+        CHECK(CdiQueuePush(queue_handle, &item));
+    }
+    while (CdiQueuePop(queue_handle, &item)) {
+        CHECK(pop_sequence++ == item.sequence);
+    }
+    CHECK(push_sequence == pop_sequence);
+    CHECK(CdiQueueIsEmpty(queue_handle));
+
+    // Once grown, the queue must hold the increased number of items by reusing its drained segments.
+    for (int i = 0; i < max_item_count; i++) {
+        item.sequence = push_sequence++;
+        CHECK(CdiQueuePush(queue_handle, &item));
+    }
+    CdiQueueStats stats;
+    CdiQueueGetStats(queue_handle, &stats);
+    CHECK(max_item_count == stats.occupancy);
+    CHECK(MAX_GROW_COUNT == stats.grow_count);
+    CdiQueueFlush(queue_handle);
+    CHECK(CdiQueueIsEmpty(queue_handle));
+
+    // Fill it once more after the flush and read everything back in order.
+    for (int i = 0; i < max_item_count; i++) {
+        item.sequence = push_sequence++;
+        CHECK(CdiQueuePush(queue_handle, &item));
+    }
+    pop_sequence = push_sequence - max_item_count;
+    while (CdiQueuePop(queue_handle, &item)) {
+        CHECK(pop_sequence++ == item.sequence);
+    }
+    CHECK(push_sequence == pop_sequence);
+
+    CdiQueueDestroy(queue_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test the usage statistics of a fixed size queue and of a queue that grows.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus StatsTest(void)
+{
+    CdiQueueHandle queue_handle = NULL;
+    TestQueueItem item = { 0 };
+    CdiQueueStats stats;
+
+    CHECK(CdiQueueCreate("Test Queue", SINGLE_THREAD_ITEM_COUNT, CDI_FIXED_QUEUE_SIZE, 0, sizeof(TestQueueItem),
+                         kQueueSignalNone, &queue_handle));
+    CdiQueueGetStats(queue_handle, &stats);
+    CHECK(SINGLE_THREAD_ITEM_COUNT == stats.item_count);
+    CHECK(0 == stats.occupancy);
+    CHECK(0 == stats.high_water_item_count);
+    CHECK(0 == stats.push_fail_count);
+    CHECK(stats.byte_size >= SINGLE_THREAD_ITEM_COUNT * sizeof(TestQueueItem));
+
+    // Fill the queue and fail to push one more, then pop one item so the consumer sees the full queue.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        CHECK(CdiQueuePush(queue_handle, &item));
+    }
+    CHECK(!CdiQueuePush(queue_handle, &item));
+    void* reserved_item_ptr = NULL;
+    CHECK(!CdiQueuePushReserve(queue_handle, &reserved_item_ptr));
+    CHECK(CdiQueuePop(queue_handle, &item));
+
+    CdiQueueGetStats(queue_handle, &stats);
+    CHECK(SINGLE_THREAD_ITEM_COUNT - 1 == stats.occupancy);
+    CHECK(SINGLE_THREAD_ITEM_COUNT == stats.high_water_item_count);
+    CHECK(0 == stats.grow_count);
+    CHECK(2 == stats.push_fail_count);
+
+    CdiQueueFlush(queue_handle);
+    CdiQueueGetStats(queue_handle, &stats);
+    CHECK(0 == stats.occupancy);
+    CHECK(SINGLE_THREAD_ITEM_COUNT == stats.high_water_item_count);
+    CdiQueueDestroy(queue_handle);
+
+    // Grow a queue twice. Each increase adds a segment of GROW_ITEM_COUNT items, so it adds the same amount of memory.
+    // The high-water mark only counts items in the segment being read, so it is the size of the largest segment.
+    const int push_count = SINGLE_THREAD_ITEM_COUNT + GROW_ITEM_COUNT + 1;
+    CHECK(CdiQueueCreate("Test Queue", SINGLE_THREAD_ITEM_COUNT, GROW_ITEM_COUNT, MAX_GROW_COUNT,
+                         sizeof(TestQueueItem), kQueueSignalNone, &queue_handle));
+    uint64_t byte_size_array[3] = { 0 };
+    int grow_index = 0;
+    for (int i = 0; i < push_count; i++) {
+        CdiQueueGetStats(queue_handle, &stats);
+        if (stats.grow_count == grow_index) {
+            byte_size_array[grow_index++] = stats.byte_size;
+        }
+        CHECK(CdiQueuePush(queue_handle, &item));
+    }
+    CdiQueueGetStats(queue_handle, &stats);
+    CHECK(SINGLE_THREAD_ITEM_COUNT + (2 * GROW_ITEM_COUNT) == stats.item_count);
+    CHECK(push_count == stats.occupancy);
+    CHECK(2 == stats.grow_count);
+    CHECK(0 == stats.push_fail_count);
+    CHECK(2 == grow_index);
+    byte_size_array[2] = stats.byte_size;
+    CHECK(byte_size_array[1] > byte_size_array[0]);
+    CHECK(byte_size_array[2] - byte_size_array[1] == byte_size_array[1] - byte_size_array[0]);
+    while (CdiQueuePop(queue_handle, &item)) {
+    }
+    CdiQueueGetStats(queue_handle, &stats);
+    CHECK(0 == stats.occupancy);
+    CHECK(SINGLE_THREAD_ITEM_COUNT == stats.high_water_item_count);
+
+    // Segments that have been drained are reused, so pushing and popping many more items than the queue holds doesn't
+    // grow it again.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT * 10; i++) {
+        for (int j = 0; j < stats.item_count; j++) {
+            CHECK(CdiQueuePush(queue_handle, &item));
+        }
+        for (int j = 0; j < stats.item_count; j++) {
+            CHECK(CdiQueuePop(queue_handle, &item));
+        }
+    }
+    CdiQueueGetStats(queue_handle, &stats);
+    CHECK(2 == stats.grow_count);
+    CHECK(byte_size_array[2] == stats.byte_size);
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CdiQueueDestroy(queue_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test a queue with a producer thread and a consumer thread, verifying that every item is received in order.
+ *
+ * @param grow_count Number of items the queue may be increased by. If not zero, the queue is filled before the producer
+ *                   thread starts, so the queue grows while the consumer is reading from it. This is repeated several
+ *                   times, since a queue may only grow MAX_GROW_COUNT times.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus SpscTest(uint32_t grow_count)
+{
+    const int iteration_count = grow_count ? 20 : 1;
+    const int prefill_count = grow_count ? SPSC_ITEM_COUNT : 0;
+
+    for (int iteration = 0; iteration < iteration_count; iteration++) {
+        CdiQueueHandle queue_handle = NULL;
+        CdiThreadID thread_id = NULL;
+        TestThreadState state = {
+            .first_sequence = prefill_count,
+            .item_count = grow_count ? (int)grow_count * MAX_GROW_COUNT : SPSC_CORRECTNESS_ITEM_COUNT,
+            .pass = true
+        };
+
+        CHECK(CdiQueueCreate("Test Queue", SPSC_ITEM_COUNT, grow_count, MAX_GROW_COUNT, sizeof(TestQueueItem),
+                             kQueueSignalPopPushWait, &queue_handle));
+        state.queue_handle = queue_handle;
+        for (int i = 0; i < prefill_count; i++) {
+            TestQueueItem item = { .sequence = i };
+            CHECK(CdiQueuePush(queue_handle, &item));
+        }
+        CHECK(StartThread(ProducerTestThread, &state, &thread_id));
+
+        bool pass = true;
+        for (int i = 0; pass && i < prefill_count + state.item_count; i++) {
+            TestQueueItem item = { 0 };
+            pass = CdiQueuePopWait(queue_handle, CDI_INFINITE, abort_signal, &item) && (uint64_t)i == item.sequence;
+        }
+        CdiOsThreadJoin(thread_id, CDI_INFINITE, NULL);
+        CHECK(pass);
+        CHECK(state.pass);
+        CHECK(CdiQueueIsEmpty(queue_handle));
+
+        CdiQueueDestroy(queue_handle);
+    }
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test pushing and popping multiple items at a time, including partial pushes to a full queue, growing a queue part
+ * way through a push and pops that span segments.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus BatchTest(void)
+{
+    CdiQueueHandle queue_handle = NULL;
+    TestQueueItem item_array[SINGLE_THREAD_ITEM_COUNT * 2] = { 0 };
+    const int item_count = CDI_ARRAY_ELEMENT_COUNT(item_array);
+
+    for (int i = 0; i < item_count; i++) {
+        item_array[i].sequence = i;
+    }
+
+    // A fixed size queue only accepts the items that fit.
+    CHECK(CdiQueueCreate("Test Queue", SINGLE_THREAD_ITEM_COUNT, CDI_FIXED_QUEUE_SIZE, 0, sizeof(TestQueueItem),
+                         kQueueSignalPopPushWait, &queue_handle));
+    CHECK(0 == CdiQueuePopMultiple(queue_handle, item_array, item_count));
+    CHECK(2 == CdiQueuePushMultiple(queue_handle, item_array, 2));
+    CHECK(SINGLE_THREAD_ITEM_COUNT - 2 == CdiQueuePushMultiple(queue_handle, &item_array[2], item_count - 2));
+    CHECK(0 == CdiQueuePushMultiple(queue_handle, item_array, 1));
+    CHECK(CdiOsSignalGet(CdiQueueGetPopWaitSignal(queue_handle)));
+
+    // Pop a few so the next push wraps around the end of the ring.
+    TestQueueItem pop_array[SINGLE_THREAD_ITEM_COUNT * 2] = { 0 };
+    CHECK(3 == CdiQueuePopMultiple(queue_handle, pop_array, 3));
+    CHECK(CdiOsSignalGet(CdiQueueGetPushWaitSignal(queue_handle)));
+    CHECK(3 == CdiQueuePushMultiple(queue_handle, &item_array[SINGLE_THREAD_ITEM_COUNT], 3));
+    CHECK(SINGLE_THREAD_ITEM_COUNT == CdiQueuePopMultiple(queue_handle, &pop_array[3], item_count));
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT + 3; i++) {
+        CHECK((uint64_t)i == pop_array[i].sequence);
+    }
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CdiQueueDestroy(queue_handle);
+
+    // A growable queue grows part way through a push, and a pop spans the old and new segments.
+    CHECK(CdiQueueCreate("Test Queue", SINGLE_THREAD_ITEM_COUNT, SINGLE_THREAD_ITEM_COUNT, MAX_GROW_COUNT,
+                         sizeof(TestQueueItem), kQueueSignalNone, &queue_handle));
+    CHECK(item_count == CdiQueuePushMultiple(queue_handle, item_array, item_count));
+    CHECK(1 == CdiQueuePopMultiple(queue_handle, NULL, 1));
+    CHECK(item_count - 1 == CdiQueuePopMultiple(queue_handle, pop_array, item_count));
+    for (int i = 0; i < item_count - 1; i++) {
+        CHECK((uint64_t)i + 1 == pop_array[i].sequence);
+    }
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CdiQueueDestroy(queue_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test reserving/committing and peeking/releasing items in place, including reserving several items before a commit,
+ * reserving past the end of a growable queue's segment and a full fixed size queue with a multiple writer lock.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus ZeroCopyTest(void)
+{
+    CdiQueueHandle queue_handle = NULL;
+    TestQueueItem* item_ptr = NULL;
+    TestQueueItem* peek_ptr = NULL;
+
+    CHECK(CdiQueueCreate("Test Queue", SINGLE_THREAD_ITEM_COUNT, CDI_FIXED_QUEUE_SIZE, 0, sizeof(TestQueueItem),
+                         kQueueSignalPopPushWait | kQueueMultipleWritersFlag, &queue_handle));
+    CHECK(!CdiQueuePopPeek(queue_handle, (void**)&peek_ptr));
+
+    // Reserved items are not visible until they are committed.
+    CHECK(CdiQueuePushReserve(queue_handle, (void**)&item_ptr));
+    item_ptr->sequence = 0;
+    CHECK(CdiQueuePushReserve(queue_handle, (void**)&item_ptr));
+    item_ptr->sequence = 1;
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CHECK(!CdiQueuePopPeek(queue_handle, (void**)&peek_ptr));
+    CdiQueuePushCommit(queue_handle);
+    CHECK(CdiOsSignalGet(CdiQueueGetPopWaitSignal(queue_handle)));
+
+    // Peeking again before a release returns the same item.
+    CHECK(CdiQueuePopPeek(queue_handle, (void**)&peek_ptr));
+    CHECK(0 == peek_ptr->sequence);
+    CHECK(CdiQueuePopPeek(queue_handle, (void**)&item_ptr));
+    CHECK(item_ptr == peek_ptr);
+    CdiQueuePopRelease(queue_handle);
+    CHECK(CdiOsSignalGet(CdiQueueGetPushWaitSignal(queue_handle)));
+    CHECK(CdiQueuePopPeekWait(queue_handle, 0, abort_signal, (void**)&peek_ptr));
+    CHECK(1 == peek_ptr->sequence);
+    CdiQueuePopRelease(queue_handle);
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CHECK(!CdiQueuePopPeekWait(queue_handle, 0, abort_signal, (void**)&peek_ptr));
+
+    // Fill the queue, wrapping around the end of the ring. A failed reserve with nothing reserved releases the lock, so
+    // the regular push below does not deadlock.
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        CHECK(CdiQueuePushReserve(queue_handle, (void**)&item_ptr));
+        item_ptr->sequence = i;
+    }
+    CHECK(!CdiQueuePushReserve(queue_handle, (void**)&item_ptr));
+    CdiQueuePushCommit(queue_handle);
+    CHECK(!CdiQueuePushReserve(queue_handle, (void**)&item_ptr));
+    CHECK(!CdiQueuePush(queue_handle, item_ptr));
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        CHECK(CdiQueuePopPeek(queue_handle, (void**)&peek_ptr));
+        CHECK((uint64_t)i == peek_ptr->sequence);
+        CdiQueuePopRelease(queue_handle);
+    }
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CdiQueueDestroy(queue_handle);
+
+    // A growable queue doesn't grow while items are reserved, since they would have to be made visible before they are
+    // committed. Once they are committed, reserving grows the queue.
+    CHECK(CdiQueueCreate("Test Queue", SINGLE_THREAD_ITEM_COUNT, SINGLE_THREAD_ITEM_COUNT, MAX_GROW_COUNT,
+                         sizeof(TestQueueItem), kQueueSignalNone, &queue_handle));
+    const int item_count = SINGLE_THREAD_ITEM_COUNT * 2;
+    for (int i = 0; i < SINGLE_THREAD_ITEM_COUNT; i++) {
+        CHECK(CdiQueuePushReserve(queue_handle, (void**)&item_ptr));
+        item_ptr->sequence = i;
+    }
+    CHECK(!CdiQueuePushReserve(queue_handle, (void**)&item_ptr));
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CHECK(!CdiQueuePopPeek(queue_handle, (void**)&peek_ptr));
+    CdiQueuePushCommit(queue_handle);
+    for (int i = SINGLE_THREAD_ITEM_COUNT; i < item_count; i++) {
+        CHECK(CdiQueuePushReserve(queue_handle, (void**)&item_ptr));
+        item_ptr->sequence = i;
+    }
+    CdiQueuePushCommit(queue_handle);
+    CdiQueueStats stats;
+    CdiQueueGetStats(queue_handle, &stats);
+    CHECK(1 == stats.grow_count);
+    CHECK(0 == stats.push_fail_count);
+    for (int i = 0; i < item_count; i++) {
+        CHECK(CdiQueuePopPeek(queue_handle, (void**)&peek_ptr));
+        CHECK((uint64_t)i == peek_ptr->sequence);
+        CdiQueuePopRelease(queue_handle);
+    }
+    CHECK(CdiQueueIsEmpty(queue_handle));
+    CdiQueueDestroy(queue_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Log the number of items per millisecond moved through a queue by a producer thread and a consumer thread.
+ *
+ * @param batch_count Number of items pushed and popped by each call. If 1, CdiQueuePushWait() and CdiQueuePopWait() are
+ *                    used. Otherwise CdiQueuePushMultiple() and CdiQueuePopMultiple() are used.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus ThroughputBenchmark(int batch_count)
+{
+    CdiQueueHandle queue_handle = NULL;
+    CdiThreadID thread_id = NULL;
+    TestThreadState state = {
+        .item_count = THROUGHPUT_BENCHMARK_ITEM_COUNT,
+        .batch_count = batch_count,
+        .pass = true
+    };
+    TestQueueItem item_array[BATCH_ITEM_COUNT];
+
+    CHECK(batch_count <= BATCH_ITEM_COUNT);
+    CHECK(CdiQueueCreate("Benchmark Queue", THROUGHPUT_BENCHMARK_QUEUE_SIZE, CDI_FIXED_QUEUE_SIZE, 0,
+                         sizeof(TestQueueItem), kQueueSignalPopPushWait, &queue_handle));
+    state.queue_handle = queue_handle;
+
+    uint64_t start_time = CdiOsGetMicroseconds();
+    CHECK(StartThread(ProducerTestThread, &state, &thread_id));
+    bool pass = true;
+    for (int i = 0; pass && i < THROUGHPUT_BENCHMARK_ITEM_COUNT;) {
+        int popped_count = (batch_count > 1) ? CdiQueuePopMultiple(queue_handle, item_array, batch_count) : 0;
+        if (0 == popped_count) {
+            // Queue is empty (or not batching), so wait for an item.
+            pass = CdiQueuePopWait(queue_handle, CDI_INFINITE, abort_signal, item_array);
+            popped_count = 1;
+        }
+        for (int j = 0; pass && j < popped_count; j++) {
+            pass = (uint64_t)(i + j) == item_array[j].sequence;
+        }
+        i += popped_count;
+    }
+    uint64_t elapsed_us = CdiOsGetMicroseconds() - start_time;
+    CdiOsThreadJoin(thread_id, CDI_INFINITE, NULL);
+    CHECK(pass);
+    CHECK(state.pass);
+    CdiQueueDestroy(queue_handle);
+
+    CDI_LOG_THREAD(kLogInfo, "Queue SPSC throughput benchmark batch[%d]: [%d] items in [%"PRIu64"]us ([%"PRIu64"] "
+                   "items/ms).", batch_count, THROUGHPUT_BENCHMARK_ITEM_COUNT, elapsed_us,
+                   elapsed_us ? ((uint64_t)THROUGHPUT_BENCHMARK_ITEM_COUNT * 1000) / elapsed_us : 0);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Log the average time for an item to be pushed by one thread and popped by another, measured by echoing items back
+ * through a second queue and halving the round trip time.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus LatencyBenchmark(void)
+{
+    CdiQueueHandle queue_handle = NULL;
+    CdiQueueHandle return_queue_handle = NULL;
+    CdiThreadID thread_id = NULL;
+    TestThreadState state = {
+        .item_count = LATENCY_BENCHMARK_ROUND_TRIPS,
+        .pass = true
+    };
+
+    CHECK(CdiQueueCreate("Benchmark Queue", SPSC_ITEM_COUNT, CDI_FIXED_QUEUE_SIZE, 0, sizeof(TestQueueItem),
+                         kQueueSignalPopPushWait, &queue_handle));
+    CHECK(CdiQueueCreate("Benchmark Return Queue", SPSC_ITEM_COUNT, CDI_FIXED_QUEUE_SIZE, 0, sizeof(TestQueueItem),
+                         kQueueSignalPopPushWait, &return_queue_handle));
+    // The echo thread pops from return_queue_handle and pushes to queue_handle.
+    state.queue_handle = queue_handle;
+    state.return_queue_handle = return_queue_handle;
+    CHECK(StartThread(EchoTestThread, &state, &thread_id));
+
+    bool pass = true;
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int i = 0; pass && i < LATENCY_BENCHMARK_ROUND_TRIPS; i++) {
+        TestQueueItem item = { .sequence = i };
+        pass = CdiQueuePush(return_queue_handle, &item) &&
+               CdiQueuePopWait(queue_handle, CDI_INFINITE, abort_signal, &item) && (uint64_t)i == item.sequence;
+    }
+    uint64_t elapsed_us = CdiOsGetMicroseconds() - start_time;
+    CdiOsThreadJoin(thread_id, CDI_INFINITE, NULL);
+    CHECK(pass);
+    CHECK(state.pass);
+    CdiQueueDestroy(return_queue_handle);
+    CdiQueueDestroy(queue_handle);
+
+    CDI_LOG_THREAD(kLogInfo, "Queue SPSC latency benchmark: [%d] round trips in [%"PRIu64"]us ([%"PRIu64"]ns one "
+                   "way).", LATENCY_BENCHMARK_ROUND_TRIPS, elapsed_us,
+                   (elapsed_us * 1000) / (LATENCY_BENCHMARK_ROUND_TRIPS * 2));
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Log the cost of a push followed by a pop from the same thread, which is the cost of the queue operations themselves
+ * without any thread hand-off.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus UncontendedBenchmark(void)
+{
+    CdiQueueHandle queue_handle = NULL;
+    TestQueueItem item = { 0 };
+
+    CHECK(CdiQueueCreate("Benchmark Queue", SPSC_ITEM_COUNT, CDI_FIXED_QUEUE_SIZE, 0, sizeof(TestQueueItem),
+                         kQueueSignalNone, &queue_handle));
+    bool pass = true;
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int i = 0; pass && i < UNCONTENDED_BENCHMARK_OP_COUNT; i++) {
+        item.sequence = i;
+        pass = CdiQueuePush(queue_handle, &item) && CdiQueuePop(queue_handle, &item);
+    }
+    uint64_t elapsed_us = CdiOsGetMicroseconds() - start_time;
+    CHECK(pass);
+    CdiQueueDestroy(queue_handle);
+
+    CDI_LOG_THREAD(kLogInfo, "Queue uncontended benchmark: [%d] push/pop pairs in [%"PRIu64"]us ([%"PRIu64"]ns per "
+                   "pair).", UNCONTENDED_BENCHMARK_OP_COUNT, elapsed_us,
+                   (elapsed_us * 1000) / UNCONTENDED_BENCHMARK_OP_COUNT);
+
+    return kCdiStatusOk;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitQueue(void)
+{
+    CdiReturnStatus rs = kCdiStatusOk;
+
+    CHECK(CdiOsSignalCreate(&abort_signal));
+    if (kCdiStatusOk != SingleThreadTest() || kCdiStatusOk != GrowTest() || kCdiStatusOk != StatsTest() ||
+        kCdiStatusOk != SpscTest(CDI_FIXED_QUEUE_SIZE) || kCdiStatusOk != SpscTest(GROW_ITEM_COUNT) ||
+        kCdiStatusOk != BatchTest() || kCdiStatusOk != ZeroCopyTest() || kCdiStatusOk != UncontendedBenchmark() ||
+        kCdiStatusOk != ThroughputBenchmark(1) || kCdiStatusOk != ThroughputBenchmark(BATCH_ITEM_COUNT) ||
+        kCdiStatusOk != LatencyBenchmark()) {
+        rs = kCdiStatusFatal;
+    }
+    CdiOsSignalDelete(abort_signal);
+    abort_signal = NULL;
+
+    return rs;
+}
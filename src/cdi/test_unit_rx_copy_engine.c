@@ -0,0 +1,266 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains a unit test of the Rx copy engine. Frames made of packets with a CDI header in front of their data
+ * are copied into linear buffers the way the Rx poll thread does it. The test checks that every posted copy is returned
+ * once and that the frames are copied correctly, then logs the copy rate with zero (copies done by the posting thread),
+ * one, two and four copy threads.
+ */
+
+#include "rx_copy_engine.h"
+
+#include <inttypes.h>
+#include <string.h>
+
+#include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "configuration.h"
+#include "internal.h"
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// Number of bytes of the simulated CDI header at the start of each packet.
+#define PACKET_HEADER_BYTES             (16)
+
+/// Number of data bytes in each packet.
+#define PACKET_DATA_BYTES               (8000)
+
+/// Number of packets in each frame.
+#define FRAME_PACKET_COUNT              (500)
+
+/// Number of data bytes in each frame.
+#define FRAME_BYTES                     (FRAME_PACKET_COUNT * PACKET_DATA_BYTES)
+
+/// Number of frames copied by each pass.
+#define PASS_FRAME_COUNT                (20)
+
+/// Number of linear buffers that the frames of a pass are copied to in turn.
+#define FRAME_BUFFER_COUNT              (4)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Gets the completed copies from the copy engine and counts them.
+ *
+ * @param handle Handle of the copy engine.
+ * @param completed_count_ptr Pointer to the count of completed copies, which is updated.
+ *
+ * @return kCdiStatusOk if the completed copies are as expected, kCdiStatusFatal otherwise.
+ */
+static CdiReturnStatus GetCompleted(RxCopyEngineHandle handle, int* completed_count_ptr)
+{
+    RxCopyRequest request_array[MAX_QUEUE_BATCH_ITEM_COUNT];
+    int count = 0;
+    do {
+        count = RxCopyEngineGetCompleted(handle, request_array, CDI_ARRAY_ELEMENT_COUNT(request_array));
+        for (int i = 0; i < count; i++) {
+            CHECK(PACKET_DATA_BYTES == request_array[i].byte_count);
+        }
+        *completed_count_ptr += count;
+    } while (count == CDI_ARRAY_ELEMENT_COUNT(request_array));
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Copies PASS_FRAME_COUNT frames into the frame buffers, using the copy engine if one is given. Like the Rx poll
+ * thread, the packets are posted to the copy engine if it has room and copied directly otherwise, and all copies are
+ * completed before a frame is considered done.
+ *
+ * @param handle Handle of the copy engine or NULL to do all of the copies directly.
+ * @param packet_sgl_array Array of FRAME_PACKET_COUNT SGLs, one per packet of a frame.
+ * @param frame_buffer_array Array of FRAME_BUFFER_COUNT frame buffers to copy the frames to.
+ * @param thread_count Number of copy threads, used in log messages.
+ *
+ * @return kCdiStatusOk if all of the copies completed as expected, kCdiStatusFatal otherwise.
+ */
+static CdiReturnStatus CopyPass(RxCopyEngineHandle handle, const CdiSgList* packet_sgl_array,
+                                uint8_t** frame_buffer_array, int thread_count)
+{
+    int posted_count = 0;
+    int completed_count = 0;
+
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int frame = 0; frame < PASS_FRAME_COUNT; frame++) {
+        uint8_t* frame_buffer_ptr = frame_buffer_array[frame % FRAME_BUFFER_COUNT];
+        for (int i = 0; i < FRAME_PACKET_COUNT; i++) {
+            RxCopyRequest request = {
+                .endpoint_ptr = NULL,
+                .packet_sgl = packet_sgl_array[i],
+                .offset = PACKET_HEADER_BYTES,
+                .dest_ptr = frame_buffer_ptr + i * PACKET_DATA_BYTES,
+                .byte_count = PACKET_DATA_BYTES,
+                .non_temporal = true
+            };
+            if (handle && RxCopyEnginePost(handle, &request)) {
+                posted_count++;
+            } else {
+                CHECK(PACKET_DATA_BYTES == CdiGatherInternal(&request.packet_sgl, request.offset, request.dest_ptr,
+                                                             request.byte_count, request.non_temporal));
+            }
+            if (handle) {
+                CHECK(kCdiStatusOk == GetCompleted(handle, &completed_count));
+            }
+        }
+        if (handle) {
+            RxCopyEngineWaitIdle(handle);
+            CHECK(kCdiStatusOk == GetCompleted(handle, &completed_count));
+            CHECK(0 == RxCopyEngineGetPendingCount(handle));
+        }
+    }
+    uint64_t elapsed_microseconds = CDI_MAX(CdiOsGetMicroseconds() - start_time, 1);
+
+    CHECK(posted_count == completed_count);
+    CDI_LOG_THREAD(kLogInfo, "Rx copy benchmark [%d] threads: [%"PRIu64"]MB/s, [%"PRIu64"]us per frame, [%d] of [%d] "
+                   "copies posted.", thread_count, (uint64_t)FRAME_BYTES * PASS_FRAME_COUNT / elapsed_microseconds,
+                   elapsed_microseconds / PASS_FRAME_COUNT, posted_count, PASS_FRAME_COUNT * FRAME_PACKET_COUNT);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Runs a pass with the given number of copy threads and checks the contents of the frame buffers.
+ *
+ * @param thread_count Number of copy threads, or zero to do the copies directly.
+ * @param packet_buffer_ptr Buffer holding the packets of a frame, each starting with a header.
+ * @param packet_sgl_array Array of FRAME_PACKET_COUNT SGLs, one per packet of a frame.
+ * @param frame_buffer_array Array of FRAME_BUFFER_COUNT frame buffers to copy the frames to.
+ *
+ * @return kCdiStatusOk if the pass succeeded, kCdiStatusFatal otherwise.
+ */
+static CdiReturnStatus RunPass(int thread_count, const uint8_t* packet_buffer_ptr, const CdiSgList* packet_sgl_array,
+                               uint8_t** frame_buffer_array)
+{
+    for (int i = 0; i < FRAME_BUFFER_COUNT; i++) {
+        memset(frame_buffer_array[i], 0, FRAME_BYTES);
+    }
+
+    RxCopyEngineHandle handle = NULL;
+    if (thread_count) {
+        CHECK(kCdiStatusOk == RxCopyEngineCreate(CdiLogGlobalGet(), thread_count, -1, &handle));
+    }
+    CdiReturnStatus rs = CopyPass(handle, packet_sgl_array, frame_buffer_array, thread_count);
+    const int pending_count = handle ? RxCopyEngineGetPendingCount(handle) : 0;
+    RxCopyEngineDestroy(handle);
+    CHECK(kCdiStatusOk == rs);
+    CHECK(0 == pending_count);
+
+    for (int i = 0; i < FRAME_BUFFER_COUNT; i++) {
+        for (int j = 0; j < FRAME_PACKET_COUNT; j++) {
+            const uint8_t* packet_data_ptr = packet_buffer_ptr + j * (PACKET_HEADER_BYTES + PACKET_DATA_BYTES) +
+                                             PACKET_HEADER_BYTES;
+            CHECK(0 == memcmp(frame_buffer_array[i] + j * PACKET_DATA_BYTES, packet_data_ptr, PACKET_DATA_BYTES));
+        }
+    }
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Builds the packets of a frame and runs a pass for each copy thread count.
+ *
+ * @param packet_buffer_ptr Buffer to hold the packets of a frame, each starting with a header.
+ * @param packet_entry_array Array of FRAME_PACKET_COUNT SGL entries, one per packet.
+ * @param packet_sgl_array Array of FRAME_PACKET_COUNT SGLs, one per packet.
+ * @param frame_buffer_array Array of FRAME_BUFFER_COUNT frame buffers to copy the frames to.
+ *
+ * @return kCdiStatusOk if all of the passes succeeded, kCdiStatusFatal otherwise.
+ */
+static CdiReturnStatus RunPasses(uint8_t* packet_buffer_ptr, CdiSglEntry* packet_entry_array,
+                                 CdiSgList* packet_sgl_array, uint8_t** frame_buffer_array)
+{
+    for (int i = 0; i < FRAME_PACKET_COUNT * (PACKET_HEADER_BYTES + PACKET_DATA_BYTES); i++) {
+        packet_buffer_ptr[i] = (uint8_t)(i * 7 + i / 251);
+    }
+    // Each packet is a single SGL entry that starts with its header.
+    for (int i = 0; i < FRAME_PACKET_COUNT; i++) {
+        packet_entry_array[i] = (CdiSglEntry) {
+            .address_ptr = packet_buffer_ptr + i * (PACKET_HEADER_BYTES + PACKET_DATA_BYTES),
+            .size_in_bytes = PACKET_HEADER_BYTES + PACKET_DATA_BYTES,
+            .internal_data_ptr = NULL,
+            .next_ptr = NULL
+        };
+        packet_sgl_array[i] = (CdiSgList) {
+            .total_data_size = PACKET_HEADER_BYTES + PACKET_DATA_BYTES,
+            .sgl_head_ptr = &packet_entry_array[i],
+            .sgl_tail_ptr = &packet_entry_array[i],
+            .internal_data_ptr = NULL
+        };
+    }
+
+    const int thread_counts[] = { 0, 1, 2, 4 };
+    for (unsigned int i = 0; i < CDI_ARRAY_ELEMENT_COUNT(thread_counts); i++) {
+        CHECK(kCdiStatusOk == RunPass(thread_counts[i], packet_buffer_ptr, packet_sgl_array, frame_buffer_array));
+    }
+
+    return kCdiStatusOk;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitRxCopyEngine(void)
+{
+    uint8_t* packet_buffer_ptr = CdiOsMemAlloc(FRAME_PACKET_COUNT * (PACKET_HEADER_BYTES + PACKET_DATA_BYTES));
+    CdiSglEntry* packet_entry_array = CdiOsMemAlloc(FRAME_PACKET_COUNT * sizeof(CdiSglEntry));
+    CdiSgList* packet_sgl_array = CdiOsMemAlloc(FRAME_PACKET_COUNT * sizeof(CdiSgList));
+    uint8_t* frame_buffer_array[FRAME_BUFFER_COUNT] = { NULL };
+    bool allocated = NULL != packet_buffer_ptr && NULL != packet_entry_array && NULL != packet_sgl_array;
+    for (int i = 0; i < FRAME_BUFFER_COUNT; i++) {
+        frame_buffer_array[i] = CdiOsMemAlloc(FRAME_BYTES);
+        allocated = allocated && NULL != frame_buffer_array[i];
+    }
+
+    CdiReturnStatus rs = kCdiStatusNotEnoughMemory;
+    if (allocated) {
+        rs = RunPasses(packet_buffer_ptr, packet_entry_array, packet_sgl_array, frame_buffer_array);
+    }
+
+    for (int i = 0; i < FRAME_BUFFER_COUNT; i++) {
+        if (frame_buffer_array[i]) {
+            CdiOsMemFree(frame_buffer_array[i]);
+        }
+    }
+    if (packet_sgl_array) {
+        CdiOsMemFree(packet_sgl_array);
+    }
+    if (packet_entry_array) {
+        CdiOsMemFree(packet_entry_array);
+    }
+    if (packet_buffer_ptr) {
+        CdiOsMemFree(packet_buffer_ptr);
+    }
+
+    return rs;
+}
@@ -10,14 +10,17 @@
  * This file contains internal definitions and implementation used with the SDK that is not part of the API.
  *
  * @brief
- * Test the RxReorder function by sending in out of sequence sgls and get an in-order sgl.
+ * Test the RxReorder function by sending in out of sequence sgls and get an in-order sgl. Both the list and the bitmap
+ * packet reorder engines are tested, and their speed is measured for increasing amounts of reordering.
  */
 
+#include <inttypes.h>
 #include <string.h>
 #include <stdlib.h>
 #include <time.h>
 
 #include "cdi_logger_api.h"
+#include "cdi_os_api.h"
 #include "cdi_raw_api.h"
 #include "internal_rx.h"
 #include "rx_reorder_packets.h"
@@ -31,35 +34,70 @@
 /// @brief A modulus used for generating a random list length.
 #define TEST_UNIT_RX_REORDER_RAND_LEN 3
 
+/// @brief Number of packets in each payload of the benchmark.
+#define BENCHMARK_PACKET_COUNT (4096)
+
+/// @brief Number of payloads reordered by the benchmark for each engine and reorder distance.
+#define BENCHMARK_PAYLOAD_COUNT (20)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+/**
+ * @brief The packets of the payload reordered by the benchmark and the order they are received in.
+ */
+typedef struct {
+    CdiRawPacketHeader header_array[BENCHMARK_PACKET_COUNT]; ///< Header and data of each packet.
+    int header_size_array[BENCHMARK_PACKET_COUNT];           ///< Size of the header of each packet.
+    CdiSglEntry entry_array[BENCHMARK_PACKET_COUNT];         ///< SGL entry of each packet.
+    CdiSgList sgl_array[BENCHMARK_PACKET_COUNT];             ///< SGL of each packet.
+    int order_array[BENCHMARK_PACKET_COUNT];                 ///< Sequence numbers in the order they are received.
+} BenchmarkState;
+
 //*********************************************************************************************************************
 //*********************************************** START OF VARIABLES **************************************************
 //*********************************************************************************************************************
 
-//*********************************************************************************************************************
-//******************************************* START OF STATIC FUNCTIONS ***********************************************
-//*********************************************************************************************************************
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+/// Reorder distances used by the benchmark. Packets are shuffled within groups of this many packets, so 1 is in order
+/// and BENCHMARK_PACKET_COUNT is a full shuffle of the payload.
+static const int reorder_distance_array[] = { 1, 8, 64, BENCHMARK_PACKET_COUNT };
 
 //*********************************************************************************************************************
-//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
 
-CdiReturnStatus TestUnitRxReorderPackets(void)
+/**
+ * Sends out of sequence SGLs to the packet reorder engine and checks that they are all attached to a single list.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param con_state_ptr Pointer to connection state holding the pools to use.
+ *
+ * @return kCdiStatusOk if successful, otherwise another value.
+ */
+static CdiReturnStatus ReorderOutOfSequenceSgls(CdiProtocolHandle protocol_handle, CdiConnectionState* con_state_ptr)
 {
-    CdiReturnStatus rs = kCdiStatusOk;
 
     // Array of out of sequence values (can be made truly random later).
     uint16_t random_sequence_num_array[] = { 2, 0, 1, 6, 7, 4, 3, 5, 8, 10, 12, 11, 9, 15, 14, 13};
     int num_rand_seq_num = sizeof(random_sequence_num_array)/sizeof(random_sequence_num_array[0]);
-    srand(time(0));
     int rand_len = 0;
     int tot_sgls = 0;
-    CdiReturnStatus ret = kCdiStatusOk;
+    CdiReturnStatus rs = kCdiStatusOk;
     bool rx_ret = true;
 
-    CdiConnectionState con_state = { 0 };
-    CdiConnectionState* con_state_ptr = &con_state;
-    con_state.magic = kMagicConnection;
-
     RxPayloadState rx_payload_state = { 0 };
     RxPayloadState* payload_state_ptr = &rx_payload_state;
 
@@ -79,33 +117,7 @@ CdiReturnStatus TestUnitRxReorderPackets(void)
     CdiRawPacketHeader common_hdr_pool[TEST_UNIT_RX_REORDER_NUM_SGLS];
     memset(&common_hdr_pool[0], 0, sizeof(common_hdr_pool));
 
-    CdiProtocolHandle protocol_handle = NULL;
-    CdiProtocolVersionNumber version = {
-        .version_num = 1,
-        .major_version_num = 0,
-        .probe_version_num = 0
-    };
-    ProtocolVersionSet(&version, &protocol_handle);
-
-    // Create a pool of locations.
-    if (!CdiPoolCreate("Rx CdiSglEntry Payload Pool",
-                       TEST_UNIT_RX_REORDER_NUM_SGLS*TEST_UNIT_RX_REORDER_RAND_LEN,    // item_count
-                       TEST_UNIT_RX_REORDER_NUM_SGLS*TEST_UNIT_RX_REORDER_RAND_LEN,    // grow_count
-                       MAX_POOL_GROW_COUNT,
-                       sizeof(CdiSglEntry), true, // true= Make thread-safe,
-                       &con_state_ptr->rx_state.payload_sgl_entry_pool_handle)) {
-        rs = kCdiStatusNotEnoughMemory;
-    }
-
-    if (kCdiStatusOk == rs) {
-        if (!CdiPoolCreate("Rx CdiReorderList Out of Order Pool", MAX_RX_OUT_OF_ORDER, MAX_RX_OUT_OF_ORDER_GROW,
-                           MAX_POOL_GROW_COUNT, sizeof(CdiReorderList), true, // true= Make thread-safe
-                           &con_state_ptr->rx_state.reorder_entries_pool_handle)) {
-            rs = kCdiStatusNotEnoughMemory;
-        }
-    }
-
-    if (kCdiStatusOk == ret) {
+    {
         // Initialize the sequence numbers.
         int j=0;
         int k=0;
@@ -186,6 +198,7 @@ CdiReturnStatus TestUnitRxReorderPackets(void)
         rx_ret = RxReorderPacketPayloadStateInit(protocol_handle,
                                                  con_state_ptr->rx_state.payload_sgl_entry_pool_handle,
                                                  con_state_ptr->rx_state.reorder_entries_pool_handle,
+                                                 con_state_ptr->rx_state.reorder_pages_pool_handle,
                                                  payload_state_ptr, new_sgl_list_ptr, cdi_header_size,
                                                  packet_sequence_num);
 
@@ -196,11 +209,16 @@ CdiReturnStatus TestUnitRxReorderPackets(void)
                                                &reorder_info);
             int packet_sequence_num = reorder_info.packet_sequence_num;
             rx_ret = RxReorderPacket(protocol_handle, con_state_ptr->rx_state.payload_sgl_entry_pool_handle,
-                                     con_state_ptr->rx_state.reorder_entries_pool_handle, payload_state_ptr,
+                                     con_state_ptr->rx_state.reorder_entries_pool_handle,
+                                     con_state_ptr->rx_state.reorder_pages_pool_handle, payload_state_ptr,
                                      new_sgl_list_ptr, cdi_header_size, packet_sequence_num);
         }
-        if (NULL != payload_state_ptr->reorder_list_ptr->next_ptr &&
-            NULL != payload_state_ptr->reorder_list_ptr->prev_ptr) {
+        if (!rx_ret) {
+            CDI_LOG_THREAD(kLogError, "Failed to reorder packets.");
+            rs = kCdiStatusFatal;
+        } else if ((NULL != payload_state_ptr->reorder_list_ptr->next_ptr &&
+                    NULL != payload_state_ptr->reorder_list_ptr->prev_ptr) ||
+                   0 != payload_state_ptr->reorder_held_packet_count) {
             CDI_LOG_THREAD(kLogError, "Test finished and there are dangling lists.");
             CdiReorderList* reorder_list_ptr = payload_state_ptr->reorder_list_ptr;
             while (reorder_list_ptr) {
@@ -212,18 +230,224 @@ CdiReturnStatus TestUnitRxReorderPackets(void)
         }
     }
     // get rid of everything
-    ProtocolVersionDestroy(protocol_handle);
-    CdiReorderList* reorder_list_ptr = payload_state_ptr->reorder_list_ptr;
-    while (reorder_list_ptr) {
-        CdiSglEntry* entry_ptr = reorder_list_ptr->sglist.sgl_head_ptr;
-        while (entry_ptr) {
-            CdiSglEntry *next_entry_ptr = entry_ptr->next_ptr; // Save next entry, since Put() will free its memory.
-            CdiPoolPut(con_state_ptr->rx_state.payload_sgl_entry_pool_handle, entry_ptr);
-            entry_ptr = next_entry_ptr;
+    RxReorderPacketFreeLists(payload_state_ptr, con_state_ptr->rx_state.payload_sgl_entry_pool_handle,
+                             con_state_ptr->rx_state.reorder_entries_pool_handle,
+                             con_state_ptr->rx_state.reorder_pages_pool_handle);
+
+    return rs;
+}
+
+/**
+ * Builds the packets of the benchmark payload, one SGL entry per packet holding its header and one byte of data.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param state_ptr Pointer to benchmark state.
+ */
+static void BenchmarkPacketsInit(CdiProtocolHandle protocol_handle, BenchmarkState* state_ptr)
+{
+    const int packet_data_size = 1; // Packets must have a least 1 byte of payload data to be considered valid.
+    TxPayloadState payload_state = { 0 };
+    payload_state.payload_packet_state.payload_type = kPayloadTypeData;
+    payload_state.source_sgl.total_data_size = BENCHMARK_PACKET_COUNT * packet_data_size;
+
+    for (int i = 0; i < BENCHMARK_PACKET_COUNT; i++) {
+        payload_state.payload_packet_state.packet_sequence_num = i;
+        state_ptr->header_size_array[i] = ProtocolPayloadHeaderInit(protocol_handle, &state_ptr->header_array[i],
+                                                                    sizeof(state_ptr->header_array[i]),
+                                                                    &payload_state);
+        CdiSglEntry* entry_ptr = &state_ptr->entry_array[i];
+        entry_ptr->address_ptr = &state_ptr->header_array[i];
+        entry_ptr->size_in_bytes = state_ptr->header_size_array[i] + packet_data_size;
+        entry_ptr->next_ptr = NULL;
+        state_ptr->sgl_array[i].sgl_head_ptr = entry_ptr;
+        state_ptr->sgl_array[i].sgl_tail_ptr = entry_ptr;
+        state_ptr->sgl_array[i].total_data_size = entry_ptr->size_in_bytes;
+    }
+}
+
+/**
+ * Sets the order the packets of the benchmark payload are received in by shuffling the sequence numbers within groups
+ * of the specified number of packets.
+ *
+ * @param reorder_distance Number of packets in each group.
+ * @param state_ptr Pointer to benchmark state.
+ */
+static void BenchmarkOrderInit(int reorder_distance, BenchmarkState* state_ptr)
+{
+    for (int i = 0; i < BENCHMARK_PACKET_COUNT; i++) {
+        state_ptr->order_array[i] = i;
+    }
+    for (int start = 0; start < BENCHMARK_PACKET_COUNT; start += reorder_distance) {
+        int count = CDI_MIN(reorder_distance, BENCHMARK_PACKET_COUNT - start);
+        for (int i = count - 1; i > 0; i--) {
+            int j = rand() % (i + 1);
+            int temp = state_ptr->order_array[start + i];
+            state_ptr->order_array[start + i] = state_ptr->order_array[start + j];
+            state_ptr->order_array[start + j] = temp;
+        }
+    }
+}
+
+/**
+ * Reorders a payload of BENCHMARK_PACKET_COUNT packets received in the order set in the benchmark state and checks
+ * that the resulting SGL holds the data of every packet in sequence order.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param con_state_ptr Pointer to connection state holding the pools to use.
+ * @param state_ptr Pointer to benchmark state.
+ * @param elapsed_us_ptr Pointer to where the time spent reordering is added, in microseconds.
+ *
+ * @return kCdiStatusOk if successful, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus BenchmarkPayload(CdiProtocolHandle protocol_handle, CdiConnectionState* con_state_ptr,
+                                        const BenchmarkState* state_ptr, uint64_t* elapsed_us_ptr)
+{
+    RxConState* rx_state_ptr = &con_state_ptr->rx_state;
+    RxPayloadState payload_state = { 0 };
+
+    uint64_t start_time = CdiOsGetMicroseconds();
+    int sequence_num = state_ptr->order_array[0];
+    bool rx_ret = RxReorderPacketPayloadStateInit(protocol_handle, rx_state_ptr->payload_sgl_entry_pool_handle,
+                                                  rx_state_ptr->reorder_entries_pool_handle,
+                                                  rx_state_ptr->reorder_pages_pool_handle, &payload_state,
+                                                  &state_ptr->sgl_array[sequence_num],
+                                                  state_ptr->header_size_array[sequence_num], sequence_num);
+    for (int i = 1; rx_ret && i < BENCHMARK_PACKET_COUNT; i++) {
+        sequence_num = state_ptr->order_array[i];
+        rx_ret = RxReorderPacket(protocol_handle, rx_state_ptr->payload_sgl_entry_pool_handle,
+                                 rx_state_ptr->reorder_entries_pool_handle, rx_state_ptr->reorder_pages_pool_handle,
+                                 &payload_state, &state_ptr->sgl_array[sequence_num],
+                                 state_ptr->header_size_array[sequence_num], sequence_num);
+    }
+    *elapsed_us_ptr += CdiOsGetMicroseconds() - start_time;
+
+    CHECK(rx_ret);
+    CHECK(NULL == payload_state.reorder_list_ptr->next_ptr);
+    CHECK(NULL == payload_state.reorder_list_ptr->prev_ptr);
+    CHECK(0 == payload_state.reorder_held_packet_count);
+    CHECK(BENCHMARK_PACKET_COUNT == payload_state.data_bytes_received);
+
+    // The payload SGL must hold the data of each packet in sequence order.
+    int count = 0;
+    for (CdiSglEntry* entry_ptr = payload_state.reorder_list_ptr->sglist.sgl_head_ptr; entry_ptr;
+         entry_ptr = entry_ptr->next_ptr) {
+        CHECK(count < BENCHMARK_PACKET_COUNT);
+        CHECK((uint8_t*)&state_ptr->header_array[count] + state_ptr->header_size_array[count] ==
+              entry_ptr->address_ptr);
+        count++;
+    }
+    CHECK(BENCHMARK_PACKET_COUNT == count);
+
+    RxReorderPacketFreeLists(&payload_state, rx_state_ptr->payload_sgl_entry_pool_handle,
+                             rx_state_ptr->reorder_entries_pool_handle, rx_state_ptr->reorder_pages_pool_handle);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Measures the speed of the packet reorder engine selected by the connection's pools for each reorder distance.
+ *
+ * @param protocol_handle Handle of protocol version.
+ * @param con_state_ptr Pointer to connection state holding the pools to use.
+ * @param state_ptr Pointer to benchmark state.
+ *
+ * @return kCdiStatusOk if successful, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus ReorderBenchmark(CdiProtocolHandle protocol_handle, CdiConnectionState* con_state_ptr,
+                                        BenchmarkState* state_ptr)
+{
+    CdiReturnStatus rs = kCdiStatusOk;
+    const char* engine_str = con_state_ptr->rx_state.reorder_pages_pool_handle ? "bitmap" : "list";
+
+    for (int i = 0; kCdiStatusOk == rs && i < CDI_ARRAY_ELEMENT_COUNT(reorder_distance_array); i++) {
+        uint64_t elapsed_us = 0;
+        for (int j = 0; kCdiStatusOk == rs && j < BENCHMARK_PAYLOAD_COUNT; j++) {
+            BenchmarkOrderInit(reorder_distance_array[i], state_ptr);
+            rs = BenchmarkPayload(protocol_handle, con_state_ptr, state_ptr, &elapsed_us);
+        }
+        if (kCdiStatusOk == rs) {
+            CDI_LOG_THREAD(kLogInfo, "Packet reorder benchmark [%s]: Reorder distance[%d] Time[%"PRIu64"]ns per "
+                           "packet.", engine_str, reorder_distance_array[i],
+                           elapsed_us * 1000 / (BENCHMARK_PACKET_COUNT * BENCHMARK_PAYLOAD_COUNT));
+        }
+    }
+
+    return rs;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitRxReorderPackets(void)
+{
+    CdiReturnStatus rs = kCdiStatusOk;
+    srand(time(0));
+
+    CdiConnectionState con_state = { 0 };
+    CdiConnectionState* con_state_ptr = &con_state;
+    con_state.magic = kMagicConnection;
+
+    CdiProtocolHandle protocol_handle = NULL;
+    CdiProtocolVersionNumber version = {
+        .version_num = 1,
+        .major_version_num = 0,
+        .probe_version_num = 0
+    };
+    ProtocolVersionSet(&version, &protocol_handle);
+
+    // Create a pool of locations. It must hold the SGL entries of an entire benchmark payload.
+    if (!CdiPoolCreate("Rx CdiSglEntry Payload Pool",
+                       BENCHMARK_PACKET_COUNT,    // item_count
+                       BENCHMARK_PACKET_COUNT,    // grow_count
+                       MAX_POOL_GROW_COUNT,
+                       sizeof(CdiSglEntry), true, // true= Make thread-safe,
+                       &con_state_ptr->rx_state.payload_sgl_entry_pool_handle)) {
+        rs = kCdiStatusNotEnoughMemory;
+    }
+
+    if (kCdiStatusOk == rs) {
+        // The list engine can use a list for every other packet of a shuffled benchmark payload.
+        if (!CdiPoolCreate("Rx CdiReorderList Out of Order Pool", BENCHMARK_PACKET_COUNT / 2, MAX_RX_OUT_OF_ORDER_GROW,
+                           MAX_POOL_GROW_COUNT, sizeof(CdiReorderList), true, // true= Make thread-safe
+                           &con_state_ptr->rx_state.reorder_entries_pool_handle)) {
+            rs = kCdiStatusNotEnoughMemory;
+        }
+    }
+
+    CdiPoolHandle reorder_pages_pool_handle = NULL;
+    if (kCdiStatusOk == rs) {
+        if (!CdiPoolCreate("Rx Reorder Page Pool", RX_REORDER_PAGE_POOL_SIZE, RX_REORDER_PAGE_POOL_SIZE_GROW,
+                           MAX_POOL_GROW_COUNT, sizeof(RxReorderPage), true, // true= Make thread-safe
+                           &reorder_pages_pool_handle)) {
+            rs = kCdiStatusNotEnoughMemory;
+        }
+    }
+
+    BenchmarkState* benchmark_state_ptr = NULL;
+    if (kCdiStatusOk == rs) {
+        benchmark_state_ptr = CdiOsMemAllocZero(sizeof(BenchmarkState));
+        if (NULL == benchmark_state_ptr) {
+            rs = kCdiStatusNotEnoughMemory;
+        } else {
+            BenchmarkPacketsInit(protocol_handle, benchmark_state_ptr);
+        }
+    }
+
+    // Test the list engine, then the bitmap engine.
+    for (int i = 0; kCdiStatusOk == rs && i < 2; i++) {
+        con_state_ptr->rx_state.reorder_pages_pool_handle = (0 == i) ? NULL : reorder_pages_pool_handle;
+        rs = ReorderOutOfSequenceSgls(protocol_handle, con_state_ptr);
+        if (kCdiStatusOk == rs) {
+            rs = ReorderBenchmark(protocol_handle, con_state_ptr, benchmark_state_ptr);
         }
-        CdiReorderList *next_ptr = reorder_list_ptr->next_ptr; // Save next entry, since Put() will free its memory.
-        CdiPoolPut(con_state_ptr->rx_state.reorder_entries_pool_handle, reorder_list_ptr);
-        reorder_list_ptr = next_ptr;
+    }
+
+    // get rid of everything
+    CdiOsMemFree(benchmark_state_ptr);
+    ProtocolVersionDestroy(protocol_handle);
+    if (reorder_pages_pool_handle) {
+        CdiPoolDestroy(reorder_pages_pool_handle);
     }
     if (con_state_ptr->rx_state.payload_sgl_entry_pool_handle) {
         CdiPoolDestroy(con_state_ptr->rx_state.payload_sgl_entry_pool_handle);
@@ -0,0 +1,309 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains a unit test of the reporting of Rx payload slices. Packets of a payload being received into a
+ * linear buffer are recorded as copied in various orders, and the test checks the slices passed to the slice callback.
+ */
+
+#include <string.h>
+
+#include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "configuration.h"
+#include "internal_rx.h"
+#include "private.h"
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// Number of data bytes in each packet.
+#define PACKET_DATA_BYTES               (100)
+
+/// Number of packets in the payload.
+#define PAYLOAD_PACKET_COUNT            (RX_SLICE_WINDOW_PACKET_COUNT * 2)
+
+/// Number of packets in the payload whose packet sequence numbers wrap.
+#define WRAP_PAYLOAD_PACKET_COUNT       (UINT16_MAX + 1 + PAYLOAD_PACKET_COUNT)
+
+/// Maximum number of slices recorded by the slice callback.
+#define MAX_SLICES                      (PAYLOAD_PACKET_COUNT)
+
+/// Value of the user data of the payload, which identifies it in the slices.
+#define PAYLOAD_USER_DATA               (0x1234567890ABCDEFULL)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+/**
+ * @brief State of the test, which is passed to the slice callback.
+ */
+typedef struct {
+    CdiConnectionState con_state;             ///< Connection state. Only the configuration data is used.
+    RxPayloadState payload_state;             ///< State of the payload being received.
+    RxSliceState slice_state;                 ///< Slice state of the payload being received.
+    uint8_t linear_buffer[PACKET_DATA_BYTES]; ///< Stands in for the payload's linear buffer. Only its address is used.
+    CdiCoreRxSliceCbData slice_array[MAX_SLICES]; ///< Slices passed to the slice callback.
+    int slice_count;                          ///< Number of slices in slice_array.
+} SliceTestState;
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Records the slices reported for the payload.
+ *
+ * @param data_ptr Pointer to the slice callback data.
+ */
+static void SliceCallback(const CdiCoreRxSliceCbData* data_ptr)
+{
+    SliceTestState* state_ptr = (SliceTestState*)data_ptr->slice_user_cb_param;
+    if (state_ptr->slice_count < MAX_SLICES) {
+        state_ptr->slice_array[state_ptr->slice_count] = *data_ptr;
+    }
+    state_ptr->slice_count++;
+}
+
+/**
+ * Prepares the test state to receive a new payload, as InitializePayloadState() does once packet #0 has arrived.
+ *
+ * @param slice_size Minimum size of the slices in bytes.
+ * @param state_ptr Pointer to test state.
+ */
+static void SlicePayloadInit(int slice_size, SliceTestState* state_ptr)
+{
+    memset(state_ptr, 0, sizeof(*state_ptr));
+    CdiRxConfigData* config_data_ptr = &state_ptr->con_state.rx_state.config_data;
+    config_data_ptr->rx_buffer_type = kCdiLinearBuffer;
+    config_data_ptr->slice_cb_ptr = SliceCallback;
+    config_data_ptr->slice_size = slice_size;
+    config_data_ptr->slice_user_cb_param = state_ptr;
+
+    RxPayloadState* payload_state_ptr = &state_ptr->payload_state;
+    payload_state_ptr->payload_state = kPayloadInProgress;
+    payload_state_ptr->expected_payload_data_size = PAYLOAD_PACKET_COUNT * PACKET_DATA_BYTES;
+    payload_state_ptr->linear_buffer_ptr = state_ptr->linear_buffer;
+    payload_state_ptr->slice_state_ptr = &state_ptr->slice_state;
+    payload_state_ptr->work_request_state.app_payload_cb_data.core_extra_data.payload_user_data = PAYLOAD_USER_DATA;
+}
+
+/**
+ * Records that a packet of the payload has been copied.
+ *
+ * @param packet_index Index of the packet within the payload. Its sequence number is the 16 LSBs of the index.
+ * @param state_ptr Pointer to test state.
+ */
+static void PacketCopied(int packet_index, SliceTestState* state_ptr)
+{
+    RxSlicePacketCopied(&state_ptr->con_state, &state_ptr->payload_state, packet_index & UINT16_MAX,
+                        (packet_index + 1) * PACKET_DATA_BYTES);
+}
+
+/**
+ * Checks that the slices reported so far follow each other from the start of the payload, identify it and are at least
+ * the minimum size.
+ *
+ * @param slice_size Minimum size of the slices in bytes.
+ * @param state_ptr Pointer to test state.
+ * @param ret_reported_size_ptr Address where to write the number of bytes reported by the slices.
+ *
+ * @return kCdiStatusOk if the slices are as expected, kCdiStatusFatal otherwise.
+ */
+static CdiReturnStatus CheckSlices(int slice_size, const SliceTestState* state_ptr, int* ret_reported_size_ptr)
+{
+    CHECK(state_ptr->slice_count <= MAX_SLICES);
+    int reported_size = 0;
+    for (int i = 0; i < state_ptr->slice_count; i++) {
+        const CdiCoreRxSliceCbData* slice_ptr = &state_ptr->slice_array[i];
+        CHECK((CdiConnectionHandle)&state_ptr->con_state == slice_ptr->connection_handle);
+        CHECK(PAYLOAD_USER_DATA == slice_ptr->core_extra_data.payload_user_data);
+        CHECK(state_ptr->linear_buffer == slice_ptr->payload_buffer_ptr);
+        CHECK(reported_size == slice_ptr->slice_offset);
+        CHECK(slice_ptr->slice_size > 0 && slice_ptr->slice_size >= slice_size);
+        CHECK(0 == slice_ptr->slice_size % PACKET_DATA_BYTES);
+        reported_size += slice_ptr->slice_size;
+    }
+    *ret_reported_size_ptr = reported_size;
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Receives the payload in order, checking that a slice is reported whenever enough data has been received and that the
+ * data that completes the payload is not reported.
+ *
+ * @param slice_size Minimum size of the slices in bytes.
+ * @param state_ptr Pointer to test state.
+ *
+ * @return kCdiStatusOk if the slices are as expected, kCdiStatusFatal otherwise.
+ */
+static CdiReturnStatus TestInOrder(int slice_size, SliceTestState* state_ptr)
+{
+    SlicePayloadInit(slice_size, state_ptr);
+
+    int reported_size = 0;
+    for (int i = 0; i < PAYLOAD_PACKET_COUNT; i++) {
+        PacketCopied(i, state_ptr);
+        CHECK(kCdiStatusOk == CheckSlices(slice_size, state_ptr, &reported_size));
+        const int received_size = (i + 1) * PACKET_DATA_BYTES;
+        if (received_size < state_ptr->payload_state.expected_payload_data_size) {
+            CHECK(received_size - reported_size < CDI_MAX(slice_size, 1));
+        }
+    }
+    CHECK(reported_size < state_ptr->payload_state.expected_payload_data_size);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Receives the payload with packets swapped in pairs and packet #0 last of the first group, checking that no slice is
+ * reported until packet #0 arrives and that slices only cover data at the start of the payload.
+ *
+ * @param state_ptr Pointer to test state.
+ *
+ * @return kCdiStatusOk if the slices are as expected, kCdiStatusFatal otherwise.
+ */
+static CdiReturnStatus TestOutOfOrder(SliceTestState* state_ptr)
+{
+    SlicePayloadInit(0, state_ptr);
+
+    // Packets #1 to #9 arrive before packet #0, which arrives while the payload is still waiting for it.
+    state_ptr->payload_state.payload_state = kPayloadPacketZeroPending;
+    for (int i = 1; i < 10; i++) {
+        PacketCopied(i, state_ptr);
+    }
+    CHECK(0 == state_ptr->slice_count);
+    state_ptr->payload_state.payload_state = kPayloadInProgress;
+    PacketCopied(0, state_ptr);
+    CHECK(1 == state_ptr->slice_count);
+    CHECK(10 * PACKET_DATA_BYTES == state_ptr->slice_array[0].slice_size);
+
+    // The other packets arrive swapped in pairs, so a slice is reported every other packet.
+    int reported_size = 0;
+    for (int i = 10; i < PAYLOAD_PACKET_COUNT; i += 2) {
+        PacketCopied(i + 1, state_ptr);
+        CHECK(kCdiStatusOk == CheckSlices(0, state_ptr, &reported_size));
+        CHECK((i + 0) * PACKET_DATA_BYTES == reported_size);
+        PacketCopied(i, state_ptr);
+        CHECK(kCdiStatusOk == CheckSlices(0, state_ptr, &reported_size));
+        if (i + 2 < PAYLOAD_PACKET_COUNT) {
+            CHECK((i + 2) * PACKET_DATA_BYTES == reported_size);
+        }
+    }
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Receives a packet too far ahead of the contiguous data to be tracked, checking that no more slices are reported for
+ * the payload, and that slices are not reported for a payload in error.
+ *
+ * @param state_ptr Pointer to test state.
+ *
+ * @return kCdiStatusOk if the slices are as expected, kCdiStatusFatal otherwise.
+ */
+static CdiReturnStatus TestNotReported(SliceTestState* state_ptr)
+{
+    SlicePayloadInit(0, state_ptr);
+    PacketCopied(0, state_ptr);
+    CHECK(1 == state_ptr->slice_count);
+    PacketCopied(1 + RX_SLICE_WINDOW_PACKET_COUNT, state_ptr);
+    for (int i = 1; i < PAYLOAD_PACKET_COUNT; i++) {
+        PacketCopied(i, state_ptr);
+    }
+    CHECK(1 == state_ptr->slice_count);
+
+    SlicePayloadInit(0, state_ptr);
+    state_ptr->payload_state.payload_state = kPayloadError;
+    for (int i = 0; i < PAYLOAD_PACKET_COUNT; i++) {
+        PacketCopied(i, state_ptr);
+    }
+    CHECK(0 == state_ptr->slice_count);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Receives a payload with more packets than packet sequence numbers, with packets swapped in pairs, checking that slices
+ * keep being reported after the sequence numbers wrap.
+ *
+ * @param state_ptr Pointer to test state.
+ *
+ * @return kCdiStatusOk if the slices are as expected, kCdiStatusFatal otherwise.
+ */
+static CdiReturnStatus TestSequenceWrap(SliceTestState* state_ptr)
+{
+    // Large slices keep the number of slices within MAX_SLICES.
+    const int slice_size = PACKET_DATA_BYTES * 1024;
+    SlicePayloadInit(slice_size, state_ptr);
+    state_ptr->payload_state.expected_payload_data_size = WRAP_PAYLOAD_PACKET_COUNT * PACKET_DATA_BYTES;
+
+    // Start the pairs at packet #1, so a pair straddles the wrap.
+    PacketCopied(0, state_ptr);
+    for (int i = 1; i + 1 < WRAP_PAYLOAD_PACKET_COUNT; i += 2) {
+        PacketCopied(i + 1, state_ptr);
+        PacketCopied(i, state_ptr);
+    }
+    int reported_size = 0;
+    CHECK(kCdiStatusOk == CheckSlices(slice_size, state_ptr, &reported_size));
+    CHECK((WRAP_PAYLOAD_PACKET_COUNT - 1) * PACKET_DATA_BYTES - reported_size < slice_size);
+    CHECK(reported_size > (UINT16_MAX + 1) * PACKET_DATA_BYTES);
+
+    return kCdiStatusOk;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitRxSlices(void)
+{
+    CdiReturnStatus rs = kCdiStatusOk;
+    SliceTestState* state_ptr = CdiOsMemAllocZero(sizeof(SliceTestState));
+    if (NULL == state_ptr) {
+        rs = kCdiStatusNotEnoughMemory;
+    }
+
+    // Slice sizes that are smaller than, equal to, not a multiple of and larger than the packets.
+    const int slice_size_array[] = { 0, PACKET_DATA_BYTES, PACKET_DATA_BYTES * 5 / 2, PACKET_DATA_BYTES * 64 };
+    for (int i = 0; kCdiStatusOk == rs && i < CDI_ARRAY_ELEMENT_COUNT(slice_size_array); i++) {
+        rs = TestInOrder(slice_size_array[i], state_ptr);
+    }
+    if (kCdiStatusOk == rs) {
+        rs = TestOutOfOrder(state_ptr);
+    }
+    if (kCdiStatusOk == rs) {
+        rs = TestNotReported(state_ptr);
+    }
+    if (kCdiStatusOk == rs) {
+        rs = TestSequenceWrap(state_ptr);
+    }
+
+    CdiOsMemFree(state_ptr);
+
+    return rs;
+}
@@ -7,14 +7,19 @@
 /**
  * @file
  * @brief
- * This file contains a unit test for the CdiCoreGather() function.
+ * This file contains a unit test for the CdiCoreGather() function. It also checks the gather that uses non-temporal
+ * stores against the regular one and logs a benchmark of both, gathering video frames from packet sized SGL entries the
+ * way the linear receive path does.
  */
 
+#include <inttypes.h>
 #include <stddef.h>
 #include <string.h>
 
 #include "cdi_core_api.h"
 #include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "internal.h"
 #include "utilities_api.h"
 
 //*********************************************************************************************************************
@@ -26,6 +31,25 @@
 /// The size of the buffers used in this unit test. It determines the maximum size of an SGL to be tested.
 #define UNIT_TEST_BUFFER_SIZE 1000
 
+/// The size of the source buffer of the non-temporal gather test.
+#define NON_TEMPORAL_TEST_BUFFER_SIZE (4096)
+/// The number of bytes before and after the gathered data that are checked to not have been written.
+#define NON_TEMPORAL_TEST_GUARD_SIZE (64)
+/// The value of the bytes around the gathered data.
+#define NON_TEMPORAL_TEST_GUARD_VALUE (0xa5)
+
+/// The number of payload bytes in each SGL entry of the benchmark, the size of an EFA packet.
+#define BENCHMARK_PACKET_BYTES (8192)
+/// The number of packet buffers the benchmark gathers from. Together they fit in the CPU caches, like just received
+/// packets do.
+#define BENCHMARK_PACKET_BUFFER_COUNT (64)
+/// The number of bytes in a 2160p 4:2:2 10-bit video frame, the size of each destination of the benchmark.
+#define BENCHMARK_FRAME_BYTES (3840 * 2160 * 20 / 8)
+/// The number of frame buffers the benchmark writes to in turn, like the linear receive buffers of a connection.
+#define BENCHMARK_FRAME_BUFFER_COUNT (RX_LINEAR_BUFFER_COUNT)
+/// The number of frames gathered by each pass of the benchmark.
+#define BENCHMARK_FRAME_COUNT (20)
+
 /**
  * This is a super simple SGL entry like structure used in the definitions of the test cases.
  */
@@ -140,6 +164,134 @@ static bool TestCase(const CaseParams* params_ptr)
     return ret;
 }
 
+/**
+ * Gathers an SGL into a destination at every alignment, with and without non-temporal stores, and checks that the data
+ * is copied and that the bytes around it are left as they were. The SGL entries are slices of one source buffer, so
+ * the gathered data must match the source buffer at the start offset.
+ *
+ * @param entry_size_array Sizes of the SGL entries.
+ * @param entry_count Number of SGL entries.
+ * @param start_offset Number of bytes to skip in the SGL.
+ *
+ * @return bool true if the case passed, false if it failed.
+ */
+static bool NonTemporalTestCase(const int* entry_size_array, int entry_count, int start_offset)
+{
+    static uint8_t source_buffer[NON_TEMPORAL_TEST_BUFFER_SIZE];
+    static uint8_t dest_buffer[NON_TEMPORAL_TEST_BUFFER_SIZE + 2 * NON_TEMPORAL_TEST_GUARD_SIZE];
+    for (int i = 0; i < NON_TEMPORAL_TEST_BUFFER_SIZE; i++) {
+        source_buffer[i] = data[i % sizeof(data)] ^ (uint8_t)(i / sizeof(data));
+    }
+
+    CdiSglEntry sgl_entries[MAX_UNIT_TEST_SGL_ENTRIES];
+    int total_data_size = 0;
+    for (int i = 0; i < entry_count; i++) {
+        SglEntryInit(&sgl_entries[i], source_buffer + total_data_size, entry_size_array[i]);
+        if (i > 0) {
+            sgl_entries[i - 1].next_ptr = &sgl_entries[i];
+        }
+        total_data_size += entry_size_array[i];
+    }
+    if (NON_TEMPORAL_TEST_BUFFER_SIZE < total_data_size) {
+        return false;
+    }
+    CdiSgList sgl = {
+        .internal_data_ptr = NULL,
+        .sgl_head_ptr = &sgl_entries[0],
+        .sgl_tail_ptr = &sgl_entries[entry_count - 1],
+        .total_data_size = total_data_size
+    };
+    const int byte_count = total_data_size - start_offset;
+
+    bool ret = true;
+    for (int non_temporal = 0; ret && non_temporal <= 1; non_temporal++) {
+        for (int alignment = 0; ret && alignment < 16; alignment++) {
+            memset(dest_buffer, NON_TEMPORAL_TEST_GUARD_VALUE, sizeof(dest_buffer));
+            uint8_t* dest_ptr = dest_buffer + NON_TEMPORAL_TEST_GUARD_SIZE + alignment;
+            ret = byte_count == CdiGatherInternal(&sgl, start_offset, dest_ptr, byte_count, non_temporal);
+            ret = ret && 0 == memcmp(source_buffer + start_offset, dest_ptr, byte_count);
+            for (uint8_t* p = dest_buffer; ret && p < dest_buffer + sizeof(dest_buffer); p++) {
+                if (p < dest_ptr || p >= dest_ptr + byte_count) {
+                    ret = NON_TEMPORAL_TEST_GUARD_VALUE == *p;
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+/**
+ * Gathers BENCHMARK_FRAME_COUNT video frames, one packet sized SGL entry at a time like the linear receive path, and
+ * logs the rate at which data was gathered.
+ *
+ * @param packet_buffer_ptr Pointer to BENCHMARK_PACKET_BUFFER_COUNT packet buffers.
+ * @param frame_buffer_array Array of BENCHMARK_FRAME_BUFFER_COUNT frame buffers.
+ * @param non_temporal True to use non-temporal stores.
+ */
+static void GatherBenchmark(uint8_t* packet_buffer_ptr, uint8_t** frame_buffer_array, bool non_temporal)
+{
+    CdiSglEntry sgl_entry;
+    CdiSgList sgl = {
+        .internal_data_ptr = NULL,
+        .sgl_head_ptr = &sgl_entry,
+        .sgl_tail_ptr = &sgl_entry,
+        .total_data_size = BENCHMARK_PACKET_BYTES
+    };
+
+    int packet_index = 0;
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int frame = 0; frame < BENCHMARK_FRAME_COUNT; frame++) {
+        uint8_t* frame_ptr = frame_buffer_array[frame % BENCHMARK_FRAME_BUFFER_COUNT];
+        for (int offset = 0; offset < BENCHMARK_FRAME_BYTES; offset += BENCHMARK_PACKET_BYTES) {
+            int byte_count = CDI_MIN(BENCHMARK_PACKET_BYTES, BENCHMARK_FRAME_BYTES - offset);
+            SglEntryInit(&sgl_entry, packet_buffer_ptr + packet_index * BENCHMARK_PACKET_BYTES, byte_count);
+            CdiGatherInternal(&sgl, 0, frame_ptr + offset, byte_count, non_temporal);
+            packet_index = (packet_index + 1) % BENCHMARK_PACKET_BUFFER_COUNT;
+        }
+    }
+    uint64_t elapsed_microseconds = CDI_MAX(CdiOsGetMicroseconds() - start_time, 1);
+
+    uint64_t byte_count = (uint64_t)BENCHMARK_FRAME_BYTES * BENCHMARK_FRAME_COUNT;
+    CDI_LOG_THREAD(kLogInfo, "Gather benchmark [%s]: [%"PRIu64"]MB/s, [%"PRIu64"]us per frame.",
+                   non_temporal ? "non-temporal" : "memcpy", byte_count / elapsed_microseconds,
+                   elapsed_microseconds / BENCHMARK_FRAME_COUNT);
+}
+
+/**
+ * Runs the gather benchmark with and without non-temporal stores.
+ *
+ * @return bool true if the benchmark ran, false if its buffers could not be allocated.
+ */
+static bool RunGatherBenchmark(void)
+{
+    uint8_t* packet_buffer_ptr = CdiOsMemAlloc(BENCHMARK_PACKET_BUFFER_COUNT * BENCHMARK_PACKET_BYTES);
+    uint8_t* frame_buffer_array[BENCHMARK_FRAME_BUFFER_COUNT] = { NULL };
+    bool ret = NULL != packet_buffer_ptr;
+    for (int i = 0; i < BENCHMARK_FRAME_BUFFER_COUNT; i++) {
+        frame_buffer_array[i] = CdiOsMemAlloc(BENCHMARK_FRAME_BYTES);
+        ret = ret && NULL != frame_buffer_array[i];
+    }
+
+    if (ret) {
+        memset(packet_buffer_ptr, 0x5a, BENCHMARK_PACKET_BUFFER_COUNT * BENCHMARK_PACKET_BYTES);
+        for (int i = 0; i < BENCHMARK_FRAME_BUFFER_COUNT; i++) {
+            memset(frame_buffer_array[i], 0, BENCHMARK_FRAME_BYTES);
+        }
+        GatherBenchmark(packet_buffer_ptr, frame_buffer_array, false);
+        GatherBenchmark(packet_buffer_ptr, frame_buffer_array, true);
+    }
+
+    for (int i = 0; i < BENCHMARK_FRAME_BUFFER_COUNT; i++) {
+        if (frame_buffer_array[i]) {
+            CdiOsMemFree(frame_buffer_array[i]);
+        }
+    }
+    if (packet_buffer_ptr) {
+        CdiOsMemFree(packet_buffer_ptr);
+    }
+    return ret;
+}
+
 /**
  * Runs all of the defined CdiCoreGather() test cases. Testing stops on the first failed case.
  *
@@ -170,5 +322,26 @@ CdiReturnStatus TestUnitSgl(void)
         }
     }
 
+    // Entry sizes are chosen to exercise the copies before and after the 16 byte aligned stores and the entries copied
+    // with memcpy() because they are too small for non-temporal stores.
+    const int non_temporal_entry_sizes[][3] = {
+        { 4000, 0, 0 },
+        { 255, 256, 3000 },
+        { 1, 1023, 2049 },
+        { 64, 79, 1100 },
+    };
+    for (unsigned int i = 0; !failed && i < CDI_ARRAY_ELEMENT_COUNT(non_temporal_entry_sizes); i++) {
+        for (int start_offset = 0; !failed && start_offset <= 100; start_offset += 50) {
+            failed = !NonTemporalTestCase(non_temporal_entry_sizes[i], 3, start_offset);
+            if (failed) {
+                CDI_LOG_THREAD(kLogError, "SGL non-temporal test [%u] offset[%d] failed.", i, start_offset);
+            }
+        }
+    }
+
+    if (!failed) {
+        failed = !RunGatherBenchmark();
+    }
+
     return failed ? kCdiStatusFatal : kCdiStatusOk;
 }
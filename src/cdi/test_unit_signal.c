@@ -0,0 +1,345 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains a unit test for the CdiOsSignal functions, including timeouts, waiting on multiple signals and
+ * waking a thread with a set/clear cycle. It also logs the cost of setting and clearing a signal that no thread is
+ * waiting on and the latency of waking a waiting thread.
+ */
+
+#include "cdi_core_api.h"
+#include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "utilities_api.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// Number of signals used by the wait multiple tests.
+#define WAIT_MULTIPLE_SIGNAL_COUNT      (3)
+
+/// Timeout used by the tests that expect a wait to time out.
+#define TIMEOUT_TEST_MS                 (10)
+
+/// Number of times a set/clear cycle is tried while waiting for a thread to be woken by one.
+#define SET_CLEAR_CYCLE_TRIES           (100)
+
+/// Number of set/clear pairs used by the set cost benchmark.
+#define SET_BENCHMARK_OP_COUNT          (1000000)
+
+/// Number of round trips used by the wake latency benchmark.
+#define WAKE_BENCHMARK_ROUND_TRIPS      (20000)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+/**
+ * @brief State passed to the test threads.
+ */
+typedef struct {
+    CdiSignalType ping_signal;  ///< Signal the thread waits on.
+    CdiSignalType pong_signal;  ///< Signal the thread sets after ping_signal was set.
+    CdiSignalType abort_signal; ///< Signal also waited on by the thread, to match how queues wait. Never set.
+    bool use_wait_multiple;     ///< If true, use CdiOsSignalsWait(), otherwise CdiOsSignalWait().
+    int round_trip_count;       ///< Number of times to wait for ping_signal.
+    int ready_count;            ///< Set to 1 once the thread is running.
+    uint32_t signal_index;      ///< Index returned by the last CdiOsSignalsWait().
+    bool pass;                  ///< Set to false by the thread if an error was detected.
+} TestThreadState;
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Thread that waits for the ping signal, clears it and then sets the pong signal, for the configured number of round
+ * trips.
+ *
+ * @param arg_ptr Pointer to the thread's TestThreadState.
+ *
+ * @return The return value is not used.
+ */
+static CDI_THREAD EchoTestThread(void* arg_ptr)
+{
+    TestThreadState* state_ptr = (TestThreadState*)arg_ptr;
+    CdiSignalType signal_array[] = { state_ptr->ping_signal, state_ptr->abort_signal };
+
+    CdiOsAtomicStore32(&state_ptr->ready_count, 1);
+    for (int i = 0; state_ptr->pass && i < state_ptr->round_trip_count; i++) {
+        if (state_ptr->use_wait_multiple) {
+            uint32_t signal_index = 0;
+            state_ptr->pass = CdiOsSignalsWait(signal_array, CDI_ARRAY_ELEMENT_COUNT(signal_array), false,
+                                               CDI_INFINITE, &signal_index) && 0 == signal_index;
+        } else {
+            state_ptr->pass = CdiOsSignalWait(state_ptr->ping_signal, CDI_INFINITE, NULL);
+        }
+        CdiOsSignalClear(state_ptr->ping_signal);
+        CdiOsSignalSet(state_ptr->pong_signal);
+    }
+
+    return 0; // Return value is not used.
+}
+
+/**
+ * Thread that waits on the ping signal and the abort signal once and stores the returned signal index.
+ *
+ * @param arg_ptr Pointer to the thread's TestThreadState.
+ *
+ * @return The return value is not used.
+ */
+static CDI_THREAD WaitMultipleTestThread(void* arg_ptr)
+{
+    TestThreadState* state_ptr = (TestThreadState*)arg_ptr;
+    CdiSignalType signal_array[] = { state_ptr->ping_signal, state_ptr->abort_signal };
+
+    CdiOsAtomicStore32(&state_ptr->ready_count, 1);
+    state_ptr->pass = CdiOsSignalsWait(signal_array, CDI_ARRAY_ELEMENT_COUNT(signal_array), false, CDI_INFINITE,
+                                       &state_ptr->signal_index);
+
+    return 0; // Return value is not used.
+}
+
+/**
+ * Start a test thread and wait for it to start running.
+ *
+ * @param thread_func Thread function.
+ * @param state_ptr Pointer to the thread's state.
+ * @param ret_thread_id_ptr Address where to write the thread's ID.
+ *
+ * @return true if the thread was started.
+ */
+static bool StartThread(CdiThreadFuncName thread_func, TestThreadState* state_ptr, CdiThreadID* ret_thread_id_ptr)
+{
+    if (!CdiOsThreadCreate(thread_func, ret_thread_id_ptr, "SignalTest", state_ptr, NULL)) {
+        return false;
+    }
+    while (0 == CdiOsAtomicLoad32(&state_ptr->ready_count)) {
+        CdiOsSleepMicroseconds(100);
+    }
+    return true;
+}
+
+/**
+ * Test setting, clearing and getting signals and waiting on them from a single thread, including timeouts.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus SingleThreadTest(void)
+{
+    CdiSignalType signal_array[WAIT_MULTIPLE_SIGNAL_COUNT] = { NULL };
+    bool timed_out = false;
+    uint32_t signal_index = 0;
+
+    for (int i = 0; i < WAIT_MULTIPLE_SIGNAL_COUNT; i++) {
+        CHECK(CdiOsSignalCreate(&signal_array[i]));
+        CHECK(!CdiOsSignalGet(signal_array[i]));
+    }
+
+    // A set signal stays set until cleared, and setting it again has no further effect.
+    CHECK(CdiOsSignalSet(signal_array[0]));
+    CHECK(CdiOsSignalSet(signal_array[0]));
+    CHECK(CdiOsSignalGet(signal_array[0]));
+    CHECK(CdiOsSignalReadState(signal_array[0]));
+    CHECK(CdiOsSignalWait(signal_array[0], CDI_INFINITE, &timed_out));
+    CHECK(!timed_out);
+    CHECK(CdiOsSignalClear(signal_array[0]));
+    CHECK(!CdiOsSignalGet(signal_array[0]));
+    CHECK(CdiOsSignalWait(signal_array[0], TIMEOUT_TEST_MS, &timed_out));
+    CHECK(timed_out);
+
+    // Wait on multiple signals returns the index of a set signal, or a timeout.
+    CHECK(CdiOsSignalsWait(signal_array, WAIT_MULTIPLE_SIGNAL_COUNT, false, TIMEOUT_TEST_MS, &signal_index));
+    CHECK(CDI_OS_SIG_TIMEOUT == signal_index);
+    CHECK(CdiOsSignalSet(signal_array[2]));
+    CHECK(CdiOsSignalsWait(signal_array, WAIT_MULTIPLE_SIGNAL_COUNT, false, CDI_INFINITE, &signal_index));
+    CHECK(2 == signal_index);
+
+    // Wait all only returns once every signal is set.
+    CHECK(CdiOsSignalsWait(signal_array, WAIT_MULTIPLE_SIGNAL_COUNT, true, TIMEOUT_TEST_MS, &signal_index));
+    CHECK(CDI_OS_SIG_TIMEOUT == signal_index);
+    CHECK(CdiOsSignalSet(signal_array[0]));
+    CHECK(CdiOsSignalSet(signal_array[1]));
+    CHECK(CdiOsSignalsWait(signal_array, WAIT_MULTIPLE_SIGNAL_COUNT, true, CDI_INFINITE, &signal_index));
+    CHECK(CDI_OS_SIG_TIMEOUT != signal_index);
+
+    for (int i = 0; i < WAIT_MULTIPLE_SIGNAL_COUNT; i++) {
+        CHECK(CdiOsSignalDelete(signal_array[i]));
+    }
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Test waking threads that are waiting on a signal, including a signal that is set and cleared again before the waiting
+ * thread runs, and a thread waiting on multiple signals being woken by the second one.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus MultipleThreadTest(void)
+{
+    CdiThreadID thread_id = NULL;
+    TestThreadState state = {
+        .round_trip_count = 1,
+        .pass = true
+    };
+
+    CHECK(CdiOsSignalCreate(&state.ping_signal));
+    CHECK(CdiOsSignalCreate(&state.pong_signal));
+    CHECK(CdiOsSignalCreate(&state.abort_signal));
+
+    // A set/clear cycle releases a thread waiting in CdiOsSignalWait(), even if it only runs after the clear. The cycle
+    // is repeated in case the thread had not started waiting yet, but a thread that sleeps through them never wakes.
+    CHECK(StartThread(EchoTestThread, &state, &thread_id));
+    bool timed_out = true;
+    for (int i = 0; timed_out && i < SET_CLEAR_CYCLE_TRIES; i++) {
+        CHECK(CdiOsSignalSet(state.ping_signal));
+        CHECK(CdiOsSignalClear(state.ping_signal));
+        CHECK(CdiOsSignalWait(state.pong_signal, TIMEOUT_TEST_MS, &timed_out));
+    }
+    CHECK(!timed_out);
+    CHECK(CdiOsThreadJoin(thread_id, CDI_INFINITE, NULL));
+    CHECK(state.pass);
+
+    // A thread waiting on multiple signals is woken by the one that is set and reports its index.
+    state.ready_count = 0;
+    state.signal_index = 0;
+    CHECK(StartThread(WaitMultipleTestThread, &state, &thread_id));
+    CdiOsSleep(TIMEOUT_TEST_MS); // Give the thread time to start waiting.
+    CHECK(CdiOsSignalSet(state.abort_signal));
+    CHECK(CdiOsThreadJoin(thread_id, CDI_INFINITE, NULL));
+    CHECK(state.pass);
+    CHECK(1 == state.signal_index);
+
+    CdiOsSignalDelete(state.abort_signal);
+    CdiOsSignalDelete(state.pong_signal);
+    CdiOsSignalDelete(state.ping_signal);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Log the cost of setting and clearing a signal that no thread is waiting on, and of setting a signal that is already
+ * set.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus SetBenchmark(void)
+{
+    CdiSignalType signal = NULL;
+    CHECK(CdiOsSignalCreate(&signal));
+
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int i = 0; i < SET_BENCHMARK_OP_COUNT; i++) {
+        CdiOsSignalSet(signal);
+        CdiOsSignalClear(signal);
+    }
+    const uint64_t set_clear_elapsed_us = CdiOsGetMicroseconds() - start_time;
+
+    start_time = CdiOsGetMicroseconds();
+    for (int i = 0; i < SET_BENCHMARK_OP_COUNT; i++) {
+        CdiOsSignalSet(signal);
+    }
+    const uint64_t set_elapsed_us = CdiOsGetMicroseconds() - start_time;
+    CdiOsSignalDelete(signal);
+
+    CDI_LOG_THREAD(kLogInfo, "Signal set benchmark: set/clear pair with no waiters [%"PRIu64"]ns, set of an already set "
+                   "signal [%"PRIu64"]ns.", (set_clear_elapsed_us * 1000) / SET_BENCHMARK_OP_COUNT,
+                   (set_elapsed_us * 1000) / SET_BENCHMARK_OP_COUNT);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Log the time taken to wake a thread waiting on a signal, measured by bouncing a pair of signals between two threads.
+ *
+ * @param use_wait_multiple If true, the threads wait using CdiOsSignalsWait() with an abort signal, like the queue
+ *                          functions do. Otherwise CdiOsSignalWait() is used.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus WakeLatencyBenchmark(bool use_wait_multiple)
+{
+    CdiThreadID thread_id = NULL;
+    TestThreadState state = {
+        .use_wait_multiple = use_wait_multiple,
+        .round_trip_count = WAKE_BENCHMARK_ROUND_TRIPS,
+        .pass = true
+    };
+
+    CHECK(CdiOsSignalCreate(&state.ping_signal));
+    CHECK(CdiOsSignalCreate(&state.pong_signal));
+    CHECK(CdiOsSignalCreate(&state.abort_signal));
+    CHECK(StartThread(EchoTestThread, &state, &thread_id));
+
+    CdiSignalType signal_array[] = { state.pong_signal, state.abort_signal };
+    bool pass = true;
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int i = 0; pass && i < WAKE_BENCHMARK_ROUND_TRIPS; i++) {
+        CdiOsSignalSet(state.ping_signal);
+        if (use_wait_multiple) {
+            uint32_t signal_index = 0;
+            pass = CdiOsSignalsWait(signal_array, CDI_ARRAY_ELEMENT_COUNT(signal_array), false, CDI_INFINITE,
+                                    &signal_index) && 0 == signal_index;
+        } else {
+            pass = CdiOsSignalWait(state.pong_signal, CDI_INFINITE, NULL);
+        }
+        CdiOsSignalClear(state.pong_signal);
+    }
+    uint64_t elapsed_us = CdiOsGetMicroseconds() - start_time;
+    CHECK(CdiOsThreadJoin(thread_id, CDI_INFINITE, NULL));
+    CHECK(pass);
+    CHECK(state.pass);
+
+    CdiOsSignalDelete(state.abort_signal);
+    CdiOsSignalDelete(state.pong_signal);
+    CdiOsSignalDelete(state.ping_signal);
+
+    CDI_LOG_THREAD(kLogInfo, "Signal wake latency benchmark (%s): [%d] round trips in [%"PRIu64"]us ([%"PRIu64"]ns "
+                   "one way).", use_wait_multiple ? "CdiOsSignalsWait" : "CdiOsSignalWait",
+                   WAKE_BENCHMARK_ROUND_TRIPS, elapsed_us, (elapsed_us * 1000) / (WAKE_BENCHMARK_ROUND_TRIPS * 2));
+
+    return kCdiStatusOk;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitSignal(void)
+{
+    CdiReturnStatus rs = kCdiStatusOk;
+
+    if (kCdiStatusOk != SingleThreadTest() || kCdiStatusOk != MultipleThreadTest() ||
+        kCdiStatusOk != SetBenchmark() || kCdiStatusOk != WakeLatencyBenchmark(false) ||
+        kCdiStatusOk != WakeLatencyBenchmark(true)) {
+        rs = kCdiStatusFatal;
+    }
+
+    return rs;
+}
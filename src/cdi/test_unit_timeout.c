@@ -54,7 +54,6 @@ static void TimerCallback(const CdiTimeoutCbData* data_ptr)
     uint64_t cb_time = CdiOsGetMicroseconds() / 1000;
     uint64_t success_time_max = (user_data_ptr->expiration_us + 3000) / 1000;
     uint64_t success_time_min = (user_data_ptr->expiration_us - 500) / 1000;
-    CdiOsSignalSet(user_data_ptr->signal);
     if ((cb_time >= success_time_min) && (cb_time <= success_time_max)) {
         user_data_ptr->pass = true;
     } else {
@@ -62,6 +61,8 @@ static void TimerCallback(const CdiTimeoutCbData* data_ptr)
         CDI_LOG_THREAD(kLogInfo, "Callback number[%d] received at time [%u]ms with expiration of[%u]ms",
                        user_data_ptr->callback_number, cb_time, user_data_ptr->expiration_us / 1000);
     }
+    // Set the signal last so the waiting test thread never reads the pass field before it has been written.
+    CdiOsSignalSet(user_data_ptr->signal);
 }
 
 /**
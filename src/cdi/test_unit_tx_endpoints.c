@@ -0,0 +1,490 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains a unit test of Tx stream connections that send payloads to more than one endpoint. A Tx stream
+ * connection using the socket adapter sends video payloads to one endpoint and audio payloads to another endpoint over
+ * the loopback interface. The test checks that all payloads are sent and logs a benchmark of the time taken to send
+ * audio payloads, first with no other traffic on the connection and then while video frames are being sent back to back
+ * on the connection's other endpoint. The benchmark is run with the audio endpoint at normal and at high priority.
+ * Finally, payloads are sent to both endpoints in batches with CdiAvmEndpointTxPayloadMultiple().
+ */
+
+#include "cdi_avm_api.h"
+#include "cdi_core_api.h"
+#include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "utilities_api.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// IP address of the loopback interface, used by the adapter and as the destination of both endpoints.
+#define LOOPBACK_IP_STR                 "127.0.0.1"
+
+/// Destination port of the video endpoint.
+#define VIDEO_DEST_PORT                 (4100)
+
+/// Destination port of the audio endpoint.
+#define AUDIO_DEST_PORT                 (4200)
+
+/// Stream identifier of the video payloads.
+#define VIDEO_STREAM_ID                 (1)
+
+/// Stream identifier of the audio payloads.
+#define AUDIO_STREAM_ID                 (2)
+
+/// @brief Number of payload bytes in a 1080p 4:2:2 10-bit video frame. The Tx packet pools of a socket adapter
+/// connection can't hold the packets of a 2160p frame (the socket adapter's packets are much smaller than EFA's), so
+/// this is the largest standard frame size the test can send.
+#define VIDEO_PAYLOAD_BYTES             (1920 * 1080 * 20 / 8)
+
+/// Maximum number of video frames in flight at one time.
+#define VIDEO_IN_FLIGHT_COUNT           (2)
+
+/// Number of payload bytes in one millisecond of 8 channel 24-bit 48kHz audio.
+#define AUDIO_PAYLOAD_BYTES             (48 * 8 * 3)
+
+/// Time between audio payloads in microseconds.
+#define AUDIO_PERIOD_MICROSECONDS       (2000)
+
+/// Number of audio payloads sent by each pass of the benchmark.
+#define AUDIO_PAYLOAD_COUNT             (250)
+
+/// Maximum number of payloads in flight on the connection, enough for the video frames and several audio payloads.
+#define MAX_IN_FLIGHT_PAYLOADS          (VIDEO_IN_FLIGHT_COUNT + 30)
+
+/// Time to wait before retrying to send a payload when the connection's payload queue is full.
+#define QUEUE_FULL_RETRY_MICROSECONDS   (100)
+
+/// Maximum latency used for all payloads. Set high, so no payloads are reported late.
+#define MAX_LATENCY_MICROSECONDS        (1000000)
+
+/// Time to wait for all payloads of a pass to complete.
+#define PASS_TIMEOUT_MS                 (10000)
+
+/// Number of audio payloads sent with each call to CdiAvmEndpointTxPayloadMultiple().
+#define AUDIO_BATCH_SIZE                (10)
+
+/// @brief Number of descriptors in each call to CdiAvmEndpointTxPayloadMultiple(): a video payload, the audio payloads
+/// and a payload with an invalid endpoint handle.
+#define BATCH_DESCRIPTOR_COUNT          (1 + AUDIO_BATCH_SIZE + 1)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+/**
+ * @brief State shared by the test and the Tx payload callback.
+ */
+typedef struct {
+    uint64_t audio_send_time_array[AUDIO_PAYLOAD_COUNT];    ///< Time each audio payload was sent in microseconds.
+    uint32_t audio_latency_array[AUDIO_PAYLOAD_COUNT];      ///< Time taken to send each audio payload in microseconds.
+    uint32_t audio_done_count;       ///< Number of audio payloads that have completed.
+    uint32_t video_in_flight_count;  ///< Number of video payloads that have been sent but have not completed.
+    uint32_t video_done_count;       ///< Number of video payloads that have completed.
+    uint32_t error_count;            ///< Number of payloads that completed with an error.
+    CdiSignalType done_signal;       ///< Set when all audio payloads of a pass and all video payloads have completed.
+} TxEndpointsTestState;
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+/// State of the test. Static, since the audio arrays are too large for the stack.
+static TxEndpointsTestState test_state;
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Set the done signal if all audio payloads of the pass and all video payloads have completed.
+ *
+ * @param state_ptr Pointer to test state.
+ */
+static void CheckDone(TxEndpointsTestState* state_ptr)
+{
+    if (AUDIO_PAYLOAD_COUNT == CdiOsAtomicLoad32(&state_ptr->audio_done_count) &&
+        0 == CdiOsAtomicLoad32(&state_ptr->video_in_flight_count)) {
+        CdiOsSignalSet(state_ptr->done_signal);
+    }
+}
+
+/**
+ * Tx payload callback. Records the time taken to send each audio payload.
+ *
+ * @param cb_data_ptr Pointer to Tx callback data. The user_cb_param is the index of an audio payload plus one, or zero
+ *                    for a video payload.
+ */
+static void TestTxCallback(const CdiAvmTxCbData* cb_data_ptr)
+{
+    TxEndpointsTestState* state_ptr = &test_state;
+    uint64_t now = CdiOsGetMicroseconds();
+
+    if (kCdiStatusOk != cb_data_ptr->core_cb_data.status_code) {
+        CdiOsAtomicInc32(&state_ptr->error_count);
+    }
+    if (AUDIO_STREAM_ID == cb_data_ptr->avm_extra_data.stream_identifier) {
+        int index = (int)(intptr_t)cb_data_ptr->core_cb_data.user_cb_param - 1;
+        state_ptr->audio_latency_array[index] = (uint32_t)(now - state_ptr->audio_send_time_array[index]);
+        CdiOsAtomicInc32(&state_ptr->audio_done_count);
+    } else {
+        CdiOsAtomicInc32(&state_ptr->video_done_count);
+        CdiOsAtomicDec32(&state_ptr->video_in_flight_count);
+    }
+    CheckDone(state_ptr);
+}
+
+/**
+ * Compare function used with qsort() to sort latencies.
+ *
+ * @param a_ptr Pointer to first latency.
+ * @param b_ptr Pointer to second latency.
+ *
+ * @return Negative, zero or positive value if the first latency is less than, equal to or greater than the second.
+ */
+static int CompareLatency(const void* a_ptr, const void* b_ptr)
+{
+    uint32_t a = *(const uint32_t*)a_ptr;
+    uint32_t b = *(const uint32_t*)b_ptr;
+    return (a > b) - (a < b);
+}
+
+/**
+ * Send a payload to an endpoint.
+ *
+ * @param endpoint_handle Endpoint to send the payload to.
+ * @param stream_id Stream identifier of the payload.
+ * @param user_cb_param Value passed to TestTxCallback().
+ * @param data_ptr Pointer to the payload's data.
+ * @param byte_size Size of the payload in bytes.
+ *
+ * @return Value returned by CdiAvmEndpointTxPayload().
+ */
+static CdiReturnStatus SendPayload(CdiEndpointHandle endpoint_handle, uint16_t stream_id,
+                                   CdiUserCbParameter user_cb_param, void* data_ptr, int byte_size)
+{
+    CdiSglEntry sgl_entry = {
+        .address_ptr = data_ptr,
+        .size_in_bytes = byte_size,
+    };
+    CdiSgList sgl = {
+        .total_data_size = byte_size,
+        .sgl_head_ptr = &sgl_entry,
+        .sgl_tail_ptr = &sgl_entry,
+    };
+    CdiAvmTxPayloadConfig payload_config = {
+        .core_config_data.user_cb_param = user_cb_param,
+        .core_config_data.unit_size = 8,
+        .avm_extra_data.stream_identifier = stream_id
+    };
+    return CdiAvmEndpointTxPayload(endpoint_handle, &payload_config, NULL, &sgl, MAX_LATENCY_MICROSECONDS);
+}
+
+/**
+ * Send AUDIO_PAYLOAD_COUNT audio payloads at a fixed rate and log the time taken to send them. If requested, video
+ * frames are sent back to back at the same time.
+ *
+ * @param video_endpoint_handle Endpoint to send video to.
+ * @param audio_endpoint_handle Endpoint to send audio to.
+ * @param video_data_ptr Pointer to the video payload data.
+ * @param audio_data_ptr Pointer to the audio payload data.
+ * @param with_video If true, video frames are sent while the audio payloads are sent.
+ * @param pass_name_str Name of the pass to log with the results.
+ *
+ * @return kCdiStatusOk if the benchmark ran, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus AudioLatencyBenchmark(CdiEndpointHandle video_endpoint_handle,
+                                             CdiEndpointHandle audio_endpoint_handle, void* video_data_ptr,
+                                             void* audio_data_ptr, bool with_video, const char* pass_name_str)
+{
+    TxEndpointsTestState* state_ptr = &test_state;
+    state_ptr->audio_done_count = 0;
+    state_ptr->video_in_flight_count = 0;
+    state_ptr->video_done_count = 0;
+    state_ptr->error_count = 0;
+    CdiOsSignalClear(state_ptr->done_signal);
+
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int i = 0; i < AUDIO_PAYLOAD_COUNT; i++) {
+        // Keep the video endpoint busy.
+        while (with_video && CdiOsAtomicLoad32(&state_ptr->video_in_flight_count) < VIDEO_IN_FLIGHT_COUNT) {
+            CdiOsAtomicInc32(&state_ptr->video_in_flight_count);
+            if (kCdiStatusOk != SendPayload(video_endpoint_handle, VIDEO_STREAM_ID, NULL, video_data_ptr,
+                                            VIDEO_PAYLOAD_BYTES)) {
+                CdiOsAtomicDec32(&state_ptr->video_in_flight_count);
+                break;
+            }
+        }
+
+        // Send the next audio payload when it is due.
+        uint64_t due_time = start_time + (uint64_t)i * AUDIO_PERIOD_MICROSECONDS;
+        uint64_t now = CdiOsGetMicroseconds();
+        if (now < due_time) {
+            CdiOsSleepMicroseconds((uint32_t)(due_time - now));
+        }
+        // The payload queue is shared by both endpoints, so retry if the video frames have filled it.
+        CdiReturnStatus rs = kCdiStatusQueueFull;
+        state_ptr->audio_send_time_array[i] = CdiOsGetMicroseconds();
+        while (true) {
+            rs = SendPayload(audio_endpoint_handle, AUDIO_STREAM_ID, (CdiUserCbParameter)(intptr_t)(i + 1),
+                             audio_data_ptr, AUDIO_PAYLOAD_BYTES);
+            if (kCdiStatusQueueFull != rs) {
+                break;
+            }
+            CdiOsSleepMicroseconds(QUEUE_FULL_RETRY_MICROSECONDS);
+        }
+        CHECK(kCdiStatusOk == rs);
+    }
+    CheckDone(state_ptr);
+    CHECK(CdiOsSignalWait(state_ptr->done_signal, PASS_TIMEOUT_MS, NULL) &&
+          CdiOsSignalReadState(state_ptr->done_signal));
+    CHECK(0 == state_ptr->error_count);
+    CHECK(!with_video || 0 < state_ptr->video_done_count);
+
+    qsort(state_ptr->audio_latency_array, AUDIO_PAYLOAD_COUNT, sizeof(state_ptr->audio_latency_array[0]),
+          CompareLatency);
+    CDI_LOG_THREAD(kLogInfo, "Tx endpoints benchmark audio [%s]: P50[%"PRIu32"]us P99[%"PRIu32"]us Max[%"PRIu32"]us. "
+                   "Video frames sent[%"PRIu32"].", pass_name_str,
+                   state_ptr->audio_latency_array[AUDIO_PAYLOAD_COUNT / 2],
+                   state_ptr->audio_latency_array[(AUDIO_PAYLOAD_COUNT * 99) / 100],
+                   state_ptr->audio_latency_array[AUDIO_PAYLOAD_COUNT - 1], state_ptr->video_done_count);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Send AUDIO_PAYLOAD_COUNT audio payloads in batches with CdiAvmEndpointTxPayloadMultiple(). Each batch also sends a
+ * small video payload to the video endpoint and contains a payload with an invalid endpoint handle, which must not
+ * prevent the payloads around it from being sent. Each batch is sent once the previous one has completed.
+ *
+ * @param video_endpoint_handle Endpoint to send video to.
+ * @param audio_endpoint_handle Endpoint to send audio to.
+ * @param video_data_ptr Pointer to the video payload data.
+ * @param audio_data_ptr Pointer to the audio payload data.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus TxPayloadMultipleTest(CdiEndpointHandle video_endpoint_handle,
+                                             CdiEndpointHandle audio_endpoint_handle, void* video_data_ptr,
+                                             void* audio_data_ptr)
+{
+    TxEndpointsTestState* state_ptr = &test_state;
+    state_ptr->audio_done_count = 0;
+    state_ptr->video_in_flight_count = 0;
+    state_ptr->video_done_count = 0;
+    state_ptr->error_count = 0;
+    CdiOsSignalClear(state_ptr->done_signal);
+
+    CdiSglEntry video_sgl_entry = {
+        .address_ptr = video_data_ptr,
+        .size_in_bytes = AUDIO_PAYLOAD_BYTES,
+    };
+    CdiSgList video_sgl = {
+        .total_data_size = AUDIO_PAYLOAD_BYTES,
+        .sgl_head_ptr = &video_sgl_entry,
+        .sgl_tail_ptr = &video_sgl_entry,
+    };
+    CdiSglEntry audio_sgl_entry = {
+        .address_ptr = audio_data_ptr,
+        .size_in_bytes = AUDIO_PAYLOAD_BYTES,
+    };
+    CdiSgList audio_sgl = {
+        .total_data_size = AUDIO_PAYLOAD_BYTES,
+        .sgl_head_ptr = &audio_sgl_entry,
+        .sgl_tail_ptr = &audio_sgl_entry,
+    };
+    CdiAvmTxPayloadConfig payload_config_array[BATCH_DESCRIPTOR_COUNT];
+    CdiAvmTxPayloadDescriptor descriptor_array[BATCH_DESCRIPTOR_COUNT];
+    CdiReturnStatus status_array[BATCH_DESCRIPTOR_COUNT];
+
+    for (int first = 0; first < AUDIO_PAYLOAD_COUNT; first += AUDIO_BATCH_SIZE) {
+        memset(payload_config_array, 0, sizeof(payload_config_array));
+        for (int i = 0; i < BATCH_DESCRIPTOR_COUNT; i++) {
+            bool video = 0 == i;
+            payload_config_array[i].core_config_data.unit_size = 8;
+            payload_config_array[i].avm_extra_data.stream_identifier = video ? VIDEO_STREAM_ID : AUDIO_STREAM_ID;
+            descriptor_array[i] = (CdiAvmTxPayloadDescriptor) {
+                .endpoint_handle = video ? video_endpoint_handle : audio_endpoint_handle,
+                .payload_config_ptr = &payload_config_array[i],
+                .avm_config_ptr = NULL,
+                .sgl_ptr = video ? &video_sgl : &audio_sgl,
+                .max_latency_microsecs = MAX_LATENCY_MICROSECONDS
+            };
+            if (!video && i <= AUDIO_BATCH_SIZE) {
+                int index = first + i - 1;
+                payload_config_array[i].core_config_data.user_cb_param = (CdiUserCbParameter)(intptr_t)(index + 1);
+                state_ptr->audio_send_time_array[index] = CdiOsGetMicroseconds();
+            }
+        }
+        descriptor_array[BATCH_DESCRIPTOR_COUNT - 1].endpoint_handle = NULL;
+        CdiOsAtomicInc32(&state_ptr->video_in_flight_count);
+
+        CHECK(kCdiStatusInvalidHandle == CdiAvmEndpointTxPayloadMultiple(descriptor_array, BATCH_DESCRIPTOR_COUNT,
+                                                                          status_array));
+        for (int i = 0; i < BATCH_DESCRIPTOR_COUNT - 1; i++) {
+            CHECK(kCdiStatusOk == status_array[i]);
+        }
+        CHECK(kCdiStatusInvalidHandle == status_array[BATCH_DESCRIPTOR_COUNT - 1]);
+
+        // Wait for the batch to complete, so the next one fits in the connection's payload queue.
+        uint64_t timeout_time = CdiOsGetMicroseconds() + PASS_TIMEOUT_MS * 1000ULL;
+        while ((CdiOsAtomicLoad32(&state_ptr->audio_done_count) < (uint32_t)(first + AUDIO_BATCH_SIZE) ||
+                0 != CdiOsAtomicLoad32(&state_ptr->video_in_flight_count)) && CdiOsGetMicroseconds() < timeout_time) {
+            CdiOsSleepMicroseconds(QUEUE_FULL_RETRY_MICROSECONDS);
+        }
+    }
+    CheckDone(state_ptr);
+    CHECK(CdiOsSignalWait(state_ptr->done_signal, PASS_TIMEOUT_MS, NULL) &&
+          CdiOsSignalReadState(state_ptr->done_signal));
+    CHECK(0 == state_ptr->error_count);
+    CHECK(AUDIO_PAYLOAD_COUNT / AUDIO_BATCH_SIZE == state_ptr->video_done_count);
+
+    qsort(state_ptr->audio_latency_array, AUDIO_PAYLOAD_COUNT, sizeof(state_ptr->audio_latency_array[0]),
+          CompareLatency);
+    CDI_LOG_THREAD(kLogInfo, "Tx endpoints benchmark audio [batches of %d]: P50[%"PRIu32"]us P99[%"PRIu32"]us "
+                   "Max[%"PRIu32"]us.", AUDIO_BATCH_SIZE, state_ptr->audio_latency_array[AUDIO_PAYLOAD_COUNT / 2],
+                   state_ptr->audio_latency_array[(AUDIO_PAYLOAD_COUNT * 99) / 100],
+                   state_ptr->audio_latency_array[AUDIO_PAYLOAD_COUNT - 1]);
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Create a socket adapter and a Tx stream connection with a video and an audio endpoint, then run the audio latency
+ * benchmark with video and, if the audio endpoint has normal priority, without video and with batched payloads. Sockets
+ * are bound to the endpoints' destination ports, so the datagrams have somewhere to go. They are never read, so
+ * datagrams are dropped once the sockets' buffers are full.
+ *
+ * @param audio_priority Priority of the audio endpoint.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus RunTxEndpointsTest(CdiTxPriority audio_priority)
+{
+    CdiReturnStatus rs = kCdiStatusOk;
+    CdiSocket video_socket = 0;
+    CdiSocket audio_socket = 0;
+    CHECK(CdiOsSocketOpen(NULL, VIDEO_DEST_PORT, LOOPBACK_IP_STR, &video_socket));
+    CHECK(CdiOsSocketOpen(NULL, AUDIO_DEST_PORT, LOOPBACK_IP_STR, &audio_socket));
+
+    CdiAdapterData adapter_data = {
+        .adapter_ip_addr_str = LOOPBACK_IP_STR,
+        .tx_buffer_size_bytes = VIDEO_PAYLOAD_BYTES + AUDIO_PAYLOAD_BYTES,
+        .ret_tx_buffer_ptr = NULL,
+        .adapter_type = kCdiAdapterTypeSocket
+    };
+    CdiAdapterHandle adapter_handle = NULL;
+    CHECK(kCdiStatusOk == CdiCoreNetworkAdapterInitialize(&adapter_data, &adapter_handle));
+    uint8_t* video_data_ptr = adapter_data.ret_tx_buffer_ptr;
+    uint8_t* audio_data_ptr = video_data_ptr + VIDEO_PAYLOAD_BYTES;
+
+    CdiLogMethodData log_method_data = {
+        .log_method = kLogMethodStdout
+    };
+    CdiTxConfigData config_data = {
+        .adapter_handle = adapter_handle,
+        .thread_core_num = -1,
+        .connection_log_method_data_ptr = &log_method_data,
+        .max_simultaneous_tx_payloads = MAX_IN_FLIGHT_PAYLOADS,
+        .stats_config.disable_cloudwatch_stats = true,
+    };
+    CdiConnectionHandle connection_handle = NULL;
+    CdiEndpointHandle video_endpoint_handle = NULL;
+    CdiEndpointHandle audio_endpoint_handle = NULL;
+    if (kCdiStatusOk == rs) {
+        rs = CdiAvmTxStreamConnectionCreate(&config_data, TestTxCallback, &connection_handle);
+    }
+    if (kCdiStatusOk == rs) {
+        CdiTxConfigDataStream stream_config = {
+            .dest_ip_addr_str = LOOPBACK_IP_STR,
+            .dest_port = VIDEO_DEST_PORT,
+            .stream_name_str = "video"
+        };
+        rs = CdiAvmTxStreamEndpointCreate(connection_handle, &stream_config, &video_endpoint_handle);
+    }
+    if (kCdiStatusOk == rs) {
+        CdiTxConfigDataStream stream_config = {
+            .dest_ip_addr_str = LOOPBACK_IP_STR,
+            .dest_port = AUDIO_DEST_PORT,
+            .stream_name_str = "audio",
+            .priority = audio_priority
+        };
+        rs = CdiAvmTxStreamEndpointCreate(connection_handle, &stream_config, &audio_endpoint_handle);
+    }
+    bool high_priority = kCdiTxPriorityHigh == audio_priority;
+    if (kCdiStatusOk == rs && !high_priority) {
+        rs = AudioLatencyBenchmark(video_endpoint_handle, audio_endpoint_handle, video_data_ptr, audio_data_ptr,
+                                   false, "alone");
+    }
+    if (kCdiStatusOk == rs) {
+        rs = AudioLatencyBenchmark(video_endpoint_handle, audio_endpoint_handle, video_data_ptr, audio_data_ptr, true,
+                                   high_priority ? "high priority with video" : "with video");
+    }
+    if (kCdiStatusOk == rs && !high_priority) {
+        rs = TxPayloadMultipleTest(video_endpoint_handle, audio_endpoint_handle, video_data_ptr, audio_data_ptr);
+    }
+
+    if (connection_handle) {
+        CdiCoreConnectionDestroy(connection_handle);
+    }
+    CdiCoreNetworkAdapterDestroy(adapter_handle);
+    CdiOsSocketClose(audio_socket);
+    CdiOsSocketClose(video_socket);
+
+    return rs;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitTxEndpoints(void)
+{
+    CdiLogMethodData log_method_data = {
+        .log_method = kLogMethodStdout
+    };
+    CdiCoreConfigData core_config = {
+        .default_log_level = kLogInfo,
+        .global_log_method_data_ptr = &log_method_data,
+        .cloudwatch_config_ptr = NULL
+    };
+    CHECK(kCdiStatusOk == CdiCoreInitialize(&core_config));
+    CHECK(CdiOsSignalCreate(&test_state.done_signal));
+
+    CdiReturnStatus rs = RunTxEndpointsTest(kCdiTxPriorityNormal);
+    if (kCdiStatusOk == rs) {
+        rs = RunTxEndpointsTest(kCdiTxPriorityHigh);
+    }
+
+    CdiOsSignalDelete(test_state.done_signal);
+    test_state.done_signal = NULL;
+    CdiCoreShutdown();
+
+    return rs;
+}
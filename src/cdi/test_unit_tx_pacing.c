@@ -0,0 +1,335 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains a unit test of the Tx packet pacer (see CdiTxPacingConfig). A Tx stream connection using the
+ * socket adapter sends video frames at a fixed frame rate over the loopback interface to a socket that is read by a
+ * receiver thread, first without pacing and then with the packets of each frame spread over part of the frame
+ * interval. The test checks that paced frames are spread as configured and logs a benchmark of the frame transfer time,
+ * the number of packets sent in each burst, the percentage of packets the receiver dropped and the CPU time used by the
+ * process, which drops when pacing lets the poll thread sleep between packets.
+ */
+
+#include "cdi_avm_api.h"
+#include "cdi_core_api.h"
+#include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "private.h"
+#include "utilities_api.h"
+
+#include <inttypes.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// IP address of the loopback interface, used by the adapter and as the destination of the endpoint.
+#define LOOPBACK_IP_STR                 "127.0.0.1"
+
+/// Destination port of the endpoint.
+#define DEST_PORT                       (4300)
+
+/// @brief Number of payload bytes in a 720p 4:2:2 10-bit video frame. Small enough that the socket adapter can send a
+/// frame well within the frame interval on a single CPU core, so pacing is not limited by the CPU.
+#define FRAME_BYTES                     (1280 * 720 * 20 / 8)
+
+/// Number of frames sent by each pass of the benchmark.
+#define FRAME_COUNT                     (30)
+
+/// Time between frames in microseconds (60 frames per second). Also used as the frames' maximum latency.
+#define FRAME_INTERVAL_MICROSECONDS     (16667)
+
+/// Percentage of the frame interval over which the packets of a paced frame are spread.
+#define PACING_LATENCY_PERCENT          (80)
+
+/// Time to wait for a frame to complete.
+#define FRAME_TIMEOUT_MS                (1000)
+
+/// Largest datagram the receiver can read.
+#define MAX_DATAGRAM_BYTES              (65536)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+/**
+ * @brief State shared by the test, the Tx payload callback and the receiver thread.
+ */
+typedef struct {
+    uint64_t send_time;               ///< Time the frame in flight was sent in microseconds.
+    uint64_t frame_time_sum;          ///< Sum of the frame transfer times of the pass in microseconds.
+    uint32_t frame_time_min;          ///< Shortest frame transfer time of the pass in microseconds.
+    uint32_t frame_time_max;          ///< Longest frame transfer time of the pass in microseconds.
+    int error_count;                  ///< Number of frames that completed with an error.
+    CdiSignalType frame_done_signal;  ///< Set when the frame in flight has completed.
+
+    CdiSocket rx_socket;              ///< Socket the receiver thread reads the datagrams from.
+    uint64_t rx_datagram_count;       ///< Number of datagrams read by the receiver thread.
+    CdiSignalType rx_stop_signal;     ///< Set to stop the receiver thread.
+    CdiSignalType rx_done_signal;     ///< Set by the receiver thread when it exits.
+    uint8_t datagram_buffer[MAX_DATAGRAM_BYTES]; ///< Buffer the receiver thread reads datagrams into.
+} TxPacingTestState;
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+/// State of the test. Static, since the datagram buffer is too large for the stack.
+static TxPacingTestState test_state;
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Tx payload callback. Records the time taken to send the frame.
+ *
+ * @param cb_data_ptr Pointer to Tx callback data.
+ */
+static void TestTxCallback(const CdiAvmTxCbData* cb_data_ptr)
+{
+    TxPacingTestState* state_ptr = &test_state;
+    uint32_t frame_time = (uint32_t)(CdiOsGetMicroseconds() - state_ptr->send_time);
+
+    if (kCdiStatusOk != cb_data_ptr->core_cb_data.status_code) {
+        state_ptr->error_count++;
+    }
+    state_ptr->frame_time_sum += frame_time;
+    if (0 == state_ptr->frame_time_min || frame_time < state_ptr->frame_time_min) {
+        state_ptr->frame_time_min = frame_time;
+    }
+    if (frame_time > state_ptr->frame_time_max) {
+        state_ptr->frame_time_max = frame_time;
+    }
+    CdiOsSignalSet(state_ptr->frame_done_signal);
+}
+
+/**
+ * Thread that counts the datagrams received by the endpoint's destination socket.
+ *
+ * @param arg_ptr Pointer to test state.
+ *
+ * @return The return value is not used.
+ */
+static CDI_THREAD ReceiverThread(void* arg_ptr)
+{
+    TxPacingTestState* state_ptr = (TxPacingTestState*)arg_ptr;
+
+    while (!CdiOsSignalReadState(state_ptr->rx_stop_signal)) {
+        int byte_count = sizeof(state_ptr->datagram_buffer);
+        if (CdiOsSocketRead(state_ptr->rx_socket, state_ptr->datagram_buffer, &byte_count) && byte_count) {
+            state_ptr->rx_datagram_count++;
+        }
+    }
+    CdiOsSignalSet(state_ptr->rx_done_signal);
+
+    return 0; // Return code not used.
+}
+
+/**
+ * Create a Tx stream connection with the specified pacing configuration, send FRAME_COUNT frames at a fixed frame rate
+ * and log the results.
+ *
+ * @param adapter_handle Handle of the socket adapter.
+ * @param frame_data_ptr Pointer to the frame data.
+ * @param pacing_ptr Pointer to the pacing configuration of the connection.
+ * @param pass_name_str Name of the pass to log with the results.
+ *
+ * @return kCdiStatusOk if the pass succeeded, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus PacingBenchmark(CdiAdapterHandle adapter_handle, void* frame_data_ptr,
+                                       const CdiTxPacingConfig* pacing_ptr, const char* pass_name_str)
+{
+    TxPacingTestState* state_ptr = &test_state;
+    state_ptr->frame_time_sum = 0;
+    state_ptr->frame_time_min = 0;
+    state_ptr->frame_time_max = 0;
+    state_ptr->error_count = 0;
+    state_ptr->rx_datagram_count = 0;
+
+    CdiLogMethodData log_method_data = {
+        .log_method = kLogMethodStdout
+    };
+    CdiTxConfigData config_data = {
+        .adapter_handle = adapter_handle,
+        .thread_core_num = -1,
+        .connection_log_method_data_ptr = &log_method_data,
+        .stats_config.disable_cloudwatch_stats = true,
+        .pacing = *pacing_ptr
+    };
+    CdiConnectionHandle connection_handle = NULL;
+    CHECK(kCdiStatusOk == CdiAvmTxStreamConnectionCreate(&config_data, TestTxCallback, &connection_handle));
+
+    CdiReturnStatus rs = kCdiStatusOk;
+    CdiTxConfigDataStream stream_config = {
+        .dest_ip_addr_str = LOOPBACK_IP_STR,
+        .dest_port = DEST_PORT,
+        .stream_name_str = "video"
+    };
+    CdiEndpointHandle endpoint_handle = NULL;
+    rs = CdiAvmTxStreamEndpointCreate(connection_handle, &stream_config, &endpoint_handle);
+
+    CdiSglEntry sgl_entry = {
+        .address_ptr = frame_data_ptr,
+        .size_in_bytes = FRAME_BYTES,
+    };
+    CdiSgList sgl = {
+        .total_data_size = FRAME_BYTES,
+        .sgl_head_ptr = &sgl_entry,
+        .sgl_tail_ptr = &sgl_entry,
+    };
+    CdiAvmTxPayloadConfig payload_config = {
+        .core_config_data.unit_size = 8,
+        .avm_extra_data.stream_identifier = 1
+    };
+    clock_t start_cpu_time = clock();
+    uint64_t start_time = CdiOsGetMicroseconds();
+    for (int i = 0; kCdiStatusOk == rs && i < FRAME_COUNT; i++) {
+        // Send the next frame when it is due.
+        uint64_t due_time = start_time + (uint64_t)i * FRAME_INTERVAL_MICROSECONDS;
+        uint64_t now = CdiOsGetMicroseconds();
+        if (now < due_time) {
+            CdiOsSleepMicroseconds((uint32_t)(due_time - now));
+        }
+        CdiOsSignalClear(state_ptr->frame_done_signal);
+        state_ptr->send_time = CdiOsGetMicroseconds();
+        rs = CdiAvmEndpointTxPayload(endpoint_handle, &payload_config, NULL, &sgl, FRAME_INTERVAL_MICROSECONDS);
+        if (kCdiStatusOk == rs && !CdiOsSignalWait(state_ptr->frame_done_signal, FRAME_TIMEOUT_MS, NULL)) {
+            rs = kCdiStatusFatal;
+        }
+    }
+    uint64_t elapsed_us = CdiOsGetMicroseconds() - start_time;
+    uint64_t cpu_us = (uint64_t)(clock() - start_cpu_time) * 1000000 / CLOCKS_PER_SEC;
+    // Give the receiver time to read the last datagrams.
+    CdiOsSleepMicroseconds(FRAME_INTERVAL_MICROSECONDS);
+
+    const CdiAdapterEndpointStats* endpoint_stats_ptr = NULL;
+    if (endpoint_handle) {
+        endpoint_stats_ptr = &endpoint_handle->transfer_stats.endpoint_stats;
+    }
+    uint64_t packet_count = endpoint_stats_ptr ? endpoint_stats_ptr->tx_packet_count : 0;
+    uint64_t delay_count = endpoint_stats_ptr ? endpoint_stats_ptr->tx_pacing_delay_count : 0;
+    if (kCdiStatusOk == rs) {
+        // Each frame starts a new burst and each delay ends one.
+        uint64_t burst_count = FRAME_COUNT + delay_count;
+        uint64_t dropped_count = packet_count > state_ptr->rx_datagram_count ?
+                                 packet_count - state_ptr->rx_datagram_count : 0;
+        CDI_LOG_THREAD(kLogInfo, "Tx pacing benchmark [%s]: Frame time Avg[%"PRIu64"]us Min[%"PRIu32"]us "
+                       "Max[%"PRIu32"]us. Packets[%"PRIu64"] Avg burst[%"PRIu64"] packets. Rx dropped[%"PRIu64"]%%. "
+                       "Process CPU[%"PRIu64"]%% of a core.",
+                       pass_name_str, state_ptr->frame_time_sum / FRAME_COUNT, state_ptr->frame_time_min,
+                       state_ptr->frame_time_max, packet_count, packet_count / burst_count,
+                       packet_count ? (dropped_count * 100) / packet_count : 0,
+                       elapsed_us ? (cpu_us * 100) / elapsed_us : 0);
+    }
+    CdiCoreConnectionDestroy(connection_handle);
+
+    CHECK(kCdiStatusOk == rs);
+    CHECK(0 == state_ptr->error_count);
+    CHECK(0 < packet_count);
+    if (pacing_ptr->latency_percent) {
+        // The pacer must not let the last packet of a frame go out before its data could have been sent at the paced
+        // rate, less the first burst.
+        uint32_t spread_time = (FRAME_INTERVAL_MICROSECONDS * PACING_LATENCY_PERCENT) / 100;
+        CHECK(state_ptr->frame_time_min >= (spread_time * 9) / 10);
+        CHECK(0 < delay_count);
+    } else {
+        CHECK(0 == delay_count);
+    }
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Create a socket adapter and a receiver thread, then run the pacing benchmark without and with pacing.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus RunTxPacingTest(void)
+{
+    TxPacingTestState* state_ptr = &test_state;
+    CHECK(CdiOsSocketOpen(NULL, DEST_PORT, LOOPBACK_IP_STR, &state_ptr->rx_socket));
+
+    CdiThreadID rx_thread_id;
+    CHECK(CdiOsThreadCreate(ReceiverThread, &rx_thread_id, "PacingRx", state_ptr, NULL));
+
+    CdiAdapterData adapter_data = {
+        .adapter_ip_addr_str = LOOPBACK_IP_STR,
+        .tx_buffer_size_bytes = FRAME_BYTES,
+        .ret_tx_buffer_ptr = NULL,
+        .adapter_type = kCdiAdapterTypeSocket
+    };
+    CdiAdapterHandle adapter_handle = NULL;
+    CdiReturnStatus rs = CdiCoreNetworkAdapterInitialize(&adapter_data, &adapter_handle);
+
+    if (kCdiStatusOk == rs) {
+        CdiTxPacingConfig pacing = { 0 };
+        rs = PacingBenchmark(adapter_handle, adapter_data.ret_tx_buffer_ptr, &pacing, "not paced");
+    }
+    if (kCdiStatusOk == rs) {
+        CdiTxPacingConfig pacing = {
+            .latency_percent = PACING_LATENCY_PERCENT
+        };
+        rs = PacingBenchmark(adapter_handle, adapter_data.ret_tx_buffer_ptr, &pacing, "paced");
+    }
+
+    if (adapter_handle) {
+        CdiCoreNetworkAdapterDestroy(adapter_handle);
+    }
+    // Wait for the receiver thread to exit before joining, so CdiOsThreadJoin() doesn't prevent it from running.
+    CdiOsSignalSet(state_ptr->rx_stop_signal);
+    CdiOsSignalWait(state_ptr->rx_done_signal, CDI_INFINITE, NULL);
+    CdiOsThreadJoin(rx_thread_id, CDI_INFINITE, NULL);
+    CdiOsSocketClose(state_ptr->rx_socket);
+
+    return rs;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitTxPacing(void)
+{
+    CdiLogMethodData log_method_data = {
+        .log_method = kLogMethodStdout
+    };
+    CdiCoreConfigData core_config = {
+        .default_log_level = kLogInfo,
+        .global_log_method_data_ptr = &log_method_data,
+        .cloudwatch_config_ptr = NULL
+    };
+    CHECK(kCdiStatusOk == CdiCoreInitialize(&core_config));
+    CHECK(CdiOsSignalCreate(&test_state.frame_done_signal));
+    CHECK(CdiOsSignalCreate(&test_state.rx_stop_signal));
+    CHECK(CdiOsSignalCreate(&test_state.rx_done_signal));
+
+    CdiReturnStatus rs = RunTxPacingTest();
+
+    CdiOsSignalDelete(test_state.rx_done_signal);
+    CdiOsSignalDelete(test_state.rx_stop_signal);
+    CdiOsSignalDelete(test_state.frame_done_signal);
+    CdiCoreShutdown();
+
+    return rs;
+}
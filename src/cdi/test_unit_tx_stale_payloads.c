@@ -0,0 +1,493 @@
+// -------------------------------------------------------------------------------------------
+// Copyright Amazon.com Inc. or its affiliates. All Rights Reserved.
+// This file is part of the AWS CDI-SDK, licensed under the BSD 2-Clause "Simplified" License.
+// License details at: https://github.com/aws/aws-cdi-sdk/blob/mainline/LICENSE
+// -------------------------------------------------------------------------------------------
+
+/**
+ * @file
+ * @brief
+ * This file contains a unit test of the Tx stale payload policy (see CdiTxStalePayloadConfig) and of the functions that
+ * cancel and replace queued Tx payloads. A Tx stream connection using the socket adapter sends a burst of frames, faster
+ * than its packet pacer lets them out, over the loopback interface. The test checks that every frame is sent when no
+ * policy is set, that only the newest frame of each stream is sent after a backlog when superseded frames are skipped
+ * or when frames are sent with CdiAvmEndpointTxPayloadReplace(), that frames that can't meet their deadline are skipped
+ * when late frames are skipped and that CdiCoreTxPayloadCancel() cancels a queued frame, but not a frame sent with the
+ * same user callback parameter after it returns. Skipped frames must complete with kCdiStatusTxPayloadStale and
+ * cancelled or replaced ones with kCdiStatusTxPayloadCancelled. The last passes send
+ * many small frames with several in flight, so that frames are skipped, replaced or cancelled while the poll thread
+ * completes the frames it has sent, and check that every frame completes exactly once.
+ */
+
+#include "cdi_avm_api.h"
+#include "cdi_core_api.h"
+#include "cdi_logger_api.h"
+#include "cdi_os_api.h"
+#include "utilities_api.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+//*********************************************************************************************************************
+//***************************************** START OF DEFINITIONS AND TYPES ********************************************
+//*********************************************************************************************************************
+
+/// IP address of the loopback interface, used by the adapter and as the destination of the endpoint.
+#define LOOPBACK_IP_STR                 "127.0.0.1"
+
+/// Destination port of the endpoint.
+#define DEST_PORT                       (4310)
+
+/// Number of payload bytes in each frame.
+#define FRAME_BYTES                     (100000)
+
+/// Number of frames sent back to back by each pass.
+#define FRAME_COUNT                     (8)
+
+/// Maximum number of bytes the pacer sends back to back.
+#define PACING_BURST_BYTES              (10000)
+
+/// Pacing rate, which sends the data of a frame that follows the first burst in 5 milliseconds.
+#define PACING_RATE_BITS_PER_SECOND     ((uint64_t)(FRAME_BYTES - PACING_BURST_BYTES) * 8 * 1000 / 5)
+
+/// @brief Maximum latency of the frames sent by the pass that skips late frames. The first frames can be sent in time,
+/// the frames at the end of the burst can't.
+#define LATE_FRAME_MAX_LATENCY_MICROSECONDS (20000)
+
+/// Number of frames sent by the passes that skip frames while other frames complete.
+#define CONCURRENT_FRAME_COUNT          (2000)
+
+/// Number of payload bytes in each frame sent by the passes that skip frames while other frames complete.
+#define CONCURRENT_FRAME_BYTES          (2000)
+
+/// Number of streams the frames sent by the passes that skip frames while other frames complete are spread over.
+#define CONCURRENT_STREAM_COUNT         (4)
+
+/// Number of payloads in flight for the passes that skip frames while other frames complete.
+#define CONCURRENT_IN_FLIGHT_PAYLOADS   (8)
+
+/// Interval, in frames, at which the pass that cancels frames while other frames complete cancels the previous frame.
+#define CONCURRENT_CANCEL_INTERVAL      (5)
+
+/// Time to wait for all the frames of a pass to complete.
+#define PASS_TIMEOUT_MS                 (5000)
+
+/**
+ * This macro performs a test. Call it with a conditional expression that must be true in order for the unit test to
+ * pass.
+ */
+#define CHECK(condition) \
+    do { \
+        if (condition) { \
+            if (verbose) CDI_LOG_THREAD(kLogInfo, "%s OK", #condition); \
+        } else { \
+            CDI_LOG_THREAD(kLogError, "%s failed", #condition); \
+            return kCdiStatusFatal; \
+        } \
+    } while (false);
+
+/**
+ * @brief State shared by the test and the Tx payload callback.
+ */
+typedef struct {
+    CdiReturnStatus status_array[CONCURRENT_FRAME_COUNT]; ///< Completion status of each frame of the pass.
+    int completion_count_array[CONCURRENT_FRAME_COUNT];   ///< Number of times each frame of the pass has completed.
+    int frame_count;                                      ///< Number of frames sent by the pass.
+    int completed_count;                                  ///< Number of frames of the pass that have completed.
+    int cancelled_count;                                  ///< Number of frames of the pass that were cancelled.
+    CdiSignalType pass_done_signal;                       ///< Set when all the frames of the pass have completed.
+} TxStaleTestState;
+
+//*********************************************************************************************************************
+//*********************************************** START OF VARIABLES **************************************************
+//*********************************************************************************************************************
+
+static const bool verbose = false;  ///< Set to true to see passing test results.
+
+/// State of the test.
+static TxStaleTestState test_state;
+
+//*********************************************************************************************************************
+//******************************************* START OF STATIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+/**
+ * Tx payload callback. Records the completion status of the frame, whose index is the user callback parameter.
+ *
+ * @param cb_data_ptr Pointer to Tx callback data.
+ */
+static void TestTxCallback(const CdiAvmTxCbData* cb_data_ptr)
+{
+    TxStaleTestState* state_ptr = &test_state;
+    int frame_index = (int)(uintptr_t)cb_data_ptr->core_cb_data.user_cb_param;
+
+    state_ptr->status_array[frame_index] = cb_data_ptr->core_cb_data.status_code;
+    state_ptr->completion_count_array[frame_index]++;
+    if (kCdiStatusTxPayloadCancelled == cb_data_ptr->core_cb_data.status_code) {
+        state_ptr->cancelled_count++;
+    }
+    if (state_ptr->frame_count == ++state_ptr->completed_count) {
+        CdiOsSignalSet(state_ptr->pass_done_signal);
+    }
+}
+
+/**
+ * Reset the state shared with the Tx payload callback for a new pass.
+ *
+ * @param frame_count Number of frames sent by the pass.
+ */
+static void PassStart(int frame_count)
+{
+    TxStaleTestState* state_ptr = &test_state;
+    memset(state_ptr->completion_count_array, 0, sizeof(state_ptr->completion_count_array));
+    state_ptr->frame_count = frame_count;
+    state_ptr->completed_count = 0;
+    state_ptr->cancelled_count = 0;
+    CdiOsSignalClear(state_ptr->pass_done_signal);
+}
+
+/**
+ * Create a Tx stream connection with the specified stale payload policy and send FRAME_COUNT frames back to back,
+ * alternating between two streams if stream_count is 2. Then wait for all of them to complete. The connection's
+ * resources are sized for a single frame in flight, so the frames that follow wait for the pacer in the connection's
+ * payload thread.
+ *
+ * @param adapter_handle Handle of the socket adapter.
+ * @param frame_data_ptr Pointer to the frame data.
+ * @param stale_payloads_ptr Pointer to the stale payload configuration of the connection.
+ * @param stream_count Number of streams (1 or 2) the frames are sent to.
+ * @param max_latency_microsecs Maximum latency of the frames.
+ * @param replace If true, frames are sent with CdiAvmEndpointTxPayloadReplace().
+ * @param cancel_frame_index Index of a frame to cancel once all have been sent, or -1 to not cancel a frame.
+ * @param resend_cancelled If true, the cancelled frame is sent again, with the same user callback parameter, once the
+ *                         cancel request has been made. Its status replaces the status of the cancelled frame.
+ * @param ret_skipped_count_ptr Pointer to returned number of frames that were not sent.
+ *
+ * @return kCdiStatusOk if all the frames completed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus SendFrames(CdiAdapterHandle adapter_handle, void* frame_data_ptr,
+                                  const CdiTxStalePayloadConfig* stale_payloads_ptr, int stream_count,
+                                  int max_latency_microsecs, bool replace, int cancel_frame_index,
+                                  bool resend_cancelled, int* ret_skipped_count_ptr)
+{
+    TxStaleTestState* state_ptr = &test_state;
+    PassStart(resend_cancelled ? FRAME_COUNT + 1 : FRAME_COUNT);
+
+    CdiLogMethodData log_method_data = {
+        .log_method = kLogMethodStdout
+    };
+    CdiTxConfigData config_data = {
+        .adapter_handle = adapter_handle,
+        .thread_core_num = -1,
+        .max_simultaneous_tx_payloads = FRAME_COUNT * 2, // Room for all the frames in the payload queue.
+        .connection_log_method_data_ptr = &log_method_data,
+        .stats_config.disable_cloudwatch_stats = true,
+        .pacing.rate_bits_per_second = PACING_RATE_BITS_PER_SECOND,
+        .pacing.burst_bytes = PACING_BURST_BYTES,
+        .resource_profile.max_payload_byte_size = FRAME_BYTES,
+        .resource_profile.max_in_flight_payloads = 1,
+        .stale_payloads = *stale_payloads_ptr
+    };
+    CdiConnectionHandle connection_handle = NULL;
+    CHECK(kCdiStatusOk == CdiAvmTxStreamConnectionCreate(&config_data, TestTxCallback, &connection_handle));
+
+    CdiTxConfigDataStream stream_config = {
+        .dest_ip_addr_str = LOOPBACK_IP_STR,
+        .dest_port = DEST_PORT,
+        .stream_name_str = "video"
+    };
+    CdiEndpointHandle endpoint_handle = NULL;
+    CdiReturnStatus rs = CdiAvmTxStreamEndpointCreate(connection_handle, &stream_config, &endpoint_handle);
+
+    CdiSglEntry sgl_entry = {
+        .address_ptr = frame_data_ptr,
+        .size_in_bytes = FRAME_BYTES,
+    };
+    CdiSgList sgl = {
+        .total_data_size = FRAME_BYTES,
+        .sgl_head_ptr = &sgl_entry,
+        .sgl_tail_ptr = &sgl_entry,
+    };
+    // The cancelled frame is sent again after the others if resend_cancelled is true.
+    const int send_count = resend_cancelled ? FRAME_COUNT + 1 : FRAME_COUNT;
+    for (int i = 0; kCdiStatusOk == rs && i < send_count; i++) {
+        const int frame_index = (i < FRAME_COUNT) ? i : cancel_frame_index;
+        CdiAvmTxPayloadConfig payload_config = {
+            .core_config_data.unit_size = 8,
+            .core_config_data.user_cb_param = (CdiUserCbParameter)(uintptr_t)frame_index,
+            .avm_extra_data.stream_identifier = (uint16_t)(1 + frame_index % stream_count)
+        };
+        if (replace) {
+            rs = CdiAvmEndpointTxPayloadReplace(endpoint_handle, &payload_config, NULL, &sgl, max_latency_microsecs);
+        } else {
+            rs = CdiAvmEndpointTxPayload(endpoint_handle, &payload_config, NULL, &sgl, max_latency_microsecs);
+        }
+        if (kCdiStatusOk == rs && FRAME_COUNT - 1 == i && -1 != cancel_frame_index) {
+            rs = CdiCoreTxPayloadCancel(connection_handle, (CdiUserCbParameter)(uintptr_t)cancel_frame_index);
+        }
+    }
+    if (kCdiStatusOk == rs && !CdiOsSignalWait(state_ptr->pass_done_signal, PASS_TIMEOUT_MS, NULL)) {
+        rs = kCdiStatusFatal;
+    }
+    CdiCoreConnectionDestroy(connection_handle);
+    CHECK(kCdiStatusOk == rs);
+
+    int skipped_count = 0;
+    for (int i = 0; i < FRAME_COUNT; i++) {
+        CdiReturnStatus status = state_ptr->status_array[i];
+        CHECK(kCdiStatusOk == status || kCdiStatusTxPayloadStale == status || kCdiStatusTxPayloadCancelled == status);
+        if (kCdiStatusOk != status) {
+            skipped_count++;
+        }
+    }
+    *ret_skipped_count_ptr = skipped_count;
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Create a Tx stream connection and send CONCURRENT_FRAME_COUNT small frames back to back, spread over
+ * CONCURRENT_STREAM_COUNT streams. Several frames are in flight, so the payload thread skips, replaces or cancels frames
+ * while the poll thread completes the frames it has sent. Both push to the application's payload callback queue, which
+ * must not lose or duplicate a completion.
+ *
+ * @param adapter_handle Handle of the socket adapter.
+ * @param frame_data_ptr Pointer to the frame data.
+ * @param skip_superseded If true, the connection skips superseded frames.
+ * @param replace If true, frames are sent with CdiAvmEndpointTxPayloadReplace().
+ * @param cancel If true, every CONCURRENT_CANCEL_INTERVAL frames the previous frame is cancelled.
+ * @param ret_skipped_count_ptr Pointer to returned number of frames that were not sent.
+ *
+ * @return kCdiStatusOk if every frame completed exactly once, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus SendFramesWhileCompleting(CdiAdapterHandle adapter_handle, void* frame_data_ptr,
+                                                 bool skip_superseded, bool replace, bool cancel,
+                                                 int* ret_skipped_count_ptr)
+{
+    TxStaleTestState* state_ptr = &test_state;
+    PassStart(CONCURRENT_FRAME_COUNT);
+
+    CdiLogMethodData log_method_data = {
+        .log_method = kLogMethodStdout
+    };
+    CdiTxConfigData config_data = {
+        .adapter_handle = adapter_handle,
+        .thread_core_num = -1,
+        .connection_log_method_data_ptr = &log_method_data,
+        .stats_config.disable_cloudwatch_stats = true,
+        .resource_profile.max_payload_byte_size = CONCURRENT_FRAME_BYTES,
+        .resource_profile.max_in_flight_payloads = CONCURRENT_IN_FLIGHT_PAYLOADS,
+        .stale_payloads.skip_superseded = skip_superseded
+    };
+    CdiConnectionHandle connection_handle = NULL;
+    CHECK(kCdiStatusOk == CdiAvmTxStreamConnectionCreate(&config_data, TestTxCallback, &connection_handle));
+
+    CdiTxConfigDataStream stream_config = {
+        .dest_ip_addr_str = LOOPBACK_IP_STR,
+        .dest_port = DEST_PORT,
+        .stream_name_str = "video"
+    };
+    CdiEndpointHandle endpoint_handle = NULL;
+    CdiReturnStatus rs = CdiAvmTxStreamEndpointCreate(connection_handle, &stream_config, &endpoint_handle);
+
+    CdiSglEntry sgl_entry = {
+        .address_ptr = frame_data_ptr,
+        .size_in_bytes = CONCURRENT_FRAME_BYTES,
+    };
+    CdiSgList sgl = {
+        .total_data_size = CONCURRENT_FRAME_BYTES,
+        .sgl_head_ptr = &sgl_entry,
+        .sgl_tail_ptr = &sgl_entry,
+    };
+    for (int i = 0; kCdiStatusOk == rs && i < CONCURRENT_FRAME_COUNT; i++) {
+        CdiAvmTxPayloadConfig payload_config = {
+            .core_config_data.unit_size = 8,
+            .core_config_data.user_cb_param = (CdiUserCbParameter)(uintptr_t)i,
+            .avm_extra_data.stream_identifier = (uint16_t)(1 + i % CONCURRENT_STREAM_COUNT)
+        };
+        // The payload queue fills up while frames are in flight, so retry until there is room.
+        do {
+            if (replace) {
+                rs = CdiAvmEndpointTxPayloadReplace(endpoint_handle, &payload_config, NULL, &sgl, 0);
+            } else {
+                rs = CdiAvmEndpointTxPayload(endpoint_handle, &payload_config, NULL, &sgl, 0);
+            }
+        } while (kCdiStatusQueueFull == rs);
+        if (kCdiStatusOk == rs && cancel && 0 == i % CONCURRENT_CANCEL_INTERVAL && 0 != i) {
+            // The frame may already be sent, in which case the request has no effect. A full cancel request queue is
+            // not an error either.
+            rs = CdiCoreTxPayloadCancel(connection_handle, (CdiUserCbParameter)(uintptr_t)(i - 1));
+            if (kCdiStatusQueueFull == rs) {
+                rs = kCdiStatusOk;
+            }
+        }
+    }
+    if (kCdiStatusOk == rs && !CdiOsSignalWait(state_ptr->pass_done_signal, PASS_TIMEOUT_MS, NULL)) {
+        CDI_LOG_THREAD(kLogError, "Only [%d] of [%d] frames completed.", state_ptr->completed_count,
+                       CONCURRENT_FRAME_COUNT);
+        rs = kCdiStatusFatal;
+    }
+    CdiCoreConnectionDestroy(connection_handle);
+    CHECK(kCdiStatusOk == rs);
+
+    int skipped_count = 0;
+    for (int i = 0; i < CONCURRENT_FRAME_COUNT; i++) {
+        CdiReturnStatus status = state_ptr->status_array[i];
+        CHECK(1 == state_ptr->completion_count_array[i]);
+        CHECK(kCdiStatusOk == status || kCdiStatusTxPayloadStale == status || kCdiStatusTxPayloadCancelled == status);
+        if (kCdiStatusOk != status) {
+            skipped_count++;
+        }
+    }
+    *ret_skipped_count_ptr = skipped_count;
+
+    return kCdiStatusOk;
+}
+
+/**
+ * Create a socket adapter and a socket for the endpoint to send to, then send a burst of frames with each policy.
+ *
+ * @return kCdiStatusOk if the test passed, otherwise kCdiStatusFatal.
+ */
+static CdiReturnStatus RunTxStalePayloadsTest(void)
+{
+    // The frames are not read. The socket only keeps the destination port open.
+    CdiSocket rx_socket;
+    CHECK(CdiOsSocketOpen(NULL, DEST_PORT, LOOPBACK_IP_STR, &rx_socket));
+
+    CdiAdapterData adapter_data = {
+        .adapter_ip_addr_str = LOOPBACK_IP_STR,
+        .tx_buffer_size_bytes = FRAME_BYTES,
+        .ret_tx_buffer_ptr = NULL,
+        .adapter_type = kCdiAdapterTypeSocket
+    };
+    CdiAdapterHandle adapter_handle = NULL;
+    CdiReturnStatus rs = CdiCoreNetworkAdapterInitialize(&adapter_data, &adapter_handle);
+    TxStaleTestState* state_ptr = &test_state;
+    int skipped_count = 0;
+
+    if (kCdiStatusOk == rs) {
+        // Without a policy, every frame is sent even though the last ones miss their deadline.
+        CdiTxStalePayloadConfig stale_payloads = { 0 };
+        rs = SendFrames(adapter_handle, adapter_data.ret_tx_buffer_ptr, &stale_payloads, 1,
+                        LATE_FRAME_MAX_LATENCY_MICROSECONDS, false, -1, false, &skipped_count);
+        if (kCdiStatusOk == rs && 0 != skipped_count) {
+            CDI_LOG_THREAD(kLogError, "Skipped [%d] frames without a stale payload policy.", skipped_count);
+            rs = kCdiStatusFatal;
+        }
+    }
+    if (kCdiStatusOk == rs) {
+        // The frames of each stream that are queued while the first frame is paced are superseded, except the newest.
+        CdiTxStalePayloadConfig stale_payloads = {
+            .skip_superseded = true
+        };
+        rs = SendFrames(adapter_handle, adapter_data.ret_tx_buffer_ptr, &stale_payloads, 2, 0, false, -1, false,
+                        &skipped_count);
+        if (kCdiStatusOk == rs && (0 == skipped_count || kCdiStatusOk != state_ptr->status_array[FRAME_COUNT - 2] ||
+                                   kCdiStatusOk != state_ptr->status_array[FRAME_COUNT - 1])) {
+            CDI_LOG_THREAD(kLogError, "Skipped [%d] superseded frames. Newest frames of each stream must be sent.",
+                           skipped_count);
+            rs = kCdiStatusFatal;
+        }
+    }
+    if (kCdiStatusOk == rs) {
+        // The first frame is sent in time, the frames at the end of the burst can't be.
+        CdiTxStalePayloadConfig stale_payloads = {
+            .skip_late = true
+        };
+        rs = SendFrames(adapter_handle, adapter_data.ret_tx_buffer_ptr, &stale_payloads, 1,
+                        LATE_FRAME_MAX_LATENCY_MICROSECONDS, false, -1, false, &skipped_count);
+        if (kCdiStatusOk == rs && (0 == skipped_count || kCdiStatusOk != state_ptr->status_array[0] ||
+                                   kCdiStatusTxPayloadStale != state_ptr->status_array[FRAME_COUNT - 1])) {
+            CDI_LOG_THREAD(kLogError, "Skipped [%d] late frames. First frame must be sent and last one skipped.",
+                           skipped_count);
+            rs = kCdiStatusFatal;
+        }
+    }
+    if (kCdiStatusOk == rs) {
+        // Replacing frames has the same effect as skipping superseded frames, without a policy.
+        CdiTxStalePayloadConfig stale_payloads = { 0 };
+        rs = SendFrames(adapter_handle, adapter_data.ret_tx_buffer_ptr, &stale_payloads, 2, 0, true, -1, false,
+                        &skipped_count);
+        if (kCdiStatusOk == rs && (0 == skipped_count || kCdiStatusOk != state_ptr->status_array[FRAME_COUNT - 2] ||
+                                   kCdiStatusOk != state_ptr->status_array[FRAME_COUNT - 1])) {
+            CDI_LOG_THREAD(kLogError, "Replaced [%d] frames. Newest frames of each stream must be sent.",
+                           skipped_count);
+            rs = kCdiStatusFatal;
+        }
+    }
+    if (kCdiStatusOk == rs) {
+        // Only the cancelled frame, which is still queued behind the others, is not sent.
+        CdiTxStalePayloadConfig stale_payloads = { 0 };
+        rs = SendFrames(adapter_handle, adapter_data.ret_tx_buffer_ptr, &stale_payloads, 1, 0, false,
+                        FRAME_COUNT - 1, false, &skipped_count);
+        if (kCdiStatusOk == rs && (1 != skipped_count ||
+                                   kCdiStatusTxPayloadCancelled != state_ptr->status_array[FRAME_COUNT - 1])) {
+            CDI_LOG_THREAD(kLogError, "Cancelled [%d] frames. Only the last frame must be cancelled.", skipped_count);
+            rs = kCdiStatusFatal;
+        }
+    }
+    if (kCdiStatusOk == rs) {
+        // A frame sent with the same user callback parameter after the cancel request is made is still sent.
+        CdiTxStalePayloadConfig stale_payloads = { 0 };
+        rs = SendFrames(adapter_handle, adapter_data.ret_tx_buffer_ptr, &stale_payloads, 1, 0, false,
+                        FRAME_COUNT - 1, true, &skipped_count);
+        if (kCdiStatusOk == rs && (0 != skipped_count || 1 != state_ptr->cancelled_count ||
+                                   2 != state_ptr->completion_count_array[FRAME_COUNT - 1])) {
+            CDI_LOG_THREAD(kLogError, "Cancelled [%d] frames. Only the frame sent before the request must be "
+                           "cancelled.", state_ptr->cancelled_count);
+            rs = kCdiStatusFatal;
+        }
+    }
+    if (kCdiStatusOk == rs) {
+        // Superseded frames are skipped while the frames that are sent complete.
+        rs = SendFramesWhileCompleting(adapter_handle, adapter_data.ret_tx_buffer_ptr, true, false, false,
+                                       &skipped_count);
+        if (kCdiStatusOk == rs && verbose) {
+            CDI_LOG_THREAD(kLogInfo, "Skipped [%d] of [%d] frames while frames completed.", skipped_count,
+                           CONCURRENT_FRAME_COUNT);
+        }
+    }
+    if (kCdiStatusOk == rs) {
+        // Frames are replaced and cancelled while the frames that are sent complete.
+        rs = SendFramesWhileCompleting(adapter_handle, adapter_data.ret_tx_buffer_ptr, false, true, true,
+                                       &skipped_count);
+        if (kCdiStatusOk == rs && verbose) {
+            CDI_LOG_THREAD(kLogInfo, "Replaced or cancelled [%d] of [%d] frames while frames completed.",
+                           skipped_count, CONCURRENT_FRAME_COUNT);
+        }
+    }
+
+    if (adapter_handle) {
+        CdiCoreNetworkAdapterDestroy(adapter_handle);
+    }
+    CdiOsSocketClose(rx_socket);
+
+    return rs;
+}
+
+//*********************************************************************************************************************
+//******************************************* START OF PUBLIC FUNCTIONS ***********************************************
+//*********************************************************************************************************************
+
+CdiReturnStatus TestUnitTxStalePayloads(void)
+{
+    CdiLogMethodData log_method_data = {
+        .log_method = kLogMethodStdout
+    };
+    CdiCoreConfigData core_config = {
+        .default_log_level = kLogInfo,
+        .global_log_method_data_ptr = &log_method_data,
+        .cloudwatch_config_ptr = NULL
+    };
+    CHECK(kCdiStatusOk == CdiCoreInitialize(&core_config));
+    CHECK(CdiOsSignalCreate(&test_state.pass_done_signal));
+
+    CdiReturnStatus rs = RunTxStalePayloadsTest();
+
+    CdiOsSignalDelete(test_state.pass_done_signal);
+    CdiCoreShutdown();
+
+    return rs;
+}
@@ -120,6 +120,26 @@ static inline void CdiSinglyLinkedListPushTail(CdiSinglyLinkedList* list_ptr,
     list_ptr->num_entries++;
 }
 
+/**
+ * Add a list of entries that are already linked together to the head of the list.
+ *
+ * @param list_ptr Pointer to instance of the list.
+ * @param head_entry_ptr Pointer to the first entry of the list to add.
+ * @param tail_entry_ptr Pointer to the last entry of the list to add.
+ * @param entry_count Number of entries in the list being added.
+ */
+static inline void CdiSinglyLinkedListPushListHead(CdiSinglyLinkedList* list_ptr,
+                                                   CdiSinglyLinkedListEntry* head_entry_ptr,
+                                                   CdiSinglyLinkedListEntry* tail_entry_ptr, int entry_count)
+{
+    tail_entry_ptr->next_ptr = list_ptr->head_ptr;
+    list_ptr->head_ptr = head_entry_ptr;
+    if (list_ptr->tail_ptr == NULL) {
+        list_ptr->tail_ptr = tail_entry_ptr;
+    }
+    list_ptr->num_entries += entry_count;
+}
+
 /**
  * Pop an item off the head of the list, removing it from the list.
  *
@@ -24,6 +24,9 @@
 /// Number of nanoseconds in a second.
 #define CDI_NANOSECONDS_PER_SECOND   (1000000000UL)
 
+/// Size of a CPU cache line in bytes. Used to pad data written by different threads onto separate cache lines.
+#define CDI_CACHE_LINE_BYTE_SIZE     (64)
+
 /**
  * This macro is used to locate a pointer to the start of a structure given a pointer to the specified member in the
  * structure.
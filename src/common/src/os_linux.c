@@ -25,6 +25,9 @@
 #include <assert.h>
 #include <dirent.h>
 #include <errno.h>
+#include <limits.h>
+#include <linux/futex.h>
+#include <linux/mempolicy.h>
 #include <malloc.h>
 #include <netdb.h>
 #include <netinet/ip.h>
@@ -40,6 +43,7 @@
 #include <string.h>
 #include <sys/mman.h>
 #include <sys/socket.h>
+#include <sys/syscall.h>
 #include <sys/uio.h>
 #include <unistd.h>
 
@@ -55,8 +59,16 @@
 /// @brief Linux definition of stack size.
 #define THREAD_STACK_SIZE (1024*1024)
 
-/// @brief Maximum number of threads that can register for notifications from another signal.
-#define MAX_THREADS_WAITING (50)
+#ifndef SYS_futex_waitv
+/// @brief System call number of futex_waitv() (Linux 5.16), for C library headers that predate it. The number is the
+/// same on all architectures.
+#define SYS_futex_waitv (449)
+#endif
+
+#ifndef FUTEX_32
+/// @brief futex_waitv() flag for a 32-bit futex word, for kernel headers that predate futex_waitv().
+#define FUTEX_32 (2)
+#endif
 
 /// Thread Info is kept in a doubly-linked list.
 typedef struct CdiThreadInfo CdiThreadInfo;
@@ -98,22 +110,44 @@ struct SemInfo
 /// @brief Forward declaration to create pointer to signal info when used.
 typedef struct SignalInfo SignalInfo;
 /**
- * @brief Structure used to hold signal state data.
+ * @brief Structure used to hold signal state data. Waiting threads sleep in the kernel on signal_count using futex(2),
+ * so setting or clearing a signal that no thread is waiting on is a single atomic operation.
  */
 struct SignalInfo
 {
-    pthread_mutex_t mutex;    ///< Mutex to protect a signal.
-    pthread_cond_t condition; ///< Condition variable for threads to wait.
-
     /// @brief Low bit is the current signal state. Upper bits are the current signal number we are at. This is used to
-    /// guarantee that every thread goes through once, even if the signal has been reset.
+    /// guarantee that every thread goes through once, even if the signal has been reset. This is the futex word.
     volatile uint32_t signal_count;
 
-    /// @brief Keeps track of who else needs to be signaled.
-    int num_other_sigs;       ///< Number of entries.
-    struct SignalInfo* other_sigs_ptr_array[MAX_THREADS_WAITING]; ///< Other signals to wake up when this is signaled.
+    /// @brief Number of threads waiting on signal_count, either in CdiOsSignalWait() or CdiOsSignalsWait().
+    /// CdiOsSignalSet() only makes a wake system call if this is non-zero.
+    volatile uint32_t waiter_count;
+
+    /// @brief Number of the threads in waiter_count that are waiting in CdiOsSignalsWait() while futex_waitv() is not
+    /// supported. CdiOsSignalSet() only advances wait_multiple_generation if this is non-zero.
+    volatile uint32_t multi_waiter_count;
 };
 
+/**
+ * @brief One entry of the array passed to futex_waitv(). Same layout as struct futex_waitv in linux/futex.h, which
+ * older kernel headers do not have.
+ */
+typedef struct {
+    uint64_t val;      ///< Value the futex word must contain for the thread to sleep.
+    uint64_t uaddr;    ///< Address of the futex word.
+    uint32_t flags;    ///< Size and type of the futex word.
+    uint32_t reserved; ///< Must be zero.
+} FutexWaitv;
+
+/**
+ * @brief Whether the kernel supports futex_waitv(). Determined by the first CdiOsSignalsWait() that has to wait.
+ */
+typedef enum {
+    kFutexWaitvUnknown,     ///< Not yet determined.
+    kFutexWaitvSupported,   ///< futex_waitv() is used to wait on multiple signals.
+    kFutexWaitvUnsupported, ///< Kernel is older than 5.16 or blocks it. wait_multiple_generation is used instead.
+} FutexWaitvSupport;
+
 /// @brief Forward declaration to create pointer to socket info when used.
 typedef struct SocketInfo SocketInfo;
 /**
@@ -134,6 +168,12 @@ struct SocketInfo
 /// Maximum length of a single formatted message string.
 #define MAX_FORMATTED_MESSAGE_LENGTH    (1024)
 
+/// Maximum number of NUMA nodes supported by CdiOsMemBindToNumaNode(). Matches the kernel's default CONFIG_NODES_SHIFT.
+#define MAX_NUMA_NODES                  (1024)
+
+/// Number of bits in each element of the node mask passed to mbind().
+#define NODE_MASK_ELEMENT_BITS          (8 * sizeof(unsigned long))
+
 //*********************************************************************************************************************
 //*********************************************** START OF VARIABLES **************************************************
 //*********************************************************************************************************************
@@ -150,6 +190,15 @@ static int signal_handler_count = 0;
 /// If true, the CDI logger will be used to generate error messages, otherwise output will be sent to stderr.
 static bool use_logger = false;
 
+/// Whether futex_waitv() can be used by CdiOsSignalsWait(). See FutexWaitvSupport.
+static volatile int futex_waitv_support = kFutexWaitvUnknown;
+
+/// @brief Futex word used by CdiOsSignalsWait() when futex_waitv() is not supported. Incremented by CdiOsSignalSet()
+/// whenever it sets a signal that a thread is waiting on in CdiOsSignalsWait(). Every thread waiting in
+/// CdiOsSignalsWait() sleeps on this one word, so each such set wakes all of them, and those not waiting on the signal
+/// that was set go back to sleep after checking their own signals.
+static volatile uint32_t wait_multiple_generation = 0;
+
 //*********************************************************************************************************************
 //******************************************* START OF STATIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
@@ -199,6 +248,73 @@ static void GetTimeout(struct timespec* spec, uint32_t num_ms, clockid_t clock_i
     spec->tv_nsec = 1000L * (((num_ms * 1000L) + (this_time.tv_nsec/1000)) % 1000000L);
 }
 
+/**
+ * Sleep until the futex word no longer contains the expected value, the thread is woken or the timeout expires.
+ *
+ * @param futex_word_ptr Pointer to the futex word.
+ * @param expected_value Value the futex word must contain for the thread to sleep.
+ * @param timeout_ptr Absolute kPreferredClock time to stop waiting at, or NULL to wait indefinitely.
+ *
+ * @return 0 if woken or the value did not match, ETIMEDOUT if the timeout expired, otherwise an errno value.
+ */
+static int FutexWait(volatile uint32_t* futex_word_ptr, uint32_t expected_value, const struct timespec* timeout_ptr)
+{
+    // FUTEX_WAIT_BITSET takes an absolute CLOCK_MONOTONIC timeout, unlike FUTEX_WAIT which takes a relative one.
+    if (-1 == syscall(SYS_futex, futex_word_ptr, FUTEX_WAIT_BITSET_PRIVATE, expected_value, timeout_ptr, NULL,
+                      FUTEX_BITSET_MATCH_ANY)) {
+        return (EAGAIN == errno || EINTR == errno) ? 0 : errno;
+    }
+    return 0;
+}
+
+/**
+ * Wake all threads sleeping on a futex word.
+ *
+ * @param futex_word_ptr Pointer to the futex word.
+ */
+static void FutexWakeAll(volatile uint32_t* futex_word_ptr)
+{
+    syscall(SYS_futex, futex_word_ptr, FUTEX_WAKE_PRIVATE, INT_MAX, NULL, NULL, 0);
+}
+
+/**
+ * Determine whether the kernel supports futex_waitv(), if not already done. futex_waitv() with no futex words fails
+ * with EINVAL if it is supported. Any other result, such as ENOSYS from an older kernel or EPERM from a seccomp
+ * profile that blocks the system call, means it can't be used.
+ */
+static void FutexWaitvProbe(void)
+{
+    if (kFutexWaitvUnknown == futex_waitv_support) {
+        const bool supported = -1 == syscall(SYS_futex_waitv, NULL, 0, 0, NULL, kPreferredClock) && EINVAL == errno;
+        futex_waitv_support = supported ? kFutexWaitvSupported : kFutexWaitvUnsupported;
+    }
+}
+
+/**
+ * Sleep until one of the futex words no longer contains its expected value, the thread is woken or the timeout
+ * expires. Uses futex_waitv() if the kernel supports it, otherwise sleeps on wait_multiple_generation, which
+ * CdiOsSignalSet() increments whenever it wakes waiters.
+ *
+ * @param waiter_array Array of futex words and their expected values.
+ * @param num_waiters Number of entries in waiter_array.
+ * @param generation Value of wait_multiple_generation read before the futex words were last checked.
+ * @param timeout_ptr Absolute kPreferredClock time to stop waiting at, or NULL to wait indefinitely.
+ *
+ * @return 0 if woken or a value did not match, ETIMEDOUT if the timeout expired, otherwise an errno value.
+ */
+static int FutexWaitMultiple(FutexWaitv* waiter_array, int num_waiters, uint32_t generation,
+                             const struct timespec* timeout_ptr)
+{
+    if (kFutexWaitvSupported == futex_waitv_support) {
+        if (-1 == syscall(SYS_futex_waitv, waiter_array, num_waiters, 0, timeout_ptr, kPreferredClock)) {
+            return (EAGAIN == errno || EINTR == errno) ? 0 : errno;
+        }
+        return 0;
+    }
+
+    return FutexWait(&wait_multiple_generation, generation, timeout_ptr);
+}
+
 /**
  *  This populates the sigaction structure with the appropriate flags and user-defined callback.
  *
@@ -389,6 +505,11 @@ bool CdiOsThreadAllocData(CdiThreadData* handle_out_ptr)
     return (0 == pthread_key_create((pthread_key_t*)handle_out_ptr, NULL));
 }
 
+bool CdiOsThreadAllocDataWithDestructor(CdiThreadDataDestructor destructor_fn, CdiThreadData* handle_out_ptr)
+{
+    return (0 == pthread_key_create((pthread_key_t*)handle_out_ptr, destructor_fn));
+}
+
 bool CdiOsThreadFreeData(CdiThreadData handle)
 {
     return (0 == pthread_key_delete(handle));
@@ -602,19 +723,13 @@ bool CdiOsSignalCreate(CdiSignalType* signal_handle_ptr)
     bool return_val = true;
     assert(NULL != signal_handle_ptr);
 
+    // Done before any thread can wait on the signal, since CdiOsSignalSet() depends on the result.
+    FutexWaitvProbe();
+
     *signal_handle_ptr = CdiOsMemAllocZero(sizeof(SignalInfo));
     if (NULL == *signal_handle_ptr) {
         return_val = false;
         ERROR_MESSAGE("failed to allocate memory");
-    } else {
-        SignalInfo* signal_info_ptr = *(SignalInfo**)signal_handle_ptr;
-        pthread_condattr_t attr;
-
-        pthread_mutex_init(&signal_info_ptr->mutex, NULL);
-        pthread_condattr_init(&attr);
-        pthread_condattr_setclock(&attr, kPreferredClock);
-        pthread_cond_init(&signal_info_ptr->condition, &attr);
-        pthread_condattr_destroy(&attr);
     }
 
     return return_val;
@@ -627,10 +742,7 @@ bool CdiOsSignalDelete(CdiSignalType signal_handle)
 
     if (signal_handle) {
         SignalInfo* signal_info_ptr = (SignalInfo*)signal_handle;
-        assert(signal_info_ptr->num_other_sigs == 0);
-
-        pthread_mutex_destroy(&signal_info_ptr->mutex);
-        pthread_cond_destroy(&signal_info_ptr->condition);
+        assert(signal_info_ptr->waiter_count == 0);
 
         CdiOsMemFree(signal_info_ptr);
     }
@@ -644,7 +756,8 @@ bool CdiOsSignalClear(CdiSignalType signal_handle)
     SignalInfo* signal_info_ptr = (SignalInfo*)signal_handle;
     assert(NULL != signal_handle);
 
-    // There is no need to grab the lock here. Clear the bottom signal bit while leaving the rest alone.
+    // Waiting threads only wake up on a set, so there is nothing else to do. Clear the bottom signal bit while leaving
+    // the rest alone.
     __sync_fetch_and_and(&signal_info_ptr->signal_count, ~1U);
 
     return return_val;
@@ -656,30 +769,30 @@ bool CdiOsSignalSet(CdiSignalType signal_handle)
     SignalInfo* signal_info_ptr = (SignalInfo*)signal_handle;
     assert(NULL != signal_handle);
 
-    pthread_mutex_lock(&signal_info_ptr->mutex);
     uint32_t signal_count = signal_info_ptr->signal_count;
-    signal_count += 2;
-    signal_count |= 1;
-    signal_info_ptr->signal_count = signal_count;
-    pthread_cond_broadcast(&signal_info_ptr->condition);
-
-    // We have to give up our lock here since we may acquire another lock during the other signals processing.
-    pthread_mutex_unlock(&signal_info_ptr->mutex);
-
-    // To support wait multiple we need to wake up all listening threads that are waiting on another condition variable.
-    if (signal_info_ptr->num_other_sigs > 0) {
-        for (int i = 0; i < MAX_THREADS_WAITING; i++) {
-            // Make a copy of the pointer, since the value in the array can be set to NULL under our nose.
-            SignalInfo* other_signal_info_ptr = signal_info_ptr->other_sigs_ptr_array[i];
-            if (other_signal_info_ptr != NULL) {
-                // To prevent race condition only signal a condition if you hold the lock to that condition.
-                pthread_mutex_lock(&other_signal_info_ptr->mutex);
-                pthread_cond_broadcast(&other_signal_info_ptr->condition);
-                pthread_mutex_unlock(&other_signal_info_ptr->mutex);
+    while (!(signal_count & 1)) {
+        // Set the signal bit and advance the signal number in a single atomic operation.
+        uint32_t previous_count = __sync_val_compare_and_swap(&signal_info_ptr->signal_count, signal_count,
+                                                              signal_count + 3);
+        if (previous_count == signal_count) {
+            // The compare and swap is a full memory barrier, so a thread that registered as a waiter before it either
+            // is counted here or sees the new signal count before it goes to sleep.
+            if (signal_info_ptr->waiter_count) {
+                FutexWakeAll(&signal_info_ptr->signal_count);
+                if (signal_info_ptr->multi_waiter_count) {
+                    __sync_fetch_and_add(&wait_multiple_generation, 1);
+                    FutexWakeAll(&wait_multiple_generation);
+                }
             }
+            return return_val;
         }
+        signal_count = previous_count;
     }
 
+    // Signal is already set. Any thread that was waiting for it was woken when it was set, since waiting threads only
+    // sleep while the signal is clear. Callers expect a memory barrier, so provide one.
+    __sync_synchronize();
+
     return return_val;
 }
 
@@ -702,6 +815,7 @@ bool CdiOsSignalWait(CdiSignalType signal_handle, uint32_t timeout_in_ms, bool*
     bool return_val = true;
     SignalInfo* signal_info_ptr = (SignalInfo*)signal_handle;
     struct timespec time_to_wait_until;
+    struct timespec* timeout_ptr = NULL;
 
     if (timed_out_ptr) {
         *timed_out_ptr = false;
@@ -709,25 +823,19 @@ bool CdiOsSignalWait(CdiSignalType signal_handle, uint32_t timeout_in_ms, bool*
 
     if (timeout_in_ms != CDI_INFINITE) {
         GetTimeout(&time_to_wait_until, timeout_in_ms, kPreferredClock);
+        timeout_ptr = &time_to_wait_until;
     }
 
     uint32_t signal_count = signal_info_ptr->signal_count;
     if (!(signal_count & 1)) {
-        int mutex_rc = pthread_mutex_lock(&signal_info_ptr->mutex);
-        if (0 != mutex_rc) {
-            ERROR_MESSAGE("Error acquiring lock in CdiOsSignalWait [%s]", strerror(mutex_rc));
-            return_val = false;
-        }
+        // Register as a waiter before checking the signal count, so CdiOsSignalSet() either sees the registration or
+        // the check below sees its change.
+        __sync_fetch_and_add(&signal_info_ptr->waiter_count, 1);
 
         // Wait until the signal is set. Note that it is possible for us to sleep through a set/clear cycle. Even if
         // the signal is not currently set, we are released if the signal count changes.
-        while (return_val && signal_info_ptr->signal_count == signal_count) {
-            int rc = 0;
-            if (CDI_INFINITE == timeout_in_ms) {
-                rc = pthread_cond_wait(&signal_info_ptr->condition, &signal_info_ptr->mutex);
-            } else {
-                rc = pthread_cond_timedwait(&signal_info_ptr->condition, &signal_info_ptr->mutex, &time_to_wait_until);
-            }
+        while (signal_info_ptr->signal_count == signal_count) {
+            int rc = FutexWait(&signal_info_ptr->signal_count, signal_count, timeout_ptr);
             if (ETIMEDOUT == rc) {
                 if (timed_out_ptr) {
                     *timed_out_ptr = true;
@@ -736,17 +844,14 @@ bool CdiOsSignalWait(CdiSignalType signal_handle, uint32_t timeout_in_ms, bool*
             } else if (0 != rc) {
                 ERROR_MESSAGE("Error in CdiOsSignalWait [%s]", strerror(rc));
                 return_val = false;
+                break;
             }
         }
-        if (0 == mutex_rc) {
-            mutex_rc = pthread_mutex_unlock(&signal_info_ptr->mutex);
-            if (0 != mutex_rc) {
-                ERROR_MESSAGE("Error releasing lock in CdiOsSignalWait [%s]", strerror(mutex_rc));
-                return_val = false;
-            }
-        }
+
+        // This atomic operation is also the memory barrier for the caller.
+        __sync_fetch_and_sub(&signal_info_ptr->waiter_count, 1);
     } else {
-        // The pthread_mutex functions imply a memory barrier. If we don't wait we must do our own.
+        // If we don't wait we must do our own memory barrier.
         __sync_synchronize();
     }
 
@@ -759,8 +864,6 @@ bool CdiOsSignalsWait(CdiSignalType* signal_array, uint8_t num_signals, bool wai
     bool return_val = true;
     SignalInfo** signal_info_ptr_array = (SignalInfo**)signal_array;
     uint32_t i;
-    uint32_t signal_count_array[CDI_MAX_WAIT_MULTIPLE];
-    int j;
     bool keep_waiting = true;
 
     if(num_signals > CDI_MAX_WAIT_MULTIPLE) {
@@ -809,63 +912,57 @@ bool CdiOsSignalsWait(CdiSignalType* signal_array, uint8_t num_signals, bool wai
                 }
             }
         }
-        // The pthread_mutex functions imply a memory barrier. If we don't wait we must do our own.
+        // If we don't wait we must do our own memory barrier.
         __sync_synchronize();
 
         return return_val;
     }
 
     // First, see if any signals are active.
+    FutexWaitv waiter_array[CDI_MAX_WAIT_MULTIPLE];
     for (i = 0; i < num_signals; i++) {
-        signal_count_array[i] = signal_info_ptr_array[i]->signal_count;
-        if (signal_count_array[i] & 1) {
+        const uint32_t signal_count = signal_info_ptr_array[i]->signal_count;
+        if (signal_count & 1) {
             keep_waiting = false;
             if (NULL != ret_signal_index_ptr) {
                 *ret_signal_index_ptr = i;
             }
             break;
         }
+        waiter_array[i].val = signal_count;
+        waiter_array[i].uaddr = (uintptr_t)&signal_info_ptr_array[i]->signal_count;
+        waiter_array[i].flags = FUTEX_32 | FUTEX_PRIVATE_FLAG;
+        waiter_array[i].reserved = 0;
     }
 
     if (keep_waiting) {
-
-        // No signals currently active, we need to wait for the first signal and register with the remaining signals.
-        struct timespec sTime;
+        // No signals currently active. Sleep on all of them at once. Each signal only needs to know how many threads
+        // are waiting on it, so CdiOsSignalSet() can skip the wake system call when there are none.
+        struct timespec time_to_wait_until;
+        struct timespec* timeout_ptr = NULL;
         if(timeout_in_ms != CDI_INFINITE) {
-            GetTimeout(&sTime, timeout_in_ms, kPreferredClock);
+            GetTimeout(&time_to_wait_until, timeout_in_ms, kPreferredClock);
+            timeout_ptr = &time_to_wait_until;
         }
 
-        pthread_mutex_lock(&signal_info_ptr_array[0]->mutex);
-        // Register with all the other signals. We use atomics to increment the signal counts and set a pointer to our
-        // signal. This is done to avoid needing to grab locks, since that will introduce messey race conditions.
-        //
-        // We need to have the lock to signal0 so that none of these signals can call signal0's condition variable until
-        // we are sleeping on it.
-        for (i = 1; i < num_signals; i++) {
-            int previous_count = __sync_fetch_and_add(&signal_info_ptr_array[i]->num_other_sigs, 1);
-            if(previous_count >= MAX_THREADS_WAITING) {
-                ERROR_MESSAGE("__sync_fetch_and_add too high");
-                __sync_fetch_and_sub(&signal_info_ptr_array[i]->num_other_sigs, 1);
-                return_val = false;
-                keep_waiting = false;
-            }
-            for (j = 0; j < MAX_THREADS_WAITING; j++) {
-                if (__sync_bool_compare_and_swap(&signal_info_ptr_array[i]->other_sigs_ptr_array[j], NULL, signal_info_ptr_array[0])) {
-                    break;
-                }
-            }
-            if (j == MAX_THREADS_WAITING) {
-                ERROR_MESSAGE("MAX_THREADS_WAITING");
-                __sync_fetch_and_sub(&signal_info_ptr_array[i]->num_other_sigs, 1);
-                return_val = false;
-                keep_waiting = false;
+        // Without futex_waitv(), a set only wakes this thread through wait_multiple_generation, so tell the signals to
+        // advance it.
+        const bool use_generation = kFutexWaitvSupported != futex_waitv_support;
+        for (i = 0; i < num_signals; i++) {
+            if (use_generation) {
+                __sync_fetch_and_add(&signal_info_ptr_array[i]->multi_waiter_count, 1);
             }
+            __sync_fetch_and_add(&signal_info_ptr_array[i]->waiter_count, 1);
         }
 
         while (keep_waiting) {
+            // Only used if futex_waitv() is not supported. Read before the signal counts, so a set that happens after
+            // they are checked changes it.
+            const uint32_t generation = __sync_fetch_and_add(&wait_multiple_generation, 0);
+
             // Check if a signal is set.
             for (i = 0; i < num_signals; i++) {
-                if(signal_info_ptr_array[i]->signal_count != signal_count_array[i]) {
+                if (signal_info_ptr_array[i]->signal_count != waiter_array[i].val) {
                     keep_waiting = false;
                     if(NULL != ret_signal_index_ptr) {
                         *ret_signal_index_ptr = i;
@@ -874,37 +971,30 @@ bool CdiOsSignalsWait(CdiSignalType* signal_array, uint8_t num_signals, bool wai
                 }
             }
             if (keep_waiting) {
-                // No signal set, wait on the first condition variable.
-                if(timeout_in_ms != CDI_INFINITE) {
-                    int ret_code = pthread_cond_timedwait(&signal_info_ptr_array[0]->condition, &signal_info_ptr_array[0]->mutex, &sTime);
-                    if (ret_code) {
-                        if (ret_signal_index_ptr) {
-                            *ret_signal_index_ptr = CDI_OS_SIG_TIMEOUT;
-                        }
-                        keep_waiting = false;
-                        break;
+                int rc = FutexWaitMultiple(waiter_array, num_signals, generation, timeout_ptr);
+                if (ETIMEDOUT == rc) {
+                    if (ret_signal_index_ptr) {
+                        *ret_signal_index_ptr = CDI_OS_SIG_TIMEOUT;
                     }
-                } else {
-                    pthread_cond_wait(&signal_info_ptr_array[0]->condition, &signal_info_ptr_array[0]->mutex);
+                    keep_waiting = false;
+                } else if (0 != rc) {
+                    ERROR_MESSAGE("Error in CdiOsSignalsWait [%s]", strerror(rc));
+                    return_val = false;
+                    keep_waiting = false;
                 }
             }
         }
 
-        // Done with the lock.
-        pthread_mutex_unlock(&signal_info_ptr_array[0]->mutex);
-
-        // Remove the registrations using atomics to avoid locks.
-        for (i = 1; i < num_signals; i++) {
-            for (j = 0; j < MAX_THREADS_WAITING; j++) {
-                if (__sync_bool_compare_and_swap(&signal_info_ptr_array[i]->other_sigs_ptr_array[j], signal_info_ptr_array[0], NULL)) {
-                    __sync_fetch_and_sub(&signal_info_ptr_array[i]->num_other_sigs, 1);
-                    break;
-                }
+        // These atomic operations are also the memory barrier for the caller.
+        for (i = 0; i < num_signals; i++) {
+            __sync_fetch_and_sub(&signal_info_ptr_array[i]->waiter_count, 1);
+            if (use_generation) {
+                __sync_fetch_and_sub(&signal_info_ptr_array[i]->multi_waiter_count, 1);
             }
         }
     }
     else {
-        // The pthread_mutex functions imply a memory barrier. If we don't wait we must do our own.
+        // If we don't wait we must do our own memory barrier.
         __sync_synchronize();
     }
 
@@ -965,6 +1055,98 @@ void CdiOsMemFreeHugePage(void* mem_ptr, int64_t mem_size)
     }
 }
 
+void* CdiOsMemAllocOnNumaNode(int64_t mem_size, int numa_node)
+{
+    // Anonymous mappings are page aligned and zero filled, and don't share pages with other allocations, so the node
+    // policy set below only affects this block.
+    uint8_t* mem_ptr = mmap(NULL, mem_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (mem_ptr == MAP_FAILED) {
+        ERROR_MESSAGE("mmap failed[%s]", strerror(errno));
+        return NULL;
+    }
+
+    if (!CdiOsMemBindToNumaNode(mem_ptr, mem_size, numa_node)) {
+        WARNING_MESSAGE("Memory could not be placed on NUMA node[%d]. Using any node.", numa_node);
+    }
+
+    // Touch each page now so it is backed by memory on the requested node before any other thread touches it.
+    const long page_size = sysconf(_SC_PAGESIZE);
+    for (int64_t offset = 0; offset < mem_size; offset += page_size) {
+        mem_ptr[offset] = 0;
+    }
+
+    return mem_ptr;
+}
+
+void CdiOsMemFreeOnNumaNode(void* mem_ptr, int64_t mem_size)
+{
+    assert(NULL != mem_ptr);
+    if (-1 == munmap(mem_ptr, mem_size)) {
+        ERROR_MESSAGE("munmap failed[%s]", strerror(errno));
+    }
+}
+
+bool CdiOsMemBindToNumaNode(void* mem_ptr, int64_t mem_size, int numa_node)
+{
+    if (CDI_NUMA_NODE_ANY == numa_node) {
+        return true;
+    }
+    if (numa_node < 0 || numa_node >= MAX_NUMA_NODES) {
+        ERROR_MESSAGE("Invalid NUMA node[%d].", numa_node);
+        return false;
+    }
+
+    unsigned long node_mask[MAX_NUMA_NODES / NODE_MASK_ELEMENT_BITS] = { 0 };
+    node_mask[numa_node / NODE_MASK_ELEMENT_BITS] = 1UL << (numa_node % NODE_MASK_ELEMENT_BITS);
+
+    // Use the preferred policy rather than a strict bind, so allocations fall back to other nodes instead of failing
+    // when the requested node runs out of memory. The kernel ignores the last bit of maxnode, hence the + 1.
+    if (-1 == syscall(SYS_mbind, mem_ptr, mem_size, MPOL_PREFERRED, node_mask, MAX_NUMA_NODES + 1, 0)) {
+        if (ENOSYS == errno) {
+            return true; // Kernel was built without NUMA support, so there is only one node.
+        }
+        ERROR_MESSAGE("mbind to NUMA node[%d] failed[%s]", numa_node, strerror(errno));
+        return false;
+    }
+
+    return true;
+}
+
+int CdiOsMemGetNumaNode(const void* mem_ptr)
+{
+    int numa_node = CDI_NUMA_NODE_ANY;
+    if (-1 == syscall(SYS_get_mempolicy, &numa_node, NULL, 0, mem_ptr, MPOL_F_NODE | MPOL_F_ADDR)) {
+        numa_node = CDI_NUMA_NODE_ANY;
+    }
+
+    return numa_node;
+}
+
+int CdiOsGetCpuNumaNode(int cpu_core_num)
+{
+    int numa_node = CDI_NUMA_NODE_ANY;
+    if (cpu_core_num < 0) {
+        return numa_node;
+    }
+
+    // Each CPU's sysfs directory contains a "node<n>" link to the node the CPU belongs to.
+    char path_str[64];
+    snprintf(path_str, sizeof(path_str), "/sys/devices/system/cpu/cpu%d", cpu_core_num);
+    DIR* dir_ptr = opendir(path_str);
+    if (dir_ptr) {
+        struct dirent* entry_ptr = NULL;
+        while (CDI_NUMA_NODE_ANY == numa_node && NULL != (entry_ptr = readdir(dir_ptr))) {
+            int node = 0;
+            if (1 == sscanf(entry_ptr->d_name, "node%d", &node)) {
+                numa_node = node;
+            }
+        }
+        closedir(dir_ptr);
+    }
+
+    return numa_node;
+}
+
 // -- File --
 bool CdiOsOpenForWrite(const char* file_name_str, CdiFileID* file_handle_ptr)
 {
@@ -27,6 +27,7 @@
 #include <crtdbg.h>
 #include <errno.h>
 #include <io.h>
+#include <limits.h>
 #include <Mmsystem.h>
 #include <malloc.h>
 #include <signal.h>
@@ -387,8 +388,15 @@ bool CdiOsThreadCreatePinned(CdiThreadFuncName thread_func, CdiThreadID* thread_
 
 bool CdiOsThreadAllocData(CdiThreadData* handle_out_ptr)
 {
-    CdiThreadData handle = TlsAlloc();
-    if (TLS_OUT_OF_INDEXES == handle)
+    return CdiOsThreadAllocDataWithDestructor(NULL, handle_out_ptr);
+}
+
+bool CdiOsThreadAllocDataWithDestructor(CdiThreadDataDestructor destructor_fn, CdiThreadData* handle_out_ptr)
+{
+    // Fiber local storage is used instead of thread local storage, since only it supports a destructor. For threads
+    // that don't use fibers, it behaves the same. NOTE: Assumes the x64 calling convention, where NTAPI has no effect.
+    CdiThreadData handle = FlsAlloc((PFLS_CALLBACK_FUNCTION)destructor_fn);
+    if (FLS_OUT_OF_INDEXES == handle)
         return false;
 
     *handle_out_ptr = handle;
@@ -397,7 +405,7 @@ bool CdiOsThreadAllocData(CdiThreadData* handle_out_ptr)
 
 bool CdiOsThreadFreeData(CdiThreadData handle)
 {
-    if (TlsFree(handle)) {
+    if (FlsFree(handle)) {
         return true;
     }
     return false;
@@ -405,7 +413,7 @@ bool CdiOsThreadFreeData(CdiThreadData handle)
 
 bool CdiOsThreadSetData(CdiThreadData handle, void* content_ptr)
 {
-    if (TlsSetValue(handle, content_ptr)) {
+    if (FlsSetValue(handle, content_ptr)) {
         return true;
     }
     return false;
@@ -413,7 +421,7 @@ bool CdiOsThreadSetData(CdiThreadData handle, void* content_ptr)
 
 bool CdiOsThreadGetData(CdiThreadData handle, void** content_out_ptr)
 {
-    *content_out_ptr = TlsGetValue(handle);
+    *content_out_ptr = FlsGetValue(handle);
 
     if (ERROR_SUCCESS != GetLastError()) {
         return false;
@@ -832,6 +840,47 @@ void CdiOsMemFreeHugePage(void* mem_ptr, int64_t mem_size)
     // Nothing needed, unless logic in alloc is implemented.
 }
 
+void* CdiOsMemAllocOnNumaNode(int64_t mem_size, int numa_node)
+{
+    // NUMA placement is not implemented on windows. VirtualAlloc() returns page aligned, zeroed memory.
+    void* mem_ptr = VirtualAlloc(NULL, (SIZE_T)mem_size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+
+    if (NULL == mem_ptr) {
+        LAST_ERROR_MESSAGE("VirtualAlloc failed");
+    }
+
+    return mem_ptr;
+}
+
+void CdiOsMemFreeOnNumaNode(void* mem_ptr, int64_t mem_size)
+{
+    assert(NULL != mem_ptr);
+    if (!VirtualFree(mem_ptr, 0, MEM_RELEASE)) {
+        LAST_ERROR_MESSAGE("VirtualFree failed");
+    }
+}
+
+bool CdiOsMemBindToNumaNode(void* mem_ptr, int64_t mem_size, int numa_node)
+{
+    return true; // Not implemented on windows.
+}
+
+int CdiOsMemGetNumaNode(const void* mem_ptr)
+{
+    return CDI_NUMA_NODE_ANY; // Not implemented on windows.
+}
+
+int CdiOsGetCpuNumaNode(int cpu_core_num)
+{
+    UCHAR numa_node = 0;
+
+    if (cpu_core_num < 0 || cpu_core_num > UCHAR_MAX || !GetNumaProcessorNode((UCHAR)cpu_core_num, &numa_node)) {
+        return CDI_NUMA_NODE_ANY;
+    }
+
+    return numa_node;
+}
+
 // -- File --
 bool CdiOsOpenForWrite(const char *file_name_str, CdiFileID *file_handle_ptr)
 {
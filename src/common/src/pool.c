@@ -32,7 +32,9 @@
 //*********************************************************************************************************************
 
 /**
- * @brief This structure represents a single pool item.
+ * @brief This structure represents a single pool item. Pools created with kPoolFlagSlimItems don't use this header, so
+ * for them a CdiPoolItem pointer is the address of the item's data and only list_entry is valid, while the item is
+ * free.
  */
 typedef struct {
     CdiSinglyLinkedListEntry list_entry; ///< List entry for this pool item.
@@ -40,35 +42,147 @@ typedef struct {
     uint8_t item_data_buffer[];          ///< Pointer to data space for this pool item.
 } CdiPoolItem;
 
+/**
+ * @brief This structure represents a magazine of free pool items cached by a thread. Only used by pools created with
+ * kPoolFlagThreadCache.
+ */
+typedef struct {
+    int item_count;            ///< Number of free items currently in the magazine.
+    CdiPoolItem* item_array[]; ///< Array of free items. Size of array is CdiPoolState.magazine_item_count.
+} PoolMagazine;
+
+/// Forward reference.
+typedef struct PoolThreadCache PoolThreadCache;
+
+/**
+ * @brief This structure holds the caches of a single thread, one for each pool created with kPoolFlagThreadCache that
+ * the thread has used. It is indexed by CdiPoolState.cache_slot. A single thread data slot for the whole process points
+ * to each thread's table, so the number of pools isn't limited by the number of thread data slots the OS provides.
+ * Only the owning thread reads its table. Changes are protected by thread_cache_mutex_lock.
+ */
+typedef struct {
+    int slot_count;                 ///< Number of entries in cache_array.
+    PoolThreadCache* cache_array[]; ///< The thread's cache for each pool slot, or NULL if the thread hasn't used it.
+} PoolThreadCacheTable;
+
+/**
+ * @brief This structure represents the magazines cached by a single thread. The thread that created the cache holds
+ * its busy flag while using the magazines. The flag is uncontended, except when a thread that would otherwise fail to
+ * get an item drains the caches of other threads (see ThreadCachesDrain()), which only takes caches that aren't busy.
+ */
+struct PoolThreadCache {
+    PoolThreadCache* next_ptr;  ///< Next cache in the pool's list of thread caches (protected by the pool's lock).
+    CdiPoolHandle pool_handle;  ///< Pool the cache belongs to. Used when the thread exits.
+    /// @brief Table of the thread that created the cache. Used to remove the cache from the table when the pool is
+    /// destroyed (protected by thread_cache_mutex_lock).
+    PoolThreadCacheTable* table_ptr;
+    int32_t busy;               ///< Non-zero while the cache's magazines are in use. Updated using atomic operations.
+    PoolMagazine* loaded_ptr;   ///< Magazine that items are taken from by get and added to by put.
+    PoolMagazine* previous_ptr; ///< Either a full or empty magazine. Swapped with loaded_ptr to avoid depot accesses.
+};
+
+/**
+ * @brief This structure represents a single cell of a lock-free depot.
+ */
+typedef struct {
+    int64_t sequence; ///< Sequence number used to determine if the cell is ready to be written to or read from.
+    void* data_ptr;   ///< Pointer stored in the cell.
+} PoolDepotCell;
+
+/**
+ * @brief This structure represents a bounded, lock-free, multiple producer/multiple consumer depot of pointers. It is
+ * used to exchange magazines between threads for pools created with kPoolFlagThreadCache. Each cell carries a sequence
+ * number, so pushing and popping only require a compare exchange on one of the positions below.
+ */
+typedef struct {
+    PoolDepotCell* cell_array;                 ///< Array of cells. The number of cells is a power of 2.
+    int64_t mask;                              ///< Number of cells minus one. Used to wrap positions into cell_array.
+    uint8_t pad1[CDI_CACHE_LINE_BYTE_SIZE];    ///< Keep enqueue_pos on its own cache line.
+    int64_t enqueue_pos;                       ///< Position of the next cell to write to.
+    uint8_t pad2[CDI_CACHE_LINE_BYTE_SIZE];    ///< Keep dequeue_pos on its own cache line.
+    int64_t dequeue_pos;                       ///< Position of the next cell to read from.
+    uint8_t pad3[CDI_CACHE_LINE_BYTE_SIZE];    ///< Keep data that follows off of the dequeue_pos cache line.
+} PoolDepot;
+
+/**
+ * @brief How the memory of a pool buffer was allocated, so it can be freed the same way.
+ */
+typedef enum {
+    kPoolBufferExisting,  ///< Buffer was provided by the caller and is not freed by the pool.
+    kPoolBufferHeap,      ///< Allocated using CdiOsMemAllocZero().
+    kPoolBufferNumaNode,  ///< Allocated using CdiOsMemAllocOnNumaNode().
+    kPoolBufferHugePages, ///< Allocated using CdiOsMemAllocHugePage().
+} PoolBufferType;
+
+/**
+ * @brief This structure describes one of the buffers that holds a pool's items.
+ */
+typedef struct {
+    void* buffer_ptr;    ///< Start of the buffer. Begins with the buffer's entry in allocated_buffer_list.
+    uint64_t byte_size;  ///< Number of bytes allocated.
+    PoolBufferType type; ///< How the buffer was allocated.
+} PoolBuffer;
+
 /**
  * @brief This structure represents the current state of a memory pool.
  */
 typedef struct {
     char name_str[MAX_POOL_NAME_LENGTH];       ///< Name of pool, used for informational purposes only.
     int pool_item_data_byte_size;              ///< Size of the data portion of each item in bytes.
-    int pool_item_byte_size;                   ///< Size of each item in bytes (sizeof(CdiPoolItem) + data portion).
+    int pool_item_byte_size;                   ///< Size of each item in bytes (item_header_byte_size + data portion).
+    int item_header_byte_size;                 ///< sizeof(CdiPoolItem), or 0 for pools created with kPoolFlagSlimItems.
     int pool_item_count;                       ///< Number of items in the pool array.
     int pool_grow_count;                       ///< Number of pool items the pool array may be increased by.
     int pool_cur_grow_count;                   ///< Number of times the current pool has been increased.
     int pool_max_grow_count;                   ///< The maximum number of times the pool can be increased.
     CdiPoolItemOperatorFunction init_fn_ptr;   ///< Pointer to initialization function that this memory pool may have.
     void* init_context_ptr;                    ///< Pointer used by initialization function that this memory pool may have.
-    bool is_existing_buffer;                   ///< Using an existing buffer. Don't free the memory when pool destroyed.
+    int numa_node;                             ///< NUMA node pool buffers are allocated on, or CDI_NUMA_NODE_ANY.
+    bool use_huge_pages;                       ///< If true, try to allocate pool buffers using huge pages.
     CdiSinglyLinkedList allocated_buffer_list; ///< Linked list of memory pools.
     CdiSinglyLinkedList free_list;             ///< List of free items.
+    bool track_in_use;                         ///< If true, in_use_list is maintained by get and put.
     CdiList in_use_list;                       ///< Doubly linked list of items currently in use.
     CdiCsID lock;                              ///< Lock used to protect multi-thread access the pool.
     CdiPoolCallback pool_cb_ptr;               ///< Pointer to user-provided callback function
+    int high_water_count;                      ///< Largest number of items in use at the same time (protected by lock).
+    int get_fail_count;                        ///< Number of gets that failed. Updated using atomic operations.
+
+    // The members below are only used by pools created with kPoolFlagThreadCache.
+    bool use_thread_cache;                     ///< If true, each thread uses its own cache of free items.
+    int magazine_item_count;                   ///< Maximum number of items in each magazine.
+    int cache_slot;                            ///< Index of the pool's caches in each PoolThreadCacheTable.
+    PoolThreadCache* thread_cache_list_ptr;    ///< List of all thread caches for this pool (protected by lock).
+    int depot_item_count;                      ///< Number of free items in full magazines stored in full_depot.
+    PoolDepot full_depot;                      ///< Depot of magazines that are full of free items.
+    PoolDepot empty_depot;                     ///< Depot of empty magazines.
+
+    int buffer_count;                          ///< Number of valid entries in buffer_array.
+    /// @brief The initial buffer followed by one buffer for each time the pool was increased. Holds
+    /// 1 + pool_max_grow_count entries.
+    PoolBuffer buffer_array[];
 } CdiPoolState;
 
 //*********************************************************************************************************************
 //*********************************************** START OF VARIABLES **************************************************
 //*********************************************************************************************************************
 
+/// Lock used to protect the variables below, the contents of every PoolThreadCacheTable and the creation and removal of
+/// thread caches. Taken before the lock of a pool, never after it.
+static CdiStaticMutexType thread_cache_mutex_lock = CDI_STATIC_MUTEX_INITIALIZER;
+static bool thread_cache_data_valid = false; ///< If true, thread_cache_data is valid (it can be zero and be valid).
+/// Thread data slot shared by all pools, used to store each thread's PoolThreadCacheTable pointer. Allocated when the
+/// first pool created with kPoolFlagThreadCache is created and never freed.
+static CdiThreadData thread_cache_data = 0;
+static bool* cache_slot_used_array = NULL;   ///< Entries are true for the slots used by existing pools.
+static int cache_slot_count = 0;             ///< Number of entries in cache_slot_used_array.
+
 //*********************************************************************************************************************
 //******************************************* START OF STATIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
 
+static bool PoolIncrease(CdiPoolHandle handle_ptr);
+
 /**
  * If lock used to protect pool resources from multi-threaded access exists, reserve it.
  *
@@ -96,25 +210,142 @@ static inline void MultithreadedRelease(CdiPoolState* state_ptr)
 /**
  * @brief Get pointer to the item's parent object (CdiPoolItem).
  *
+ * @param state_ptr Pool state information.
  * @param item_ptr Pointer to object being queried.
  *
  * @return Pointer to parent of object.
  */
-static inline CdiPoolItem* GetPoolItemFromItemDataPointer(const void* item_ptr)
+static inline CdiPoolItem* GetPoolItemFromItemDataPointer(const CdiPoolState* state_ptr, const void* item_ptr)
 {
-    return CONTAINER_OF(item_ptr, CdiPoolItem, item_data_buffer);
+    return (CdiPoolItem*)((const uint8_t*)item_ptr - state_ptr->item_header_byte_size);
 }
 
 /**
  * @brief Get pointer to the item's data given the address of the pool item (CdiPoolItem).
  *
+ * @param state_ptr Pool state information.
  * @param pool_item_ptr Pointer to pool item.
  *
  * @return Pointer to item's data.
  */
-static inline uint8_t* GetDataItem(CdiPoolItem* pool_item_ptr)
+static inline uint8_t* GetDataItem(const CdiPoolState* state_ptr, CdiPoolItem* pool_item_ptr)
+{
+    return (uint8_t*)pool_item_ptr + state_ptr->item_header_byte_size;
+}
+
+/**
+ * @brief Get the number of bytes used by each item of a pool.
+ *
+ * @param item_byte_size Size of the data portion of each item in bytes.
+ * @param flags Flags used to create the pool.
+ *
+ * @return Number of bytes.
+ */
+static uint32_t GetItemStride(uint32_t item_byte_size, CdiPoolFlags flags)
+{
+    if (flags & kPoolFlagSlimItems) {
+        // Free items hold the free list link, so they must be large enough and aligned for it.
+        uint32_t stride = (item_byte_size > sizeof(CdiSinglyLinkedListEntry)) ? item_byte_size :
+                                                                                sizeof(CdiSinglyLinkedListEntry);
+        return (stride + sizeof(void*) - 1) & ~(uint32_t)(sizeof(void*) - 1);
+    }
+    return sizeof(CdiPoolItem) + item_byte_size;
+}
+
+/**
+ * @brief Get the size of a pool buffer that holds the specified number of items.
+ *
+ * @param item_count Number of items in the buffer.
+ * @param item_stride Number of bytes used by each item (see GetItemStride()).
+ *
+ * @return Size of buffer in bytes.
+ */
+static inline uint32_t GetBufferSizeNeeded(uint32_t item_count, uint32_t item_stride)
+{
+    // Each group of buffer allocations (one initially plus one for each increase) requires a singly linked list entry.
+    return sizeof(CdiSinglyLinkedListEntry) + (item_count * item_stride);
+}
+
+/**
+ * Update the pool's high-water mark of items in use. Items held in thread caches and the depot are counted as in use,
+ * so for pools created with kPoolFlagThreadCache the mark is only updated when a thread refills its cache from the free
+ * list. NOTE: this function assumes that MultiThreadedReserve() has been called first.
+ *
+ * @param state_ptr Pool state information.
+ */
+static inline void UpdateHighWaterCount(CdiPoolState* state_ptr)
 {
-    return pool_item_ptr->item_data_buffer;
+    int in_use_count = state_ptr->pool_item_count - CdiSinglyLinkedListSize(&state_ptr->free_list);
+    if (state_ptr->use_thread_cache) {
+        in_use_count -= CdiOsAtomicLoad32(&state_ptr->depot_item_count);
+    }
+    if (in_use_count > state_ptr->high_water_count) {
+        state_ptr->high_water_count = in_use_count;
+    }
+}
+
+/**
+ * Allocate a zeroed buffer for pool items. If requested and the buffer is large enough, huge pages are used, falling
+ * back to regular pages if none are available. The buffer is placed on the specified NUMA node.
+ *
+ * @param use_huge_pages If true, try to use huge pages.
+ * @param numa_node NUMA node to allocate the buffer on, or CDI_NUMA_NODE_ANY.
+ * @param byte_size Size of the buffer in bytes.
+ * @param ret_buffer_ptr Address where to write the description of the allocated buffer.
+ *
+ * @return true if successful, otherwise false (not enough memory).
+ */
+static bool PoolBufferAlloc(bool use_huge_pages, int numa_node, uint64_t byte_size, PoolBuffer* ret_buffer_ptr)
+{
+    ret_buffer_ptr->buffer_ptr = NULL;
+    ret_buffer_ptr->byte_size = byte_size;
+    ret_buffer_ptr->type = (CDI_NUMA_NODE_ANY == numa_node) ? kPoolBufferHeap : kPoolBufferNumaNode;
+
+    // Buffers that only span a few regular pages gain little from huge pages and would waste most of one.
+    if (use_huge_pages && byte_size >= POOL_HUGE_PAGES_MIN_BYTE_SIZE) {
+        uint64_t huge_byte_size = ((byte_size + CDI_HUGE_PAGES_BYTE_SIZE - 1) / CDI_HUGE_PAGES_BYTE_SIZE) *
+                                  CDI_HUGE_PAGES_BYTE_SIZE;
+        ret_buffer_ptr->buffer_ptr = CdiOsMemAllocHugePage(huge_byte_size);
+        if (ret_buffer_ptr->buffer_ptr) {
+            // Huge pages are zero filled and not touched until items are added to the pool, so the node can still be
+            // set here.
+            CdiOsMemBindToNumaNode(ret_buffer_ptr->buffer_ptr, huge_byte_size, numa_node);
+            ret_buffer_ptr->byte_size = huge_byte_size;
+            ret_buffer_ptr->type = kPoolBufferHugePages;
+        }
+    }
+
+    if (NULL == ret_buffer_ptr->buffer_ptr) {
+        if (kPoolBufferHeap == ret_buffer_ptr->type) {
+            ret_buffer_ptr->buffer_ptr = CdiOsMemAllocZero(byte_size);
+        } else {
+            ret_buffer_ptr->buffer_ptr = CdiOsMemAllocOnNumaNode(byte_size, numa_node);
+        }
+    }
+
+    return NULL != ret_buffer_ptr->buffer_ptr;
+}
+
+/**
+ * Free a buffer that was allocated using PoolBufferAlloc(). Nothing is done for existing buffers.
+ *
+ * @param buffer_ptr Pointer to the description of the buffer.
+ */
+static void PoolBufferFree(const PoolBuffer* buffer_ptr)
+{
+    switch (buffer_ptr->type) {
+        case kPoolBufferExisting:
+            break;
+        case kPoolBufferHeap:
+            CdiOsMemFree(buffer_ptr->buffer_ptr);
+            break;
+        case kPoolBufferNumaNode:
+            CdiOsMemFreeOnNumaNode(buffer_ptr->buffer_ptr, buffer_ptr->byte_size);
+            break;
+        case kPoolBufferHugePages:
+            CdiOsMemFreeHugePage(buffer_ptr->buffer_ptr, buffer_ptr->byte_size);
+            break;
+    }
 }
 
 /**
@@ -141,13 +372,682 @@ static inline bool AddEntriesToBuffers(CdiPoolState* state_ptr, uint8_t* pool_it
         CdiPoolItem* pool_item_ptr = (CdiPoolItem*)(pool_item_array_offset + state_ptr->pool_item_byte_size * i);
         CdiSinglyLinkedListPushHead(&state_ptr->free_list, &pool_item_ptr->list_entry);
         if (state_ptr->init_fn_ptr != NULL) {
-            ret = state_ptr->init_fn_ptr(state_ptr->init_context_ptr, GetDataItem(pool_item_ptr));
+            ret = state_ptr->init_fn_ptr(state_ptr->init_context_ptr, GetDataItem(state_ptr, pool_item_ptr));
         }
     }
 
     return ret;
 }
 
+/**
+ * Create a depot that holds at least the specified number of pointers.
+ *
+ * @param depot_ptr Pointer to depot to initialize.
+ * @param min_cell_count Minimum number of pointers the depot must be able to hold.
+ *
+ * @return true if successful, otherwise false (not enough memory).
+ */
+static bool DepotCreate(PoolDepot* depot_ptr, int min_cell_count)
+{
+    int cell_count = 2;
+    while (cell_count < min_cell_count) {
+        cell_count *= 2;
+    }
+
+    depot_ptr->cell_array = (PoolDepotCell*)CdiOsMemAlloc(cell_count * sizeof(PoolDepotCell));
+    if (NULL == depot_ptr->cell_array) {
+        return false;
+    }
+    for (int i = 0; i < cell_count; i++) {
+        depot_ptr->cell_array[i].sequence = i;
+        depot_ptr->cell_array[i].data_ptr = NULL;
+    }
+    depot_ptr->mask = cell_count - 1;
+    depot_ptr->enqueue_pos = 0;
+    depot_ptr->dequeue_pos = 0;
+
+    return true;
+}
+
+/**
+ * Push a pointer into a depot. This function is thread-safe and does not use locks.
+ *
+ * @param depot_ptr Pointer to depot.
+ * @param data_ptr Pointer to store in the depot.
+ *
+ * @return true if successful, otherwise false (depot is full).
+ */
+static bool DepotPush(PoolDepot* depot_ptr, void* data_ptr)
+{
+    PoolDepotCell* cell_ptr = NULL;
+    int64_t pos = CdiOsAtomicLoad64(&depot_ptr->enqueue_pos);
+    while (true) {
+        cell_ptr = &depot_ptr->cell_array[pos & depot_ptr->mask];
+        int64_t diff = CdiOsAtomicLoad64(&cell_ptr->sequence) - pos;
+        if (0 == diff) {
+            // Cell is ready to be written. Claim it by advancing the enqueue position.
+            if (CdiOsAtomicCompareExchange64(&depot_ptr->enqueue_pos, pos, pos + 1)) {
+                break;
+            }
+            pos = CdiOsAtomicLoad64(&depot_ptr->enqueue_pos);
+        } else if (diff < 0) {
+            return false; // Cell has not been read yet, so the depot is full.
+        } else {
+            pos = CdiOsAtomicLoad64(&depot_ptr->enqueue_pos); // Another thread claimed the cell, so try again.
+        }
+    }
+
+    cell_ptr->data_ptr = data_ptr;
+    CdiOsAtomicStore64(&cell_ptr->sequence, pos + 1); // Publish the data to readers.
+
+    return true;
+}
+
+/**
+ * Pop a pointer from a depot. This function is thread-safe and does not use locks.
+ *
+ * @param depot_ptr Pointer to depot.
+ * @param ret_data_ptr Address where to write the returned pointer.
+ *
+ * @return true if successful, otherwise false (depot is empty).
+ */
+static bool DepotPop(PoolDepot* depot_ptr, void** ret_data_ptr)
+{
+    PoolDepotCell* cell_ptr = NULL;
+    int64_t pos = CdiOsAtomicLoad64(&depot_ptr->dequeue_pos);
+    while (true) {
+        cell_ptr = &depot_ptr->cell_array[pos & depot_ptr->mask];
+        int64_t diff = CdiOsAtomicLoad64(&cell_ptr->sequence) - (pos + 1);
+        if (0 == diff) {
+            // Cell contains data. Claim it by advancing the dequeue position.
+            if (CdiOsAtomicCompareExchange64(&depot_ptr->dequeue_pos, pos, pos + 1)) {
+                break;
+            }
+            pos = CdiOsAtomicLoad64(&depot_ptr->dequeue_pos);
+        } else if (diff < 0) {
+            return false; // Cell has not been written yet, so the depot is empty.
+        } else {
+            pos = CdiOsAtomicLoad64(&depot_ptr->dequeue_pos); // Another thread claimed the cell, so try again.
+        }
+    }
+
+    *ret_data_ptr = cell_ptr->data_ptr;
+    CdiOsAtomicStore64(&cell_ptr->sequence, pos + depot_ptr->mask + 1); // Make the cell available to writers.
+
+    return true;
+}
+
+/**
+ * Free the memory used by a depot. Any pointers still stored in the depot are not freed.
+ *
+ * @param depot_ptr Pointer to depot.
+ */
+static void DepotDestroy(PoolDepot* depot_ptr)
+{
+    CdiOsMemFree(depot_ptr->cell_array);
+    depot_ptr->cell_array = NULL;
+}
+
+/**
+ * Get an empty magazine, either from the pool's depot of empty magazines or by allocating a new one.
+ *
+ * @param state_ptr Pool state information.
+ *
+ * @return Pointer to empty magazine or NULL if not enough memory.
+ */
+static PoolMagazine* MagazineGetEmpty(CdiPoolState* state_ptr)
+{
+    PoolMagazine* magazine_ptr = NULL;
+    if (!DepotPop(&state_ptr->empty_depot, (void**)&magazine_ptr)) {
+        magazine_ptr = (PoolMagazine*)CdiOsMemAlloc(sizeof(PoolMagazine) +
+                                                    state_ptr->magazine_item_count * sizeof(CdiPoolItem*));
+    }
+    if (magazine_ptr) {
+        magazine_ptr->item_count = 0;
+    }
+
+    return magazine_ptr;
+}
+
+/**
+ * Return an empty magazine to the pool's depot of empty magazines. If the depot is full, the magazine is freed.
+ *
+ * @param state_ptr Pool state information.
+ * @param magazine_ptr Pointer to empty magazine.
+ */
+static void MagazinePutEmpty(CdiPoolState* state_ptr, PoolMagazine* magazine_ptr)
+{
+    if (!DepotPush(&state_ptr->empty_depot, magazine_ptr)) {
+        CdiOsMemFree(magazine_ptr);
+    }
+}
+
+/**
+ * Try to mark a thread cache as busy.
+ *
+ * @param cache_ptr Pointer to thread cache.
+ *
+ * @return true if the cache was not busy and is now marked busy, otherwise false.
+ */
+static inline bool ThreadCacheTryReserve(PoolThreadCache* cache_ptr)
+{
+    return CdiOsAtomicCompareExchange32(&cache_ptr->busy, 0, 1);
+}
+
+/**
+ * Mark a thread cache as no longer busy.
+ *
+ * @param cache_ptr Pointer to thread cache.
+ */
+static inline void ThreadCacheRelease(PoolThreadCache* cache_ptr)
+{
+    CdiOsAtomicStore32(&cache_ptr->busy, 0);
+}
+
+/**
+ * Move all items held by a thread cache's magazines to the pool's free list. NOTE: this function assumes that
+ * MultiThreadedReserve() has been called first and that the cache is not in use by its thread.
+ *
+ * @param state_ptr Pool state information.
+ * @param cache_ptr Pointer to thread cache.
+ *
+ * @return Number of items moved.
+ */
+static int ThreadCacheEmpty(CdiPoolState* state_ptr, PoolThreadCache* cache_ptr)
+{
+    int count = 0;
+    PoolMagazine* magazine_array[] = { cache_ptr->loaded_ptr, cache_ptr->previous_ptr };
+    for (int i = 0; i < (int)CDI_ARRAY_ELEMENT_COUNT(magazine_array); i++) {
+        PoolMagazine* magazine_ptr = magazine_array[i];
+        while (magazine_ptr->item_count) {
+            CdiSinglyLinkedListPushHead(&state_ptr->free_list,
+                                        &magazine_ptr->item_array[--magazine_ptr->item_count]->list_entry);
+            count++;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Move the free items held by the depot and by the caches of threads that aren't currently using them to the pool's
+ * free list. Used before failing a get, so free items held by idle threads don't exhaust a pool that can't grow. NOTE:
+ * this function assumes that MultiThreadedReserve() has been called first.
+ *
+ * @param state_ptr Pool state information.
+ *
+ * @return Number of items moved to the free list.
+ */
+static int ThreadCachesDrain(CdiPoolState* state_ptr)
+{
+    int count = 0;
+    PoolMagazine* magazine_ptr = NULL;
+    while (DepotPop(&state_ptr->full_depot, (void**)&magazine_ptr)) {
+        CdiOsAtomicAdd32(&state_ptr->depot_item_count, -magazine_ptr->item_count);
+        while (magazine_ptr->item_count) {
+            CdiSinglyLinkedListPushHead(&state_ptr->free_list,
+                                        &magazine_ptr->item_array[--magazine_ptr->item_count]->list_entry);
+            count++;
+        }
+        MagazinePutEmpty(state_ptr, magazine_ptr);
+    }
+
+    // Caches that are busy belong to active threads, including the calling thread, so skip them. Their threads can't
+    // be waiting for the pool's lock while they hold the cache, since the lock is only reserved after the cache.
+    for (PoolThreadCache* cache_ptr = state_ptr->thread_cache_list_ptr; cache_ptr; cache_ptr = cache_ptr->next_ptr) {
+        if (ThreadCacheTryReserve(cache_ptr)) {
+            count += ThreadCacheEmpty(state_ptr, cache_ptr);
+            ThreadCacheRelease(cache_ptr);
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Called when a thread that has used a pool created with kPoolFlagThreadCache exits. Returns the items held by each of
+ * the thread's caches to the free list of their pool and frees the caches and the thread's cache table. Holding
+ * thread_cache_mutex_lock ensures that a pool being destroyed at the same time either frees its caches before they are
+ * reached here or is not destroyed until this function is done with them (see ThreadCacheDestroy()).
+ *
+ * @param content_ptr Pointer to the exiting thread's cache table.
+ */
+static void ThreadCacheTableExit(void* content_ptr)
+{
+    PoolThreadCacheTable* table_ptr = (PoolThreadCacheTable*)content_ptr;
+
+    CdiOsStaticMutexLock(thread_cache_mutex_lock);
+    for (int i = 0; i < table_ptr->slot_count; i++) {
+        PoolThreadCache* cache_ptr = table_ptr->cache_array[i];
+        if (NULL == cache_ptr) {
+            continue;
+        }
+        CdiPoolState* state_ptr = (CdiPoolState*)cache_ptr->pool_handle;
+
+        MultithreadedReserve(state_ptr);
+        ThreadCacheEmpty(state_ptr, cache_ptr);
+        for (PoolThreadCache** link_ptr = &state_ptr->thread_cache_list_ptr; *link_ptr;
+             link_ptr = &(*link_ptr)->next_ptr) {
+            if (cache_ptr == *link_ptr) {
+                *link_ptr = cache_ptr->next_ptr;
+                break;
+            }
+        }
+        MagazinePutEmpty(state_ptr, cache_ptr->loaded_ptr);
+        MagazinePutEmpty(state_ptr, cache_ptr->previous_ptr);
+        MultithreadedRelease(state_ptr);
+
+        CdiOsMemFree(cache_ptr);
+    }
+    CdiOsStaticMutexUnlock(thread_cache_mutex_lock);
+
+    CdiOsMemFree(table_ptr);
+}
+
+/**
+ * Get the calling thread's cache table, replacing it with a larger one if it has no entry for the specified slot. NOTE:
+ * this function assumes that thread_cache_mutex_lock is held.
+ *
+ * @param slot Slot of the pool the caller needs an entry for.
+ *
+ * @return Pointer to the thread's cache table or NULL if it could not be created.
+ */
+static PoolThreadCacheTable* ThreadCacheTableGet(int slot)
+{
+    PoolThreadCacheTable* table_ptr = NULL;
+    CdiOsThreadGetData(thread_cache_data, (void**)&table_ptr);
+    if (table_ptr && slot < table_ptr->slot_count) {
+        return table_ptr;
+    }
+
+    // Size the table for every slot currently in use, so it only grows again when more pools are created.
+    PoolThreadCacheTable* new_table_ptr = (PoolThreadCacheTable*)CdiOsMemAllocZero(sizeof(PoolThreadCacheTable) +
+                                                                 cache_slot_count * sizeof(PoolThreadCache*));
+    if (NULL == new_table_ptr) {
+        return NULL;
+    }
+    if (!CdiOsThreadSetData(thread_cache_data, new_table_ptr)) {
+        CdiOsMemFree(new_table_ptr);
+        return NULL;
+    }
+    new_table_ptr->slot_count = cache_slot_count;
+    if (table_ptr) {
+        for (int i = 0; i < table_ptr->slot_count; i++) {
+            PoolThreadCache* cache_ptr = table_ptr->cache_array[i];
+            new_table_ptr->cache_array[i] = cache_ptr;
+            if (cache_ptr) {
+                cache_ptr->table_ptr = new_table_ptr;
+            }
+        }
+        CdiOsMemFree(table_ptr);
+    }
+
+    return new_table_ptr;
+}
+
+/**
+ * Get the calling thread's cache for the pool, creating it if this is the first time the thread has used the pool.
+ * The cache is marked busy, so ThreadCacheRelease() must be called when done using it.
+ *
+ * @param state_ptr Pool state information.
+ *
+ * @return Pointer to the thread's cache or NULL if it could not be created.
+ */
+static PoolThreadCache* GetThreadCache(CdiPoolState* state_ptr)
+{
+    // Only the calling thread changes its table pointer and entries other threads change belong to destroyed pools, so
+    // no lock is needed to find an existing cache.
+    PoolThreadCacheTable* table_ptr = NULL;
+    CdiOsThreadGetData(thread_cache_data, (void**)&table_ptr);
+    PoolThreadCache* cache_ptr = (table_ptr && state_ptr->cache_slot < table_ptr->slot_count) ?
+                                 table_ptr->cache_array[state_ptr->cache_slot] : NULL;
+    if (cache_ptr) {
+        // Only fails while another thread drains the cache, which doesn't take long.
+        while (!ThreadCacheTryReserve(cache_ptr)) {
+        }
+        return cache_ptr;
+    }
+
+    cache_ptr = (PoolThreadCache*)CdiOsMemAllocZero(sizeof(PoolThreadCache));
+    if (cache_ptr) {
+        cache_ptr->pool_handle = (CdiPoolHandle)state_ptr;
+        cache_ptr->busy = 1;
+        cache_ptr->loaded_ptr = MagazineGetEmpty(state_ptr);
+        cache_ptr->previous_ptr = MagazineGetEmpty(state_ptr);
+        if (cache_ptr->loaded_ptr && cache_ptr->previous_ptr) {
+            // Add to the thread's table and to the pool's list of caches, so the pool can account for items held by
+            // the cache.
+            CdiOsStaticMutexLock(thread_cache_mutex_lock);
+            table_ptr = ThreadCacheTableGet(state_ptr->cache_slot);
+            if (table_ptr) {
+                cache_ptr->table_ptr = table_ptr;
+                table_ptr->cache_array[state_ptr->cache_slot] = cache_ptr;
+                MultithreadedReserve(state_ptr);
+                cache_ptr->next_ptr = state_ptr->thread_cache_list_ptr;
+                state_ptr->thread_cache_list_ptr = cache_ptr;
+                MultithreadedRelease(state_ptr);
+            }
+            CdiOsStaticMutexUnlock(thread_cache_mutex_lock);
+        }
+        if (NULL == cache_ptr->table_ptr) {
+            if (cache_ptr->loaded_ptr) {
+                CdiOsMemFree(cache_ptr->loaded_ptr);
+            }
+            if (cache_ptr->previous_ptr) {
+                CdiOsMemFree(cache_ptr->previous_ptr);
+            }
+            CdiOsMemFree(cache_ptr);
+            cache_ptr = NULL;
+        }
+    }
+
+    if (NULL == cache_ptr) {
+        CDI_LOG_THREAD(kLogError, "Failed to create thread cache for pool[%s]. Using locks.", state_ptr->name_str);
+    }
+
+    return cache_ptr;
+}
+
+/**
+ * Swap the loaded and previous magazines of a thread cache.
+ *
+ * @param cache_ptr Pointer to thread cache.
+ */
+static inline void SwapMagazines(PoolThreadCache* cache_ptr)
+{
+    PoolMagazine* tmp_ptr = cache_ptr->loaded_ptr;
+    cache_ptr->loaded_ptr = cache_ptr->previous_ptr;
+    cache_ptr->previous_ptr = tmp_ptr;
+}
+
+/**
+ * Get a free item using the calling thread's cache. Locks are only used if the depot does not contain any full
+ * magazines.
+ *
+ * @param state_ptr Pool state information.
+ * @param cache_ptr Pointer to the calling thread's cache.
+ *
+ * @return Pointer to free item or NULL if the pool is empty and cannot be increased.
+ */
+static CdiPoolItem* ThreadCacheGet(CdiPoolState* state_ptr, PoolThreadCache* cache_ptr)
+{
+    if (0 == cache_ptr->loaded_ptr->item_count) {
+        PoolMagazine* full_magazine_ptr = NULL;
+        if (cache_ptr->previous_ptr->item_count) {
+            SwapMagazines(cache_ptr);
+        } else if (DepotPop(&state_ptr->full_depot, (void**)&full_magazine_ptr)) {
+            CdiOsAtomicAdd32(&state_ptr->depot_item_count, -full_magazine_ptr->item_count);
+            // Both of our magazines are empty. Keep one and return the other to the depot.
+            MagazinePutEmpty(state_ptr, cache_ptr->previous_ptr);
+            cache_ptr->previous_ptr = cache_ptr->loaded_ptr;
+            cache_ptr->loaded_ptr = full_magazine_ptr;
+        } else {
+            // Depot is empty, so refill the loaded magazine from the free list (increasing the pool if necessary). As a
+            // last resort, take the items held by the caches of idle threads.
+            PoolMagazine* magazine_ptr = cache_ptr->loaded_ptr;
+            bool drained = false;
+            MultithreadedReserve(state_ptr);
+            while (magazine_ptr->item_count < state_ptr->magazine_item_count) {
+                CdiPoolItem* pool_item_ptr = (CdiPoolItem*)CdiSinglyLinkedListPopHead(&state_ptr->free_list);
+                if (NULL == pool_item_ptr) {
+                    if (magazine_ptr->item_count) {
+                        break;
+                    }
+                    if (!PoolIncrease((CdiPoolHandle)state_ptr)) {
+                        if (drained || 0 == ThreadCachesDrain(state_ptr)) {
+                            break;
+                        }
+                        drained = true;
+                    }
+                } else {
+                    magazine_ptr->item_array[magazine_ptr->item_count++] = pool_item_ptr;
+                }
+            }
+            UpdateHighWaterCount(state_ptr);
+            MultithreadedRelease(state_ptr);
+        }
+    }
+
+    PoolMagazine* magazine_ptr = cache_ptr->loaded_ptr;
+    return (magazine_ptr->item_count) ? magazine_ptr->item_array[--magazine_ptr->item_count] : NULL;
+}
+
+/**
+ * Put a free item using the calling thread's cache. Locks are only used if the depot cannot accept a full magazine.
+ *
+ * @param state_ptr Pool state information.
+ * @param cache_ptr Pointer to the calling thread's cache.
+ * @param pool_item_ptr Pointer to item being freed.
+ */
+static void ThreadCachePut(CdiPoolState* state_ptr, PoolThreadCache* cache_ptr, CdiPoolItem* pool_item_ptr)
+{
+    if (state_ptr->magazine_item_count == cache_ptr->loaded_ptr->item_count) {
+        if (0 == cache_ptr->previous_ptr->item_count) {
+            SwapMagazines(cache_ptr);
+        } else {
+            // Both of our magazines are full. Move one to the depot, replacing it with an empty one.
+            PoolMagazine* full_magazine_ptr = cache_ptr->previous_ptr;
+            PoolMagazine* empty_magazine_ptr = MagazineGetEmpty(state_ptr);
+            CdiOsAtomicAdd32(&state_ptr->depot_item_count, full_magazine_ptr->item_count);
+            if (empty_magazine_ptr && DepotPush(&state_ptr->full_depot, full_magazine_ptr)) {
+                cache_ptr->previous_ptr = cache_ptr->loaded_ptr;
+                cache_ptr->loaded_ptr = empty_magazine_ptr;
+            } else {
+                // Should never happen, since the depot is sized to hold all items. Fall back to the free list.
+                CdiOsAtomicAdd32(&state_ptr->depot_item_count, -full_magazine_ptr->item_count);
+                if (empty_magazine_ptr) {
+                    MagazinePutEmpty(state_ptr, empty_magazine_ptr);
+                }
+                PoolMagazine* magazine_ptr = cache_ptr->loaded_ptr;
+                MultithreadedReserve(state_ptr);
+                while (magazine_ptr->item_count) {
+                    CdiSinglyLinkedListPushHead(&state_ptr->free_list,
+                                                &magazine_ptr->item_array[--magazine_ptr->item_count]->list_entry);
+                }
+                MultithreadedRelease(state_ptr);
+            }
+        }
+    }
+
+    PoolMagazine* magazine_ptr = cache_ptr->loaded_ptr;
+    magazine_ptr->item_array[magazine_ptr->item_count++] = pool_item_ptr;
+}
+
+/**
+ * Get the number of free items in the pool, including items held in thread caches and the depot. NOTE: this function
+ * assumes that MultiThreadedReserve() has been called first.
+ *
+ * @param state_ptr Pool state information.
+ *
+ * @return Number of free items.
+ */
+static int GetFreeItemCount(CdiPoolState* state_ptr)
+{
+    int count = CdiSinglyLinkedListSize(&state_ptr->free_list);
+    if (state_ptr->use_thread_cache) {
+        count += CdiOsAtomicLoad32(&state_ptr->depot_item_count);
+        for (PoolThreadCache* cache_ptr = state_ptr->thread_cache_list_ptr; cache_ptr; cache_ptr = cache_ptr->next_ptr) {
+            count += cache_ptr->loaded_ptr->item_count + cache_ptr->previous_ptr->item_count;
+        }
+    }
+
+    return count;
+}
+
+/**
+ * Call a function for every item in each of the pool's allocated buffers, regardless of whether it is free or in use.
+ *
+ * @param state_ptr Pool state information.
+ * @param operator_function Pointer to a function that is to be called once for each item in the pool.
+ * @param context_ptr This value is passed as the first argument to the operator function.
+ *
+ * @return false if operator_function returned false for at least one item in the pool, otherwise true.
+ */
+static bool ForEachAllocatedItem(CdiPoolState* state_ptr, CdiPoolItemOperatorFunction operator_function,
+                                 const void* context_ptr)
+{
+    bool ret = true;
+
+    // Buffers are pushed onto the head of allocated_buffer_list, so the last one is the initial buffer and all of the
+    // others are from PoolIncrease().
+    int grow_items = state_ptr->pool_grow_count * state_ptr->pool_cur_grow_count;
+    for (CdiSinglyLinkedListEntry* buffer_ptr = state_ptr->allocated_buffer_list.head_ptr; NULL != buffer_ptr;
+         buffer_ptr = buffer_ptr->next_ptr) {
+        int item_count = (buffer_ptr->next_ptr) ? state_ptr->pool_grow_count :
+                                                  state_ptr->pool_item_count - grow_items;
+        uint8_t* pool_item_array = (uint8_t*)buffer_ptr + sizeof(CdiSinglyLinkedListEntry);
+        for (int i = 0; i < item_count; i++) {
+            CdiPoolItem* pool_item_ptr = (CdiPoolItem*)(pool_item_array + state_ptr->pool_item_byte_size * i);
+            ret = operator_function(context_ptr, GetDataItem(state_ptr, pool_item_ptr)) && ret;
+        }
+    }
+
+    return ret;
+}
+
+/**
+ * Operator function used with ForEachAllocatedItem() to add a pool item to the pool's free list.
+ *
+ * @param context_ptr Pointer to pool state information.
+ * @param item_ptr Pointer to the item's data.
+ *
+ * @return true always.
+ */
+static bool AddItemToFreeList(const void* context_ptr, void* item_ptr)
+{
+    CdiPoolState* state_ptr = (CdiPoolState*)context_ptr;
+    CdiPoolItem* pool_item_ptr = GetPoolItemFromItemDataPointer(state_ptr, item_ptr);
+    CdiSinglyLinkedListPushHead(&state_ptr->free_list, &pool_item_ptr->list_entry);
+    return true;
+}
+
+/**
+ * Rebuild the free list so it contains every item in the pool. Used by pools that don't keep an in use list. For pools
+ * created with kPoolFlagThreadCache, all thread caches and the depot are emptied first. NOTE: this function assumes
+ * that MultiThreadedReserve() has been called first and that no other threads are using the pool.
+ *
+ * @param state_ptr Pool state information.
+ */
+static void FreeListReset(CdiPoolState* state_ptr)
+{
+    if (state_ptr->use_thread_cache) {
+        for (PoolThreadCache* cache_ptr = state_ptr->thread_cache_list_ptr; cache_ptr;
+             cache_ptr = cache_ptr->next_ptr) {
+            cache_ptr->loaded_ptr->item_count = 0;
+            cache_ptr->previous_ptr->item_count = 0;
+        }
+        PoolMagazine* magazine_ptr = NULL;
+        while (DepotPop(&state_ptr->full_depot, (void**)&magazine_ptr)) {
+            magazine_ptr->item_count = 0;
+            MagazinePutEmpty(state_ptr, magazine_ptr);
+        }
+        CdiOsAtomicStore32(&state_ptr->depot_item_count, 0);
+    }
+
+    CdiSinglyLinkedListInit(&state_ptr->free_list);
+    ForEachAllocatedItem(state_ptr, AddItemToFreeList, state_ptr);
+}
+
+/**
+ * Free all thread caches and depots used by a pool created with kPoolFlagThreadCache and release the pool's cache slot.
+ * Items in them are not returned to the free list.
+ *
+ * @param state_ptr Pool state information.
+ */
+static void ThreadCacheDestroy(CdiPoolState* state_ptr)
+{
+    // Hold the lock while the caches are removed from the tables of their threads, so a thread that exits at the same
+    // time can't use them or the pool (see ThreadCacheTableExit()).
+    CdiOsStaticMutexLock(thread_cache_mutex_lock);
+    PoolThreadCache* cache_ptr = state_ptr->thread_cache_list_ptr;
+    while (cache_ptr) {
+        PoolThreadCache* next_ptr = cache_ptr->next_ptr;
+        cache_ptr->table_ptr->cache_array[state_ptr->cache_slot] = NULL;
+        CdiOsMemFree(cache_ptr->loaded_ptr);
+        CdiOsMemFree(cache_ptr->previous_ptr);
+        CdiOsMemFree(cache_ptr);
+        cache_ptr = next_ptr;
+    }
+    state_ptr->thread_cache_list_ptr = NULL;
+    if (state_ptr->use_thread_cache) {
+        cache_slot_used_array[state_ptr->cache_slot] = false;
+        state_ptr->use_thread_cache = false;
+    }
+    CdiOsStaticMutexUnlock(thread_cache_mutex_lock);
+
+    PoolMagazine* magazine_ptr = NULL;
+    if (state_ptr->full_depot.cell_array) {
+        while (DepotPop(&state_ptr->full_depot, (void**)&magazine_ptr)) {
+            CdiOsMemFree(magazine_ptr);
+        }
+        DepotDestroy(&state_ptr->full_depot);
+    }
+    if (state_ptr->empty_depot.cell_array) {
+        while (DepotPop(&state_ptr->empty_depot, (void**)&magazine_ptr)) {
+            CdiOsMemFree(magazine_ptr);
+        }
+        DepotDestroy(&state_ptr->empty_depot);
+    }
+}
+
+/**
+ * Create the depots needed for a pool created with kPoolFlagThreadCache and allocate the pool's slot in the thread
+ * cache tables. The thread data slot that holds each thread's table is allocated the first time this is called.
+ *
+ * @param state_ptr Pool state information.
+ * @param max_item_count Maximum number of items the pool can hold, including all increases.
+ *
+ * @return true if successful, otherwise false.
+ */
+static bool ThreadCacheCreate(CdiPoolState* state_ptr, int max_item_count)
+{
+    // Small pools use small magazines, so a large portion of the pool is not held in a single thread's cache.
+    state_ptr->magazine_item_count = CDI_MAX(1, CDI_MIN(POOL_MAGAZINE_ITEM_COUNT,
+                                                        state_ptr->pool_item_count / POOL_MAGAZINE_MIN_DIVISOR));
+
+    // The depots are sized so every item in the pool can be stored in them, so pushes only fail in error cases.
+    int depot_size = (max_item_count / state_ptr->magazine_item_count) + 2;
+    if (!DepotCreate(&state_ptr->full_depot, depot_size) || !DepotCreate(&state_ptr->empty_depot, depot_size)) {
+        return false;
+    }
+
+    CdiOsStaticMutexLock(thread_cache_mutex_lock);
+    if (!thread_cache_data_valid) {
+        thread_cache_data_valid = CdiOsThreadAllocDataWithDestructor(ThreadCacheTableExit, &thread_cache_data);
+    }
+    int slot = 0;
+    while (slot < cache_slot_count && cache_slot_used_array[slot]) {
+        slot++;
+    }
+    if (thread_cache_data_valid && slot == cache_slot_count) {
+        int new_slot_count = cache_slot_count + POOL_THREAD_CACHE_SLOT_GROW_COUNT;
+        bool* new_array = (bool*)CdiOsMemAllocZero(new_slot_count * sizeof(bool));
+        if (new_array) {
+            for (int i = 0; i < cache_slot_count; i++) {
+                new_array[i] = cache_slot_used_array[i];
+            }
+            if (cache_slot_used_array) {
+                CdiOsMemFree(cache_slot_used_array);
+            }
+            cache_slot_used_array = new_array;
+            cache_slot_count = new_slot_count;
+        }
+    }
+    bool ret = thread_cache_data_valid && slot < cache_slot_count;
+    if (ret) {
+        cache_slot_used_array[slot] = true;
+        state_ptr->cache_slot = slot;
+        state_ptr->use_thread_cache = true;
+    }
+    CdiOsStaticMutexUnlock(thread_cache_mutex_lock);
+
+    if (!ret) {
+        CDI_LOG_THREAD(kLogError, "Failed to allocate thread cache slot for pool[%s].", state_ptr->name_str);
+    }
+
+    return ret;
+}
+
 /**
  * @brief Creates a memory pool and returns ret_handle, which is a pointer to create memory pool.
  *
@@ -156,27 +1056,32 @@ static inline bool AddEntriesToBuffers(CdiPoolState* state_ptr, uint8_t* pool_it
  * @param grow_count Number of items that a pool may be increased by if the initial size requested is inadequate.
  * @param max_grow_count Maximum number of times a pool may be increased before an error occurs.
  * @param item_byte_size Size of each item in bytes.
- * @param thread_safe If true, locks are used to protect resources from multi-threaded access, otherwise locks are not
- *                    used and single threaded access to all resources is required.
- * @param pool_item_array Pointer to data buffer for the memory pool.
- * @param is_existing_buffer If true, using an existing buffer so don't free the memory when the pool is destroyed.
+ * @param flags Option flags. See CdiPoolFlags.
+ * @param numa_node NUMA node that grow buffers are to be allocated on.
+ * @param buffer_ptr Pointer to the description of the initial data buffer for the memory pool. Unless it is an existing
+ *                   buffer, it is owned (and freed) by the pool, even if this function fails.
  * @param ret_handle_ptr Pointer to returned handle of the new pool.
  * @param init_fn The address of a function that will be called for each item in the pool at creation time; a value of
  *                NULL indicates that no initialization beyond zeroing the memory is to be done.
  * @param init_context_ptr A value to provide as init_context to init_fn().
  */
 static bool PoolCreate(const char* name_str, uint32_t item_count, uint32_t grow_count, uint32_t max_grow_count,
-                       uint32_t item_byte_size, bool thread_safe, void* pool_item_array, bool is_existing_buffer,
+                       uint32_t item_byte_size, CdiPoolFlags flags, int numa_node, const PoolBuffer* buffer_ptr,
                        CdiPoolHandle* ret_handle_ptr, CdiPoolItemOperatorFunction init_fn, void* init_context_ptr)
 {
     bool ret = true;
 
-    CdiPoolState* state_ptr = (CdiPoolState*)CdiOsMemAllocZero(sizeof(CdiPoolState));
+    CdiPoolState* state_ptr = (CdiPoolState*)CdiOsMemAllocZero(sizeof(CdiPoolState) +
+                                                               (1 + max_grow_count) * sizeof(PoolBuffer));
     if (NULL == state_ptr) {
+        PoolBufferFree(buffer_ptr);
         ret = false;
+    } else {
+        state_ptr->buffer_array[0] = *buffer_ptr;
+        state_ptr->buffer_count = 1;
     }
 
-    if (ret && thread_safe) {
+    if (ret && (flags & (kPoolFlagThreadSafe | kPoolFlagThreadCache))) {
         // Create critical section.
         if (!CdiOsCritSectionCreate(&state_ptr->lock)) {
             ret = false;
@@ -188,9 +1093,11 @@ static bool PoolCreate(const char* name_str, uint32_t item_count, uint32_t grow_
         state_ptr->pool_grow_count = grow_count;
         state_ptr->pool_max_grow_count = max_grow_count;
         state_ptr->pool_item_data_byte_size = item_byte_size;
-        state_ptr->pool_item_byte_size = sizeof(CdiPoolItem) + item_byte_size;
+        state_ptr->pool_item_byte_size = GetItemStride(item_byte_size, flags);
+        state_ptr->item_header_byte_size = (flags & kPoolFlagSlimItems) ? 0 : sizeof(CdiPoolItem);
         state_ptr->pool_item_count = item_count;
-        state_ptr->is_existing_buffer = is_existing_buffer;
+        state_ptr->numa_node = numa_node;
+        state_ptr->use_huge_pages = (flags & kPoolFlagHugePages);
         state_ptr->init_fn_ptr = init_fn;
         state_ptr->init_context_ptr = init_context_ptr;
 
@@ -203,14 +1110,21 @@ static bool PoolCreate(const char* name_str, uint32_t item_count, uint32_t grow_
         // Initialize the in use list. We use a doubly-linked list so we can remove items from any location within
         // the list without walking it.
         CdiListInit(&state_ptr->in_use_list);
+        // Items held in thread caches are not tracked and slim items have no room for the list entry, so the in use
+        // list cannot be maintained for those pools.
+        state_ptr->track_in_use = !(flags & (kPoolFlagThreadCache | kPoolFlagSlimItems));
 
-        ret = AddEntriesToBuffers(state_ptr, (uint8_t*)pool_item_array, (int)item_count);
+        ret = AddEntriesToBuffers(state_ptr, (uint8_t*)buffer_ptr->buffer_ptr, (int)item_count);
         if (!ret) {
             CDI_LOG_THREAD(kLogError, "Pool[%s] adding initial entries to pool failed.",
                            state_ptr->name_str, state_ptr->pool_grow_count, state_ptr->pool_item_count);
         }
     }
 
+    if (ret && (flags & kPoolFlagThreadCache)) {
+        ret = ThreadCacheCreate(state_ptr, (int)(item_count + grow_count * max_grow_count));
+    }
+
     if (!ret) {
         CdiPoolDestroy((CdiPoolHandle)state_ptr);
         state_ptr = NULL;
@@ -236,13 +1150,15 @@ static bool PoolIncrease(CdiPoolHandle handle_ptr)
 
     // First check to see if this memory pool hasn't already exceeded its growth count.
     if (state_ptr->pool_cur_grow_count < state_ptr->pool_max_grow_count) {
-        uint32_t size_needed = CdiPoolGetSizeNeeded(state_ptr->pool_grow_count, state_ptr->pool_item_byte_size);
-        pool_item_array = CdiOsMemAllocZero(size_needed);
-        if (NULL == pool_item_array) {
+        uint32_t size_needed = GetBufferSizeNeeded(state_ptr->pool_grow_count, state_ptr->pool_item_byte_size);
+        PoolBuffer* buffer_ptr = &state_ptr->buffer_array[state_ptr->buffer_count];
+        if (!PoolBufferAlloc(state_ptr->use_huge_pages, state_ptr->numa_node, size_needed, buffer_ptr)) {
             CDI_LOG_THREAD(kLogError, "Not enough memory to increase allocation to pool[%s] by size[%d] items.",
                            state_ptr->name_str, state_ptr->pool_cur_grow_count);
             ret = false;
         } else {
+            pool_item_array = buffer_ptr->buffer_ptr;
+            state_ptr->buffer_count++;
             state_ptr->pool_item_count += state_ptr->pool_grow_count;
             state_ptr->pool_cur_grow_count++;
         }
@@ -269,15 +1185,80 @@ static bool PoolIncrease(CdiPoolHandle handle_ptr)
     return ret;
 }
 
+/**
+ * Put an item back into the calling thread's cache, or add it to a list of items to be put back into the free list
+ * using PutItemList() if the pool doesn't use thread caches.
+ *
+ * @param state_ptr Pointer to pool state.
+ * @param cache_ptr Pointer to the calling thread's cache, or NULL if the pool doesn't use thread caches.
+ * @param item_ptr Pointer to the item data.
+ * @param put_list_ptr Pointer to the list of items to be put back into the free list.
+ */
+static void PutItemToCacheOrList(CdiPoolState* state_ptr, PoolThreadCache* cache_ptr, const void* item_ptr,
+                                 CdiSinglyLinkedList* put_list_ptr)
+{
+    CdiPoolItem* pool_item_ptr = GetPoolItemFromItemDataPointer(state_ptr, item_ptr);
+    if (NULL == cache_ptr) {
+        CdiSinglyLinkedListPushTail(put_list_ptr, &pool_item_ptr->list_entry);
+    } else {
+        ThreadCachePut(state_ptr, cache_ptr, pool_item_ptr);
+        if (state_ptr->pool_cb_ptr) {
+            CdiPoolCbData cb_data = {
+                .is_put = true,
+                .num_entries = cache_ptr->loaded_ptr->item_count,
+                .item_data_ptr = item_ptr
+            };
+            (state_ptr->pool_cb_ptr)(&cb_data);
+        }
+    }
+}
+
+/**
+ * Splice a list of pool items onto the free list of the pool using a single lock acquisition. The splice takes constant
+ * time, but pools that track items in use or have a callback still visit every item in the list while holding the lock.
+ *
+ * @param state_ptr Pointer to pool state.
+ * @param put_list_ptr Pointer to the list of items built by PutItemToCacheOrList().
+ */
+static void PutItemList(CdiPoolState* state_ptr, const CdiSinglyLinkedList* put_list_ptr)
+{
+    if (CdiSinglyLinkedListIsEmpty(put_list_ptr)) {
+        return;
+    }
+
+    MultithreadedReserve(state_ptr);
+
+    if (state_ptr->track_in_use) {
+        for (CdiSinglyLinkedListEntry* entry_ptr = put_list_ptr->head_ptr; entry_ptr; entry_ptr = entry_ptr->next_ptr) {
+            CdiListRemove(&state_ptr->in_use_list, &((CdiPoolItem*)entry_ptr)->in_use_list_entry);
+        }
+    }
+    CdiSinglyLinkedListPushListHead(&state_ptr->free_list, put_list_ptr->head_ptr, put_list_ptr->tail_ptr,
+                                    put_list_ptr->num_entries);
+
+    if (state_ptr->pool_cb_ptr) {
+        CdiSinglyLinkedListEntry* entry_ptr = put_list_ptr->head_ptr;
+        for (int i = 0; i < put_list_ptr->num_entries; i++, entry_ptr = entry_ptr->next_ptr) {
+            CdiPoolCbData cb_data = {
+                .is_put = true,
+                .num_entries = CdiSinglyLinkedListSize(&state_ptr->free_list),
+                .item_data_ptr = GetDataItem(state_ptr, (CdiPoolItem*)entry_ptr)
+            };
+            (state_ptr->pool_cb_ptr)(&cb_data);
+        }
+    }
+
+    MultithreadedRelease(state_ptr);
+}
+
 //*********************************************************************************************************************
 //******************************************* START OF PUBLIC FUNCTIONS ***********************************************
 //*********************************************************************************************************************
 
 uint32_t CdiPoolGetSizeNeeded(uint32_t item_count, uint32_t item_byte_size)
 {
-    // Each item in the pool requires storage for an CdiPoolItem structure plus the data itself. Each group of buffer
-    // allocations (one initially plus one for each increase) requires a singly linked list entry.
-    return sizeof(CdiSinglyLinkedListEntry) + (item_count * (sizeof(CdiPoolItem) + item_byte_size));
+    // Each item in the pool requires storage for an CdiPoolItem structure plus the data itself.
+    return GetBufferSizeNeeded(item_count, GetItemStride(item_byte_size, kPoolFlagNone));
 }
 
 bool CdiPoolCreate(const char* name_str, uint32_t item_count, uint32_t grow_count, uint32_t max_grow_count,
@@ -292,15 +1273,47 @@ bool CdiPoolCreateAndInitItems(const char* name_str, uint32_t item_count, uint32
                                uint32_t item_byte_size, bool thread_safe, CdiPoolHandle* ret_handle_ptr,
                                CdiPoolItemOperatorFunction init_fn, void* init_context_ptr)
 {
-    uint32_t size_needed = CdiPoolGetSizeNeeded(item_count, item_byte_size);
-    void* pool_item_array = CdiOsMemAllocZero(size_needed);
-    if (NULL == pool_item_array) {
+    return CdiPoolCreateWithFlags(name_str, item_count, grow_count, max_grow_count, item_byte_size,
+                                  thread_safe ? kPoolFlagThreadSafe : kPoolFlagNone, ret_handle_ptr, init_fn,
+                                  init_context_ptr);
+}
+
+bool CdiPoolCreateWithFlags(const char* name_str, uint32_t item_count, uint32_t grow_count, uint32_t max_grow_count,
+                            uint32_t item_byte_size, CdiPoolFlags flags, CdiPoolHandle* ret_handle_ptr,
+                            CdiPoolItemOperatorFunction init_fn, void* init_context_ptr)
+{
+    return CdiPoolCreateOnNumaNode(name_str, item_count, grow_count, max_grow_count, item_byte_size, flags,
+                                   CDI_NUMA_NODE_ANY, ret_handle_ptr, init_fn, init_context_ptr);
+}
+
+bool CdiPoolCreateOnNumaNode(const char* name_str, uint32_t item_count, uint32_t grow_count, uint32_t max_grow_count,
+                             uint32_t item_byte_size, CdiPoolFlags flags, int numa_node,
+                             CdiPoolHandle* ret_handle_ptr, CdiPoolItemOperatorFunction init_fn,
+                             void* init_context_ptr)
+{
+    if ((flags & kPoolFlagSlimItems) && init_fn) {
+        CDI_LOG_THREAD(kLogError, "Pool[%s] with slim items can't use an initialization function.", name_str);
+        return false;
+    }
+
+    uint32_t size_needed = GetBufferSizeNeeded(item_count, GetItemStride(item_byte_size, flags));
+    PoolBuffer buffer;
+    if (!PoolBufferAlloc(flags & kPoolFlagHugePages, numa_node, size_needed, &buffer)) {
         CDI_LOG_THREAD(kLogError, "Not enough memory to allocate pool[%s] with size[%d]", name_str, size_needed);
         return false;
     }
 
-    return PoolCreate(name_str, item_count, grow_count, max_grow_count, item_byte_size, thread_safe, pool_item_array,
-                      false, ret_handle_ptr, init_fn, init_context_ptr);
+    bool ret = PoolCreate(name_str, item_count, grow_count, max_grow_count, item_byte_size, flags, numa_node,
+                          &buffer, ret_handle_ptr, init_fn, init_context_ptr);
+    if (ret && CDI_NUMA_NODE_ANY != numa_node) {
+        int placed_numa_node = CdiOsMemGetNumaNode(buffer.buffer_ptr);
+        if (CDI_NUMA_NODE_ANY != placed_numa_node && placed_numa_node != numa_node) {
+            CDI_LOG_THREAD(kLogWarning, "Pool[%s] requested NUMA node[%d] but was placed on node[%d].", name_str,
+                           numa_node, placed_numa_node);
+        }
+    }
+
+    return ret;
 }
 
 bool CdiPoolCreateUsingExistingBuffer(const char* name_str, uint32_t item_count, uint32_t item_byte_size,
@@ -327,8 +1340,14 @@ bool CdiPoolCreateUsingExistingBufferAndInitItems(const char* name_str, uint32_t
 
     if (buffer_ptr) {
         if (buffer_byte_size >= size_needed) {
-            ret = PoolCreate(name_str, item_count, 0, 0, item_byte_size, thread_safe, buffer_ptr, true, ret_handle_ptr,
-                             init_fn, init_context_ptr);
+            PoolBuffer buffer = {
+                .buffer_ptr = buffer_ptr,
+                .byte_size = buffer_byte_size,
+                .type = kPoolBufferExisting
+            };
+            ret = PoolCreate(name_str, item_count, 0, 0, item_byte_size,
+                             thread_safe ? kPoolFlagThreadSafe : kPoolFlagNone, CDI_NUMA_NODE_ANY, &buffer,
+                             ret_handle_ptr, init_fn, init_context_ptr);
         } else {
             CDI_LOG_THREAD(kLogError, "Buffer[%s] size requested is larger than existing buffer. Requested size "
                            "[%"PRIu32"]; available size [%"PRIu32"].", name_str, size_needed, buffer_byte_size);
@@ -344,22 +1363,19 @@ void CdiPoolDestroy(CdiPoolHandle handle)
     CdiPoolState* state_ptr = (CdiPoolState*)handle;
 
     if (state_ptr) {
-        // Check to ensure the free list contains all entries before yanking the memory away.
-        if (state_ptr->pool_item_count != CdiSinglyLinkedListSize(&state_ptr->free_list)) {
+        // Check to ensure the free list (and thread caches, if used) contains all entries before yanking the memory
+        // away.
+        int free_count = GetFreeItemCount(state_ptr);
+        if (state_ptr->pool_item_count != free_count) {
             CDI_LOG_THREAD(kLogFatal, "Pool[%s] to be destroyed has[%d] entries still in use.", state_ptr->name_str,
-                           state_ptr->pool_item_count - CdiSinglyLinkedListSize(&state_ptr->free_list));
+                           state_ptr->pool_item_count - free_count);
             assert(false);
         }
+        ThreadCacheDestroy(state_ptr);
 
-        if (!state_ptr->is_existing_buffer) {
-            CdiSinglyLinkedListEntry* allocated_buffer_ptr = state_ptr->allocated_buffer_list.head_ptr;
-
-            // Free up each of the allocated buffers.
-            while (allocated_buffer_ptr) {
-                CdiSinglyLinkedListEntry* next_allocated_buffer_ptr = allocated_buffer_ptr->next_ptr;
-                CdiOsMemFree(allocated_buffer_ptr);
-                allocated_buffer_ptr = next_allocated_buffer_ptr;
-            }
+        // Free up each of the allocated buffers.
+        for (int i = 0; i < state_ptr->buffer_count; i++) {
+            PoolBufferFree(&state_ptr->buffer_array[i]);
         }
 
         CdiOsCritSectionDelete(state_ptr->lock);
@@ -372,7 +1388,10 @@ bool CdiPoolPeekInUse(CdiPoolHandle handle, void** ret_item_ptr)
     bool ret = false;
     CdiPoolState* state_ptr = (CdiPoolState*)handle;
 
-    if (state_ptr) {
+    if (state_ptr && !state_ptr->track_in_use) {
+        // Pools that use thread caches don't maintain an in use list.
+        *ret_item_ptr = NULL;
+    } else if (state_ptr) {
         MultithreadedReserve(state_ptr);
 
         CdiListEntry* list_entry_ptr = CdiListPeek(&state_ptr->in_use_list);
@@ -380,7 +1399,7 @@ bool CdiPoolPeekInUse(CdiPoolHandle handle, void** ret_item_ptr)
             *ret_item_ptr = NULL;
         } else {
             CdiPoolItem* pool_item_ptr = (CdiPoolItem*)CONTAINER_OF(list_entry_ptr, CdiPoolItem, in_use_list_entry);
-            *ret_item_ptr = GetDataItem(pool_item_ptr);
+            *ret_item_ptr = GetDataItem(state_ptr, pool_item_ptr);
             ret = true;
         }
 
@@ -395,6 +1414,26 @@ bool CdiPoolGet(CdiPoolHandle handle, void** ret_item_ptr)
     bool ret = true;
     CdiPoolState* state_ptr = (CdiPoolState*)handle;
 
+    PoolThreadCache* cache_ptr = state_ptr->use_thread_cache ? GetThreadCache(state_ptr) : NULL;
+    if (cache_ptr) {
+        CdiPoolItem* pool_item_ptr = ThreadCacheGet(state_ptr, cache_ptr);
+        int cached_count = cache_ptr->loaded_ptr->item_count;
+        ThreadCacheRelease(cache_ptr);
+        *ret_item_ptr = pool_item_ptr ? GetDataItem(state_ptr, pool_item_ptr) : NULL;
+        if (pool_item_ptr && state_ptr->pool_cb_ptr) {
+            CdiPoolCbData cb_data = {
+                .is_put = false,
+                .num_entries = cached_count,
+                .item_data_ptr = *ret_item_ptr
+            };
+            (state_ptr->pool_cb_ptr)(&cb_data);
+        }
+        if (NULL == pool_item_ptr) {
+            CdiOsAtomicInc32(&state_ptr->get_fail_count);
+        }
+        return NULL != pool_item_ptr;
+    }
+
     MultithreadedReserve(state_ptr);
 
     CdiPoolItem* pool_item_ptr = (CdiPoolItem*)CdiSinglyLinkedListPopHead(&state_ptr->free_list);
@@ -402,16 +1441,18 @@ bool CdiPoolGet(CdiPoolHandle handle, void** ret_item_ptr)
         // No items left, attempt to increase pool.
         if (!PoolIncrease(handle)) {
             *ret_item_ptr = NULL;
+            CdiOsAtomicInc32(&state_ptr->get_fail_count);
             ret = false;
         } else {
             pool_item_ptr = (CdiPoolItem*)CdiSinglyLinkedListPopHead(&state_ptr->free_list);
-            *ret_item_ptr = GetDataItem(pool_item_ptr);
+            *ret_item_ptr = GetDataItem(state_ptr, pool_item_ptr);
         }
     } else {
-        *ret_item_ptr = GetDataItem(pool_item_ptr);
+        *ret_item_ptr = GetDataItem(state_ptr, pool_item_ptr);
     }
 
     if (pool_item_ptr) {
+        UpdateHighWaterCount(state_ptr);
         if (state_ptr->pool_cb_ptr) {
             CdiPoolCbData cb_data = {
                 .is_put = false,
@@ -422,7 +1463,9 @@ bool CdiPoolGet(CdiPoolHandle handle, void** ret_item_ptr)
         }
 
         // Add the item to the in use list.
-        CdiListAddHead(&state_ptr->in_use_list, &pool_item_ptr->in_use_list_entry);
+        if (state_ptr->track_in_use) {
+            CdiListAddHead(&state_ptr->in_use_list, &pool_item_ptr->in_use_list_entry);
+        }
     }
 
     MultithreadedRelease(state_ptr);
@@ -430,16 +1473,118 @@ bool CdiPoolGet(CdiPoolHandle handle, void** ret_item_ptr)
     return ret;
 }
 
+bool CdiPoolGetMultiple(CdiPoolHandle handle, int item_count, void** ret_item_array)
+{
+    bool ret = true;
+    CdiPoolState* state_ptr = (CdiPoolState*)handle;
+    int got_count = 0;
+
+    PoolThreadCache* cache_ptr = state_ptr->use_thread_cache ? GetThreadCache(state_ptr) : NULL;
+    if (cache_ptr) {
+        for (; got_count < item_count; got_count++) {
+            CdiPoolItem* pool_item_ptr = ThreadCacheGet(state_ptr, cache_ptr);
+            if (NULL == pool_item_ptr) {
+                ret = false;
+                break;
+            }
+            ret_item_array[got_count] = GetDataItem(state_ptr, pool_item_ptr);
+        }
+        if (!ret) {
+            CdiOsAtomicInc32(&state_ptr->get_fail_count);
+            // Not enough free items, so return the ones we got.
+            while (got_count) {
+                ThreadCachePut(state_ptr, cache_ptr,
+                               GetPoolItemFromItemDataPointer(state_ptr, ret_item_array[--got_count]));
+            }
+        }
+        int cached_count = cache_ptr->loaded_ptr->item_count;
+        ThreadCacheRelease(cache_ptr);
+        if (ret && state_ptr->pool_cb_ptr) {
+            for (int i = 0; i < item_count; i++) {
+                CdiPoolCbData cb_data = {
+                    .is_put = false,
+                    .num_entries = cached_count,
+                    .item_data_ptr = ret_item_array[i]
+                };
+                (state_ptr->pool_cb_ptr)(&cb_data);
+            }
+        }
+    } else {
+        MultithreadedReserve(state_ptr);
+
+        for (; got_count < item_count; got_count++) {
+            CdiPoolItem* pool_item_ptr = (CdiPoolItem*)CdiSinglyLinkedListPopHead(&state_ptr->free_list);
+            if (NULL == pool_item_ptr) {
+                // No items left, attempt to increase pool.
+                if (!PoolIncrease(handle)) {
+                    ret = false;
+                    break;
+                }
+                pool_item_ptr = (CdiPoolItem*)CdiSinglyLinkedListPopHead(&state_ptr->free_list);
+            }
+            ret_item_array[got_count] = GetDataItem(state_ptr, pool_item_ptr);
+        }
+
+        if (!ret) {
+            CdiOsAtomicInc32(&state_ptr->get_fail_count);
+            // Not enough free items, so return the ones we got.
+            while (got_count) {
+                CdiPoolItem* pool_item_ptr = GetPoolItemFromItemDataPointer(state_ptr, ret_item_array[--got_count]);
+                CdiSinglyLinkedListPushHead(&state_ptr->free_list, &pool_item_ptr->list_entry);
+            }
+        } else {
+            UpdateHighWaterCount(state_ptr);
+            for (int i = 0; i < item_count; i++) {
+                if (state_ptr->pool_cb_ptr) {
+                    CdiPoolCbData cb_data = {
+                        .is_put = false,
+                        .num_entries = CdiSinglyLinkedListSize(&state_ptr->free_list),
+                        .item_data_ptr = ret_item_array[i]
+                    };
+                    (state_ptr->pool_cb_ptr)(&cb_data);
+                }
+                // Add the item to the in use list.
+                if (state_ptr->track_in_use) {
+                    CdiPoolItem* pool_item_ptr = GetPoolItemFromItemDataPointer(state_ptr, ret_item_array[i]);
+                    CdiListAddHead(&state_ptr->in_use_list, &pool_item_ptr->in_use_list_entry);
+                }
+            }
+        }
+
+        MultithreadedRelease(state_ptr);
+    }
+
+    return ret;
+}
+
 void CdiPoolPut(CdiPoolHandle handle, const void* item_ptr)
 {
     CdiPoolState* state_ptr = (CdiPoolState*)handle;
-    CdiPoolItem* pool_item_ptr = GetPoolItemFromItemDataPointer(item_ptr);
+    CdiPoolItem* pool_item_ptr = GetPoolItemFromItemDataPointer(state_ptr, item_ptr);
+
+    PoolThreadCache* cache_ptr = state_ptr->use_thread_cache ? GetThreadCache(state_ptr) : NULL;
+    if (cache_ptr) {
+        ThreadCachePut(state_ptr, cache_ptr, pool_item_ptr);
+        int cached_count = cache_ptr->loaded_ptr->item_count;
+        ThreadCacheRelease(cache_ptr);
+        if (state_ptr->pool_cb_ptr) {
+            CdiPoolCbData cb_data = {
+                .is_put = true,
+                .num_entries = cached_count,
+                .item_data_ptr = item_ptr
+            };
+            (state_ptr->pool_cb_ptr)(&cb_data);
+        }
+        return;
+    }
 
     MultithreadedReserve(state_ptr);
 
     // Add the item back to the free list and remove from the in use list.
     CdiSinglyLinkedListPushHead(&state_ptr->free_list, &pool_item_ptr->list_entry);
-    CdiListRemove(&state_ptr->in_use_list, &pool_item_ptr->in_use_list_entry);
+    if (state_ptr->track_in_use) {
+        CdiListRemove(&state_ptr->in_use_list, &pool_item_ptr->in_use_list_entry);
+    }
 
     if (state_ptr->pool_cb_ptr) {
         CdiPoolCbData cb_data = {
@@ -453,16 +1598,74 @@ void CdiPoolPut(CdiPoolHandle handle, const void* item_ptr)
     MultithreadedRelease(state_ptr);
 }
 
+bool CdiPoolPutList(CdiPoolHandle handle, const void* item_list_ptr, uint32_t next_ptr_offset)
+{
+    bool ret = true;
+    CdiPoolState* state_ptr = (CdiPoolState*)handle;
+
+    if (NULL == item_list_ptr) {
+        return ret; // Nothing to put.
+    }
+    PoolThreadCache* cache_ptr = state_ptr->use_thread_cache ? GetThreadCache(state_ptr) : NULL;
+
+    // Link the pool items together without holding the lock, so a single lock acquisition puts all of them. The splice
+    // itself doesn't depend on the number of items, but PutItemList() still walks the list to maintain in_use_list and
+    // to invoke the pool's callback.
+    CdiSinglyLinkedList put_list;
+    CdiSinglyLinkedListInit(&put_list);
+    const uint8_t* item_ptr = (const uint8_t*)item_list_ptr;
+    while (item_ptr) {
+        // Save next item, since putting an item in a thread cache can make it available to other threads.
+        const uint8_t* next_item_ptr = *(const uint8_t* const*)(item_ptr + next_ptr_offset);
+        PutItemToCacheOrList(state_ptr, cache_ptr, item_ptr, &put_list);
+
+        // Check for infinite loop (using same pointer)?
+        if (item_ptr == next_item_ptr) {
+            assert(false);
+            ret = false;
+            break;
+        }
+        item_ptr = next_item_ptr;
+    }
+    if (cache_ptr) {
+        ThreadCacheRelease(cache_ptr);
+    }
+    PutItemList(state_ptr, &put_list);
+
+    return ret;
+}
+
+void CdiPoolPutMultiple(CdiPoolHandle handle, int item_count, void* const* item_array)
+{
+    CdiPoolState* state_ptr = (CdiPoolState*)handle;
+    PoolThreadCache* cache_ptr = (state_ptr->use_thread_cache && item_count) ? GetThreadCache(state_ptr) : NULL;
+
+    CdiSinglyLinkedList put_list;
+    CdiSinglyLinkedListInit(&put_list);
+    for (int i = 0; i < item_count; i++) {
+        PutItemToCacheOrList(state_ptr, cache_ptr, item_array[i], &put_list);
+    }
+    if (cache_ptr) {
+        ThreadCacheRelease(cache_ptr);
+    }
+    PutItemList(state_ptr, &put_list);
+}
+
 void CdiPoolPutAll(CdiPoolHandle handle)
 {
     CdiPoolState* state_ptr = (CdiPoolState*)handle;
     if (state_ptr) {
         MultithreadedReserve(state_ptr);
 
-        // Walk the pool list and free all the entries.
-        void* entry_ptr = NULL;
-        while (CdiPoolPeekInUse(handle, (void**)&entry_ptr)) {
-            CdiPoolPut(handle, entry_ptr);
+        if (!state_ptr->track_in_use) {
+            // No in use list is kept, so rebuild the free list from the allocated buffers.
+            FreeListReset(state_ptr);
+        } else {
+            // Walk the pool list and free all the entries.
+            void* entry_ptr = NULL;
+            while (CdiPoolPeekInUse(handle, (void**)&entry_ptr)) {
+                CdiPoolPut(handle, entry_ptr);
+            }
         }
 
         MultithreadedRelease(state_ptr);
@@ -476,6 +1679,21 @@ const char* CdiPoolGetName(CdiPoolHandle handle)
     return state_ptr->name_str;
 }
 
+int CdiPoolGetNumaNode(CdiPoolHandle handle)
+{
+    CdiPoolState* state_ptr = (CdiPoolState*)handle;
+
+    // The initial buffer never changes, so no lock is needed.
+    return CdiOsMemGetNumaNode(state_ptr->buffer_array[0].buffer_ptr);
+}
+
+bool CdiPoolUsesHugePages(CdiPoolHandle handle)
+{
+    CdiPoolState* state_ptr = (CdiPoolState*)handle;
+
+    return kPoolBufferHugePages == state_ptr->buffer_array[0].type;
+}
+
 uint32_t CdiPoolGetItemSize(CdiPoolHandle handle)
 {
     CdiPoolState* state_ptr = (CdiPoolState*)handle;
@@ -488,7 +1706,7 @@ int CdiPoolGetFreeItemCount(CdiPoolHandle handle)
     CdiPoolState* state_ptr = (CdiPoolState*)handle;
 
     MultithreadedReserve(state_ptr);
-    int count = CdiSinglyLinkedListSize(&state_ptr->free_list);
+    int count = GetFreeItemCount(state_ptr);
     MultithreadedRelease(state_ptr);
 
     return count;
@@ -505,21 +1723,39 @@ int CdiPoolGetTotalItemCount(CdiPoolHandle handle)
     return count;
 }
 
+void CdiPoolGetStats(CdiPoolHandle handle, CdiPoolStats* ret_stats_ptr)
+{
+    CdiPoolState* state_ptr = (CdiPoolState*)handle;
+
+    MultithreadedReserve(state_ptr);
+    ret_stats_ptr->total_item_count = state_ptr->pool_item_count;
+    ret_stats_ptr->free_item_count = GetFreeItemCount(state_ptr);
+    ret_stats_ptr->high_water_item_count = state_ptr->high_water_count;
+    ret_stats_ptr->grow_count = state_ptr->pool_cur_grow_count;
+    ret_stats_ptr->byte_size = (uint64_t)state_ptr->pool_item_count * state_ptr->pool_item_byte_size;
+    MultithreadedRelease(state_ptr);
+    ret_stats_ptr->get_fail_count = CdiOsAtomicLoad32(&state_ptr->get_fail_count);
+}
+
 bool CdiPoolForEachItem(CdiPoolHandle handle, CdiPoolItemOperatorFunction operator_function, const void* context_ptr)
 {
     CdiPoolState* state_ptr = (CdiPoolState*)handle;
     bool ret = true;
     MultithreadedReserve(state_ptr);
 
-    if (state_ptr->pool_item_count != state_ptr->free_list.num_entries) {
+    int free_count = GetFreeItemCount(state_ptr);
+    if (state_ptr->pool_item_count != free_count) {
         CDI_LOG_THREAD(kLogFatal, "For each on pool[%s] has[%d] entries still in use.", state_ptr->name_str,
-                       state_ptr->pool_item_count - state_ptr->free_list.num_entries);
+                       state_ptr->pool_item_count - free_count);
         assert(false);
         ret = false;
+    } else if (state_ptr->use_thread_cache) {
+        // Free items may be held in thread caches, so walk the allocated buffers instead of the free list.
+        ret = ForEachAllocatedItem(state_ptr, operator_function, context_ptr);
     } else {
         for (CdiSinglyLinkedListEntry* entry_ptr = state_ptr->free_list.head_ptr ; NULL != entry_ptr ;
              entry_ptr = entry_ptr->next_ptr) {
-            ret = operator_function(context_ptr, GetDataItem((CdiPoolItem*)entry_ptr)) && ret;
+            ret = operator_function(context_ptr, GetDataItem(state_ptr, (CdiPoolItem*)entry_ptr)) && ret;
         }
     }
 
@@ -11,6 +11,14 @@
  * writer thread to use CdiQuenePush(). No resource locks are used, so the functions are not reetrant. Blocking
  * CdiQueuePopWait() and CdiQueuePushWait() queue API functions can be used if enabled using the signal_mode parameter
  * of the CdiQueueCreate() API fucntion. NOTE: The API functions only support a single-producer/single-consumer.
+ *
+ * Items are stored in a contiguous power-of-two sized ring. The producer's write index and the consumer's read index
+ * are kept on separate cache lines and each side keeps a snapshot of the other side's index, so in the common case a
+ * push or pop does not touch a cache line that was last written by the other thread. Growing the queue adds a new
+ * segment to a ring of segments instead of adding items to the existing one. See QueueSegment.
+ *
+ * CdiQueuePushReserve()/CdiQueuePushCommit() and CdiQueuePopPeek()/CdiQueuePopRelease() hand out pointers to item
+ * slots, so large items can be written and read in place instead of being copied in and out of the queue.
  */
 
 // Include headers in the following order: Related header, C system headers, other libraries' headers, your project's
@@ -33,30 +41,55 @@
 /// @brief Maximum length of the queue name that is stored internally in queue.c.
 #define MAX_QUEUE_NAME_LENGTH               (64)
 
+/// Forward reference.
+typedef struct QueueSegment QueueSegment;
+
 /**
- * @brief This structure represents a single queue item.
+ * @brief This structure represents a contiguous ring of queue items. The ring size is a power of two, so an item's slot
+ * is found by masking its index. Indices only ever increase: the segment is empty when read_index equals write_index
+ * and full when write_index - read_index equals capacity. Only the producer changes write_index and only the consumer
+ * changes read_index, so each is kept on its own cache line.
+ *
+ * The segments of a queue are linked into a ring using next_segment_ptr. A queue that has never grown is a ring of one
+ * segment. When the producer's segment is full, the producer moves on to the next segment in the ring if the consumer
+ * has drained it and moved past it. Otherwise, if the queue is growable, a new segment of grow_count items is inserted
+ * after the producer's segment. Before moving on, the producer sets the closed flag of the segment it is leaving and
+ * never writes to it again until it comes back around the ring, so the consumer moves to the next segment once it has
+ * drained a closed one.
  */
-typedef struct {
-    CdiSinglyLinkedListEntry list_entry; ///< List entry for this item.
-    uint8_t item_data_buffer[];          ///< Pointer to data space for this item.
-} QueueItem;
+struct QueueSegment {
+    CdiSinglyLinkedListEntry list_entry;  ///< Entry in the queue's allocated buffer list. Must be first.
+    QueueSegment* next_segment_ptr;       ///< Next segment in the ring. Only changed by the producer.
+    uint32_t capacity;                    ///< Number of items this segment can hold.
+    uint32_t index_mask;                  ///< Number of slots in the ring minus one.
+    uint32_t closed;                      ///< Non-zero once the producer has moved on to the next segment.
+
+    uint8_t write_pad[CDI_CACHE_LINE_BYTE_SIZE]; ///< Keeps write_index off of the cache line used by the fields above.
+    uint32_t write_index;                 ///< Index of the next item to write. Only changed by the producer.
+    uint8_t read_pad[CDI_CACHE_LINE_BYTE_SIZE]; ///< Keeps read_index off of the producer's cache line.
+    uint32_t read_index;                  ///< Index of the next item to read. Only changed by the consumer.
+    uint8_t item_pad[CDI_CACHE_LINE_BYTE_SIZE]; ///< Keeps the items off of the consumer's cache line.
+
+    /// @brief Ring of (index_mask + 1) items. Declared as uint64_t so the items are 8 byte aligned regardless of the
+    /// size of the fields above.
+    uint64_t item_array[];
+};
 
 /**
- * @brief Structure used to hold state data for a single queue.
+ * @brief Structure used to hold state data for a single queue. Producer and consumer state are on separate cache lines.
+ * Each side keeps a snapshot of the other side's index, so the cache line holding the other side's index only needs to
+ * be read when the snapshot indicates that the segment is full (producer) or empty (consumer).
  */
 typedef struct {
     char name_str[MAX_QUEUE_NAME_LENGTH];       ///< Name of queue. Used for informational purposes only.
 
     int queue_item_data_byte_size;              ///< Size of the data portion of each item in bytes.
-    int queue_item_byte_size;                   ///< Size of each item in bytes (sizeof(QueueItem) + data portion).
-    int queue_item_count;                       ///< Number of items in the queue array.
+    int queue_item_count;                       ///< Number of items the queue can hold.
     int queue_grow_count;                       ///< Number of queue items the queue array may be increased by.
     int queue_cur_grow_count;                   ///< Number of times the current queue has been increased.
     int queue_max_grow_count;                   ///< The maximum number of times the queue can be increased.
-    CdiSinglyLinkedList allocated_buffer_list;  ///< Linked list of allocated memory buffers.
-
-    CdiSinglyLinkedListEntry* entry_read_ptr;   ///< Current read entry in the circular queue
-    CdiSinglyLinkedListEntry* entry_write_ptr;  ///< Current write entry in the circular queue
+    CdiSinglyLinkedList allocated_buffer_list;  ///< Linked list of allocated segments.
+    uint64_t allocated_byte_size;               ///< Total size of the segments in allocated_buffer_list.
 
     CdiSignalType wake_pop_waiters_signal;      ///< If enabled, signal set whenever item is pushed.
     CdiSignalType wake_push_waiters_signal;     ///< If enabled, signal set whenever item is popped.
@@ -67,6 +100,20 @@ typedef struct {
     int occupancy;                              ///< The number of entries currently enqueued.
     CdiQueueCallback debug_cb_ptr;              ///< Pointer to user-provided debug callback function
 #endif
+
+    uint8_t producer_pad[CDI_CACHE_LINE_BYTE_SIZE]; ///< Keeps producer state off of the cache line used above.
+    QueueSegment* write_segment_ptr;            ///< Segment being written to by the producer.
+    uint32_t cached_read_index;                 ///< Producer's snapshot of write_segment_ptr->read_index.
+    /// @brief Items reserved in write_segment_ptr by CdiQueuePushReserve() since the last commit. They are not visible
+    /// to the consumer until CdiQueuePushCommit() is called.
+    uint32_t reserved_count;
+    int push_fail_count;                        ///< Number of pushes that failed because the queue was full.
+
+    uint8_t consumer_pad[CDI_CACHE_LINE_BYTE_SIZE]; ///< Keeps consumer state off of the producer's cache line.
+    QueueSegment* read_segment_ptr;             ///< Segment being read from by the consumer.
+    uint32_t cached_write_index;                ///< Consumer's snapshot of read_segment_ptr->write_index.
+    uint32_t high_water_count;                  ///< Largest number of items seen by the consumer in its segment.
+    uint8_t end_pad[CDI_CACHE_LINE_BYTE_SIZE];  ///< Keeps consumer state off of the cache line of the next allocation.
 } QueueState;
 
 //*********************************************************************************************************************
@@ -78,83 +125,62 @@ typedef struct {
 //*********************************************************************************************************************
 
 /**
- * @brief Get pointer to the item's parent object (QueueItem).
+ * @brief Get pointer to the data buffer of an item in a segment.
  *
- * @param item_data_ptr Pointer to object being queried.
+ * @param state_ptr Queue state information.
+ * @param segment_ptr Pointer to segment holding the item.
+ * @param index Index of the item. Masked to get the item's slot.
  *
- * @return Pointer to parent of object.
+ * @return Pointer to item's data buffer.
  */
-static inline QueueItem* GetQueueItemFromItemDataPointer(const void* item_data_ptr)
+static inline uint8_t* GetItemDataPointer(const QueueState* state_ptr, QueueSegment* segment_ptr, uint32_t index)
 {
-    return CONTAINER_OF(item_data_ptr, QueueItem, item_data_buffer);
+    return (uint8_t*)segment_ptr->item_array +
+           (uint64_t)(index & segment_ptr->index_mask) * state_ptr->queue_item_data_byte_size;
 }
 
 /**
- * @brief Get pointer to the data buffer related to the linked list entry of the item.
+ * @brief Allocates a segment that can hold the specified number of items and adds it to the allocated buffer list.
  *
- * @param entry_item_ptr Pointer to queue item.
+ * @param state_ptr Queue state information.
+ * @param item_count Number of items the segment must be able to hold.
  *
- * @return Pointer to item's data buffer.
+ * @return Pointer to the new segment, or NULL if there is not enough memory.
  */
-static inline uint8_t* GetDataItemFromListEntry(CdiSinglyLinkedListEntry* entry_item_ptr)
+static QueueSegment* SegmentCreate(QueueState* state_ptr, uint32_t item_count)
 {
-    QueueItem* queue_item_ptr = (QueueItem*)entry_item_ptr;
-    return queue_item_ptr->item_data_buffer;
-}
+    uint64_t slot_count = 1;
+    while (slot_count < item_count) {
+        slot_count <<= 1;
+    }
 
-/**
- * @brief Adds queue item array to allocated buffer and insert into the circular item list at the current write pointer
- * location.
- *
- * @param state_ptr Queue state information.
- * @param queue_item_array The array being attached.
- * @param item_count Number of items in array to be attached.
- */
-static inline void AddEntriesToBuffers(QueueState* state_ptr, uint8_t* queue_item_array, int item_count)
-{
-    // Store this entry into the allocated buffer list.
-    CdiSinglyLinkedListEntry* queue_item_array_list_ptr = (CdiSinglyLinkedListEntry*)queue_item_array;
-    CdiSinglyLinkedListPushHead(&state_ptr->allocated_buffer_list, queue_item_array_list_ptr);
-
-    // Since we must insert the new entries into the existing list at the write pointer location and not the head, a new
-    // list will be created to hold all the new items. Then, the new list can be inserted.
-    CdiSinglyLinkedList new_list;
-    CdiSinglyLinkedListInit(&new_list);
-
-    // Offset from the link list entry for this array.
-    uint8_t* queue_item_array_offset = queue_item_array + sizeof(CdiSinglyLinkedListEntry);
-    for (int i = 0; i < item_count; i++) {
-        QueueItem* queue_item_ptr = (QueueItem*)(queue_item_array_offset + (uint64_t)state_ptr->queue_item_byte_size * i);
-        CdiSinglyLinkedListPushTail(&new_list, &queue_item_ptr->list_entry);
-    }
-
-    // Check if the existing list is empty.
-    if (NULL == state_ptr->entry_write_ptr) {
-        // The existing list is empty. Make the list circular, by pointing the tail back at the head of the list.
-        new_list.tail_ptr->next_ptr = new_list.head_ptr;
-        // Now, set the write pointer to the start of the list.
-        state_ptr->entry_write_ptr = new_list.head_ptr;
+    uint64_t size_needed = sizeof(QueueSegment) + (slot_count * state_ptr->queue_item_data_byte_size);
+    QueueSegment* segment_ptr = (QueueSegment*)CdiOsMemAllocZero(size_needed);
+    if (NULL == segment_ptr) {
+        CDI_LOG_THREAD(kLogError, "Not enough memory to allocate queue[%s] with size [%"PRIu64"]", state_ptr->name_str,
+                       size_needed);
     } else {
-        // The existing list is not empty, so insert the new list into the existing one. Set the tail of the new list to
-        // point at the write entry's next_ptr.
-        new_list.tail_ptr->next_ptr = state_ptr->entry_write_ptr->next_ptr;
-        // Now, update the write entry's next_ptr to point to the head of the new list.
-        state_ptr->entry_write_ptr->next_ptr = new_list.head_ptr;
+        segment_ptr->capacity = item_count;
+        segment_ptr->index_mask = (uint32_t)(slot_count - 1);
+        CdiSinglyLinkedListPushHead(&state_ptr->allocated_buffer_list, &segment_ptr->list_entry);
+        CdiOsAtomicAdd64(&state_ptr->allocated_byte_size, size_needed);
     }
+
+    return segment_ptr;
 }
 
 /**
- * @brief Increases the size of a queue, if it is growable.
+ * @brief Increases the size of a queue, if it is growable. A new segment of grow_count items is inserted into the ring
+ * after the producer's segment. Must only be called by the producer.
  *
- * @param handle_ptr Pointer to queue handle.
+ * @param state_ptr Queue state information.
  *
- * @return If successful true is returned, otherwise false is returned.
+ * @return Pointer to the new segment if successful, otherwise NULL.
  */
-static bool QueueIncrease(CdiQueueHandle handle_ptr)
+static QueueSegment* QueueIncrease(QueueState* state_ptr)
 {
     bool ret = true;
-    void* queue_item_array = NULL;
-    QueueState* state_ptr = (QueueState*)handle_ptr;
+    QueueSegment* new_segment_ptr = NULL;
 
     if (0 == state_ptr->queue_grow_count) {
         // Queue is not growable. Don't assert() here or generate a log message, since it is ok to be full.
@@ -167,10 +193,8 @@ static bool QueueIncrease(CdiQueueHandle handle_ptr)
 
         // First check to see if this queue hasn't already exceeded its growth count.
         if (state_ptr->queue_cur_grow_count < state_ptr->queue_max_grow_count) {
-            uint32_t size_needed = sizeof(CdiSinglyLinkedListEntry) + (state_ptr->queue_grow_count * (sizeof(QueueItem) +
-                                state_ptr->queue_item_byte_size));
-            queue_item_array = CdiOsMemAllocZero(size_needed);
-            if (NULL == queue_item_array) {
+            new_segment_ptr = SegmentCreate(state_ptr, state_ptr->queue_grow_count);
+            if (NULL == new_segment_ptr) {
                 CDI_LOG_THREAD(kLogError, "Not enough memory to increase allocation to queue[%s] by size[%d] items.",
                                state_ptr->name_str, state_ptr->queue_cur_grow_count);
                 assert(false); // Catch this as an error and halt execution in a debug build.
@@ -190,32 +214,255 @@ static bool QueueIncrease(CdiQueueHandle handle_ptr)
     if (ret) {
         CDI_LOG_THREAD(kLogWarning, "Queue[%s] increased by[%d] to items count[%d]",
                        state_ptr->name_str, state_ptr->queue_grow_count, state_ptr->queue_item_count);
-        AddEntriesToBuffers(state_ptr, (uint8_t*)queue_item_array, (int)state_ptr->queue_grow_count);
+        // Link the new segment into the ring using an atomic operation, so threads walking the ring see its link to
+        // the rest of the ring before they see the segment.
+        QueueSegment* segment_ptr = state_ptr->write_segment_ptr;
+        new_segment_ptr->next_segment_ptr = segment_ptr->next_segment_ptr;
+        CdiOsAtomicStorePointer(&segment_ptr->next_segment_ptr, new_segment_ptr);
     }
-    return ret;
+    return ret ? new_segment_ptr : NULL;
+}
+
+/**
+ * @brief Move the producer on to the next segment once its segment is full. The next segment in the ring is reused if
+ * the consumer has drained it and moved past it, otherwise the queue is increased. Must only be called by the producer
+ * after all items written to its segment have been made visible to the consumer.
+ *
+ * @param state_ptr Queue state information.
+ *
+ * @return true if the producer moved to another segment, otherwise false (queue is full).
+ */
+static bool ProducerNextSegment(QueueState* state_ptr)
+{
+    QueueSegment* segment_ptr = state_ptr->write_segment_ptr;
+    QueueSegment* next_segment_ptr = segment_ptr->next_segment_ptr;
+
+    // The consumer never moves past the producer's segment, so if it isn't reading the next segment, it has drained it.
+    // Use atomic operation to ensure latest memory is being read from.
+    if (next_segment_ptr == (QueueSegment*)CdiOsAtomicLoadPointer(&state_ptr->read_segment_ptr)) {
+        next_segment_ptr = QueueIncrease(state_ptr);
+        if (NULL == next_segment_ptr) {
+            return false;
+        }
+    } else {
+        CdiOsAtomicStore32(&next_segment_ptr->closed, 0);
+    }
+
+    // Close the segment using an atomic operation, so the consumer sees every item written to it and the link to the
+    // next segment before it sees the flag.
+    CdiOsAtomicStore32(&segment_ptr->closed, 1);
+    state_ptr->write_segment_ptr = next_segment_ptr;
+    state_ptr->cached_read_index = CdiOsAtomicLoad32(&next_segment_ptr->read_index);
+    return true;
 }
 
 /**
- * Wait on either an empty or full queue. This is done by using the specified signal to wait for one of the queue
- * read/write pointers to change. The wait can be aborted if any of the signals in the specified signal array get set.
+ * @brief Get the number of items that can be written to the producer's segment, up to the number wanted. The snapshot
+ * of the consumer's read index is only refreshed if it shows fewer free items than wanted. Must only be called by the
+ * producer.
  *
- * @param entry_change_ptr Pointer to either the read or write pointer that is going to be changed outside the scope of
- *                         this function. The contents of this pointer is made a volatile pointer to prevent the
- *                         compiler from caching it in a register. It must be re-read from memory each time it is used
- *                         in this function.
- * @param entry_static_ptr Pointer to the read or write pointer that is not being changed.
- * @param wait_signal Signal that is set when the address pointed to by entry_change_ptr changes.
+ * @param state_ptr Queue state information.
+ * @param segment_ptr Pointer to the producer's segment.
+ * @param wanted_count Number of items the producer wants to write.
+ *
+ * @return Number of items that can be written, which is no more than wanted_count.
+ */
+static uint32_t ProducerGetFreeCount(QueueState* state_ptr, QueueSegment* segment_ptr, uint32_t wanted_count)
+{
+    const uint32_t write_index = segment_ptr->write_index;
+    uint32_t free_count = segment_ptr->capacity - (write_index - state_ptr->cached_read_index);
+
+    if (free_count < wanted_count) {
+        // Refresh the snapshot of the consumer's read index. Use atomic operation to ensure latest memory is being read
+        // from.
+        state_ptr->cached_read_index = CdiOsAtomicLoad32(&segment_ptr->read_index);
+        free_count = segment_ptr->capacity - (write_index - state_ptr->cached_read_index);
+    }
+
+    return (free_count < wanted_count) ? free_count : wanted_count;
+}
+
+/**
+ * @brief Make items that have been written to the producer's segment visible to the consumer. Must only be called by
+ * the producer.
+ *
+ * @param state_ptr Queue state information.
+ * @param segment_ptr Pointer to the producer's segment.
+ * @param item_count Number of items written starting at the segment's write index.
+ */
+static void ProducerPublish(QueueState* state_ptr, QueueSegment* segment_ptr, uint32_t item_count)
+{
+    const uint32_t write_index = segment_ptr->write_index;
+
+#ifdef DEBUG
+    for (uint32_t i = 0; i < item_count; i++) {
+        const int current_occupancy = CdiOsAtomicInc32(&state_ptr->occupancy);
+
+        if (state_ptr->debug_cb_ptr) {
+            uint8_t* item_data_ptr = GetItemDataPointer(state_ptr, segment_ptr, write_index + i);
+            CdiQueueCbData cb_data = {
+                .is_pop = false,
+                .read_ptr = GetItemDataPointer(state_ptr, segment_ptr, state_ptr->cached_read_index),
+                .write_ptr = item_data_ptr,
+                .item_data_ptr = item_data_ptr,
+                .occupancy = current_occupancy,
+            };
+            (state_ptr->debug_cb_ptr)(&cb_data);
+        }
+    }
+#else
+    (void)state_ptr;
+#endif
+
+    // Advance the write index past all of the items. Use an atomic operation to ensure the item data has been
+    // completely written to memory before this variable gets changed.
+    CdiOsAtomicStore32(&segment_ptr->write_index, write_index + item_count);
+}
+
+/**
+ * @brief Get the segment and index of the next item to be read. If the consumer's segment has been drained and the
+ * producer has closed it, the consumer moves to the next segment. Must only be called by the consumer.
+ *
+ * @param state_ptr Queue state information.
+ * @param ret_read_index_ptr Address where to write the index of the item in the returned segment.
+ *
+ * @return Pointer to segment holding the next item, or NULL if the queue is empty.
+ */
+static QueueSegment* ConsumerGetReadSegment(QueueState* state_ptr, uint32_t* ret_read_index_ptr)
+{
+    QueueSegment* segment_ptr = state_ptr->read_segment_ptr;
+    uint32_t read_index = segment_ptr->read_index;
+
+    while (read_index == state_ptr->cached_write_index) {
+        // Segment appears to be empty, so refresh the snapshot of the producer's write index. Use atomic operations to
+        // ensure latest memory is being read from.
+        state_ptr->cached_write_index = CdiOsAtomicLoad32(&segment_ptr->write_index);
+        if (read_index != state_ptr->cached_write_index) {
+            if (state_ptr->cached_write_index - read_index > state_ptr->high_water_count) {
+                state_ptr->high_water_count = state_ptr->cached_write_index - read_index;
+            }
+            break;
+        }
+        if (0 == CdiOsAtomicLoad32(&segment_ptr->closed)) {
+            return NULL;
+        }
+        // The producer has moved on to the next segment. Items may have been written to this segment after the write
+        // index was read above but before the segment was closed, so check once more before moving on.
+        state_ptr->cached_write_index = CdiOsAtomicLoad32(&segment_ptr->write_index);
+        if (read_index != state_ptr->cached_write_index) {
+            break;
+        }
+        segment_ptr = (QueueSegment*)CdiOsAtomicLoadPointer(&segment_ptr->next_segment_ptr);
+        CdiOsAtomicStorePointer(&state_ptr->read_segment_ptr, segment_ptr);
+        read_index = segment_ptr->read_index;
+        state_ptr->cached_write_index = read_index;
+    }
+
+    *ret_read_index_ptr = read_index;
+    return segment_ptr;
+}
+
+/**
+ * @brief Get the number of items that can be read from the consumer's segment, up to the number wanted. Must only be
+ * called by the consumer after ConsumerGetReadSegment() has returned the segment.
+ *
+ * @param state_ptr Queue state information.
+ * @param segment_ptr Pointer to the consumer's segment.
+ * @param read_index Index of the next item to read.
+ * @param wanted_count Number of items the consumer wants to read.
+ *
+ * @return Number of items that can be read, which is no more than wanted_count.
+ */
+static uint32_t ConsumerGetItemCount(QueueState* state_ptr, QueueSegment* segment_ptr, uint32_t read_index,
+                                     uint32_t wanted_count)
+{
+    uint32_t item_count = state_ptr->cached_write_index - read_index;
+
+    if (item_count < wanted_count) {
+        // Refresh the snapshot of the producer's write index. Use atomic operation to ensure latest memory is being
+        // read from.
+        state_ptr->cached_write_index = CdiOsAtomicLoad32(&segment_ptr->write_index);
+        item_count = state_ptr->cached_write_index - read_index;
+        if (item_count > state_ptr->high_water_count) {
+            state_ptr->high_water_count = item_count;
+        }
+    }
+
+    return (item_count < wanted_count) ? item_count : wanted_count;
+}
+
+/**
+ * @brief Advance the read index of the consumer's segment past items that have been read. If that drains a segment the
+ * producer has closed, the consumer moves on to the next segment right away, so the producer can reuse the drained
+ * segment instead of increasing the queue. Must only be called by the consumer.
+ *
+ * @param state_ptr Queue state information.
+ * @param segment_ptr Pointer to the consumer's segment.
+ * @param read_index New read index.
+ */
+static void ConsumerAdvance(QueueState* state_ptr, QueueSegment* segment_ptr, uint32_t read_index)
+{
+    // Use an atomic operation to ensure the items have been read before the producer can reuse their slots.
+    CdiOsAtomicStore32(&segment_ptr->read_index, read_index);
+
+    if (read_index == state_ptr->cached_write_index && CdiOsAtomicLoad32(&segment_ptr->closed)) {
+        uint32_t next_read_index = 0;
+        ConsumerGetReadSegment(state_ptr, &next_read_index);
+    }
+}
+
+/**
+ * @brief Set a wait signal unless it is already set. A signal that is still set has not been cleared by the thread on
+ * the other side of the queue since it was last set, so that thread is either running or about to wake up and will
+ * see the change without paying for another CdiOsSignalSet(). CdiOsSignalGet() is a full memory barrier, so it cannot
+ * be reordered ahead of the index update that precedes it.
+ *
+ * @param signal Signal to set. Nothing is done if NULL.
+ */
+static inline void SetWaitSignal(CdiSignalType signal)
+{
+    if (signal && !CdiOsSignalGet(signal)) {
+        CdiOsSignalSet(signal);
+    }
+}
+
+/**
+ * @brief Check if the producer's segment is full and the producer can't move on to the next segment without increasing
+ * the queue. Only used while waiting, so the snapshot of the read index is not used.
+ *
+ * @param state_ptr Queue state information.
+ *
+ * @return true if full, otherwise false.
+ */
+static bool QueueIsFull(QueueState* state_ptr)
+{
+    // Use atomic operations to ensure latest memory is being read from.
+    QueueSegment* segment_ptr = (QueueSegment*)CdiOsAtomicLoadPointer(&state_ptr->write_segment_ptr);
+    if (CdiOsAtomicLoad32(&segment_ptr->write_index) - CdiOsAtomicLoad32(&segment_ptr->read_index) <
+            segment_ptr->capacity) {
+        return false;
+    }
+    // The next segment can be reused once the consumer has moved past it. See ProducerNextSegment().
+    return CdiOsAtomicLoadPointer(&segment_ptr->next_segment_ptr) ==
+           CdiOsAtomicLoadPointer(&state_ptr->read_segment_ptr);
+}
+
+/**
+ * Wait on either an empty or full queue. This is done by using the specified signal to wait for the queue to become
+ * non-empty or non-full. The wait can be aborted if any of the signals in the specified signal array get set.
+ *
+ * @param state_ptr Queue state information.
+ * @param wait_for_item If true, wait until the queue is not empty. Otherwise wait until the queue is not full.
+ * @param wait_signal Signal that is set when the queue's read or write index changes.
  * @param timeout_ms Maximume time to wait, in milliseconds.
  * @param cancel_wait_signal_array Array of wait cancel signals.
  * @param num_signals Number of signals in the signal array.
  * @param ret_signal_index_ptr Address where to write the returned index value of the signal that was set.
  *
- * @return Returns true if the wait_signal was set and the contents of the address pointed to by entry_change_ptr
- *         changed.
+ * @return Returns true if the wait_signal was set and the queue is no longer empty or full.
  */
-static inline bool WaitForSignals(CdiSinglyLinkedListEntry* volatile* entry_change_ptr,
-                                  CdiSinglyLinkedListEntry* entry_static_ptr, CdiSignalType wait_signal, int timeout_ms,
-                                  CdiSignalType* cancel_wait_signal_array, int num_signals,
+static inline bool WaitForSignals(QueueState* state_ptr, bool wait_for_item, CdiSignalType wait_signal,
+                                  int timeout_ms, CdiSignalType* cancel_wait_signal_array, int num_signals,
                                   uint32_t* ret_signal_index_ptr)
 {
     bool ret = true;
@@ -237,8 +484,8 @@ static inline bool WaitForSignals(CdiSinglyLinkedListEntry* volatile* entry_chan
             signal_ptr[i+1] = cancel_wait_signal_array[i];
         }
 
-        // Exit loop if queue pointer changes, get a signal or timeout.
-        while (*entry_change_ptr == entry_static_ptr) {
+        // Exit loop if queue state changes, get a signal or timeout.
+        while (wait_for_item ? CdiQueueIsEmpty((CdiQueueHandle)state_ptr) : QueueIsFull(state_ptr)) {
             CdiOsSignalsWait(signal_ptr, num_actual_signals, false, timeout_ms, &signal_index);
             if (0 != signal_index) {
                 // Wait was aborted (not set by "wait_signal") or timed-out (signal_index=CDI_OS_SIG_TIMEOUT).
@@ -274,39 +521,30 @@ bool CdiQueueCreate(const char* name_str, uint32_t item_count, uint32_t grow_cou
         return false;
     }
 
-    // The implementation does not allow item_count items to occupy the queue. It is deemed to be "full" when it has
-    // item_count - 1 items in it. Adjust item_count so that the true size requested is available.
-    item_count += 1;
-
-    uint32_t size_needed = sizeof(CdiSinglyLinkedListEntry) + (item_count * (sizeof(QueueItem) + item_byte_size));
-    void* queue_item_array = CdiOsMemAllocZero(size_needed);
-    if (NULL == queue_item_array) {
-        CDI_LOG_THREAD(kLogError, "Not enough memory to allocate queue[%s] with size [%"PRIu32"]", name_str, size_needed);
-        return false;
-    }
-
     QueueState* state_ptr = (QueueState*)CdiOsMemAllocZero(sizeof(QueueState));
     if (NULL == state_ptr) {
-        CdiOsMemFree(queue_item_array);
-        queue_item_array = NULL;
         return false;
     }
 
-    if (ret) {
-        CdiOsStrCpy(state_ptr->name_str, sizeof(state_ptr->name_str), name_str);
-        state_ptr->queue_grow_count = grow_count;
-        state_ptr->queue_max_grow_count = max_grow_count;
-        state_ptr->queue_item_data_byte_size = item_byte_size;
-        state_ptr->queue_item_byte_size = sizeof(QueueItem) + item_byte_size;
-        state_ptr->queue_item_count = item_count;
+    CdiOsStrCpy(state_ptr->name_str, sizeof(state_ptr->name_str), name_str);
+    state_ptr->queue_grow_count = grow_count;
+    state_ptr->queue_max_grow_count = max_grow_count;
+    state_ptr->queue_item_data_byte_size = item_byte_size;
+    state_ptr->queue_item_count = item_count;
 
-        // Initialize the allocated buffers.
-        CdiSinglyLinkedListInit(&state_ptr->allocated_buffer_list);
+    // Initialize the allocated buffers.
+    CdiSinglyLinkedListInit(&state_ptr->allocated_buffer_list);
 
-        AddEntriesToBuffers(state_ptr, (uint8_t*)queue_item_array, (int)item_count);
-        // Set read pointer to match write pointer, so the queue starts empty.
-        state_ptr->entry_read_ptr = state_ptr->entry_write_ptr;
+    QueueSegment* segment_ptr = SegmentCreate(state_ptr, item_count);
+    if (NULL == segment_ptr) {
+        CdiOsMemFree(state_ptr);
+        return false;
     }
+    // Producer and consumer start on the same segment with both indices at zero, so the queue starts empty. The
+    // segment is a ring of one until the queue is increased.
+    segment_ptr->next_segment_ptr = segment_ptr;
+    state_ptr->write_segment_ptr = segment_ptr;
+    state_ptr->read_segment_ptr = segment_ptr;
 
     // Mask off option bits leaving only the mode selection.
     const CdiQueueSignalMode signal_mode_masked = signal_mode & kQueueSignalModeMask;
@@ -336,54 +574,69 @@ bool CdiQueueCreate(const char* name_str, uint32_t item_count, uint32_t grow_cou
 }
 
 bool CdiQueuePop(CdiQueueHandle handle, void* item_dest_ptr)
+{
+    return 1 == CdiQueuePopMultiple(handle, item_dest_ptr, 1);
+}
+
+int CdiQueuePopMultiple(CdiQueueHandle handle, void* item_dest_array, int max_item_count)
 {
     QueueState* state_ptr = (QueueState*)handle;
+    uint8_t* item_dest_ptr = (uint8_t*)item_dest_array;
+    int popped_count = 0;
 
     if (NULL != state_ptr->wake_pop_waiters_signal) {
-        // Clear signal then use the read/write pointers, in case another thread is using one of the Push functions.
+        // Clear signal then use the read/write indices, in case another thread is using one of the Push functions.
         CdiOsSignalClear(state_ptr->wake_pop_waiters_signal);
     }
 
-    // Use atomic operations to ensure latest memory is being read from.
-    CdiSinglyLinkedListEntry* entry_read_ptr = (CdiSinglyLinkedListEntry*)CdiOsAtomicLoadPointer(&state_ptr->entry_read_ptr);
-    CdiSinglyLinkedListEntry* entry_write_ptr = (CdiSinglyLinkedListEntry*)CdiOsAtomicLoadPointer(&state_ptr->entry_write_ptr);
+    while (popped_count < max_item_count) {
+        uint32_t read_index = 0;
+        QueueSegment* segment_ptr = ConsumerGetReadSegment(state_ptr, &read_index);
 
-    // Check if queue is empty.
-    if (entry_read_ptr == entry_write_ptr) {
-        return false;
-    }
+        // Check if queue is empty.
+        if (NULL == segment_ptr) {
+            break;
+        }
 
-    if (item_dest_ptr) {
-        // Copy the data from the queue buffer to the memory pointed to by item_dest_ptr.
-        uint8_t* item_data_ptr = GetDataItemFromListEntry(entry_read_ptr);
-        memcpy(item_dest_ptr, item_data_ptr, state_ptr->queue_item_data_byte_size);
-    }
+        const uint32_t item_count = ConsumerGetItemCount(state_ptr, segment_ptr, read_index,
+                                                         max_item_count - popped_count);
+        for (uint32_t i = 0; i < item_count; i++) {
+            uint8_t* item_data_ptr = GetItemDataPointer(state_ptr, segment_ptr, read_index + i);
+            if (item_dest_ptr) {
+                // Copy the data from the queue buffer to the memory pointed to by item_dest_ptr.
+                memcpy(item_dest_ptr, item_data_ptr, state_ptr->queue_item_data_byte_size);
+            }
 
 #ifdef DEBUG
-    const int current_occupancy = CdiOsAtomicDec32(&state_ptr->occupancy);
-
-    if (state_ptr->debug_cb_ptr) {
-        CdiQueueCbData cb_data = {
-            .is_pop = true,
-            .read_ptr = entry_read_ptr,
-            .write_ptr = entry_write_ptr,
-            .item_data_ptr = item_dest_ptr,
-            .occupancy = current_occupancy,
-        };
-        (state_ptr->debug_cb_ptr)(&cb_data);
-    }
+            const int current_occupancy = CdiOsAtomicDec32(&state_ptr->occupancy);
+
+            if (state_ptr->debug_cb_ptr) {
+                CdiQueueCbData cb_data = {
+                    .is_pop = true,
+                    .read_ptr = item_data_ptr,
+                    .write_ptr = GetItemDataPointer(state_ptr, segment_ptr, state_ptr->cached_write_index),
+                    .item_data_ptr = item_dest_ptr,
+                    .occupancy = current_occupancy,
+                };
+                (state_ptr->debug_cb_ptr)(&cb_data);
+            }
 #endif
+            if (item_dest_ptr) {
+                item_dest_ptr += state_ptr->queue_item_data_byte_size;
+            }
+        }
 
-    // Advance the read pointer. Use an atomic operation to ensure the memcpy above has copied all the data to memory
-    // before this variable gets changed.
-    CdiOsAtomicStorePointer(&state_ptr->entry_read_ptr, CdiSinglyLinkedListNextEntry(entry_read_ptr));
+        // Advance the read index past all of the items, now that the memcpy above has copied them.
+        ConsumerAdvance(state_ptr, segment_ptr, read_index + item_count);
+        popped_count += item_count;
+    }
 
-    // If blockable push was enabled upon creation, set the signal to wake-up any waiting threads.
-    if (state_ptr->wake_push_waiters_signal) {
-        CdiOsSignalSet(state_ptr->wake_push_waiters_signal);
+    if (popped_count) {
+        // If blockable push was enabled upon creation, set the signal to wake-up any waiting threads.
+        SetWaitSignal(state_ptr->wake_push_waiters_signal);
     }
 
-    return true;
+    return popped_count;
 }
 
 bool CdiQueuePopWait(CdiQueueHandle handle, int timeout_ms, CdiSignalType abort_wait_signal, void* item_dest_ptr)
@@ -406,77 +659,191 @@ bool CdiQueuePopWaitMultiple(CdiQueueHandle handle, int timeout_ms, CdiSignalTyp
     // Wait here until an entry has been popped, get an abort signal or a timeout.
     while (ret && !CdiQueuePop(handle, item_dest_ptr)) {
         // Queue is empty, so setup to wait for an item to be pushed to it.
-        ret = WaitForSignals(&state_ptr->entry_write_ptr, state_ptr->entry_read_ptr,
-                             state_ptr->wake_pop_waiters_signal, timeout_ms, abort_wait_signal_array, num_signals,
-                             ret_signal_index_ptr);
+        ret = WaitForSignals(state_ptr, true, state_ptr->wake_pop_waiters_signal, timeout_ms, abort_wait_signal_array,
+                             num_signals, ret_signal_index_ptr);
     }
 
     return ret;
 }
 
-bool CdiQueuePush(CdiQueueHandle handle, const void* data_ptr)
+bool CdiQueuePopPeek(CdiQueueHandle handle, void** ret_item_ptr)
+{
+    QueueState* state_ptr = (QueueState*)handle;
+
+    if (NULL != state_ptr->wake_pop_waiters_signal) {
+        // Clear signal then use the read/write indices, in case another thread is using one of the Push functions.
+        CdiOsSignalClear(state_ptr->wake_pop_waiters_signal);
+    }
+
+    uint32_t read_index = 0;
+    QueueSegment* segment_ptr = ConsumerGetReadSegment(state_ptr, &read_index);
+
+    // Check if queue is empty.
+    if (NULL == segment_ptr) {
+        return false;
+    }
+
+    // The producer does not write to this slot until CdiQueuePopRelease() advances the read index, so the item can be
+    // used in place.
+    *ret_item_ptr = GetItemDataPointer(state_ptr, segment_ptr, read_index);
+    return true;
+}
+
+bool CdiQueuePopPeekWait(CdiQueueHandle handle, int timeout_ms, CdiSignalType abort_wait_signal, void** ret_item_ptr)
 {
     bool ret = true;
     QueueState* state_ptr = (QueueState*)handle;
 
-    if (state_ptr->multiple_writer_cs) {
-        CdiOsCritSectionReserve(state_ptr->multiple_writer_cs);
+    if (NULL == state_ptr->wake_pop_waiters_signal) {
+        CDI_LOG_THREAD(kLogError,
+                       "Queue[%s] not configured for PopWait signal. See CdiQueueCreate().", state_ptr->name_str);
+        return false;
     }
 
-    // Use atomic operations to ensure latest memory is being read from.
-    CdiSinglyLinkedListEntry* entry_read_ptr = (CdiSinglyLinkedListEntry*)CdiOsAtomicLoadPointer(&state_ptr->entry_read_ptr);
-    CdiSinglyLinkedListEntry* entry_write_ptr = (CdiSinglyLinkedListEntry*)CdiOsAtomicLoadPointer(&state_ptr->entry_write_ptr);
-
-    CdiSinglyLinkedListEntry* new_write_ptr = CdiSinglyLinkedListNextEntry(entry_write_ptr);
-
-    // Check if queue is full.
-    if (new_write_ptr == entry_read_ptr) {
-        // Queue is full. Try to grow it.
-        ret = QueueIncrease(handle);
-        if (ret) {
-            // Successfully grew the queue, so get new write pointer since growing it changes the value. Use atomic
-            // operation to ensure latest memory is being read from.
-            entry_write_ptr = (CdiSinglyLinkedListEntry*)CdiOsAtomicLoadPointer(&state_ptr->entry_write_ptr);
-            new_write_ptr = CdiSinglyLinkedListNextEntry(entry_write_ptr);
-        }
+    // Wait here until an entry is available, get an abort signal or a timeout.
+    while (ret && !CdiQueuePopPeek(handle, ret_item_ptr)) {
+        // Queue is empty, so setup to wait for an item to be pushed to it.
+        ret = WaitForSignals(state_ptr, true, state_ptr->wake_pop_waiters_signal, timeout_ms, &abort_wait_signal, 1,
+                             NULL);
     }
 
-    if (ret) {
-        // Copy the data to the queue buffer before updating the write pointer, so the read operation always has valid
-        // data.
-        uint8_t* item_dest_ptr = GetDataItemFromListEntry(entry_write_ptr);
-        memcpy(item_dest_ptr, data_ptr, state_ptr->queue_item_data_byte_size);
+    return ret;
+}
+
+void CdiQueuePopRelease(CdiQueueHandle handle)
+{
+    QueueState* state_ptr = (QueueState*)handle;
+    uint32_t read_index = 0;
+
+    // Returns the same segment and index that CdiQueuePopPeek() did, since only the consumer changes them.
+    QueueSegment* segment_ptr = ConsumerGetReadSegment(state_ptr, &read_index);
+    assert(NULL != segment_ptr); // CdiQueuePopPeek() must have returned an item.
 
 #ifdef DEBUG
-        const int current_occupancy = CdiOsAtomicInc32(&state_ptr->occupancy);
+    const int current_occupancy = CdiOsAtomicDec32(&state_ptr->occupancy);
 
-        if (state_ptr->debug_cb_ptr) {
-            CdiQueueCbData cb_data = {
-                .is_pop = false,
-                .read_ptr = entry_read_ptr,
-                .write_ptr = entry_write_ptr,
-                .item_data_ptr = item_dest_ptr,
-                .occupancy = current_occupancy,
-            };
-            (state_ptr->debug_cb_ptr)(&cb_data);
-        }
+    if (state_ptr->debug_cb_ptr) {
+        uint8_t* item_data_ptr = GetItemDataPointer(state_ptr, segment_ptr, read_index);
+        CdiQueueCbData cb_data = {
+            .is_pop = true,
+            .read_ptr = item_data_ptr,
+            .write_ptr = GetItemDataPointer(state_ptr, segment_ptr, state_ptr->cached_write_index),
+            .item_data_ptr = item_data_ptr,
+            .occupancy = current_occupancy,
+        };
+        (state_ptr->debug_cb_ptr)(&cb_data);
+    }
 #endif
 
-        // Update the write pointer. Use an atomic operation to ensure the data written above by the memcpy has been
-        // completely written to memory before this variable gets changed.
-        CdiOsAtomicStorePointer(&state_ptr->entry_write_ptr, new_write_ptr);
+    // The caller is done with the item, so the producer can reuse its slot.
+    ConsumerAdvance(state_ptr, segment_ptr, read_index + 1);
 
-        // If blockable pop was enabled upon creation, set the signal to wake-up any waiting threads.
-        if (state_ptr->wake_pop_waiters_signal) {
-            CdiOsSignalSet(state_ptr->wake_pop_waiters_signal);
+    // If blockable push was enabled upon creation, set the signal to wake-up any waiting threads.
+    SetWaitSignal(state_ptr->wake_push_waiters_signal);
+}
+
+bool CdiQueuePush(CdiQueueHandle handle, const void* data_ptr)
+{
+    return 1 == CdiQueuePushMultiple(handle, data_ptr, 1);
+}
+
+int CdiQueuePushMultiple(CdiQueueHandle handle, const void* item_array, int item_count)
+{
+    QueueState* state_ptr = (QueueState*)handle;
+    const uint8_t* item_src_ptr = (const uint8_t*)item_array;
+    int pushed_count = 0;
+
+    if (state_ptr->multiple_writer_cs) {
+        CdiOsCritSectionReserve(state_ptr->multiple_writer_cs);
+    }
+    assert(0 == state_ptr->reserved_count); // Must not be used between CdiQueuePushReserve() and CdiQueuePushCommit().
+
+    while (pushed_count < item_count) {
+        QueueSegment* segment_ptr = state_ptr->write_segment_ptr;
+        const uint32_t write_index = segment_ptr->write_index;
+        const uint32_t free_count = ProducerGetFreeCount(state_ptr, segment_ptr, item_count - pushed_count);
+
+        if (0 == free_count) {
+            // Segment is full. Items already written to it have been made visible to the consumer, so it is ok for
+            // the producer to move on to another segment, growing the queue if needed.
+            if (!ProducerNextSegment(state_ptr)) {
+                state_ptr->push_fail_count++;
+                break;
+            }
+            continue;
+        }
+
+        // Copy the data to the queue buffer before updating the write index, so the read operation always has valid
+        // data.
+        for (uint32_t i = 0; i < free_count; i++) {
+            uint8_t* item_dest_ptr = GetItemDataPointer(state_ptr, segment_ptr, write_index + i);
+            memcpy(item_dest_ptr, item_src_ptr, state_ptr->queue_item_data_byte_size);
+            item_src_ptr += state_ptr->queue_item_data_byte_size;
         }
+
+        ProducerPublish(state_ptr, segment_ptr, free_count);
+        pushed_count += free_count;
+    }
+
+    if (pushed_count) {
+        // If blockable pop was enabled upon creation, set the signal to wake-up any waiting threads.
+        SetWaitSignal(state_ptr->wake_pop_waiters_signal);
     }
 
     if (state_ptr->multiple_writer_cs) {
         CdiOsCritSectionRelease(state_ptr->multiple_writer_cs);
     }
 
-    return ret;
+    return pushed_count;
+}
+
+bool CdiQueuePushReserve(CdiQueueHandle handle, void** ret_item_ptr)
+{
+    QueueState* state_ptr = (QueueState*)handle;
+
+    if (state_ptr->multiple_writer_cs && 0 == state_ptr->reserved_count) {
+        // Held until CdiQueuePushCommit(), so other writers cannot use the slots that follow this one.
+        CdiOsCritSectionReserve(state_ptr->multiple_writer_cs);
+    }
+
+    QueueSegment* segment_ptr = state_ptr->write_segment_ptr;
+    const uint32_t reserved_count = state_ptr->reserved_count;
+    if (ProducerGetFreeCount(state_ptr, segment_ptr, reserved_count + 1) <= reserved_count) {
+        if (reserved_count) {
+            // Segment is full. The consumer moves on once it has drained this segment, so the producer can't move to
+            // another segment until the items reserved here are committed. The caller commits them and tries again.
+            return false;
+        }
+        if (!ProducerNextSegment(state_ptr)) {
+            state_ptr->push_fail_count++;
+            if (state_ptr->multiple_writer_cs) {
+                // Nothing has been reserved, so CdiQueuePushCommit() will not be called.
+                CdiOsCritSectionRelease(state_ptr->multiple_writer_cs);
+            }
+            return false;
+        }
+        segment_ptr = state_ptr->write_segment_ptr;
+    }
+
+    *ret_item_ptr = GetItemDataPointer(state_ptr, segment_ptr, segment_ptr->write_index + reserved_count);
+    state_ptr->reserved_count++;
+    return true;
+}
+
+void CdiQueuePushCommit(CdiQueueHandle handle)
+{
+    QueueState* state_ptr = (QueueState*)handle;
+
+    assert(0 != state_ptr->reserved_count); // CdiQueuePushReserve() must have returned an item.
+    ProducerPublish(state_ptr, state_ptr->write_segment_ptr, state_ptr->reserved_count);
+    state_ptr->reserved_count = 0;
+
+    // If blockable pop was enabled upon creation, set the signal to wake-up any waiting threads.
+    SetWaitSignal(state_ptr->wake_pop_waiters_signal);
+
+    if (state_ptr->multiple_writer_cs) {
+        CdiOsCritSectionRelease(state_ptr->multiple_writer_cs);
+    }
 }
 
 bool CdiQueuePushWait(CdiQueueHandle handle, int timeout_ms, CdiSignalType abort_wait_signal, const void* item_ptr)
@@ -496,17 +863,14 @@ bool CdiQueuePushWaitMultiple(CdiQueueHandle handle, int timeout_ms, CdiSignalTy
         return false;
     }
 
-    // Clear signal and then use the entry write/read pointers, in case another thread is using one of the Pop API
-    // functions.
+    // Clear signal and then use the read/write indices, in case another thread is using one of the Pop API functions.
     CdiOsSignalClear(state_ptr->wake_push_waiters_signal);
 
-    CdiSinglyLinkedListEntry* new_write_ptr = CdiSinglyLinkedListNextEntry(state_ptr->entry_write_ptr);
-
     // Wait here until the entry is pushed, get an abort signal or a timeout.
     while (ret && !CdiQueuePush(handle, item_ptr)) {
         // Queue is full, so setup to wait for an item to be popped from it.
-        ret = WaitForSignals(&state_ptr->entry_read_ptr, new_write_ptr, state_ptr->wake_push_waiters_signal,
-                             timeout_ms, signal_array, num_signals, ret_signal_index_ptr);
+        ret = WaitForSignals(state_ptr, false, state_ptr->wake_push_waiters_signal, timeout_ms, signal_array,
+                             num_signals, ret_signal_index_ptr);
     }
 
     return ret;
@@ -515,14 +879,38 @@ bool CdiQueuePushWaitMultiple(CdiQueueHandle handle, int timeout_ms, CdiSignalTy
 void CdiQueueFlush(CdiQueueHandle handle)
 {
     QueueState* state_ptr = (QueueState*)handle;
-    CdiOsAtomicStorePointer(&state_ptr->entry_read_ptr, CdiOsAtomicLoadPointer(&state_ptr->entry_write_ptr));
+    QueueSegment* segment_ptr = state_ptr->read_segment_ptr;
+
+    // Discard everything in the consumer's segment and in any segments the producer has moved on to since.
+    while (true) {
+        const uint32_t write_index = CdiOsAtomicLoad32(&segment_ptr->write_index);
+        CdiOsAtomicStore32(&segment_ptr->read_index, write_index);
+        state_ptr->cached_write_index = write_index;
+        if (0 == CdiOsAtomicLoad32(&segment_ptr->closed)) {
+            break;
+        }
+        // Flush any items written before the segment was closed, then move on to the next one.
+        CdiOsAtomicStore32(&segment_ptr->read_index, CdiOsAtomicLoad32(&segment_ptr->write_index));
+        segment_ptr = (QueueSegment*)CdiOsAtomicLoadPointer(&segment_ptr->next_segment_ptr);
+        CdiOsAtomicStorePointer(&state_ptr->read_segment_ptr, segment_ptr);
+    }
 }
 
 bool CdiQueueIsEmpty(CdiQueueHandle handle)
 {
     QueueState* state_ptr = (QueueState*)handle;
-    // Use atomic operations to ensure latest memory is being read from.
-    return (CdiOsAtomicLoadPointer(&state_ptr->entry_read_ptr) == CdiOsAtomicLoadPointer(&state_ptr->entry_write_ptr));
+    // Segments are not freed until the queue is destroyed, so it is safe to walk the ring from any thread. Segments
+    // that neither side is using have been drained, so checking all of them is the same as checking the ones between
+    // the consumer and the producer. Use atomic operations to ensure latest memory is being read from.
+    QueueSegment* first_segment_ptr = (QueueSegment*)CdiOsAtomicLoadPointer(&state_ptr->read_segment_ptr);
+    QueueSegment* segment_ptr = first_segment_ptr;
+    do {
+        if (CdiOsAtomicLoad32(&segment_ptr->read_index) != CdiOsAtomicLoad32(&segment_ptr->write_index)) {
+            return false;
+        }
+        segment_ptr = (QueueSegment*)CdiOsAtomicLoadPointer(&segment_ptr->next_segment_ptr);
+    } while (segment_ptr != first_segment_ptr);
+    return true;
 }
 
 CdiSignalType CdiQueueGetPushWaitSignal(CdiQueueHandle handle)
@@ -549,6 +937,27 @@ CdiSignalType CdiQueueGetPopWaitSignal(CdiQueueHandle handle)
     return NULL;
 }
 
+void CdiQueueGetStats(CdiQueueHandle handle, CdiQueueStats* ret_stats_ptr)
+{
+    QueueState* state_ptr = (QueueState*)handle;
+
+    // Segments are not freed until the queue is destroyed, so it is safe to walk the ring from any thread.
+    int occupancy = 0;
+    QueueSegment* first_segment_ptr = (QueueSegment*)CdiOsAtomicLoadPointer(&state_ptr->read_segment_ptr);
+    QueueSegment* segment_ptr = first_segment_ptr;
+    do {
+        occupancy += (int)(CdiOsAtomicLoad32(&segment_ptr->write_index) - CdiOsAtomicLoad32(&segment_ptr->read_index));
+        segment_ptr = (QueueSegment*)CdiOsAtomicLoadPointer(&segment_ptr->next_segment_ptr);
+    } while (segment_ptr != first_segment_ptr);
+
+    ret_stats_ptr->item_count = CdiOsAtomicLoad32(&state_ptr->queue_item_count);
+    ret_stats_ptr->occupancy = occupancy;
+    ret_stats_ptr->high_water_item_count = (int)CdiOsAtomicLoad32(&state_ptr->high_water_count);
+    ret_stats_ptr->grow_count = CdiOsAtomicLoad32(&state_ptr->queue_cur_grow_count);
+    ret_stats_ptr->push_fail_count = CdiOsAtomicLoad32(&state_ptr->push_fail_count);
+    ret_stats_ptr->byte_size = CdiOsAtomicLoad64(&state_ptr->allocated_byte_size);
+}
+
 const char* CdiQueueGetName(CdiQueueHandle handle)
 {
     QueueState* state_ptr = (QueueState*)handle;
@@ -582,11 +991,11 @@ void CdiQueueDestroy(CdiQueueHandle handle)
 
     if (state_ptr) {
         // Ensure that the queue is empty.
-        assert(state_ptr->entry_read_ptr == state_ptr->entry_write_ptr);
+        assert(CdiQueueIsEmpty(handle));
 
         CdiSinglyLinkedListEntry* allocated_buffer_ptr = state_ptr->allocated_buffer_list.head_ptr;
 
-        // Free up each of the allocated buffers.
+        // Free up each of the allocated segments.
         while (allocated_buffer_ptr) {
             CdiSinglyLinkedListEntry* next_allocated_buffer_ptr = CdiSinglyLinkedListNextEntry(allocated_buffer_ptr);
             CdiOsMemFree(allocated_buffer_ptr);
@@ -355,6 +355,10 @@ static OptDef my_options[] =
     { "ka",   "keep_alive",   0, NULL,               NULL,
         "For the given connection, Tx continues sending payloads and Rx continues receiving payloads\n"
         "even when a payload error is detected. This option is disabled by default."},
+    { "rprf", "resource_profile", 0, NULL,             NULL,
+        "For the given connection, size the SDK's internal resources from the largest payload size\n"
+        "and the rate of its streams instead of using the worst case sizes. This option is disabled\n"
+        "by default."},
     { "ad",   "adapter",      1, "<adapter type>",   NULL,
         "Global option. Choose an adapter for the test to run all connections on."},
     { "bt",   "buffer_type",  1, "<buffer type>",    NULL,
@@ -1425,6 +1429,8 @@ void PrintTestSettings(const TestSettings* const test_settings_ptr, const int nu
         TestConsoleLog(kLogInfo, "    Conn Name    : %s",
                        CdiGetEmptyStringIfNull(test_settings_ptr[i].connection_name_str));
         TestConsoleLog(kLogInfo, "    Keep Alive   : %s", CdiUtilityBoolToString(test_settings_ptr[i].keep_alive));
+        TestConsoleLog(kLogInfo, "    Res Profile  : %s",
+                       CdiUtilityBoolToString(test_settings_ptr[i].resource_profile));
         TestConsoleLog(kLogInfo, "    Adapter      : %s",
                        CdiGetEmptyStringIfNull(CdiUtilityKeyEnumToString(kKeyAdapterType,
                                                                       adapter_data_ptr->adapter_type)));
@@ -1627,6 +1633,14 @@ ProgramExecutionStatus GetArgs(int argc, const char** argv_ptr, TestSettings* te
             case kTestOptionKeepAlive:
                 test_settings_ptr[connection_index].keep_alive = true;
                 break;
+            case kTestOptionResourceProfile:
+                if (is_parsing_stream_option) {
+                    TestConsoleLog(kLogError, "--resource_profile is not a stream option. Specify for a connection.");
+                    arg_error = true;
+                } else {
+                    test_settings_ptr[connection_index].resource_profile = true;
+                }
+                break;
             case kTestOptionBufferType:
                 if (is_parsing_stream_option) {
                         TestConsoleLog(kLogError, "--buffer_type is not a stream option. Specify for a connection.");
@@ -75,6 +75,7 @@ typedef enum {
     kTestOptionStreamID,
     kTestOptionConfigSkip,
     kTestOptionKeepAlive,
+    kTestOptionResourceProfile,
     kTestOptionAdapter,
     kTestOptionBufferType,
     kTestOptionLocalIP,
@@ -174,6 +175,8 @@ typedef struct {
     CdiConnectionProtocolType connection_protocol;
     /// When true, receiver stays alive even after the first test finishes.
     bool keep_alive;
+    /// When true, the connection's resources are sized from its largest payload size and rate.
+    bool resource_profile;
     /// Enum representing the buffer type.
     CdiBufferType buffer_type;
     /// The local network adapter IP address.
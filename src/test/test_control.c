@@ -17,6 +17,7 @@
 #include "test_control.h"
 
 #include <assert.h>
+#include <inttypes.h>
 #include <stdio.h>
 #include <stdlib.h>
 
@@ -283,6 +284,28 @@ void TestStatisticsCallback(const CdiCoreStatsCbData* cb_data_ptr)
                         connection_info_ptr->transfer_time_max_overall,
                         counter_stats_ptr->num_payloads_late);
 
+        if (connection_info_ptr->test_settings_ptr->tx && 0 < interval_stats_ptr->transfer_count) {
+            CDI_LOG_THREAD_COMPONENT(kLogInfo, kLogComponentPerformanceMetrics,
+                            "Tx queue time: Avg[%lu]us Max[%u]us. Packets[%lu] Pacing delays[%lu].",
+                            interval_stats_ptr->tx_queue_time_sum / interval_stats_ptr->transfer_count,
+                            interval_stats_ptr->tx_queue_time_max,
+                            endpoint_stats_ptr->tx_packet_count,
+                            endpoint_stats_ptr->tx_pacing_delay_count);
+        }
+
+        const CdiResourceStats* resource_stats_ptr = &transfer_stats_ptr->resource_stats;
+        CDI_LOG_THREAD_COMPONENT(kLogInfo, kLogComponentPerformanceMetrics,
+                        "Pools: Peak usage[%u%%] Free[%u/%u] Grows[%u] Get failures[%u]. Queues: Peak usage[%u%%] "
+                        "Grows[%u] Push failures[%u].",
+                        resource_stats_ptr->pool_peak_usage_percent,
+                        resource_stats_ptr->pool_free_item_count,
+                        resource_stats_ptr->pool_item_count,
+                        resource_stats_ptr->pool_grow_count,
+                        resource_stats_ptr->pool_get_fail_count,
+                        resource_stats_ptr->queue_peak_usage_percent,
+                        resource_stats_ptr->queue_grow_count,
+                        resource_stats_ptr->queue_push_fail_count);
+
         // Save counter based stats so we can calculate deltas next time.
         connection_info_ptr->payload_counter_stats_array[i] = *counter_stats_ptr;
     }
@@ -589,3 +612,33 @@ void LogTimestamps(const StreamSettings* stream_settings_ptr, TestConnectionStre
         stream_info_ptr->last_ptp_timestamp = current_ptp_timestamp;
     }
 }
+
+void TestResourceProfileSet(const TestSettings* test_settings_ptr, CdiResourceProfile* ret_profile_ptr)
+{
+    if (test_settings_ptr->resource_profile) {
+        int max_payload_size = 0;
+        for (int i = 0; i < test_settings_ptr->number_of_streams; i++) {
+            if (test_settings_ptr->stream_settings[i].payload_size > max_payload_size) {
+                max_payload_size = test_settings_ptr->stream_settings[i].payload_size;
+            }
+        }
+        ret_profile_ptr->max_payload_byte_size = max_payload_size;
+        if (test_settings_ptr->rate_denominator) {
+            // Round up so the rate is never underestimated.
+            ret_profile_ptr->payloads_per_second = (test_settings_ptr->rate_numerator +
+                                                    test_settings_ptr->rate_denominator - 1) /
+                                                   test_settings_ptr->rate_denominator;
+        }
+    }
+}
+
+void TestLogResourceFootprint(const TestConnectionInfo* connection_info_ptr)
+{
+    CdiResourceStats resource_stats;
+    if (kCdiStatusOk == CdiCoreConnectionGetResourceStats(connection_info_ptr->connection_handle, &resource_stats)) {
+        CDI_LOG_THREAD(kLogInfo, "Connection resources: Pools[%u items, %"PRIu64" KiB] Queues[%u items, %"PRIu64
+                       " KiB] Rx packet buffers[%"PRIu64" KiB].", resource_stats.pool_item_count,
+                       resource_stats.pool_byte_size / 1024, resource_stats.queue_item_count,
+                       resource_stats.queue_byte_size / 1024, resource_stats.rx_packet_buffer_byte_size / 1024);
+    }
+}
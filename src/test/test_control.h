@@ -370,4 +370,20 @@ CdiPtpTimestamp GetAudioPtpTimestamp(const StreamSettings* stream_settings_ptr,
 void LogTimestamps(const StreamSettings* stream_settings_ptr, TestConnectionStreamInfo* stream_info_ptr,
                    CdiPtpTimestamp current_ptp_timestamp);
 
+/**
+ * @brief Fill in a connection's resource profile from its test settings, if --resource_profile was used. Otherwise the
+ * profile is left unchanged.
+ *
+ * @param test_settings_ptr Pointer to the connection's test settings.
+ * @param ret_profile_ptr Pointer to the resource profile to fill in.
+ */
+void TestResourceProfileSet(const TestSettings* test_settings_ptr, CdiResourceProfile* ret_profile_ptr);
+
+/**
+ * @brief Log the memory used by the resources of a connection that has just been created.
+ *
+ * @param connection_info_ptr Pointer to the connection's info.
+ */
+void TestLogResourceFootprint(const TestConnectionInfo* connection_info_ptr);
+
 #endif // TEST_CONTROL_H__
@@ -1114,6 +1114,7 @@ CDI_THREAD TestRxCreateThread(void* arg_ptr)
     connection_info_ptr->config_data.rx.linear_buffer_size = max_payload_size;
     connection_info_ptr->config_data.rx.user_cb_param = connection_info_ptr;
     connection_info_ptr->config_data.rx.connection_log_method_data_ptr = &log_method_data;
+    TestResourceProfileSet(test_settings_ptr, &connection_info_ptr->config_data.rx.resource_profile);
 
     // Configure connection callback.
     connection_info_ptr->config_data.rx.connection_cb_ptr = TestConnectionCallback;
@@ -1212,6 +1213,10 @@ CDI_THREAD TestRxCreateThread(void* arg_ptr)
                         connection_info_ptr->config_data.rx.connection_name_str);
         }
 
+        if (!got_error) {
+            TestLogResourceFootprint(connection_info_ptr);
+        }
+
         if (got_error) {
             CdiLogMultilineState m_state;
             CDI_LOG_THREAD_MULTILINE_BEGIN(kLogError, &m_state);
@@ -897,6 +897,7 @@ CDI_THREAD TestTxCreateThread(void* arg_ptr)
         connection_info_ptr->config_data.tx.shared_thread_id = test_settings_ptr->shared_thread_id;
         connection_info_ptr->config_data.tx.thread_core_num = test_settings_ptr->thread_core_num;
         connection_info_ptr->config_data.tx.connection_log_method_data_ptr = &log_method_data;
+        TestResourceProfileSet(test_settings_ptr, &connection_info_ptr->config_data.tx.resource_profile);
 
         // Configure connection callback.
         connection_info_ptr->config_data.tx.connection_cb_ptr = TestConnectionCallback;
@@ -965,6 +966,10 @@ CDI_THREAD TestTxCreateThread(void* arg_ptr)
                         connection_info_ptr->config_data.tx.connection_name_str);
         }
 
+        if (!got_error) {
+            TestLogResourceFootprint(connection_info_ptr);
+        }
+
         if (got_error) {
             CdiLogMultilineState m_state;
             CDI_LOG_THREAD_MULTILINE_BEGIN(kLogError, &m_state);